@@ -0,0 +1,114 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/examples/CMakeLists.txt"
+  "/root/repo/examples/EchoServer/CMakeLists.txt"
+  "/root/repo/tests/CMakeLists.txt"
+  "/root/repo/tests/TestBuffer/CMakeLists.txt"
+  "/root/repo/tests/TestBusyPoll/CMakeLists.txt"
+  "/root/repo/tests/TestComputeThreadPool/CMakeLists.txt"
+  "/root/repo/tests/TestCoroutine/CMakeLists.txt"
+  "/root/repo/tests/TestEventloop/CMakeLists.txt"
+  "/root/repo/tests/TestEventloopThread/CMakeLists.txt"
+  "/root/repo/tests/TestEventloopThreadPool/CMakeLists.txt"
+  "/root/repo/tests/TestFuture/CMakeLists.txt"
+  "/root/repo/tests/TestLog/CMakeLists.txt"
+  "/root/repo/tests/TestLoopMesh/CMakeLists.txt"
+  "/root/repo/tests/TestMemoryPool/CMakeLists.txt"
+  "/root/repo/tests/TestNetAddr/CMakeLists.txt"
+  "/root/repo/tests/TestShareMemory/CMakeLists.txt"
+  "/root/repo/tests/TestTcpClient/CMakeLists.txt"
+  "/root/repo/tests/TestTcpRelay/CMakeLists.txt"
+  "/root/repo/tests/TestTcpServer/CMakeLists.txt"
+  "/root/repo/tests/TestTimer/CMakeLists.txt"
+  "/root/repo/tests/TestUdpServer/CMakeLists.txt"
+  "/root/repo/tests/TestUnixSocket/CMakeLists.txt"
+  "/root/repo/tests/TestUpstreamPool/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestLog/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestNetAddr/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestBuffer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestEventloop/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestEventloopThread/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestEventloopThreadPool/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestTimer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestMemoryPool/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestShareMemory/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestTcpServer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestTcpClient/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestUpstreamPool/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestUdpServer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestUnixSocket/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestTcpRelay/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestBusyPoll/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestComputeThreadPool/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestLoopMesh/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestFuture/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/TestCoroutine/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/EchoServer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/ReactorStatic.dir/DependInfo.cmake"
+  "tests/TestLog/CMakeFiles/TestLog.dir/DependInfo.cmake"
+  "tests/TestNetAddr/CMakeFiles/TestNetAddr.dir/DependInfo.cmake"
+  "tests/TestBuffer/CMakeFiles/TestBuffer.dir/DependInfo.cmake"
+  "tests/TestEventloop/CMakeFiles/TestEventloop.dir/DependInfo.cmake"
+  "tests/TestEventloopThread/CMakeFiles/TestEventloopThread.dir/DependInfo.cmake"
+  "tests/TestEventloopThreadPool/CMakeFiles/TestEventloopThreadPool.dir/DependInfo.cmake"
+  "tests/TestTimer/CMakeFiles/TestTimer.dir/DependInfo.cmake"
+  "tests/TestMemoryPool/CMakeFiles/TestMemoryPool.dir/DependInfo.cmake"
+  "tests/TestShareMemory/CMakeFiles/TestShareMemory.dir/DependInfo.cmake"
+  "tests/TestTcpServer/CMakeFiles/TestTcpServer.dir/DependInfo.cmake"
+  "tests/TestTcpClient/CMakeFiles/TestTcpClient.dir/DependInfo.cmake"
+  "tests/TestUpstreamPool/CMakeFiles/TestUpstreamPool.dir/DependInfo.cmake"
+  "tests/TestUdpServer/CMakeFiles/TestUdpServer.dir/DependInfo.cmake"
+  "tests/TestUnixSocket/CMakeFiles/TestUnixSocket.dir/DependInfo.cmake"
+  "tests/TestTcpRelay/CMakeFiles/TestTcpRelay.dir/DependInfo.cmake"
+  "tests/TestBusyPoll/CMakeFiles/TestBusyPoll.dir/DependInfo.cmake"
+  "tests/TestComputeThreadPool/CMakeFiles/TestComputeThreadPool.dir/DependInfo.cmake"
+  "tests/TestLoopMesh/CMakeFiles/TestLoopMesh.dir/DependInfo.cmake"
+  "tests/TestFuture/CMakeFiles/TestFuture.dir/DependInfo.cmake"
+  "tests/TestCoroutine/CMakeFiles/TestCoroutine.dir/DependInfo.cmake"
+  "examples/EchoServer/CMakeFiles/EchoServer.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,48 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/Acceptor.cpp" "CMakeFiles/ReactorStatic.dir/src/Acceptor.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Acceptor.cpp.o.d"
+  "/root/repo/src/Address.cpp" "CMakeFiles/ReactorStatic.dir/src/Address.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Address.cpp.o.d"
+  "/root/repo/src/Buffer.cpp" "CMakeFiles/ReactorStatic.dir/src/Buffer.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Buffer.cpp.o.d"
+  "/root/repo/src/Channel.cpp" "CMakeFiles/ReactorStatic.dir/src/Channel.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Channel.cpp.o.d"
+  "/root/repo/src/ComputeThreadPool.cpp" "CMakeFiles/ReactorStatic.dir/src/ComputeThreadPool.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/ComputeThreadPool.cpp.o.d"
+  "/root/repo/src/Connection.cpp" "CMakeFiles/ReactorStatic.dir/src/Connection.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Connection.cpp.o.d"
+  "/root/repo/src/Connector.cpp" "CMakeFiles/ReactorStatic.dir/src/Connector.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Connector.cpp.o.d"
+  "/root/repo/src/Coroutine.cpp" "CMakeFiles/ReactorStatic.dir/src/Coroutine.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Coroutine.cpp.o.d"
+  "/root/repo/src/EpPoller.cpp" "CMakeFiles/ReactorStatic.dir/src/EpPoller.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/EpPoller.cpp.o.d"
+  "/root/repo/src/EventLoop.cpp" "CMakeFiles/ReactorStatic.dir/src/EventLoop.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/EventLoop.cpp.o.d"
+  "/root/repo/src/EventLoopThread.cpp" "CMakeFiles/ReactorStatic.dir/src/EventLoopThread.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/EventLoopThread.cpp.o.d"
+  "/root/repo/src/EventLoopThreadPool.cpp" "CMakeFiles/ReactorStatic.dir/src/EventLoopThreadPool.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/EventLoopThreadPool.cpp.o.d"
+  "/root/repo/src/Future.cpp" "CMakeFiles/ReactorStatic.dir/src/Future.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Future.cpp.o.d"
+  "/root/repo/src/Logger.cpp" "CMakeFiles/ReactorStatic.dir/src/Logger.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Logger.cpp.o.d"
+  "/root/repo/src/MemoryPool.cpp" "CMakeFiles/ReactorStatic.dir/src/MemoryPool.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/MemoryPool.cpp.o.d"
+  "/root/repo/src/PPoller.cpp" "CMakeFiles/ReactorStatic.dir/src/PPoller.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/PPoller.cpp.o.d"
+  "/root/repo/src/Poller.cpp" "CMakeFiles/ReactorStatic.dir/src/Poller.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Poller.cpp.o.d"
+  "/root/repo/src/PollerFactory.cpp" "CMakeFiles/ReactorStatic.dir/src/PollerFactory.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/PollerFactory.cpp.o.d"
+  "/root/repo/src/ShareMemory.cpp" "CMakeFiles/ReactorStatic.dir/src/ShareMemory.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/ShareMemory.cpp.o.d"
+  "/root/repo/src/SlabPool.cpp" "CMakeFiles/ReactorStatic.dir/src/SlabPool.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/SlabPool.cpp.o.d"
+  "/root/repo/src/Socket.cpp" "CMakeFiles/ReactorStatic.dir/src/Socket.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Socket.cpp.o.d"
+  "/root/repo/src/Socketop.cpp" "CMakeFiles/ReactorStatic.dir/src/Socketop.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Socketop.cpp.o.d"
+  "/root/repo/src/TcpClient.cpp" "CMakeFiles/ReactorStatic.dir/src/TcpClient.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/TcpClient.cpp.o.d"
+  "/root/repo/src/TcpRelay.cpp" "CMakeFiles/ReactorStatic.dir/src/TcpRelay.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/TcpRelay.cpp.o.d"
+  "/root/repo/src/TcpServer.cpp" "CMakeFiles/ReactorStatic.dir/src/TcpServer.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/TcpServer.cpp.o.d"
+  "/root/repo/src/Timer.cpp" "CMakeFiles/ReactorStatic.dir/src/Timer.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Timer.cpp.o.d"
+  "/root/repo/src/UdpServer.cpp" "CMakeFiles/ReactorStatic.dir/src/UdpServer.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/UdpServer.cpp.o.d"
+  "/root/repo/src/UdpSocket.cpp" "CMakeFiles/ReactorStatic.dir/src/UdpSocket.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/UdpSocket.cpp.o.d"
+  "/root/repo/src/UpstreamPool.cpp" "CMakeFiles/ReactorStatic.dir/src/UpstreamPool.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/UpstreamPool.cpp.o.d"
+  "/root/repo/src/Utils.cpp" "CMakeFiles/ReactorStatic.dir/src/Utils.cpp.o" "gcc" "CMakeFiles/ReactorStatic.dir/src/Utils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
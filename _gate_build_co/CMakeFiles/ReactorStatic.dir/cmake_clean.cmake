@@ -0,0 +1,69 @@
+file(REMOVE_RECURSE
+  "/root/repo/lib/libReactor.a"
+  "/root/repo/lib/libReactor.pdb"
+  "CMakeFiles/ReactorStatic.dir/src/Acceptor.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Acceptor.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Address.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Address.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Buffer.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Buffer.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Channel.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Channel.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/ComputeThreadPool.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/ComputeThreadPool.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Connection.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Connection.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Connector.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Connector.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Coroutine.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Coroutine.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/EpPoller.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/EpPoller.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/EventLoop.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/EventLoop.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/EventLoopThread.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/EventLoopThread.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/EventLoopThreadPool.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/EventLoopThreadPool.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Future.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Future.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Logger.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Logger.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/MemoryPool.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/MemoryPool.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/PPoller.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/PPoller.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Poller.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Poller.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/PollerFactory.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/PollerFactory.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/ShareMemory.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/ShareMemory.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/SlabPool.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/SlabPool.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Socket.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Socket.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Socketop.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Socketop.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/TcpClient.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/TcpClient.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/TcpRelay.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/TcpRelay.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/TcpServer.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/TcpServer.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Timer.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Timer.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/UdpServer.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/UdpServer.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/UdpSocket.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/UdpSocket.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/UpstreamPool.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/UpstreamPool.cpp.o.d"
+  "CMakeFiles/ReactorStatic.dir/src/Utils.cpp.o"
+  "CMakeFiles/ReactorStatic.dir/src/Utils.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ReactorStatic.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
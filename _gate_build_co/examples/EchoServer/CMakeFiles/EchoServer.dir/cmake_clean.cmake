@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/examples/EchoServer"
+  "/root/repo/bin/examples/EchoServer.pdb"
+  "CMakeFiles/EchoServer.dir/EchoServer.cpp.o"
+  "CMakeFiles/EchoServer.dir/EchoServer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/EchoServer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
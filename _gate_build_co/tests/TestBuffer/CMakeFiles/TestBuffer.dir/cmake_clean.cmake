@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestBuffer"
+  "/root/repo/bin/tests/TestBuffer.pdb"
+  "CMakeFiles/TestBuffer.dir/TestBuffer.cpp.o"
+  "CMakeFiles/TestBuffer.dir/TestBuffer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestBuffer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
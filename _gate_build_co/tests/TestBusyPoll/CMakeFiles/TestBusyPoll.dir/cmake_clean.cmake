@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestBusyPoll"
+  "/root/repo/bin/tests/TestBusyPoll.pdb"
+  "CMakeFiles/TestBusyPoll.dir/TestBusyPoll.cpp.o"
+  "CMakeFiles/TestBusyPoll.dir/TestBusyPoll.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestBusyPoll.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestComputeThreadPool"
+  "/root/repo/bin/tests/TestComputeThreadPool.pdb"
+  "CMakeFiles/TestComputeThreadPool.dir/TestComputeThreadPool.cpp.o"
+  "CMakeFiles/TestComputeThreadPool.dir/TestComputeThreadPool.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestComputeThreadPool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestCoroutine"
+  "/root/repo/bin/tests/TestCoroutine.pdb"
+  "CMakeFiles/TestCoroutine.dir/TestCoroutine.cpp.o"
+  "CMakeFiles/TestCoroutine.dir/TestCoroutine.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestCoroutine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
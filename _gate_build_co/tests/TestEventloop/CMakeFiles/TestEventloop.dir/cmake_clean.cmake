@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestEventloop"
+  "/root/repo/bin/tests/TestEventloop.pdb"
+  "CMakeFiles/TestEventloop.dir/TestEventloop.cpp.o"
+  "CMakeFiles/TestEventloop.dir/TestEventloop.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestEventloop.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestEventloopThread"
+  "/root/repo/bin/tests/TestEventloopThread.pdb"
+  "CMakeFiles/TestEventloopThread.dir/TestEventloopThread.cpp.o"
+  "CMakeFiles/TestEventloopThread.dir/TestEventloopThread.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestEventloopThread.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestEventloopThreadPool"
+  "/root/repo/bin/tests/TestEventloopThreadPool.pdb"
+  "CMakeFiles/TestEventloopThreadPool.dir/TestEventloopThreadPool.cpp.o"
+  "CMakeFiles/TestEventloopThreadPool.dir/TestEventloopThreadPool.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestEventloopThreadPool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
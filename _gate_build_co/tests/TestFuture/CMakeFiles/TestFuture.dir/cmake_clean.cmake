@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestFuture"
+  "/root/repo/bin/tests/TestFuture.pdb"
+  "CMakeFiles/TestFuture.dir/TestFuture.cpp.o"
+  "CMakeFiles/TestFuture.dir/TestFuture.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestFuture.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
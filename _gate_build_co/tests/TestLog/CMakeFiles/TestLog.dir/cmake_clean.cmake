@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestLog"
+  "/root/repo/bin/tests/TestLog.pdb"
+  "CMakeFiles/TestLog.dir/TestLog.cpp.o"
+  "CMakeFiles/TestLog.dir/TestLog.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestLog.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestLoopMesh"
+  "/root/repo/bin/tests/TestLoopMesh.pdb"
+  "CMakeFiles/TestLoopMesh.dir/TestLoopMesh.cpp.o"
+  "CMakeFiles/TestLoopMesh.dir/TestLoopMesh.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestLoopMesh.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
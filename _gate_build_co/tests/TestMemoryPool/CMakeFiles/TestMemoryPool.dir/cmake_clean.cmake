@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestMemoryPool"
+  "/root/repo/bin/tests/TestMemoryPool.pdb"
+  "CMakeFiles/TestMemoryPool.dir/TestMemoryPool.cpp.o"
+  "CMakeFiles/TestMemoryPool.dir/TestMemoryPool.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestMemoryPool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
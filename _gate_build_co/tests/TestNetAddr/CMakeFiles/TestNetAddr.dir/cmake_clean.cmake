@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestNetAddr"
+  "/root/repo/bin/tests/TestNetAddr.pdb"
+  "CMakeFiles/TestNetAddr.dir/TestNetAddr.cpp.o"
+  "CMakeFiles/TestNetAddr.dir/TestNetAddr.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestNetAddr.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestShareMemory"
+  "/root/repo/bin/tests/TestShareMemory.pdb"
+  "CMakeFiles/TestShareMemory.dir/TestShareMemory.cpp.o"
+  "CMakeFiles/TestShareMemory.dir/TestShareMemory.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestShareMemory.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
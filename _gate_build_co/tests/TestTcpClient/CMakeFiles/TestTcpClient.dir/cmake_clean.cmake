@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestTcpClient"
+  "/root/repo/bin/tests/TestTcpClient.pdb"
+  "CMakeFiles/TestTcpClient.dir/TestTcpClient.cpp.o"
+  "CMakeFiles/TestTcpClient.dir/TestTcpClient.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestTcpClient.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestTcpRelay"
+  "/root/repo/bin/tests/TestTcpRelay.pdb"
+  "CMakeFiles/TestTcpRelay.dir/TestTcpRelay.cpp.o"
+  "CMakeFiles/TestTcpRelay.dir/TestTcpRelay.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestTcpRelay.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestTcpServer"
+  "/root/repo/bin/tests/TestTcpServer.pdb"
+  "CMakeFiles/TestTcpServer.dir/TestTcpServer.cpp.o"
+  "CMakeFiles/TestTcpServer.dir/TestTcpServer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestTcpServer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestTimer"
+  "/root/repo/bin/tests/TestTimer.pdb"
+  "CMakeFiles/TestTimer.dir/TestTimer.cpp.o"
+  "CMakeFiles/TestTimer.dir/TestTimer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestTimer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
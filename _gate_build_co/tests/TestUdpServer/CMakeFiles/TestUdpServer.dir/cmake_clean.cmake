@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestUdpServer"
+  "/root/repo/bin/tests/TestUdpServer.pdb"
+  "CMakeFiles/TestUdpServer.dir/TestUdpServer.cpp.o"
+  "CMakeFiles/TestUdpServer.dir/TestUdpServer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestUdpServer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
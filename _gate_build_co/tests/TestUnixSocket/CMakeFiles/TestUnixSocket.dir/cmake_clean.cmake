@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestUnixSocket"
+  "/root/repo/bin/tests/TestUnixSocket.pdb"
+  "CMakeFiles/TestUnixSocket.dir/TestUnixSocket.cpp.o"
+  "CMakeFiles/TestUnixSocket.dir/TestUnixSocket.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestUnixSocket.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tests/TestUpstreamPool"
+  "/root/repo/bin/tests/TestUpstreamPool.pdb"
+  "CMakeFiles/TestUpstreamPool.dir/TestUpstreamPool.cpp.o"
+  "CMakeFiles/TestUpstreamPool.dir/TestUpstreamPool.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestUpstreamPool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+#include <iostream>
+#include <Utils/Logger.h>
+#include <Utils/BinaryLogger.h>
+using namespace Utils;
+
+/**
+ * @brief 将BinaryLogger以二进制文件方式写入的日志解码为文本，输出到标准输出
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <binary log file>" << std::endl;
+        return 1;
+    }
+
+    uint64_t count = 0;
+    if (!BinaryLogger::DecodeFile(argv[1], std::cout, count)) {
+        std::cerr << "Decode binary log failed. file: " << argv[1] << " decoded: " << count << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -20,12 +20,121 @@ constexpr int BUFFER_INIT_SIZE = 1024;
 // 缓冲区预分配空间大小，单位：字节
 constexpr int BUFFER_PREPEND_SIZE = 8;
 
+// 连接器首次重连延时，单位：秒
+constexpr double CONNECTOR_INIT_RETRY_DELAY = 0.5;
+
+// 连接器最大重连延时，单位：秒
+constexpr double CONNECTOR_MAX_RETRY_DELAY = 30.0;
+
+// 连接器重连延时随机抖动比例，单位：百分比
+constexpr int CONNECTOR_RETRY_JITTER_PERCENT = 20;
+
+// 上游连接池单个事件循环内每个上游地址的最大空闲连接数
+constexpr std::size_t UPSTREAM_POOL_MAX_IDLE = 8;
+
+// 上游连接池单个事件循环内每个上游地址的最大连接数(含连接中)
+constexpr std::size_t UPSTREAM_POOL_MAX_TOTAL = 64;
+
+// 上游连接池单个连接上允许同时进行的最大请求数(1则不启用管线化)
+constexpr std::size_t UPSTREAM_POOL_MAX_PIPELINE = 1;
+
+// 上游连接池空闲连接超时时长，单位：秒
+constexpr double UPSTREAM_POOL_IDLE_TIMEOUT = 60.0;
+
+// 上游连接池建立连接超时时长，单位：秒
+constexpr double UPSTREAM_POOL_CONNECT_TIMEOUT = 3.0;
+
+// UDP单次批量收发的最大报文数
+constexpr std::size_t UDP_BATCH_SIZE = 64;
+
+// UDP单个报文接收缓冲区大小，单位：字节
+constexpr std::size_t UDP_DATAGRAM_BUFFER_SIZE = 2048;
+
+// UDP启用GRO时单个报文接收缓冲区大小(可容纳合并后的报文)，单位：字节
+constexpr std::size_t UDP_GRO_BUFFER_SIZE = 65536;
+
+// UDP单次GSO发送的最大分段数
+constexpr std::size_t UDP_GSO_MAX_SEGMENTS = 64;
+
+// UDP单次GSO发送的最大数据长度(单个UDP报文负载上限)，单位：字节
+constexpr std::size_t UDP_GSO_MAX_BYTES = 65507;
+
+// UDP单次可读事件中最多批量接收的轮数，避免单个套接字长期占用事件循环
+constexpr int UDP_READ_BATCH_ROUNDS = 16;
+
+// Unix域套接字单次可传递的最大文件描述符数
+constexpr std::size_t UNIX_MAX_PASS_FDS = 16;
+
+// 一致性哈希中每个事件循环的虚拟节点数
+constexpr unsigned int EV_LOOP_HASH_VIRTUAL_NODES = 64;
+
+// 工作事件循环之间消息网格中单个环形队列的容量
+constexpr std::size_t EV_LOOP_MESH_RING_SIZE = 1024;
+
+// 单次可读事件中最多接受的连接数
+constexpr std::size_t ACCEPT_BATCH_SIZE = 64;
+
+// tcp零拷贝转发单方向管道容量，单位：字节
+constexpr std::size_t TCP_RELAY_PIPE_SIZE = 256 * 1024;
+
+// tcp连接再均衡的默认采样间隔，单位：秒
+constexpr double TCP_REBALANCE_INTERVAL = 1.0;
+
+// tcp连接再均衡的默认触发比例，最忙与最闲事件循环的负载之比超过该值时迁移连接
+constexpr double TCP_REBALANCE_RATIO = 1.5;
+
+// tcp连接再均衡的最小负载差，单个采样间隔内低于该值时不迁移，单位：字节
+constexpr uint64_t TCP_REBALANCE_MIN_LOAD = 1024 * 1024;
+
+// tcp连接负载中每次读写事件折算的字节数
+constexpr uint64_t TCP_REBALANCE_EVENT_WEIGHT = 512;
+
+// 计算线程池单个事件循环的后续任务合并投递的最大数量
+constexpr std::size_t COMPUTE_CONTINUATION_BATCH_SIZE = 64;
+
+// 计算线程池后续任务的最长缓存时长，超过后即使仍有待执行任务也投递，单位：微秒
+constexpr int COMPUTE_CONTINUATION_BATCH_DELAY = 200;
+
+// 事件循环线程退出时等待事件循环结束的最长时长，单位：毫秒
+constexpr int EV_LOOP_THD_QUIT_TIMEOUT = 3000;
+
+// 运行时移除工作线程时等待活跃连接数归零的默认最长时长，单位：秒
+constexpr double EV_LOOP_DRAIN_TIMEOUT = 5.0;
+
+// 运行时移除工作线程时检查活跃连接数的间隔，单位：毫秒
+constexpr int EV_LOOP_DRAIN_CHECK_INTERVAL = 10;
+
+// 事件循环阻塞等待期间单轮事件处理耗时的衰减半衰期，单位：毫秒
+constexpr int EV_LOOP_LATENCY_HALF_LIFE = 10;
+
+// 异步日志每个线程的环形缓冲区默认容量，单位：字节
+constexpr std::size_t LOG_ASYNC_RING_SIZE = 1024 * 1024;
+
+// 异步日志后台写线程默认刷新间隔，单位：毫秒
+constexpr int LOG_ASYNC_FLUSH_INTERVAL = 100;
+
+// 异步日志后台写线程单次writev()的最大数据段数
+constexpr int LOG_ASYNC_IOV_MAX = 64;
+
+// 二进制日志单条记录的最大长度，超出部分的参数被截断，单位：字节
+constexpr std::size_t LOG_BINARY_RECORD_MAX = 1024;
+
+// 格式化时间缓冲区长度，格式：YYYY-MM-DD HH:MM:SS.fff，含结尾'\0'
+constexpr std::size_t TIME_FORMAT_SIZE = 24;
+
 // 命名前缀
 const std::string EV_LOOP_THD_POOL_PREFIX = "EV_LOOP_THD_POOL_";
 const std::string EV_LOOP_MAIN_THD_PREFIX = "MAIN_THD_";
 const std::string EV_LOOP_WORK_THD_PREFIX = "WORK_THD_";
 const std::string EV_LOOP_PREFIX = "EV_LOOP_";
 const std::string TIME_QUEUE_PREFIX = "TIME_QUEUE_";
+const std::string SLAB_POOL_PREFIX = "SLAB_POOL_";
+const std::string COMPUTE_THD_POOL_PREFIX = "COMPUTE_THD_POOL_";
+
+// 线程名前缀，线程名最长15个字符，超出部分截断
+const std::string EV_LOOP_MAIN_THD_NAME_PREFIX = "ev_main_";
+const std::string EV_LOOP_WORK_THD_NAME_PREFIX = "ev_work_";
+const std::string COMPUTE_THD_NAME_PREFIX = "compute_";
 
 // 多级命名连接符
 const std::string PREFIX_SIGN = "@";
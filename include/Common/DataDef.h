@@ -49,10 +49,21 @@ typedef enum class ConnStateType : int {
     ConnStateClosed = 0,
     ConnStateConnected = 1,
     ConnStateDisconnected = 2,
-    ConnStateError = 3
+    ConnStateError = 3,
+    ConnStateMigrating = 4
 
 } ConnState_t;
 
+/**
+ * @brief 连接器状态类型
+ */
+typedef enum class ConnectorStateType : int {
+    ConnectorDisconnected = 0,
+    ConnectorConnecting = 1,
+    ConnectorConnected = 2
+
+} ConnectorState_t;
+
 /**
  * @brief poller类型
  */
@@ -68,8 +79,8 @@ typedef enum class PollerType : int {
  */
 typedef enum class PollerControlType : int {
     PollerAdd = 1,
-    PollerModify = 2,
-    PollerRemove = 3
+    PollerModify = 3,
+    PollerRemove = 2
 
 } PollerCtrl_t;
 
@@ -78,7 +89,8 @@ typedef enum class PollerControlType : int {
  */
 typedef enum class AddrType : int {
     IPv4 = AF_INET,
-    IPv6 = AF_INET6
+    IPv6 = AF_INET6,
+    Unix = AF_UNIX
 
 } Addr_t;
 
@@ -87,7 +99,8 @@ typedef enum class AddrType : int {
  */
 typedef enum class SocketType : int {
     TCP = SOCK_STREAM,
-    UDP = SOCK_DGRAM
+    UDP = SOCK_DGRAM,
+    SEQPACKET = SOCK_SEQPACKET
 
 } Socket_t;
 
@@ -101,4 +114,58 @@ typedef enum class SocketShutdownType : int {
 
 } SocketShutdown_t;
 
+/**
+ * @brief tcp服务接受连接方式
+ */
+typedef enum class AcceptModeType : int {
+    /** 主事件循环接受连接，再分发到工作事件循环 */
+    AcceptMainLoop = 0,
+
+    /** 每个工作事件循环各自监听(SO_REUSEPORT)并接受连接 */
+    AcceptPerWorker = 1
+
+} AcceptMode_t;
+
+/**
+ * @brief 工作事件循环选择策略
+ */
+typedef enum class PlacementType : int {
+    /** 轮询 */
+    PlacementRoundRobin = 0,
+
+    /** 活跃连接数最少 */
+    PlacementLeastConnections = 1,
+
+    /** 最近事件循环单轮处理耗时最短 */
+    PlacementLeastLatency = 2,
+
+    /** 按对端地址一致性哈希，同一对端固定到同一事件循环 */
+    PlacementConsistentHash = 3
+
+} Placement_t;
+
+/**
+ * @brief 异步日志缓冲区已满时的处理策略
+ */
+typedef enum class LogOverflowType : int {
+    /** 丢弃日志并计数 */
+    LogOverflowDrop = 0,
+
+    /** 阻塞写日志的线程直到后台写线程腾出空间 */
+    LogOverflowBlock = 1
+
+} LogOverflow_t;
+
+/**
+ * @brief 二进制日志输出方式
+ */
+typedef enum class BinaryLogModeType : int {
+    /** 后台写线程格式化为文本，与文本日志写入同一输出 */
+    BinaryLogText = 0,
+
+    /** 后台写线程直接写入二进制文件，由解码工具离线格式化 */
+    BinaryLogRaw = 1
+
+} BinaryLogMode_t;
+
 }; // namespace Common
\ No newline at end of file
@@ -46,6 +46,9 @@ class EventLoop;
 using EventLoopPtr = std::shared_ptr<EventLoop>;
 using EventLoopWkPtr = std::weak_ptr<EventLoop>;
 
+// 连接id类型
+using ConnectionId = uint64_t;
+
 }; // namespace Net
 
 namespace Thread {
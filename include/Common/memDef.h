@@ -14,6 +14,21 @@ constexpr static uint32_t MEMORY_ALIGNMENT = sizeof(unsigned long);
 // 共享内存默认大小
 constexpr static std::size_t SHARE_MEMORY_DFT_SIZE = 4096;
 
+// slab内存池最小内存块大小(不含内存块头部)
+constexpr static std::size_t SLAB_POOL_MIN_BLOCK_SIZE = 64;
+
+// slab内存池最大内存块大小(不含内存块头部)，超过该大小直接通过malloc()申请
+constexpr static std::size_t SLAB_POOL_MAX_BLOCK_SIZE = 64 * 1024;
+
+// slab内存池单次向系统申请的内存页大小
+constexpr static std::size_t SLAB_POOL_CHUNK_SIZE = 64 * 1024;
+
+// slab内存池内存块规格数量：64B, 128B, ... , 64KB
+constexpr static uint32_t SLAB_POOL_CLASS_NUM = 11;
+
+// slab内存池大块内存规格标识
+constexpr static uint32_t SLAB_POOL_LARGE_CLASS = SLAB_POOL_CLASS_NUM;
+
 /**
  * @brief 小块内存数据结构
  */
@@ -172,4 +187,48 @@ typedef struct ShareMemoryPrivateLockDataType {
 
 } ShareMemoryPrivateLock_dt;
 
+/**
+ * @note  位于每个slab内存块数据前，大小为16字节以保证数据首地址对齐
+ * @brief slab内存块头部数据结构
+ */
+typedef struct SlabBlockHeaderDataType {
+    //                                  内存块所属内存池，大块内存为nullptr
+    void*                               pool { nullptr };
+
+    //                                  内存块规格索引
+    uint32_t                            classIdx { 0 };
+
+    //                                  内存块数据可用大小
+    uint32_t                            size { 0 };
+
+} SlabBlockHeader_dt;
+
+using SlabBlockHeaderPtr = SlabBlockHeader_dt*;
+
+/**
+ * @note  空闲内存块复用数据区域存储链表指针
+ * @brief slab空闲内存块数据结构
+ */
+typedef struct SlabFreeBlockDataType {
+    //                                  下一个空闲内存块
+    SlabFreeBlockDataType*              next { nullptr };
+
+} SlabFreeBlock_dt;
+
+using SlabFreeBlockPtr = SlabFreeBlock_dt*;
+
+/**
+ * @brief slab内存页数据结构
+ */
+typedef struct SlabChunkDataType {
+    //                                  下一个内存页
+    SlabChunkDataType*                  next { nullptr };
+
+    //                                  内存页大小
+    std::size_t                         size { 0 };
+
+} SlabChunk_dt;
+
+using SlabChunkPtr = SlabChunk_dt*;
+
 }; // namespace Common
\ No newline at end of file
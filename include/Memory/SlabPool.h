@@ -0,0 +1,165 @@
+#pragma once
+#include <new>
+#include <array>
+#include <atomic>
+#include <string>
+#include <memory>
+#include <thread>
+#include "Utils/Utils.h"
+#include "Common/memDef.h"
+using namespace Utils;
+using namespace Common;
+
+namespace Memory {
+
+/**
+ * @note  内存块只在所属线程中申请和复用，其他线程释放的内存块先挂到无锁链表上，由所属线程下次申请时回收
+ * @brief slab内存池类(按规格划分空闲链表的定长内存块池)
+ */
+class SlabPool : public Noncopyable, public std::enable_shared_from_this<SlabPool> {
+public:
+    using Ptr = std::shared_ptr<SlabPool>;
+    using WkPtr = std::weak_ptr<SlabPool>;
+    using Memory = void*;
+
+public:
+    explicit SlabPool(std::string id);
+    ~SlabPool();
+
+public:
+    /**
+     * @note            非所属线程申请或申请大小超过SLAB_POOL_MAX_BLOCK_SIZE时直接通过malloc()申请
+     * @brief           申请内存
+     * @return          内存指针
+     * @param           size 申请内存大小
+     */
+    Memory              allocateMemory(std::size_t size);
+
+    /**
+     * @note            可在任意线程中调用
+     * @brief           释放内存
+     * @param           data 内存首地址
+     */
+    void                freeMemory(Memory data);
+
+public:
+    /**
+     * @brief           获取内存块数据可用大小
+     * @return          数据可用大小
+     * @param           data 内存首地址
+     */
+    static std::size_t  GetBlockSize(Memory data);
+
+    /**
+     * @brief           获取内存池id
+     * @return          内存池id
+     */
+    inline std::string  getId() const { return m_id; }
+
+    /**
+     * @brief           获取内存池向系统申请的内存总大小
+     * @return          内存总大小
+     */
+    inline std::size_t  getChunkBytes() const { return m_chunkBytes; }
+
+    /**
+     * @brief           判断当前线程是否为内存池所属线程
+     * @return          判断结果
+     */
+    inline bool         isInOwnerThread() const { return m_ownerThreadId == std::this_thread::get_id(); }
+
+private:
+    /**
+     * @brief           获取申请大小对应的内存块规格索引
+     * @return          规格索引
+     * @param           size 申请内存大小
+     */
+    static uint32_t     GetClassIdx(std::size_t size);
+
+    /**
+     * @brief           申请大块内存
+     * @return          内存指针
+     * @param           size 申请内存大小
+     */
+    static Memory       AllocateLargeMemory(std::size_t size);
+
+    /**
+     * @brief           回收其他线程释放的内存块
+     */
+    void                reclaimRemoteBlocks();
+
+    /**
+     * @brief           为指定规格申请新的内存页并切分成内存块
+     * @return          申请结果
+     * @param           classIdx 规格索引
+     */
+    bool                refillBlocks(uint32_t classIdx);
+
+private:
+    //                  内存池id
+    std::string         m_id;
+
+    //                  内存池所属线程id，为创建内存池的线程，即所属事件循环的线程
+    std::thread::id     m_ownerThreadId;
+
+    //                  各规格空闲内存块链表
+    std::array<SlabFreeBlockPtr, SLAB_POOL_CLASS_NUM> m_freeBlocks;
+
+    //                  其他线程释放的内存块链表
+    std::atomic<SlabFreeBlockPtr> m_remoteFreeBlocks;
+
+    //                  内存页链表
+    SlabChunkPtr        m_chunks;
+
+    //                  内存页总大小
+    std::size_t         m_chunkBytes;
+};
+
+/**
+ * @note  供std::allocate_shared()等标准库接口使用，对象与控制块在同一内存块中分配
+ * @brief slab内存池分配器
+ */
+template <typename T>
+class SlabAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    friend class SlabAllocator;
+
+public:
+    explicit SlabAllocator(SlabPool::Ptr pool) : m_pool(std::move(pool)) {}
+
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U>& other) : m_pool(other.m_pool) {}
+
+public:
+    T* allocate(std::size_t n) {
+        auto mem = nullptr == m_pool ? ::malloc(n * sizeof(T)) : m_pool->allocateMemory(n * sizeof(T));
+        if (nullptr == mem) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(mem);
+    }
+
+    void deallocate(T* data, std::size_t n) {
+        (void)n;
+        nullptr == m_pool ? ::free(data) : m_pool->freeMemory(data);
+    }
+
+    template <typename U>
+    bool operator==(const SlabAllocator<U>& other) const {
+        return m_pool == other.m_pool;
+    }
+
+    template <typename U>
+    bool operator!=(const SlabAllocator<U>& other) const {
+        return m_pool != other.m_pool;
+    }
+
+private:
+    // 所属内存池，持有强引用保证内存池晚于内存块释放
+    SlabPool::Ptr m_pool;
+};
+
+}; // namespace Memory
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include <memory>
+#include <algorithm>
 #include "Common/TypeDef.h"
+#include "Common/ConfigDef.h"
 #include "Utils/Utils.h"
 #include "Utils/Address.h"
 #include "Net/Socket.h"
@@ -23,10 +25,24 @@ public:
 
 public:
     /**
+     * @note   需在所属事件循环线程中调用；监听套接字尚未开始监听时先调用listenSocket()
      * @brief  开启监听
      */
     void listen();
 
+    /**
+     * @note   可在任意线程中调用，在listen()之前执行；端口复用监听组中的顺序即各监听套接字开始监听的顺序
+     * @brief  监听套接字开始监听，不注册事件
+     * @return 监听结果
+     */
+    bool listenSocket();
+
+    /**
+     * @note   需在所属事件循环线程中调用，停止后不再接受新连接
+     * @brief  停止监听
+     */
+    void stop();
+
     /**
      * @brief  正在已监听
      * @return 判断结果
@@ -35,6 +51,22 @@ public:
         return m_isListening;
     }
 
+    /**
+     * @brief  获取监听socket fd
+     * @return 监听socket fd
+     */
+    inline int getFd() const {
+        return m_sock->getFd();
+    }
+
+    /**
+     * @brief  获取事件循环对象弱引用
+     * @return 事件循环对象弱引用
+     */
+    inline EventLoopWkPtr getOwnerLoop() const {
+        return m_ownerLoop;
+    }
+
 protected:
     /**
      * @brief  处理新连接
@@ -50,6 +82,9 @@ protected:
     // 启动监听标识符
     bool m_isListening;
 
+    // 监听套接字是否已开始监听
+    bool m_isSockListening;
+
     // 本端地址
     Address::Ptr m_addr;
 
@@ -76,6 +111,9 @@ public:
     TcpAcceptor(const EventLoopWkPtr& loop, const Address::Ptr& addr, bool reuseport = true);
     ~TcpAcceptor() override = default;
 
+protected:
+    TcpAcceptor(const EventLoopWkPtr& loop, const Address::Ptr& addr, const Socket_t& type, bool reuseport);
+
 public:
     /**
      * @brief  设置新连接回调函数
@@ -86,8 +124,17 @@ public:
         m_newConnCb = cb;
     }
 
+    /**
+     * @brief 设置单次可读事件中最多接受的连接数
+     * @param batchSize 最多接受的连接数，最小为1
+     */
+    inline void setAcceptBatchSize(std::size_t batchSize) {
+        m_acceptBatchSize = std::max<std::size_t>(batchSize, 1);
+    }
+
 protected:
     /**
+     * @note   循环接受连接直到无待接受连接或达到单次上限，避免监听套接字长期占用事件循环
      * @brief  处理新连接
      * @return 处理结果
      * @param  recvTime 接收到事件的时间
@@ -97,6 +144,28 @@ protected:
 private:
     // 新连接回调函数
     NewConnCb m_newConnCb;
+
+    // 单次可读事件中最多接受的连接数
+    std::size_t m_acceptBatchSize;
+};
+
+/**
+ * @note  文件路径地址在绑定前删除残留的套接字文件，析构时删除；抽象地址无需清理
+ * @brief Unix域套接字连接接受类
+ */
+class UnixAcceptor : public TcpAcceptor {
+public:
+    using Ptr = std::shared_ptr<UnixAcceptor>;
+    using WkPtr = std::weak_ptr<UnixAcceptor>;
+
+public:
+    /**
+     * @param loop 事件循环对象弱引用
+     * @param addr Unix域套接字地址
+     * @param type 套接字类型，支持流式(Socket_t::TCP)和SEQPACKET
+     */
+    UnixAcceptor(const EventLoopWkPtr& loop, const Address::Ptr& addr, const Socket_t& type = Socket_t::TCP);
+    ~UnixAcceptor() override;
 };
 
 }; // namespace Net
\ No newline at end of file
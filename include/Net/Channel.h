@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <memory>
 #include <functional>
 #include "Common/TypeDef.h"
@@ -25,8 +26,8 @@ public:
 
     // 事件回调函数类型
     using EventCb = std::function<void(Timestamp)>;
-    // 事件回调函数map，key = 事件类型，value = 事件回调函数
-    using EventCbMap = std::unordered_map<Event_t, EventCb>;
+    // 事件回调函数数组，按读、写、关闭、错误、读写事件顺序存储，避免每个channel额外的哈希表节点分配
+    using EventCbList = std::array<EventCb, 5>;
 
 public:
     Channel(EventLoopWkPtr loop, int fd);
@@ -167,8 +168,8 @@ private:
     // 事件循环对象弱引用
     EventLoopWkPtr m_ownerLoop;
 
-    // 事件回调函数map
-    EventCbMap m_evCbMap;
+    // 事件回调函数数组
+    EventCbList m_evCbList;
 };
 
 /**
@@ -1,6 +1,9 @@
 #pragma once
+#include <deque>
+#include <mutex>
 #include <atomic>
 #include <memory>
+#include <vector>
 #include "Common/TypeDef.h"
 #include "Utils/Utils.h"
 #include "Utils/Buffer.h"
@@ -10,6 +13,8 @@ using namespace Common;
 
 namespace Net {
 
+class TcpRelay;
+
 /**
  * @brief 连接类
  */
@@ -112,26 +117,28 @@ public:
     }
 
     /**
+     * @note   缓冲区内嵌在连接对象中，返回的智能指针共享连接对象的引用计数
      * @brief  获取输入缓冲区
      * @return 输入缓冲区
      */
-    inline Buffer::Ptr getInputBuffer() const {
-        return m_inBuf;
+    inline Buffer::Ptr getInputBuffer() {
+        return Buffer::Ptr(this->shared_from_this(), &m_inBuf);
     }
 
     /**
+     * @note   缓冲区内嵌在连接对象中，返回的智能指针共享连接对象的引用计数
      * @brief  获取输出缓冲区
      * @return 输出缓冲区
      */
-    inline Buffer::Ptr getOutputBuffer() const {
-        return m_outBuf;
+    inline Buffer::Ptr getOutputBuffer() {
+        return Buffer::Ptr(this->shared_from_this(), &m_outBuf);
     }
 
     /**
      * @brief  获取连接id
      * @return 连接id
      */
-    inline std::string getConnectionId() const {
+    inline ConnectionId getConnectionId() const {
         return m_connId;
     }
 
@@ -192,10 +199,88 @@ public:
      * @return 事件循环对象弱引用
      */
     inline EventLoopWkPtr getOwnerLoop() const {
+        std::lock_guard<std::mutex> lock(m_loopMutex);
         return m_ownerLoop;
     }
 
+    /**
+     * @brief  获取连接状态
+     * @return 连接状态
+     */
+    inline ConnState_t getConnState() const {
+        return m_connState;
+    }
+
+    /**
+     * @brief  获取累计读取字节数
+     * @return 累计读取字节数
+     */
+    inline uint64_t getReadBytes() const {
+        return m_readBytes.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief  获取累计写入字节数
+     * @return 累计写入字节数
+     */
+    inline uint64_t getWrittenBytes() const {
+        return m_writtenBytes.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief  获取累计处理的读写事件数
+     * @return 累计事件数
+     */
+    inline uint64_t getEventCount() const {
+        return m_eventCount.load(std::memory_order_relaxed);
+    }
+
 protected:
+    /**
+     * @note   从所属事件循环的slab内存池中分配，事件回调仅持有连接的弱引用
+     * @brief  创建channel并设置事件回调
+     * @return channel对象
+     */
+    ChannelPtr createChannel();
+
+    /**
+     * @note  仅在所属事件循环线程中更新，其他线程可读取
+     * @brief 累加流量统计
+     * @param readBytes 读取字节数
+     * @param writtenBytes 写入字节数
+     * @param events 读写事件数
+     */
+    inline void addTraffic(uint64_t readBytes, uint64_t writtenBytes, uint64_t events) {
+        m_readBytes.store(m_readBytes.load(std::memory_order_relaxed) + readBytes, std::memory_order_relaxed);
+        m_writtenBytes.store(m_writtenBytes.load(std::memory_order_relaxed) + writtenBytes, std::memory_order_relaxed);
+        m_eventCount.store(m_eventCount.load(std::memory_order_relaxed) + events, std::memory_order_relaxed);
+    }
+
+    /**
+     * @note   迁移期间channel已注销，数据暂存在输出缓冲区，由目标事件循环重新注册后写出
+     * @brief  迁移期间写入输出缓冲区
+     * @return 写入结果，连接已不在迁移状态时返回false
+     * @param  data 发送数据
+     * @param  size 发送数据长度
+     */
+    bool bufferWhileMigrating(const void* data, std::size_t size);
+
+    /**
+     * @note   记录定时器id及到期时间，迁移时在目标事件循环中重新设置
+     * @brief  设置延迟关闭定时器
+     * @return 设置结果
+     * @param  loop 设置定时器的事件循环
+     * @param  expires 到期时间
+     */
+    bool armCloseTimer(const EventLoopPtr& loop, Timestamp expires);
+
+    /**
+     * @note  在连接当前所属事件循环中执行，迁移途中投递的任务转投到目标事件循环
+     * @brief 开启或关闭读事件
+     * @param enabled 是否开启
+     */
+    void updateReadEnabled(bool enabled);
+
     /**
      * @brief  处理读事件
      * @param  recvTime 接收到事件的时间
@@ -221,8 +306,8 @@ protected:
     virtual void handleError(Timestamp recvTime) = 0;
 
 protected:
-    // 连接id
-    std::string m_connId;
+    // 连接id(进程内唯一)
+    const ConnectionId m_connId;
 
     // socket对象
     Socket::Ptr m_sock;
@@ -240,10 +325,10 @@ protected:
     WriteableCb m_writeCb;
 
     // 输入缓冲区对象
-    Buffer::Ptr m_inBuf;
+    Buffer m_inBuf;
 
     // 输出缓冲区对象
-    Buffer::Ptr m_outBuf;
+    Buffer m_outBuf;
 
     // channel对象
     ChannelPtr m_channel;
@@ -251,8 +336,29 @@ protected:
     // 事件循环对象弱引用
     EventLoopWkPtr m_ownerLoop;
 
+    // 所属事件循环互斥锁，保护迁移时改变的所属事件循环、迁移期间写入的输出缓冲区及延迟关闭定时器
+    mutable std::mutex m_loopMutex;
+
+    // 延迟关闭定时器id
+    TimerId m_closeTimerId;
+
+    // 延迟关闭到期时间
+    Timestamp m_closeExpires;
+
+    // 是否有未到期的延迟关闭定时器
+    bool m_hasCloseTimer;
+
     // 连接状态
     std::atomic<ConnState_t> m_connState;
+
+    // 累计读取字节数
+    std::atomic<uint64_t> m_readBytes;
+
+    // 累计写入字节数
+    std::atomic<uint64_t> m_writtenBytes;
+
+    // 累计处理的读写事件数
+    std::atomic<uint64_t> m_eventCount;
 };
 
 /**
@@ -263,11 +369,22 @@ public:
     using Ptr = std::shared_ptr<TcpConnection>;
     using WkPtr = std::weak_ptr<TcpConnection>;
     using HighWaterMarkCb = std::function<void(Connection::Ptr conn, std::size_t highWaterMark)>;
+    using MigrateCb = std::function<void(Connection::Ptr conn, bool result)>;
 
 public:
     TcpConnection(const EventLoopWkPtr& loop, const Socket::Ptr& sock);
     ~TcpConnection() override;
 
+public:
+    /**
+     * @note   连接对象从所属事件循环的slab内存池中分配，Unix域套接字创建UnixConnection
+     * @brief  根据连接套接字创建连接对象
+     * @return 连接对象
+     * @param  loop 所属事件循环
+     * @param  sock 连接套接字
+     */
+    static TcpConnection::Ptr Create(const EventLoopWkPtr& loop, const Socket::Ptr& sock);
+
 public:
     /**
      * @brief  发送数据
@@ -283,6 +400,18 @@ public:
      */
     bool shutdown();
 
+    /**
+     * @note   需在所属事件循环线程中调用，转发期间不可迁移；先执行原事件循环中已投递的任务，再注销channel，
+     *         随后在目标事件循环中重新注册并将缓冲区存储迁移到其内存池，未读取的数据由内核保留；
+     *         迁移期间连接状态为ConnStateMigrating，send()写入的数据暂存在输出缓冲区，重新注册后写出；
+     *         未到期的延迟关闭定时器在目标事件循环中按原到期时间重新设置
+     * @brief  将连接迁移到其他事件循环
+     * @return 迁移是否已开始
+     * @param  dstLoop 目标事件循环
+     * @param  cb 迁移结果回调函数，成功时在目标事件循环中执行，失败时在原事件循环中执行
+     */
+    bool migrate(const EventLoopWkPtr& dstLoop, const MigrateCb& cb = nullptr);
+
 public:
     /**
      * @brief 设置高水位回调函数
@@ -335,11 +464,79 @@ protected:
     void handleError(Timestamp recvTime) override;
 
 private:
+    /**
+     * @brief 在原事件循环中注销channel，并投递到目标事件循环
+     * @param dstLoop 目标事件循环
+     * @param cb 迁移结果回调函数
+     */
+    void detachFromLoop(const EventLoopWkPtr& dstLoop, const MigrateCb& cb);
+
+    /**
+     * @brief 在目标事件循环中重新注册channel
+     * @param evType 迁移前监听的事件类型
+     * @param cb 迁移结果回调函数
+     */
+    void attachToLoop(Event_t evType, const MigrateCb& cb);
+
+private:
+    friend class TcpRelay;
+
+    // 是否正在迁移，避免重复迁移
+    bool m_isMigrating;
+
     // tcp高水位线
     std::size_t m_highWaterMark;
 
     // 高水位回调函数
     HighWaterMarkCb m_highWaterMarkCb;
+
+protected:
+    // 连接所属的转发对象，转发期间读写事件由其接管
+    std::shared_ptr<TcpRelay> m_relay;
+};
+
+/**
+ * @note  流式套接字行为与TcpConnection一致；SEQPACKET套接字每次读回调收到一条完整记录，回调需消费该记录以保留记录边界
+ * @brief Unix域套接字连接类，支持通过SCM_RIGHTS传递文件描述符
+ */
+class UnixConnection : public TcpConnection {
+public:
+    using Ptr = std::shared_ptr<UnixConnection>;
+    using WkPtr = std::weak_ptr<UnixConnection>;
+
+public:
+    UnixConnection(const EventLoopWkPtr& loop, const Socket::Ptr& sock);
+    ~UnixConnection() override;
+
+public:
+    /**
+     * @note   需在所属事件循环线程中调用，且输出缓冲区为空；文件描述符随数据首字节到达对端，本端描述符仍由调用方关闭
+     * @brief  发送数据并传递文件描述符
+     * @return 发送结果
+     * @param  data 发送数据(至少1字节)
+     * @param  size 发送数据长度
+     * @param  fds 传递的文件描述符，最多UNIX_MAX_PASS_FDS个
+     */
+    bool sendFds(const void* data, std::size_t size, const std::vector<int>& fds);
+
+    /**
+     * @note   需在所属事件循环线程中调用，文件描述符所有权转移给调用方
+     * @brief  取出已接收的文件描述符
+     * @return 取出的文件描述符数量
+     * @param  fds 文件描述符
+     */
+    std::size_t takeFds(std::vector<int>& fds);
+
+protected:
+    /**
+     * @brief  处理读事件，接收数据及随附的文件描述符
+     * @param  recvTime 接收到事件的时间
+     */
+    void handleRead(Timestamp recvTime) override;
+
+private:
+    // 已接收未取出的文件描述符
+    std::deque<int> m_recvFds;
 };
 
 }; // namespace Net
\ No newline at end of file
@@ -0,0 +1,191 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include "Common/TypeDef.h"
+#include "Utils/Utils.h"
+#include "Utils/Address.h"
+#include "Net/Socket.h"
+using namespace Utils;
+using namespace Common;
+
+namespace Net {
+
+/**
+ * @note  非阻塞连接，连接失败后按带随机抖动的指数退避定时重连；连接过程在所属事件循环线程中执行
+ * @brief TCP连接器类
+ */
+class TcpConnector : public Noncopyable, public std::enable_shared_from_this<TcpConnector> {
+public:
+    using Ptr = std::shared_ptr<TcpConnector>;
+    using WkPtr = std::weak_ptr<TcpConnector>;
+    using NewConnCb = std::function<void(Socket::Ptr& connSock, Timestamp recvTime)>;
+    using FailedCb = std::function<void(int errCode)>;
+
+public:
+    TcpConnector(EventLoopWkPtr loop, Address::Ptr peerAddr);
+    ~TcpConnector();
+
+public:
+    /**
+     * @brief  启动连接
+     * @return 启动结果
+     */
+    bool start();
+
+    /**
+     * @note   重置重连延时后立即重新连接
+     * @brief  重新启动连接
+     * @return 启动结果
+     */
+    bool restart();
+
+    /**
+     * @brief 停止连接，取消进行中的连接和重连定时器
+     */
+    void stop();
+
+public:
+    /**
+     * @brief 设置新连接回调函数
+     * @param cb 新连接回调函数
+     */
+    inline void setNewConnCb(const NewConnCb& cb) {
+        m_newConnCb = cb;
+    }
+
+    /**
+     * @note  每次连接失败后、设置重连定时器前调用，回调中可调用stop()放弃重连
+     * @brief 设置连接失败回调函数
+     * @param cb 连接失败回调函数
+     */
+    inline void setFailedCb(const FailedCb& cb) {
+        m_failedCb = cb;
+    }
+
+    /**
+     * @note  需在启动连接前设置
+     * @brief 设置重连延时
+     * @param initDelay 首次重连延时(单位: 秒)
+     * @param maxDelay 最大重连延时(单位: 秒)
+     */
+    inline void setRetryDelay(double initDelay, double maxDelay) {
+        m_initRetryDelay = initDelay;
+        m_maxRetryDelay = maxDelay;
+        m_retryDelay = initDelay;
+    }
+
+    /**
+     * @brief  获取连接器状态
+     * @return 连接器状态
+     */
+    inline ConnectorState_t getState() const {
+        return m_state;
+    }
+
+    /**
+     * @brief  获取累计重连次数
+     * @return 累计重连次数
+     */
+    inline uint64_t getRetryCount() const {
+        return m_retryCount;
+    }
+
+    /**
+     * @brief  获取对端地址
+     * @return 对端地址
+     */
+    inline Address::Ptr getPeerAddr() const {
+        return m_peerAddr;
+    }
+
+private:
+    /**
+     * @brief 在事件循环线程中启动连接
+     */
+    void startInLoop();
+
+    /**
+     * @brief 在事件循环线程中停止连接
+     */
+    void stopInLoop();
+
+    /**
+     * @brief 创建非阻塞socket并发起连接
+     */
+    void connect();
+
+    /**
+     * @brief 连接进行中，监听socket可写事件
+     * @param sock 连接中的socket
+     */
+    void connecting(const Socket::Ptr& sock);
+
+    /**
+     * @brief  移除channel并取回连接中的socket
+     * @return 连接中的socket
+     */
+    Socket::Ptr resetChannel();
+
+    /**
+     * @brief 按指数退避设置重连定时器
+     * @param errCode 连接失败错误码
+     */
+    void retry(int errCode);
+
+    /**
+     * @brief 处理可写事件，确认连接结果
+     * @param recvTime 接收到事件的时间
+     */
+    void handleWrite(Timestamp recvTime);
+
+    /**
+     * @brief 处理错误事件
+     * @param recvTime 接收到事件的时间
+     */
+    void handleError(Timestamp recvTime);
+
+private:
+    // 事件循环对象弱引用
+    EventLoopWkPtr m_ownerLoop;
+
+    // 对端地址
+    Address::Ptr m_peerAddr;
+
+    // 启动标识符
+    std::atomic_bool m_isStarted;
+
+    // 连接器状态
+    std::atomic<ConnectorState_t> m_state;
+
+    // 连接中的socket对象
+    Socket::Ptr m_sock;
+
+    // 连接中的channel对象
+    ChannelPtr m_channel;
+
+    // 首次重连延时(单位: 秒)
+    double m_initRetryDelay;
+
+    // 最大重连延时(单位: 秒)
+    double m_maxRetryDelay;
+
+    // 下次重连延时(单位: 秒)
+    double m_retryDelay;
+
+    // 是否存在未触发的重连定时器
+    bool m_isRetryTimerSet;
+
+    // 重连定时器id
+    TimerId m_retryTimerId;
+
+    // 累计重连次数
+    std::atomic<uint64_t> m_retryCount;
+
+    // 新连接回调函数
+    NewConnCb m_newConnCb;
+
+    // 连接失败回调函数
+    FailedCb m_failedCb;
+};
+
+}; // namespace Net
\ No newline at end of file
@@ -0,0 +1,441 @@
+#pragma once
+#ifdef REACTOR_ENABLE_COROUTINE
+#include <string>
+#include <memory>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <coroutine>
+#include "Utils/Utils.h"
+#include "Utils/Address.h"
+#include "Net/EventLoop.h"
+#include "Net/Connection.h"
+#include "Net/Connector.h"
+using namespace Utils;
+
+namespace Net {
+
+/**
+ * @note   在事件循环线程中创建的协程帧从该事件循环的slab内存池中分配，其他线程中通过malloc()分配；
+ *         帧前部保存所属内存池，释放前内存池不会析构
+ * @brief  申请协程帧内存
+ * @return 协程帧内存指针
+ * @param  size 协程帧大小
+ */
+void* AllocateCoFrame(std::size_t size);
+
+/**
+ * @brief 释放协程帧内存
+ * @param frame 协程帧内存指针
+ */
+void FreeCoFrame(void* frame);
+
+/**
+ * @brief 记录分离协程中未捕获的异常
+ * @param exception 异常
+ */
+void ReportCoException(const std::exception_ptr& exception);
+
+/**
+ * @brief 协程promise公共部分
+ */
+class CoPromiseBase {
+public:
+    /**
+     * @note  协程结束时对称转移到等待者，分离的协程自行释放协程帧
+     * @brief 协程结束挂起点
+     */
+    struct FinalAwaiter {
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            auto& promise = handle.promise();
+            if (promise.m_isDetached) {
+                if (promise.m_exception) {
+                    ReportCoException(promise.m_exception);
+                }
+                handle.destroy();
+                return std::noop_coroutine();
+            }
+
+            if (promise.m_continuation) {
+                return promise.m_continuation;
+            }
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {
+        }
+    };
+
+public:
+    static void* operator new(std::size_t size) {
+        return AllocateCoFrame(size);
+    }
+
+    static void operator delete(void* frame) {
+        FreeCoFrame(frame);
+    }
+
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+
+    void unhandled_exception() {
+        m_exception = std::current_exception();
+    }
+
+public:
+    // 等待当前协程结束的协程
+    std::coroutine_handle<> m_continuation;
+
+    // 未捕获的异常
+    std::exception_ptr m_exception;
+
+    // 是否已分离
+    bool m_isDetached = false;
+};
+
+/**
+ * @brief 协程返回值存储
+ */
+template <typename T>
+class CoPromiseValue {
+public:
+    template <typename U>
+    void return_value(U&& value) {
+        m_value.emplace(std::forward<U>(value));
+    }
+
+    T takeValue() {
+        return std::move(*m_value);
+    }
+
+private:
+    // 返回值
+    std::optional<T> m_value;
+};
+
+template <>
+class CoPromiseValue<void> {
+public:
+    void return_void() {
+    }
+
+    void takeValue() {
+    }
+};
+
+/**
+ * @note  协程创建后挂起，被co_await或CoSpawn()时开始执行；等待者在被等待协程结束时直接恢复，不经过任务队列
+ * @brief 协程任务
+ */
+template <typename T = void>
+class CoTask : public Noncopyable {
+public:
+    struct promise_type : public CoPromiseBase, public CoPromiseValue<T> {
+        CoTask get_return_object() {
+            return CoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+public:
+    CoTask(CoTask&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {
+    }
+
+    ~CoTask() {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+    }
+
+public:
+    bool await_ready() const noexcept {
+        return !m_handle || m_handle.done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        m_handle.promise().m_continuation = caller;
+        return m_handle;
+    }
+
+    T await_resume() {
+        auto& promise = m_handle.promise();
+        if (promise.m_exception) {
+            std::rethrow_exception(promise.m_exception);
+        }
+        return promise.takeValue();
+    }
+
+    /**
+     * @note  分离后协程在当前线程开始执行，结束时自行释放协程帧，返回值被丢弃
+     * @brief 分离并启动协程
+     */
+    void detach() {
+        auto handle = std::exchange(m_handle, nullptr);
+        if (handle) {
+            handle.promise().m_isDetached = true;
+            handle.resume();
+        }
+    }
+
+private:
+    explicit CoTask(std::coroutine_handle<promise_type> handle) : m_handle(handle) {
+    }
+
+private:
+    // 协程句柄
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+/**
+ * @note  通常在事件循环线程中调用，协程在首个挂起点之前同步执行
+ * @brief 分离并启动协程
+ * @param task 协程任务
+ */
+template <typename T>
+void CoSpawn(CoTask<T> task) {
+    task.detach();
+}
+
+/**
+ * @note  须在事件循环线程中使用；构造时接管连接的连接、读、写完成回调，未读取的数据保留在连接输入缓冲区中；
+ *        同一时刻最多一个读协程和一个写协程等待，连接断开时唤醒全部等待的协程
+ * @brief 协程化TCP连接
+ */
+class CoStream : public Noncopyable, public std::enable_shared_from_this<CoStream> {
+public:
+    using Ptr = std::shared_ptr<CoStream>;
+    using WkPtr = std::weak_ptr<CoStream>;
+
+    /**
+     * @brief 读等待
+     */
+    struct ReadAwaiter {
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> handle);
+        std::string await_resume();
+
+        // 所属协程化连接
+        CoStream* m_stream;
+
+        // 需要读取的字节数，0表示读取全部可读数据
+        std::size_t m_size;
+    };
+
+    /**
+     * @brief 写等待
+     */
+    struct WriteAwaiter {
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+        bool await_resume() const noexcept;
+
+        // 所属协程化连接
+        CoStream* m_stream;
+
+        // 写入的数据
+        std::string m_data;
+    };
+
+public:
+    /**
+     * @brief  创建协程化连接
+     * @return 协程化连接
+     * @param  conn 已打开的TCP连接
+     */
+    static Ptr Create(const TcpConnection::Ptr& conn);
+
+    explicit CoStream(const TcpConnection::Ptr& conn);
+
+public:
+    /**
+     * @note   连接断开且无可读数据时返回空字符串
+     * @brief  读取当前全部可读数据，无数据时挂起等待
+     * @return 读取的数据
+     */
+    inline ReadAwaiter read() {
+        return ReadAwaiter{this, 0};
+    }
+
+    /**
+     * @note   连接在读满前断开时返回空字符串
+     * @brief  读取指定字节数的数据，不足时挂起等待
+     * @return 读取的数据
+     * @param  size 读取的字节数
+     */
+    inline ReadAwaiter readExactly(std::size_t size) {
+        return ReadAwaiter{this, size};
+    }
+
+    /**
+     * @note   数据全部写入内核后恢复
+     * @brief  写入数据
+     * @return 写入结果
+     * @param  data 写入的数据
+     */
+    inline WriteAwaiter write(std::string data) {
+        return WriteAwaiter{this, std::move(data)};
+    }
+
+    /**
+     * @note   对端关闭连接后读协程返回空字符串
+     * @brief  关闭连接写方向
+     * @return 关闭结果
+     */
+    bool shutdown();
+
+public:
+    /**
+     * @brief  连接是否已断开
+     * @return 判断结果
+     */
+    inline bool isClosed() const {
+        return m_isClosed;
+    }
+
+    /**
+     * @brief  获取TCP连接
+     * @return TCP连接
+     */
+    inline TcpConnection::Ptr getConnection() const {
+        return m_conn;
+    }
+
+private:
+    /**
+     * @brief 安装连接回调函数
+     */
+    void attach();
+
+    /**
+     * @brief 处理可读数据，满足等待条件时恢复读协程
+     */
+    void handleMessage();
+
+    /**
+     * @brief 处理写完成，恢复写协程
+     */
+    void handleWriteComplete();
+
+    /**
+     * @brief 处理连接断开，恢复全部等待的协程
+     */
+    void handleClose();
+
+    /**
+     * @brief  输入缓冲区数据是否满足读取条件
+     * @return 判断结果
+     * @param  size 需要读取的字节数，0表示任意数据
+     */
+    bool isReadable(std::size_t size) const;
+
+private:
+    // TCP连接
+    TcpConnection::Ptr m_conn;
+
+    // 等待读的协程
+    std::coroutine_handle<> m_reader;
+
+    // 读等待的字节数，0表示任意数据
+    std::size_t m_readSize;
+
+    // 等待写完成的协程
+    std::coroutine_handle<> m_writer;
+
+    // 是否正在调用send()，期间写完成回调会同步执行
+    bool m_isSending;
+
+    // 写是否已完成
+    bool m_isWriteDone;
+
+    // 连接是否已断开
+    bool m_isClosed;
+};
+
+/**
+ * @brief 定时等待
+ */
+struct CoSleepAwaiter {
+    bool await_ready() const noexcept {
+        return m_delay <= 0;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle);
+
+    bool await_resume() const noexcept {
+        return m_result;
+    }
+
+    // 所属事件循环
+    EventLoopWkPtr m_loop;
+
+    // 等待时长(单位: 秒)
+    double m_delay;
+
+    // 等待结果，添加定时器失败时为false
+    bool m_result;
+};
+
+/**
+ * @note   协程在事件循环线程中恢复，可用于将协程切换到指定事件循环
+ * @brief  挂起协程指定时长
+ * @return 等待结果
+ * @param  loop 事件循环
+ * @param  delay 等待时长(单位: 秒)
+ */
+inline CoSleepAwaiter CoSleep(const EventLoopWkPtr& loop, double delay) {
+    return CoSleepAwaiter{loop, delay, true};
+}
+
+/**
+ * @brief 连接等待
+ */
+struct CoConnectAwaiter {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle);
+
+    TcpConnection::Ptr await_resume() {
+        return std::move(m_conn);
+    }
+
+    // 所属事件循环
+    EventLoopWkPtr m_loop;
+
+    // 对端地址
+    Address::Ptr m_peerAddr;
+
+    // 连接器
+    TcpConnector::Ptr m_connector;
+
+    // 建立的连接，失败时为nullptr
+    TcpConnection::Ptr m_conn;
+};
+
+/**
+ * @note   不重连，首次连接失败即返回nullptr；返回的连接已打开，尚未设置回调函数
+ * @brief  连接对端
+ * @return 建立的连接
+ * @param  loop 连接所属事件循环
+ * @param  peerAddr 对端地址
+ */
+inline CoConnectAwaiter CoConnect(const EventLoopWkPtr& loop, const Address::Ptr& peerAddr) {
+    return CoConnectAwaiter{loop, peerAddr, nullptr, nullptr};
+}
+
+}; // namespace Net
+
+#endif // REACTOR_ENABLE_COROUTINE
\ No newline at end of file
@@ -5,8 +5,11 @@
 #include <atomic>
 #include <memory>
 #include <functional>
+#include <type_traits>
 #include "Common/TypeDef.h"
 #include "Utils/Utils.h"
+#include "Memory/SlabPool.h"
+#include "Net/Future.h"
 using namespace Utils;
 
 namespace Net {
@@ -22,10 +25,38 @@ public:
     using Task = std::function<void()>;
     using TaskList = std::list<Task>;
 
+    /**
+     * @brief 忙轮询统计
+     */
+    struct BusyPollStats {
+        // 零超时轮询耗时(单位: 纳秒)
+        uint64_t m_spinNs = 0;
+
+        // 阻塞等待耗时(单位: 纳秒)
+        uint64_t m_sleepNs = 0;
+
+        // 零超时轮询次数
+        uint64_t m_spinPolls = 0;
+
+        // 零超时轮询获得事件的次数
+        uint64_t m_spinHits = 0;
+
+        // 阻塞等待次数
+        uint64_t m_blockPolls = 0;
+    };
+
 public:
     explicit EventLoop(std::string id);
     ~EventLoop();
 
+public:
+    /**
+     * @note   仅在loop()运行期间有效，事件循环未运行的线程返回nullptr
+     * @brief  获取当前线程中运行的事件循环
+     * @return 事件循环指针
+     */
+    static EventLoop* GetCurrentLoop();
+
 public:
     /**
      * @brief  初始化eventLoop
@@ -79,6 +110,32 @@ public:
      */
     bool executeTaskInLoop(const Task& task, bool highPriority = false);
 
+    /**
+     * @note   任务在当前事件循环中执行，返回值通过异步结果传回；调用方通过then()设置的后续任务在调用方事件循环中执行
+     * @brief  提交有返回值的任务
+     * @return 异步结果，任务投递失败时返回无效的异步结果
+     * @param  func 任务，形如R()
+     */
+    template <typename Func>
+    Future<typename std::result_of<Func()>::type> submit(Func func) {
+        using Result = typename std::result_of<Func()>::type;
+        Promise<Result> promise;
+        if (!this->executeTask([promise, func]() mutable {
+            promise.setValue(func());
+        })) {
+            return Future<Result>();
+        }
+        return promise.getFuture();
+    }
+
+    /**
+     * @note   需在事件循环所在线程中调用；钩子在每轮事件及任务处理完成后按添加顺序执行
+     * @brief  添加事件循环迭代钩子
+     * @return 添加结果
+     * @param  hook 迭代钩子
+     */
+    bool addIterationHook(const Task& hook);
+
 public:
     /**
      * @brief  添加定时器任务
@@ -132,6 +189,14 @@ public:
         return m_threadId == std::this_thread::get_id();
     }
 
+    /**
+     * @brief  是否正在执行迭代钩子
+     * @return 判断结果
+     */
+    inline bool isRunningHooks() const {
+        return m_isRunningHooks;
+    }
+
     /**
      * @brief  获取事件循环id
      * @return 事件循环id
@@ -148,6 +213,94 @@ public:
         return m_threadId;
     }
 
+    /**
+     * @note   内存池仅在事件循环所属线程中复用内存块，用于连接等对象的分配
+     * @brief  获取事件循环内存池
+     * @return 事件循环内存池
+     */
+    inline Memory::SlabPool::Ptr getSlabPool() const {
+        return m_slabPool;
+    }
+
+    /**
+     * @note  由分配连接的一方维护，仅用于负载均衡
+     * @brief 增加活跃连接数
+     */
+    inline void incActiveConnections() {
+        m_activeConnCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 减少活跃连接数
+     * @param count 减少的连接数
+     */
+    inline void decActiveConnections(uint64_t count = 1) {
+        m_activeConnCount.fetch_sub(count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief  获取活跃连接数
+     * @return 活跃连接数
+     */
+    inline uint64_t getActiveConnections() const {
+        return m_activeConnCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @note   每轮从poll()返回到任务处理完成的耗时，按1/8权重做指数平滑；阻塞等待事件期间不再更新，
+     *         按等待时长每EV_LOOP_LATENCY_HALF_LIFE毫秒减半，空闲的事件循环不会一直保留偶发的高耗时
+     * @brief  获取最近单轮事件处理耗时
+     * @return 单轮事件处理耗时(单位: 纳秒)
+     */
+    uint64_t getIterationLatency() const;
+
+    /**
+     * @note  由事件循环线程在设置CPU亲和性后维护
+     * @brief 设置事件循环所在线程绑定的CPU编号
+     * @param cpu CPU编号，未绑定到单个CPU时为-1
+     */
+    inline void setBoundCpu(int cpu) {
+        m_boundCpu.store(cpu, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief  获取事件循环所在线程绑定的CPU编号
+     * @return CPU编号，未绑定到单个CPU时为-1
+     */
+    inline int getBoundCpu() const {
+        return m_boundCpu.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @note  有事件处理后的预算时长内以零超时轮询，避免线程休眠与唤醒的开销，期间持续占用CPU；
+     *        超出预算仍无事件则恢复阻塞等待，在下一次poll()返回后生效
+     * @brief 设置忙轮询预算
+     * @param budgetUs 忙轮询预算(单位: 微秒)，0则不启用
+     */
+    inline void setBusyPollBudget(uint64_t budgetUs) {
+        m_busyPollBudget.store(budgetUs, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief  获取忙轮询预算
+     * @return 忙轮询预算(单位: 微秒)
+     */
+    inline uint64_t getBusyPollBudget() const {
+        return m_busyPollBudget.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 获取忙轮询统计
+     * @param stats 忙轮询统计
+     */
+    inline void getBusyPollStats(BusyPollStats& stats) const {
+        stats.m_spinNs = m_spinNs.load(std::memory_order_relaxed);
+        stats.m_sleepNs = m_sleepNs.load(std::memory_order_relaxed);
+        stats.m_spinPolls = m_spinPolls.load(std::memory_order_relaxed);
+        stats.m_spinHits = m_spinHits.load(std::memory_order_relaxed);
+        stats.m_blockPolls = m_blockPolls.load(std::memory_order_relaxed);
+    }
+
 private:
     /**
      * @brief  处理事件
@@ -165,6 +318,9 @@ private:
     // 事件循环是否在运行
     std::atomic_bool m_running;
 
+    // 是否已请求退出，用于处理loop()启动前调用quit()的情况
+    std::atomic_bool m_quitRequested;
+
     // 事件循环是否在等待poll()中
     std::atomic_bool m_waiting;
 
@@ -180,11 +336,42 @@ private:
     // 任务列表
     TaskList m_taskList;
 
+    // 迭代钩子列表，仅事件循环线程访问，钩子执行中添加钩子不影响遍历
+    TaskList m_iterationHooks;
+
+    // 是否正在执行迭代钩子，仅事件循环线程访问
+    bool m_isRunningHooks;
+
     // 互斥锁, 保护任务列表
     std::mutex m_taskMutex;
 
     // 定时器队列
     TimerQueuePtr m_timerQueue;
+
+    // 内存池
+    Memory::SlabPool::Ptr m_slabPool;
+
+    // 活跃连接数
+    std::atomic<uint64_t> m_activeConnCount;
+
+    // 平滑后的单轮事件处理耗时(单位: 纳秒)，仅事件循环线程写入
+    std::atomic<uint64_t> m_iterationLatency;
+
+    // 单轮事件处理耗时的更新时间(steady_clock，单位: 纳秒)，仅事件循环线程写入
+    std::atomic<int64_t> m_latencyUpdateNs;
+
+    // 所在线程绑定的CPU编号
+    std::atomic<int> m_boundCpu;
+
+    // 忙轮询预算(单位: 微秒)
+    std::atomic<uint64_t> m_busyPollBudget;
+
+    // 忙轮询统计，仅事件循环线程写入
+    std::atomic<uint64_t> m_spinNs;
+    std::atomic<uint64_t> m_sleepNs;
+    std::atomic<uint64_t> m_spinPolls;
+    std::atomic<uint64_t> m_spinHits;
+    std::atomic<uint64_t> m_blockPolls;
 };
 
 }; // namespace Net
\ No newline at end of file
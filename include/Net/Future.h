@@ -0,0 +1,301 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <functional>
+#include "Common/TypeDef.h"
+#include "Utils/Utils.h"
+#include "Memory/SlabPool.h"
+using namespace Utils;
+
+namespace Net {
+
+/**
+ * @brief 异步结果后续任务执行器
+ */
+class FutureExecutor {
+public:
+    using Task = std::function<void()>;
+
+public:
+    /**
+     * @brief  获取当前线程中运行的事件循环
+     * @return 事件循环，非事件循环线程为空
+     */
+    static EventLoopWkPtr CurrentLoop();
+
+    /**
+     * @note   当前线程为事件循环线程时从其内存池中分配异步结果状态
+     * @brief  获取当前线程中运行的事件循环的内存池
+     * @return 内存池，非事件循环线程为nullptr
+     */
+    static Memory::SlabPool::Ptr CurrentSlabPool();
+
+    /**
+     * @note   当前线程即为loop所属线程时直接执行，否则投递到loop执行；loop已释放时丢弃
+     * @brief  在事件循环中执行后续任务
+     * @return 执行结果
+     * @param  loop 事件循环
+     * @param  task 后续任务
+     */
+    static bool Dispatch(const EventLoopWkPtr& loop, const Task& task);
+};
+
+/**
+ * @note  结果与后续任务各自仅设置一次，各自置位同一原子状态中的标志位，由后置位的一方执行后续任务，不使用互斥锁和条件变量
+ * @brief 异步结果共享状态
+ */
+template <typename T>
+class FutureState : public Noncopyable {
+public:
+    using Ptr = std::shared_ptr<FutureState>;
+    using Continuation = std::function<void(T)>;
+
+    /**
+     * @brief 共享状态标志位
+     */
+    enum State_t {
+        // 结果和后续任务均未设置
+        StateEmpty = 0,
+        // 结果已设置
+        StateReady = 1,
+        // 后续任务已设置
+        StateWaiting = 2,
+    };
+
+public:
+    FutureState() : m_state(StateEmpty), m_isValueSet(false), m_isContinuationSet(false), m_isInline(false) {
+    }
+
+public:
+    /**
+     * @brief  设置结果
+     * @return 设置结果，重复设置时返回false
+     * @param  value 结果
+     */
+    bool setValue(T value) {
+        if (m_isValueSet.exchange(true)) {
+            return false;
+        }
+
+        m_value = std::move(value);
+        if (0 != (m_state.fetch_or(StateReady, std::memory_order_acq_rel) & StateWaiting)) {
+            // 后续任务已设置，由设置结果的一方执行
+            this->runContinuation();
+        }
+        return true;
+    }
+
+    /**
+     * @brief  设置后续任务
+     * @return 设置结果，重复设置时返回false
+     * @param  cont 后续任务
+     * @param  loop 后续任务所在事件循环
+     * @param  isInline 是否在设置结果的线程中直接执行，loop为空时同样直接执行
+     */
+    bool setContinuation(const Continuation& cont, const EventLoopWkPtr& loop, bool isInline) {
+        if (nullptr == cont || m_isContinuationSet.exchange(true)) {
+            return false;
+        }
+
+        m_continuation = cont;
+        m_loop = loop;
+        // 未指定事件循环时在设置结果的线程中执行
+        m_isInline = isInline || loop.expired();
+        if (0 != (m_state.fetch_or(StateWaiting, std::memory_order_acq_rel) & StateReady)) {
+            // 结果已设置，由设置后续任务的一方执行
+            this->runContinuation();
+        }
+        return true;
+    }
+
+    /**
+     * @note   设置后续任务后同样可判断
+     * @brief  结果是否已设置
+     * @return 判断结果
+     */
+    inline bool isReady() const {
+        return 0 != (m_state.load(std::memory_order_acquire) & StateReady);
+    }
+
+private:
+    /**
+     * @brief 执行后续任务，结果与后续任务此时均已设置
+     */
+    void runContinuation() {
+        if (m_isInline) {
+            m_continuation(std::move(m_value));
+            return;
+        }
+
+        auto value = std::make_shared<T>(std::move(m_value));
+        auto cont = std::move(m_continuation);
+        FutureExecutor::Dispatch(m_loop, [cont, value]() {
+            cont(std::move(*value));
+        });
+    }
+
+private:
+    // 共享状态，State_t标志位的组合
+    std::atomic<int> m_state;
+
+    // 结果是否已设置
+    std::atomic_bool m_isValueSet;
+
+    // 后续任务是否已设置
+    std::atomic_bool m_isContinuationSet;
+
+    // 结果
+    T m_value;
+
+    // 后续任务
+    Continuation m_continuation;
+
+    // 后续任务所在事件循环
+    EventLoopWkPtr m_loop;
+
+    // 是否在设置结果的线程中直接执行后续任务
+    bool m_isInline;
+};
+
+/**
+ * @note  值语义的轻量句柄，拷贝后共享同一状态；结果类型需可默认构造，不支持void
+ * @brief 异步结果
+ */
+template <typename T>
+class Future {
+public:
+    using Continuation = typename FutureState<T>::Continuation;
+
+public:
+    Future() = default;
+    explicit Future(typename FutureState<T>::Ptr state) : m_state(std::move(state)) {
+    }
+
+public:
+    /**
+     * @note   后续任务在调用then()的事件循环中执行；非事件循环线程中调用时在设置结果的线程中执行
+     * @brief  设置结果就绪后的后续任务
+     * @return 设置结果，每个异步结果仅可设置一次
+     * @param  cont 后续任务，形如void(T)
+     */
+    bool then(const Continuation& cont) {
+        return this->valid() && m_state->setContinuation(cont, FutureExecutor::CurrentLoop(), false);
+    }
+
+    /**
+     * @brief  设置结果就绪后在指定事件循环中执行的后续任务
+     * @return 设置结果，每个异步结果仅可设置一次
+     * @param  loop 后续任务所在事件循环
+     * @param  cont 后续任务，形如void(T)
+     */
+    bool then(const EventLoopWkPtr& loop, const Continuation& cont) {
+        return this->valid() && m_state->setContinuation(cont, loop, false);
+    }
+
+    /**
+     * @note   后续任务应尽量简短，不会切换线程
+     * @brief  设置结果就绪后在设置结果的线程中直接执行的后续任务
+     * @return 设置结果，每个异步结果仅可设置一次
+     * @param  cont 后续任务，形如void(T)
+     */
+    bool thenInline(const Continuation& cont) {
+        return this->valid() && m_state->setContinuation(cont, EventLoopWkPtr(), true);
+    }
+
+    /**
+     * @brief  结果是否已就绪
+     * @return 判断结果
+     */
+    inline bool isReady() const {
+        return this->valid() && m_state->isReady();
+    }
+
+    /**
+     * @brief  是否关联共享状态
+     * @return 判断结果
+     */
+    inline bool valid() const {
+        return nullptr != m_state;
+    }
+
+private:
+    // 共享状态
+    typename FutureState<T>::Ptr m_state;
+};
+
+/**
+ * @note  值语义的轻量句柄，可拷贝到任务中；当前线程为事件循环线程时共享状态从其内存池中分配
+ * @brief 异步结果设置方
+ */
+template <typename T>
+class Promise {
+public:
+    Promise() : m_state(std::allocate_shared<FutureState<T>>(Memory::SlabAllocator<FutureState<T>>(FutureExecutor::CurrentSlabPool()))) {
+    }
+
+public:
+    /**
+     * @brief  获取异步结果
+     * @return 异步结果
+     */
+    inline Future<T> getFuture() const {
+        return Future<T>(m_state);
+    }
+
+    /**
+     * @brief  设置结果
+     * @return 设置结果，重复设置时返回false
+     * @param  value 结果
+     */
+    inline bool setValue(T value) const {
+        return m_state->setValue(std::move(value));
+    }
+
+private:
+    // 共享状态
+    typename FutureState<T>::Ptr m_state;
+};
+
+/**
+ * @note   各结果在设置结果的线程中直接汇总，全部就绪后按输入顺序设置汇总结果，期间不阻塞任何线程
+ * @brief  等待全部异步结果
+ * @return 汇总的异步结果
+ * @param  futures 异步结果列表，每个异步结果的后续任务由本函数设置
+ */
+template <typename T>
+Future<std::vector<T>> WhenAll(std::vector<Future<T>>& futures) {
+    Promise<std::vector<T>> promise;
+    if (futures.empty()) {
+        promise.setValue(std::vector<T>());
+        return promise.getFuture();
+    }
+
+    /**
+     * @brief 汇总上下文
+     */
+    struct WhenAllContext {
+        explicit WhenAllContext(std::size_t count) : m_results(count), m_remaining(count) {
+        }
+
+        // 各异步结果
+        std::vector<T> m_results;
+
+        // 未就绪的异步结果数
+        std::atomic<std::size_t> m_remaining;
+    };
+
+    auto ctx = std::make_shared<WhenAllContext>(futures.size());
+    for (std::size_t idx = 0; idx < futures.size(); ++idx) {
+        futures[idx].thenInline([ctx, idx, promise](T value) {
+            ctx->m_results[idx] = std::move(value);
+            if (1 == ctx->m_remaining.fetch_sub(1, std::memory_order_acq_rel)) {
+                promise.setValue(std::move(ctx->m_results));
+            }
+        });
+    }
+    return promise.getFuture();
+}
+
+}; // namespace Net
\ No newline at end of file
@@ -35,13 +35,20 @@ public:
     bool listen() const;
 
     /**
-     * @note   仅client socket使用
+     * @note   仅client socket使用，非阻塞socket连接进行中时同样返回true
      * @brief  连接
      * @return 连接结果
      * @param  peerAddr 对端地址
      */
     bool connect(const Address::Ptr& peerAddr);
 
+    /**
+     * @note   仅client socket使用，连接建立后获取内核分配的本地地址
+     * @brief  更新本地地址
+     * @return 更新结果
+     */
+    bool updateLocalAddr();
+
     /**
      * @brief 复用地址
      * @param enabled 是否启用
@@ -181,12 +188,13 @@ public:
 
 public:
     /**
-     * @note   仅server socket使用
+     * @note   仅面向连接的server socket(流式或SEQPACKET)使用；连接socket为非阻塞，本端地址沿用监听地址
      * @brief  接受连接
      * @return 接受结果
      * @param  connSock 连接socket
+     * @param  errCode 失败时的错误码
      */
-    bool accept(Socket::Ptr& connSock) const;
+    bool accept(Socket::Ptr& connSock, int& errCode) const;
 
     /**
      * @note  仅tcp socket使用
@@ -209,6 +217,18 @@ public:
      */
     void setKeepaliveEnabled(bool enabled) const;
 
+    /**
+     * @brief 设置套接字关联的CPU编号(SO_INCOMING_CPU)
+     * @param cpu CPU编号
+     */
+    void setIncomingCpu(int cpu) const;
+
+    /**
+     * @brief 设置套接字忙轮询时长(SO_BUSY_POLL)
+     * @param usec 忙轮询时长(单位: 微秒)
+     */
+    void setBusyPoll(int usec) const;
+
 private:
     // socket fd
     const int m_fd;
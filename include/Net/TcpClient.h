@@ -0,0 +1,218 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include "Utils/Utils.h"
+#include "Net/Connector.h"
+#include "Net/Connection.h"
+#include "Thread/EventLoopThreadPool.h"
+using namespace Utils;
+using namespace Thread;
+
+namespace Net {
+
+/**
+ * @note  连接在构造时指定的事件循环中创建，回调函数与TcpServer一致
+ * @brief TCP客户端类
+ */
+class TcpClient : public Noncopyable, public std::enable_shared_from_this<TcpClient> {
+public:
+    using Ptr = std::shared_ptr<TcpClient>;
+    using WkPtr = std::weak_ptr<TcpClient>;
+    using ConnCb = TcpConnection::ConnCb;
+    using ReadableCb = TcpConnection::ReadableCb;
+    using WriteableCb = TcpConnection::WriteableCb;
+
+public:
+    TcpClient(const EventLoopWkPtr& loop, Address::Ptr peerAddr);
+
+    /**
+     * @note  按线程池的选择策略选择工作事件循环(一致性哈希按对端地址选择)，与共享该线程池的服务共用事件循环；
+     *        已建立的连接计入所属事件循环的活跃连接数，发起连接时向线程池注册排空回调，所属事件循环被移除时
+     *        连接迁移到保留的事件循环，连接器随之重建
+     * @brief 在已有的事件循环线程池上创建客户端
+     * @param pool 事件循环线程池
+     * @param peerAddr 对端地址
+     */
+    TcpClient(const EventLoopThreadPool::Ptr& pool, Address::Ptr peerAddr);
+    ~TcpClient();
+
+public:
+    /**
+     * @brief  发起连接，连接失败时自动重连
+     * @return 发起结果
+     */
+    bool connect();
+
+    /**
+     * @brief 断开已建立的连接(关闭写端)，并不再重连
+     */
+    void disconnect();
+
+    /**
+     * @brief 停止进行中的连接和重连
+     */
+    void stop();
+
+public:
+    /**
+     * @brief 设置连接断开后是否自动重连
+     * @param enabled 是否启用
+     */
+    inline void setRetryEnabled(bool enabled) {
+        m_isRetry = enabled;
+    }
+
+    /**
+     * @note  需在发起连接前设置
+     * @brief 设置重连延时
+     * @param initDelay 首次重连延时(单位: 秒)
+     * @param maxDelay 最大重连延时(单位: 秒)
+     */
+    inline void setRetryDelay(double initDelay, double maxDelay) {
+        std::lock_guard<std::mutex> lock(m_connMutex);
+        m_initRetryDelay = initDelay;
+        m_maxRetryDelay = maxDelay;
+        m_connector->setRetryDelay(initDelay, maxDelay);
+    }
+
+    /**
+     * @brief 设置连接回调函数
+     * @param cb 回调函数
+     */
+    inline void setConnectCallback(const ConnCb& cb) {
+        m_connCb = cb;
+    }
+
+    /**
+     * @brief 设置数据读取回调函数
+     * @param cb 回调函数
+     */
+    inline void setMessageCallback(const ReadableCb& cb) {
+        m_readCb = cb;
+    }
+
+    /**
+     * @brief 设置数据写入回调函数
+     * @param cb 回调函数
+     */
+    inline void setWriteCompleteCallback(const WriteableCb& cb) {
+        m_writeCb = cb;
+    }
+
+    /**
+     * @brief  获取当前连接
+     * @return 当前连接，未建立连接时返回空
+     */
+    inline TcpConnection::Ptr getConnection() const {
+        std::lock_guard<std::mutex> lock(m_connMutex);
+        return m_conn;
+    }
+
+    /**
+     * @brief  获取连接器
+     * @return 连接器
+     */
+    inline TcpConnector::Ptr getConnector() const {
+        std::lock_guard<std::mutex> lock(m_connMutex);
+        return m_connector;
+    }
+
+    /**
+     * @brief  获取客户端信息
+     * @return 客户端信息
+     */
+    inline std::string getClientInfo() const {
+        return m_peerAddr->printIpPort();
+    }
+
+private:
+    /**
+     * @brief 新连接处理函数
+     * @param connSock 连接套接字
+     * @param recvTime 连接建立时间
+     */
+    void onNewConnection(Socket::Ptr& connSock, Timestamp recvTime);
+
+    /**
+     * @brief 连接关闭处理函数
+     * @param conn 关闭的连接
+     */
+    void onConnectionClosed(const Connection::Ptr& conn);
+
+    /**
+     * @note  所属事件循环被线程池移除时，在该事件循环中执行；isForce为true时关闭连接
+     * @brief 将连接及连接器迁移到保留的工作事件循环
+     * @param loop 被移除的事件循环
+     * @param isForce 是否强制关闭
+     */
+    void drainInLoop(const EventLoopPtr& loop, bool isForce);
+
+    /**
+     * @brief  创建连接器，沿用重连延时并设置新连接回调
+     * @return 连接器
+     * @param  loop 连接器所属事件循环
+     */
+    TcpConnector::Ptr createConnector(const EventLoopWkPtr& loop);
+
+    /**
+     * @note  仅在线程池上创建的客户端计数，已计入其他事件循环时先从其中扣减
+     * @brief 将当前连接计入事件循环的活跃连接数
+     * @param loop 事件循环
+     */
+    void countConnection(const EventLoopPtr& loop);
+
+    /**
+     * @brief 从事件循环的活跃连接数中扣减当前连接
+     * @param loop 事件循环，为空时从已计入的事件循环中扣减
+     */
+    void uncountConnection(const EventLoopPtr& loop);
+
+private:
+    // 事件循环对象弱引用，所属事件循环被移除时改变，由m_connMutex保护
+    EventLoopWkPtr m_ownerLoop;
+
+    // 对端地址
+    Address::Ptr m_peerAddr;
+
+    // 连接器对象，由m_connMutex保护
+    TcpConnector::Ptr m_connector;
+
+    // 是否期望保持连接
+    std::atomic_bool m_isConnect;
+
+    // 连接断开后是否自动重连
+    std::atomic_bool m_isRetry;
+
+    // 当前连接互斥锁
+    mutable std::mutex m_connMutex;
+
+    // 当前连接
+    TcpConnection::Ptr m_conn;
+
+    // 所属线程池，仅在线程池上创建时有效
+    EventLoopThreadPool::WkPtr m_pool;
+
+    // 在线程池中注册的排空回调id
+    uint64_t m_drainCbId;
+
+    // 当前连接已计入活跃连接数的事件循环，由m_connMutex保护
+    EventLoopWkPtr m_countedLoop;
+
+    // 首次重连延时(单位: 秒)，重建连接器时沿用
+    double m_initRetryDelay;
+
+    // 最大重连延时(单位: 秒)，重建连接器时沿用
+    double m_maxRetryDelay;
+
+    // 连接回调函数
+    ConnCb m_connCb;
+
+    // 数据读取回调函数
+    ReadableCb m_readCb;
+
+    // 数据写入回调函数
+    WriteableCb m_writeCb;
+};
+
+}; // namespace Net
\ No newline at end of file
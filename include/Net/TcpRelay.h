@@ -0,0 +1,173 @@
+#pragma once
+#include <array>
+#include <memory>
+#include "Common/ConfigDef.h"
+#include "Utils/Utils.h"
+#include "Net/Connection.h"
+using namespace Utils;
+
+namespace Net {
+
+/**
+ * @note  两个连接需属于同一事件循环，转发期间连接的读写事件由转发对象接管，不再调用连接的消息回调；
+ *        数据经内核管道通过splice()在两个套接字间移动，不经过用户态缓冲区；
+ *        对端关闭写方向后，待管道中数据写完再关闭另一端的写方向(半关闭)，两个方向均结束后关闭两个连接；
+ *        向已关闭的对端写数据可能触发SIGPIPE，使用方需忽略该信号
+ * @brief tcp连接零拷贝转发类
+ */
+class TcpRelay : public Noncopyable, public std::enable_shared_from_this<TcpRelay> {
+public:
+    using Ptr = std::shared_ptr<TcpRelay>;
+    using WkPtr = std::weak_ptr<TcpRelay>;
+    // 转发结束回调，两个方向均结束或任一连接异常时调用
+    using FinishCb = std::function<void(const TcpRelay::Ptr& relay)>;
+
+    /**
+     * @brief 单方向转发状态
+     */
+    struct RelayPipe {
+        // 数据来源连接
+        TcpConnection::WkPtr m_src;
+
+        // 数据目的连接
+        TcpConnection::WkPtr m_dst;
+
+        // 管道读端
+        int m_pipeReadFd = -1;
+
+        // 管道写端
+        int m_pipeWriteFd = -1;
+
+        // 管道中待写出的数据长度
+        std::size_t m_pending = 0;
+
+        // 累计转发数据长度
+        uint64_t m_bytes = 0;
+
+        // 来源连接是否已读到结束
+        bool m_isSrcEof = false;
+
+        // 该方向是否已结束
+        bool m_isFinished = false;
+    };
+
+public:
+    TcpRelay(const TcpConnection::Ptr& first, const TcpConnection::Ptr& second);
+    ~TcpRelay();
+
+public:
+    /**
+     * @note   需在连接所属事件循环线程中调用，连接输入缓冲区中已有的数据先转发给另一端
+     * @brief  开始转发
+     * @return 开始结果
+     */
+    bool start();
+
+    /**
+     * @note  需在连接所属事件循环线程中调用
+     * @brief 停止转发并关闭两个连接
+     */
+    void stop();
+
+public:
+    /**
+     * @brief 设置转发结束回调函数
+     * @param cb 回调函数
+     */
+    inline void setFinishCallback(const FinishCb& cb) {
+        m_finishCb = cb;
+    }
+
+    /**
+     * @note  需在开始转发前设置，关闭后经连接缓冲区复制转发；splice()不可用时自动关闭
+     * @brief 设置是否启用零拷贝转发
+     * @param enabled 是否启用
+     */
+    inline void setSpliceEnabled(bool enabled) {
+        m_isSpliceEnabled = enabled;
+    }
+
+    /**
+     * @brief  是否启用零拷贝转发
+     * @return 是否启用
+     */
+    inline bool isSpliceEnabled() const {
+        return m_isSpliceEnabled;
+    }
+
+    /**
+     * @brief  获取第一个连接发往第二个连接的累计数据长度
+     * @return 累计数据长度
+     */
+    inline uint64_t getForwardBytes() const {
+        return m_pipes[0].m_bytes;
+    }
+
+    /**
+     * @brief  获取第二个连接发往第一个连接的累计数据长度
+     * @return 累计数据长度
+     */
+    inline uint64_t getBackwardBytes() const {
+        return m_pipes[1].m_bytes;
+    }
+
+private:
+    friend class TcpConnection;
+
+    /**
+     * @brief 处理连接读事件，将数据移入对应方向的管道
+     * @param conn 可读连接
+     */
+    void handleRead(const TcpConnection::Ptr& conn);
+
+    /**
+     * @brief 处理连接写事件，继续写出对应方向管道中的数据
+     * @param conn 可写连接
+     */
+    void handleWrite(const TcpConnection::Ptr& conn);
+
+    /**
+     * @brief 处理连接关闭事件
+     * @param conn 关闭的连接
+     */
+    void handleClose(const TcpConnection::Ptr& conn);
+
+    /**
+     * @brief 经连接输入缓冲区复制转发数据
+     * @param pipe 转发方向
+     */
+    void copyRead(RelayPipe& pipe);
+
+    /**
+     * @note  目的端阻塞时停止读取来源端(背压)，目的端恢复可写后继续读取
+     * @brief 将待转发数据写入目的连接，并根据结果调整两端的读写事件
+     * @param pipe 转发方向
+     */
+    void flush(RelayPipe& pipe);
+
+    /**
+     * @brief 结束转发，关闭仍处于转发中的连接
+     */
+    void finish();
+
+private:
+    // 所属事件循环
+    EventLoopWkPtr m_ownerLoop;
+
+    // 转发方向，0: 第一个连接 -> 第二个连接，1: 第二个连接 -> 第一个连接
+    std::array<RelayPipe, 2> m_pipes;
+
+    // 是否启用零拷贝转发
+    bool m_isSpliceEnabled;
+
+    // 是否已开始转发
+    bool m_isStarted;
+
+    // 是否已结束转发
+    bool m_isFinished;
+
+    // 转发结束回调函数
+    FinishCb m_finishCb;
+};
+
+}; // namespace Net
\ No newline at end of file
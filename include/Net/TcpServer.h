@@ -1,7 +1,10 @@
 #pragma once
-#include <map>
+#include <mutex>
 #include <atomic>
 #include <memory>
+#include <vector>
+#include <unordered_map>
+#include "Common/DataDef.h"
 #include "Utils/Utils.h"
 #include "Net/Acceptor.h"
 #include "Net/Connection.h"
@@ -22,10 +25,46 @@ public:
     using ReadableCb = TcpConnection::ReadableCb;
     using WriteableCb = TcpConnection::WriteableCb;
     // key = connection id, value = connection ptr
-    using ConnectionMap = std::map<std::string, Connection::Ptr>;
+    using ConnectionMap = std::unordered_map<ConnectionId, Connection::Ptr>;
+
+    /**
+     * @note  分片仅允许在其所属事件循环线程中访问，因此无需加锁
+     * @brief 连接管理分片
+     */
+    struct ConnectionShard {
+        using Ptr = std::shared_ptr<ConnectionShard>;
+        using WkPtr = std::weak_ptr<ConnectionShard>;
+
+        // 分片所属事件循环
+        EventLoopWkPtr m_ownerLoop;
+
+        // 分片管理的连接
+        ConnectionMap m_connMap;
+
+        // 上一采样间隔内分片的连接负载，由所属事件循环更新
+        std::atomic<uint64_t> m_load{0};
+
+        // 各连接上次采样时的累计负载，仅所属事件循环访问
+        std::unordered_map<ConnectionId, uint64_t> m_lastTraffic;
+
+        // 各连接上一采样间隔内的负载，仅所属事件循环访问
+        std::unordered_map<ConnectionId, uint64_t> m_connLoad;
+    };
+
+    // key = event loop, value = connection shard
+    using ConnectionShardMap = std::unordered_map<const EventLoop*, ConnectionShard::Ptr>;
 
 public:
     explicit TcpServer(Address::Ptr addr, const ThreadInitCb& cb = nullptr, unsigned int numWorkThreads = 4, bool reuseport = true);
+
+    /**
+     * @note  多个服务及客户端共享同一组事件循环；绑定CPU、忙轮询、选择策略及扩缩容均作用于共享的线程池
+     * @brief 在已有的事件循环线程池上创建服务
+     * @param pool 事件循环线程池
+     * @param addr 本端地址
+     * @param reuseport 是否启用端口复用
+     */
+    TcpServer(const EventLoopThreadPool::Ptr& pool, Address::Ptr addr, bool reuseport = true);
     ~TcpServer();
 
 public:
@@ -64,6 +103,131 @@ public:
         m_writeCb = cb;
     }
 
+    /**
+     * @note  需在启动服务前设置；每个工作事件循环各自监听时，接受连接、创建连接及读写均在同一线程中完成，
+     *        Unix域套接字地址不支持端口复用，始终由主事件循环接受连接
+     * @brief 设置接受连接方式
+     * @param mode 接受连接方式
+     * @param cpuSteering 是否按处理数据包的CPU分发连接(SO_ATTACH_REUSEPORT_CBPF)，各工作线程需一对一绑定到不同CPU，否则使用内核哈希
+     */
+    inline void setAcceptMode(AcceptMode_t mode, bool cpuSteering = false) {
+        m_acceptMode = mode;
+        m_isCpuSteering = cpuSteering;
+    }
+
+    /**
+     * @note  需在启动服务前设置；仅对绑定到单个CPU的工作事件循环生效(见EventLoopThreadPool::pinWorkLoops())，
+     *        新连接及各自监听时的监听套接字设置为所属事件循环的CPU
+     * @brief 设置是否按所属事件循环的CPU设置套接字SO_INCOMING_CPU
+     * @param enabled 是否启用
+     */
+    inline void setIncomingCpuEnabled(bool enabled) {
+        m_isIncomingCpu = enabled;
+    }
+
+    /**
+     * @note   第i个工作线程绑定到cpus[i % cpus.size()]
+     * @brief  将工作线程逐一绑定到单个CPU
+     * @return 设置结果
+     * @param  cpus CPU编号列表
+     */
+    inline bool pinWorkLoops(const std::vector<int>& cpus) {
+        return m_workLoopThreadPool->pinWorkLoops(cpus);
+    }
+
+    /**
+     * @note   工作事件循环在有事件后的预算时长内以零超时轮询，新连接设置SO_BUSY_POLL；
+     *         忙轮询持续占用CPU，工作线程应绑定到独占的CPU(见pinWorkLoops())
+     * @brief  设置忙轮询
+     * @return 设置结果
+     * @param  loopBudgetUs 事件循环忙轮询预算(单位: 微秒)，0则不启用
+     * @param  socketBusyPollUs 新连接套接字忙轮询时长(单位: 微秒)，0则不设置
+     */
+    inline bool setBusyPoll(uint64_t loopBudgetUs, int socketBusyPollUs = 0) {
+        m_socketBusyPollUs = socketBusyPollUs;
+        return m_workLoopThreadPool->setBusyPollBudget(loopBudgetUs);
+    }
+
+    /**
+     * @note  仅主事件循环接受连接时生效；一致性哈希按对端ip选择
+     * @brief 设置新连接的工作事件循环选择策略
+     * @param policy 选择策略
+     */
+    inline void setPlacementPolicy(Placement_t policy) {
+        m_workLoopThreadPool->setPlacementPolicy(policy);
+    }
+
+    /**
+     * @brief  获取事件循环线程池
+     * @return 事件循环线程池
+     */
+    inline EventLoopThreadPool::Ptr getEventLoopThreadPool() const {
+        return m_workLoopThreadPool;
+    }
+
+    /**
+     * @note  移除工作事件循环时(包括通过共享的线程池直接移除)，迁移失败的连接按关闭处理
+     * @brief 设置移除工作事件循环时是否将其中的连接迁移到保留的事件循环
+     * @param enabled 是否迁移
+     */
+    inline void setMigrateOnDrain(bool enabled) {
+        m_isMigrateOnDrain = enabled;
+    }
+
+    /**
+     * @note   共享线程池的任一服务每个工作事件循环独立监听时不可扩缩容
+     * @brief  运行时增加工作事件循环，新连接随即按选择策略分配到新事件循环
+     * @return 增加结果
+     * @param  count 增加的工作事件循环数
+     */
+    bool addWorkLoops(unsigned int count);
+
+    /**
+     * @note   需在工作事件循环以外的线程中调用，阻塞至移除完成；共享线程池的任一服务每个工作事件循环独立监听时不可扩缩容
+     * @brief  运行时移除工作事件循环，共享线程池的各服务将其中的连接迁移到保留的事件循环，
+     *         或关闭写方向等待对端关闭，超时后强制关闭
+     * @return 移除结果
+     * @param  count 移除的工作事件循环数
+     * @param  drainTimeout 等待连接迁移或关闭的最长时长(单位: 秒)
+     */
+    bool removeWorkLoops(unsigned int count, double drainTimeout = EV_LOOP_DRAIN_TIMEOUT);
+
+    /**
+     * @brief  获取当前工作事件循环数
+     * @return 工作事件循环数
+     */
+    inline std::size_t getWorkLoopCount() const {
+        return m_workLoopThreadPool->getWorkLoopCount();
+    }
+
+    /**
+     * @note   连接随之在两个分片之间转移，活跃连接数在原事件循环注销连接后转移；
+     *         在其他线程中调用时投递到连接所属事件循环中执行，返回值仅表示是否已投递
+     * @brief  将tcp服务管理的连接迁移到其他工作事件循环
+     * @return 迁移是否已开始
+     * @param  conn 连接
+     * @param  dstLoop 目标工作事件循环
+     */
+    bool migrateConnection(const Connection::Ptr& conn, const EventLoopWkPtr& dstLoop);
+
+    /**
+     * @note   在主事件循环中按采样间隔运行，各工作事件循环统计其连接在上一间隔内的负载(读写字节数及事件数折算)；
+     *         最忙与最闲的事件循环负载之比超过ratio时，从最忙的事件循环迁移一个负载不超过差值一半的最热连接到最闲的事件循环
+     * @brief  启用连接再均衡
+     * @return 启用结果
+     * @param  intervalSec 采样间隔(单位: 秒)
+     * @param  ratio 触发比例
+     */
+    bool enableRebalance(double intervalSec = TCP_REBALANCE_INTERVAL, double ratio = TCP_REBALANCE_RATIO);
+
+    /**
+     * @brief  获取已完成的连接迁移数
+     * @return 迁移数
+     */
+    inline uint64_t getMigratedCount() const {
+        return m_migratedCount;
+    }
+
     /**
      * @brief  获取服务信息
      * @return 服务信息
@@ -73,6 +237,17 @@ public:
     }
 
 private:
+    /**
+     * @brief 在主事件循环中创建监听器，接受的连接分发到工作事件循环
+     */
+    void listenInMainLoop();
+
+    /**
+     * @brief  在每个工作事件循环中创建端口复用监听器
+     * @return 创建结果
+     */
+    bool listenInWorkLoops();
+
     /**
      * @brief 新连接处理函数
      * @param connSock 连接套接字
@@ -80,6 +255,55 @@ private:
      */
     void onNewConnection(Socket::Ptr& connSock, Timestamp recvTime);
 
+    /**
+     * @note  仅在分片所属事件循环线程中调用
+     * @brief 在工作线程中创建并注册新连接
+     * @param shard 连接所属分片
+     * @param connSock 连接套接字
+     */
+    void newConnectionInLoop(const ConnectionShard::Ptr& shard, const Socket::Ptr& connSock);
+
+    /**
+     * @note   运行时增加的工作事件循环在首次分配连接时创建分片
+     * @brief  获取事件循环对应的连接管理分片
+     * @return 连接管理分片
+     * @param  loop 工作事件循环
+     */
+    ConnectionShard::Ptr getConnectionShard(const EventLoopPtr& loop);
+
+    /**
+     * @brief  在连接所属事件循环中检查连接所属分片并迁移
+     * @return 迁移是否已开始
+     * @param  conn 连接
+     * @param  srcLoop 连接所属事件循环
+     * @param  dstLoop 目标工作事件循环
+     */
+    bool migrateConnectionInLoop(const TcpConnection::Ptr& conn, const EventLoopPtr& srcLoop, const EventLoopWkPtr& dstLoop);
+
+    /**
+     * @brief 在被移除的事件循环中排空连接
+     * @param loop 被移除的事件循环
+     * @param isForce 是否强制关闭
+     */
+    void drainConnectionsInLoop(const EventLoopPtr& loop, bool isForce);
+
+    /**
+     * @brief 移除所属事件循环已退出的分片
+     */
+    void removeExpiredShards();
+
+    /**
+     * @brief 按各分片的负载迁移连接并发起下一轮采样，在主事件循环中执行
+     * @param ratio 触发比例
+     */
+    void rebalance(double ratio);
+
+    /**
+     * @brief 统计分片中各连接上一采样间隔内的负载，在分片所属事件循环中执行
+     * @param shard 连接管理分片
+     */
+    static void SampleShardLoad(const ConnectionShard::Ptr& shard);
+
 private:
     // 服务启动状态
     std::atomic_bool m_isStarted;
@@ -96,8 +320,38 @@ private:
     // 接收器对象
     TcpAcceptor::Ptr m_acceptor;
 
-    // 连接管理map
-    ConnectionMap m_connMap;
+    // 接受连接方式
+    AcceptMode_t m_acceptMode;
+
+    // 是否按CPU分发连接
+    bool m_isCpuSteering;
+
+    // 是否按所属事件循环的CPU设置SO_INCOMING_CPU
+    bool m_isIncomingCpu;
+
+    // 新连接套接字忙轮询时长(单位: 微秒)
+    std::atomic<int> m_socketBusyPollUs;
+
+    // 工作事件循环各自的接收器对象，按绑定顺序排列
+    std::vector<TcpAcceptor::Ptr> m_workAcceptors;
+
+    // 在线程池中注册的排空回调id，0表示未注册
+    uint64_t m_drainCbId;
+
+    // 移除工作事件循环时是否迁移连接
+    std::atomic_bool m_isMigrateOnDrain;
+
+    // 连接再均衡定时器id，0表示未启用
+    TimerId m_rebalanceTimerId;
+
+    // 已完成的连接迁移数
+    std::atomic<uint64_t> m_migratedCount;
+
+    // 连接管理分片互斥锁，仅保护分片表，分片内连接由所属事件循环访问
+    std::mutex m_shardMutex;
+
+    // 连接管理分片，每个工作事件循环对应一个分片
+    ConnectionShardMap m_connShards;
 
     // 连接回调函数
     ConnCb m_connCb;
@@ -0,0 +1,119 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "Utils/Utils.h"
+#include "Net/UdpSocket.h"
+#include "Thread/EventLoopThreadPool.h"
+using namespace Utils;
+using namespace Thread;
+
+namespace Net {
+
+/**
+ * @note  每个工作事件循环各自创建一个启用端口复用的UDP套接字绑定同一地址，由内核按报文四元组分发
+ * @brief UDP服务器类
+ */
+class UdpServer : public Noncopyable, public std::enable_shared_from_this<UdpServer> {
+public:
+    using Ptr = std::shared_ptr<UdpServer>;
+    using WkPtr = std::weak_ptr<UdpServer>;
+    using ReadableCb = UdpSocket::ReadableCb;
+
+public:
+    explicit UdpServer(Address::Ptr addr, const ThreadInitCb& cb = nullptr, unsigned int numWorkThreads = 4);
+
+    /**
+     * @note  与共享该线程池的其他服务共用事件循环；运行期间线程池不可扩缩容
+     * @brief 在已有的事件循环线程池上创建服务
+     * @param pool 事件循环线程池
+     * @param addr 本端地址
+     */
+    UdpServer(const EventLoopThreadPool::Ptr& pool, Address::Ptr addr);
+    ~UdpServer();
+
+public:
+    /**
+     * @brief 启动服务
+     */
+    void run();
+
+    /**
+     * @brief 关闭服务
+     */
+    void shutdown();
+
+public:
+    /**
+     * @note  需在启动服务前设置，回调在接收报文的工作线程中执行
+     * @brief 设置报文接收回调函数
+     * @param cb 回调函数
+     */
+    inline void setMessageCallback(const ReadableCb& cb) {
+        m_readCb = cb;
+    }
+
+    /**
+     * @note  需在启动服务前设置
+     * @brief 设置是否启用GRO(接收端合并报文)
+     * @param enabled 是否启用
+     */
+    inline void setGroEnabled(bool enabled) {
+        m_isGroEnabled = enabled;
+    }
+
+    /**
+     * @note  需在启动服务前设置
+     * @brief 设置是否启用GSO(发送端分段卸载)
+     * @param enabled 是否启用
+     */
+    inline void setGsoEnabled(bool enabled) {
+        m_isGsoEnabled = enabled;
+    }
+
+    /**
+     * @note   统计本次运行中的套接字，关闭服务后清零
+     * @brief  获取累计接收报文数
+     * @return 累计接收报文数
+     */
+    uint64_t getRecvCount() const;
+
+    /**
+     * @note   统计本次运行中的套接字，关闭服务后清零
+     * @brief  获取累计丢弃报文数
+     * @return 累计丢弃报文数
+     */
+    uint64_t getDropCount() const;
+
+    /**
+     * @brief  获取服务信息
+     * @return 服务信息
+     */
+    inline std::string getServerInfo() const {
+        return m_addr->printIpPort();
+    }
+
+private:
+    // 服务启动状态
+    std::atomic_bool m_isStarted;
+
+    // 是否启用GRO
+    bool m_isGroEnabled;
+
+    // 是否启用GSO
+    bool m_isGsoEnabled;
+
+    // 本端地址
+    Address::Ptr m_addr;
+
+    // 事件循环线程池对象
+    EventLoopThreadPool::Ptr m_workLoopThreadPool;
+
+    // 各工作事件循环的UDP套接字，启动后只读
+    std::vector<UdpSocket::Ptr> m_sockets;
+
+    // 报文接收回调函数
+    ReadableCb m_readCb;
+};
+
+}; // namespace Net
\ No newline at end of file
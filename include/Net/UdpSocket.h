@@ -0,0 +1,234 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <sys/socket.h>
+#include "Common/TypeDef.h"
+#include "Common/ConfigDef.h"
+#include "Utils/Utils.h"
+#include "Utils/Address.h"
+#include "Net/Socket.h"
+using namespace Utils;
+using namespace Common;
+
+namespace Net {
+
+/**
+ * @note  通过recvmmsg()/sendmmsg()批量收发报文，每批最多UDP_BATCH_SIZE个；收发均在所属事件循环线程中执行
+ * @brief UDP套接字类
+ */
+class UdpSocket : public Noncopyable, public std::enable_shared_from_this<UdpSocket> {
+public:
+    using Ptr = std::shared_ptr<UdpSocket>;
+    using WkPtr = std::weak_ptr<UdpSocket>;
+
+    /**
+     * @note  接收回调中数据和地址仅在回调期间有效
+     * @brief UDP报文
+     */
+    struct Datagram {
+        // 报文数据
+        const uint8_t* m_data;
+
+        // 报文长度
+        std::size_t m_size;
+
+        // 对端地址
+        const sockaddr_storage* m_peerAddr;
+    };
+
+    using DatagramBatch = std::vector<Datagram>;
+    using ReadableCb = std::function<void(const UdpSocket::Ptr& sock, const DatagramBatch& batch, Timestamp recvTime)>;
+
+public:
+    UdpSocket(EventLoopWkPtr loop, Address::Ptr localAddr, bool reuseport = false);
+    ~UdpSocket();
+
+public:
+    /**
+     * @note   需在所属事件循环线程中调用
+     * @brief  创建并绑定套接字，开始接收报文
+     * @return 打开结果
+     */
+    bool open();
+
+    /**
+     * @note  需在所属事件循环线程中调用
+     * @brief 停止接收并关闭套接字
+     */
+    void close();
+
+    /**
+     * @brief  发送单个报文
+     * @return 发送结果
+     * @param  peerAddr 对端地址
+     * @param  data 报文数据
+     * @param  size 报文长度
+     */
+    bool sendTo(const sockaddr_storage& peerAddr, const void* data, std::size_t size);
+
+    /**
+     * @brief  发送单个报文
+     * @return 发送结果
+     * @param  peerAddr 对端地址
+     * @param  data 报文数据
+     * @param  size 报文长度
+     */
+    bool sendTo(const Address::Ptr& peerAddr, const void* data, std::size_t size);
+
+    /**
+     * @note   按UDP_BATCH_SIZE分批调用sendmmsg()，发送缓冲区满时丢弃剩余报文
+     * @brief  批量发送报文
+     * @return 发送成功的报文数
+     * @param  batch 报文数组
+     */
+    std::size_t sendBatch(const DatagramBatch& batch);
+
+    /**
+     * @note   启用GSO时由内核按分段大小切分，否则在用户态切分后批量发送
+     * @brief  将数据按固定分段大小切分为多个报文发送到同一对端
+     * @return 发送成功的报文数
+     * @param  peerAddr 对端地址
+     * @param  data 数据
+     * @param  size 数据长度
+     * @param  segmentSize 分段大小
+     */
+    std::size_t sendSegments(const sockaddr_storage& peerAddr, const void* data, std::size_t size, uint16_t segmentSize);
+
+public:
+    /**
+     * @brief 设置报文接收回调函数
+     * @param cb 回调函数
+     */
+    inline void setMessageCallback(const ReadableCb& cb) {
+        m_readCb = cb;
+    }
+
+    /**
+     * @note  需在打开套接字前设置，内核不支持时自动关闭
+     * @brief 设置是否启用GRO(接收端合并报文)
+     * @param enabled 是否启用
+     */
+    inline void setGroEnabled(bool enabled) {
+        m_isGroEnabled = enabled;
+    }
+
+    /**
+     * @note  内核不支持时自动关闭
+     * @brief 设置是否启用GSO(发送端分段卸载)
+     * @param enabled 是否启用
+     */
+    inline void setGsoEnabled(bool enabled) {
+        m_isGsoEnabled = enabled;
+    }
+
+    /**
+     * @brief  获取本地地址
+     * @return 本地地址
+     */
+    inline Address::Ptr getLocalAddr() const {
+        return m_localAddr;
+    }
+
+    /**
+     * @brief  获取socket fd
+     * @return socket fd
+     */
+    inline int getFd() const {
+        return nullptr == m_sock ? -1 : m_sock->getFd();
+    }
+
+    /**
+     * @brief  获取累计接收报文数
+     * @return 累计接收报文数
+     */
+    inline uint64_t getRecvCount() const {
+        return m_recvCount;
+    }
+
+    /**
+     * @brief  获取累计丢弃(截断或发送失败)报文数
+     * @return 累计丢弃报文数
+     */
+    inline uint64_t getDropCount() const {
+        return m_dropCount;
+    }
+
+private:
+    /**
+     * @brief 处理读事件，批量接收报文
+     * @param recvTime 接收到事件的时间
+     */
+    void handleRead(Timestamp recvTime);
+
+    /**
+     * @brief 处理错误事件
+     * @param recvTime 接收到事件的时间
+     */
+    void handleError(Timestamp recvTime);
+
+    /**
+     * @brief  通过GSO发送分段数据
+     * @return 发送结果
+     * @param  peerAddr 对端地址
+     * @param  data 数据
+     * @param  size 数据长度
+     * @param  segmentSize 分段大小
+     */
+    bool sendGso(const sockaddr_storage& peerAddr, const uint8_t* data, std::size_t size, uint16_t segmentSize);
+
+private:
+    // 事件循环对象弱引用
+    EventLoopWkPtr m_ownerLoop;
+
+    // 本地地址
+    Address::Ptr m_localAddr;
+
+    // 是否启用端口复用
+    bool m_isReusePort;
+
+    // 是否启用GRO
+    bool m_isGroEnabled;
+
+    // 是否启用GSO
+    bool m_isGsoEnabled;
+
+    // socket对象
+    Socket::Ptr m_sock;
+
+    // channel对象
+    ChannelPtr m_channel;
+
+    // 单个报文接收缓冲区大小
+    std::size_t m_slotSize;
+
+    // 接收缓冲区，按报文槽位划分
+    std::vector<uint8_t> m_recvBuf;
+
+    // 接收报文对端地址
+    std::array<sockaddr_storage, UDP_BATCH_SIZE> m_peerAddrs;
+
+    // 接收报文缓冲区描述
+    std::array<iovec, UDP_BATCH_SIZE> m_recvIovecs;
+
+    // 接收报文控制信息缓冲区
+    std::array<std::array<char, CMSG_SPACE(sizeof(int))>, UDP_BATCH_SIZE> m_recvCtrls;
+
+    // 接收报文头
+    std::array<mmsghdr, UDP_BATCH_SIZE> m_recvMsgs;
+
+    // 接收报文批次，回调间复用
+    DatagramBatch m_batch;
+
+    // 累计接收报文数
+    std::atomic<uint64_t> m_recvCount;
+
+    // 累计丢弃报文数
+    std::atomic<uint64_t> m_dropCount;
+
+    // 报文接收回调函数
+    ReadableCb m_readCb;
+};
+
+}; // namespace Net
\ No newline at end of file
@@ -0,0 +1,289 @@
+#pragma once
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "Common/ConfigDef.h"
+#include "Utils/Utils.h"
+#include "Net/Connector.h"
+#include "Net/Connection.h"
+using namespace Utils;
+
+namespace Net {
+
+/**
+ * @note  每个事件循环独立维护各上游地址的连接，请求只使用当前事件循环所属的连接，不存在跨线程切换；
+ *        单个连接可同时承载多个进行中的请求(管线化)，响应需由使用方按请求顺序匹配
+ * @brief 上游连接池类
+ */
+class UpstreamPool : public Noncopyable, public std::enable_shared_from_this<UpstreamPool> {
+public:
+    using Ptr = std::shared_ptr<UpstreamPool>;
+    using WkPtr = std::weak_ptr<UpstreamPool>;
+    using ReadableCb = TcpConnection::ReadableCb;
+    using SteadyTime = std::chrono::steady_clock::time_point;
+    // 获取连接结果回调，获取失败时连接为空
+    using AcquireCb = std::function<void(const TcpConnection::Ptr& conn)>;
+
+    /**
+     * @brief 连接池配置
+     */
+    struct Options {
+        // 单个事件循环内每个上游地址的最大空闲连接数
+        std::size_t m_maxIdle = UPSTREAM_POOL_MAX_IDLE;
+
+        // 单个事件循环内每个上游地址的最大连接数(含连接中)
+        std::size_t m_maxTotal = UPSTREAM_POOL_MAX_TOTAL;
+
+        // 单个连接上允许同时进行的最大请求数
+        std::size_t m_maxPipeline = UPSTREAM_POOL_MAX_PIPELINE;
+
+        // 空闲连接超时时长(单位: 秒)
+        double m_idleTimeout = UPSTREAM_POOL_IDLE_TIMEOUT;
+
+        // 建立连接超时时长(单位: 秒)
+        double m_connectTimeout = UPSTREAM_POOL_CONNECT_TIMEOUT;
+    };
+
+    /**
+     * @brief 池化的上游连接
+     */
+    struct UpstreamConn {
+        // 上游连接
+        TcpConnection::Ptr m_conn;
+
+        // 进行中的请求数
+        std::size_t m_inflight = 0;
+
+        // 最近一次归还时间
+        SteadyTime m_lastActive;
+    };
+
+    /**
+     * @brief 连接中的上游连接
+     */
+    struct PendingConnect {
+        // 连接器
+        TcpConnector::Ptr m_connector;
+
+        // 建立连接超时定时器id
+        TimerId m_timerId = 0;
+    };
+
+    /**
+     * @brief 同一上游地址的连接组
+     */
+    struct UpstreamGroup {
+        using Ptr = std::shared_ptr<UpstreamGroup>;
+        using WkPtr = std::weak_ptr<UpstreamGroup>;
+
+        // 上游地址
+        Address::Ptr m_addr;
+
+        // 已建立的连接，key = connection id
+        std::unordered_map<ConnectionId, UpstreamConn> m_conns;
+
+        // 连接中的连接器，key = connector raw ptr
+        std::unordered_map<const TcpConnector*, PendingConnect> m_connectors;
+
+        // 等待可用连接的请求
+        std::deque<AcquireCb> m_waiters;
+    };
+
+    /**
+     * @note  分片仅允许在其所属事件循环线程中访问，因此无需加锁
+     * @brief 连接池分片
+     */
+    struct PoolShard {
+        using Ptr = std::shared_ptr<PoolShard>;
+        using WkPtr = std::weak_ptr<PoolShard>;
+
+        // 分片所属事件循环
+        EventLoopWkPtr m_ownerLoop;
+
+        // 各上游地址的连接组，key = upstream ip port
+        std::unordered_map<std::string, UpstreamGroup::Ptr> m_groups;
+
+        // 空闲连接回收定时器id
+        TimerId m_evictTimerId = 0;
+    };
+
+    // key = event loop, value = pool shard，构造后只读
+    using PoolShardMap = std::unordered_map<const EventLoop*, PoolShard::Ptr>;
+
+public:
+    explicit UpstreamPool(const std::vector<EventLoopWkPtr>& loops);
+    UpstreamPool(const std::vector<EventLoopWkPtr>& loops, const Options& options);
+    ~UpstreamPool();
+
+public:
+    /**
+     * @brief  启动空闲连接回收定时器
+     * @return 启动结果
+     */
+    bool start();
+
+    /**
+     * @brief 关闭所有连接，等待中的请求以空连接回调
+     */
+    void stop();
+
+    /**
+     * @note   应在loop所在线程中调用，回调在loop线程中执行；其他线程调用时投递到loop线程
+     * @brief  获取loop所属的上游连接，无可用连接时按限制新建连接或排队等待
+     * @return 发起结果
+     * @param  loop 请求所在事件循环
+     * @param  addr 上游地址
+     * @param  cb 获取结果回调函数
+     */
+    bool acquire(const EventLoopPtr& loop, const Address::Ptr& addr, const AcquireCb& cb);
+
+    /**
+     * @note  每次成功获取连接后，请求完成时需调用一次
+     * @brief 归还上游连接
+     * @param conn 上游连接
+     * @param reusable 连接是否可继续使用，否则关闭该连接
+     */
+    void release(const TcpConnection::Ptr& conn, bool reusable = true);
+
+public:
+    /**
+     * @note  需在获取连接前设置，对所有上游连接生效
+     * @brief 设置上游响应读取回调函数
+     * @param cb 回调函数
+     */
+    inline void setMessageCallback(const ReadableCb& cb) {
+        m_readCb = cb;
+    }
+
+    /**
+     * @brief  获取连接池配置
+     * @return 连接池配置
+     */
+    inline const Options& getOptions() const {
+        return m_options;
+    }
+
+private:
+    /**
+     * @brief  查找事件循环对应的分片
+     * @return 分片，不存在时返回空
+     * @param  loop 事件循环
+     */
+    PoolShard::Ptr getShard(const EventLoop* loop) const;
+
+    /**
+     * @brief  查找连接所在的连接组
+     * @return 连接组，不存在时返回空
+     * @param  shard 连接池分片
+     * @param  connId 连接id
+     */
+    UpstreamGroup::Ptr findGroup(const PoolShard::Ptr& shard, ConnectionId connId) const;
+
+    /**
+     * @brief 在事件循环线程中获取连接
+     * @param shard 连接池分片
+     * @param addr 上游地址
+     * @param cb 获取结果回调函数
+     */
+    void acquireInLoop(const PoolShard::Ptr& shard, const Address::Ptr& addr, const AcquireCb& cb);
+
+    /**
+     * @brief 在事件循环线程中归还连接
+     * @param shard 连接池分片
+     * @param conn 上游连接
+     * @param reusable 连接是否可继续使用
+     */
+    void releaseInLoop(const PoolShard::Ptr& shard, const TcpConnection::Ptr& conn, bool reusable);
+
+    /**
+     * @note   优先选择进行中请求数最少的连接
+     * @brief  选择未达到管线化上限的连接
+     * @return 可用连接，不存在时返回空
+     * @param  group 连接组
+     */
+    UpstreamConn* pickConnection(const UpstreamGroup::Ptr& group) const;
+
+    /**
+     * @brief 将可用连接分配给等待中的请求，连接不足时按限制新建连接
+     * @param shard 连接池分片
+     * @param group 连接组
+     */
+    void dispatchWaiters(const PoolShard::Ptr& shard, const UpstreamGroup::Ptr& group);
+
+    /**
+     * @note   连接器在所属事件循环中同步发起连接，创建套接字或连接立即失败时在返回前已按连接失败处理
+     * @brief  发起到上游的新连接
+     * @return 连接是否仍在进行中
+     * @param  shard 连接池分片
+     * @param  group 连接组
+     */
+    bool connectUpstream(const PoolShard::Ptr& shard, const UpstreamGroup::Ptr& group);
+
+    /**
+     * @brief 上游连接建立处理函数
+     * @param shard 连接池分片
+     * @param group 连接组
+     * @param connector 完成连接的连接器
+     * @param connSock 连接套接字
+     */
+    void onConnected(const PoolShard::Ptr& shard, const UpstreamGroup::Ptr& group, const TcpConnector::Ptr& connector, Socket::Ptr& connSock);
+
+    /**
+     * @brief 上游连接失败或超时处理函数
+     * @param shard 连接池分片
+     * @param group 连接组
+     * @param connector 连接失败的连接器
+     */
+    void onConnectFailed(const PoolShard::Ptr& shard, const UpstreamGroup::Ptr& group, const TcpConnector::Ptr& connector);
+
+    /**
+     * @brief 上游连接关闭处理函数
+     * @param shard 连接池分片
+     * @param conn 关闭的连接
+     */
+    void onConnectionClosed(const PoolShard::Ptr& shard, const Connection::Ptr& conn);
+
+    /**
+     * @brief  移除进行中的连接器并删除其建立连接超时定时器
+     * @return 连接器是否仍在进行中
+     * @param  shard 连接池分片
+     * @param  group 连接组
+     * @param  connector 连接器
+     */
+    static bool removeConnector(const PoolShard::Ptr& shard, const UpstreamGroup::Ptr& group, const TcpConnector* connector);
+
+    /**
+     * @brief 移除并关闭连接
+     * @param group 连接组
+     * @param connId 连接id
+     */
+    static void evictConnection(const UpstreamGroup::Ptr& group, ConnectionId connId);
+
+    /**
+     * @brief  关闭分片内所有连接和进行中的连接
+     * @return 未完成的等待请求
+     * @param  shard 连接池分片
+     */
+    static std::deque<AcquireCb> closeShard(const PoolShard::Ptr& shard);
+
+    /**
+     * @brief 回收超时及不可用的空闲连接
+     * @param shard 连接池分片
+     */
+    void evictIdleConnections(const PoolShard::Ptr& shard);
+
+private:
+    // 连接池配置
+    Options m_options;
+
+    // 连接池分片
+    PoolShardMap m_shards;
+
+    // 上游响应读取回调函数
+    ReadableCb m_readCb;
+};
+
+}; // namespace Net
\ No newline at end of file
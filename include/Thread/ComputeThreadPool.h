@@ -0,0 +1,201 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <string>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+#include "Common/TypeDef.h"
+#include "Utils/Utils.h"
+using namespace Utils;
+using namespace Common;
+
+namespace Thread {
+
+/**
+ * @note  每个计算线程拥有独立的任务队列，从队尾取出自己的任务，空闲时从其他线程的队首窃取任务；
+ *        计算线程中提交的任务进入本线程队列，其他线程提交的任务轮询分配；
+ *        任务完成后的后续任务按目标事件循环合并，待执行任务清空、缓存超过COMPUTE_CONTINUATION_BATCH_DELAY或达到批量上限时通过一次executeTaskInLoop()投递回事件循环执行
+ * @brief 工作窃取计算线程池，用于将耗时的计算从事件循环中卸载
+ */
+class ComputeThreadPool : public Noncopyable, public std::enable_shared_from_this<ComputeThreadPool> {
+public:
+    using Ptr = std::shared_ptr<ComputeThreadPool>;
+    using WkPtr = std::weak_ptr<ComputeThreadPool>;
+    using Job = std::function<void()>;
+
+    /**
+     * @brief 计算任务
+     */
+    struct ComputeJob {
+        // 计算任务
+        Job m_job;
+
+        // 后续任务所在事件循环
+        Net::EventLoopWkPtr m_loop;
+
+        // 后续任务
+        Job m_continuation;
+    };
+
+    /**
+     * @brief 计算线程任务队列
+     */
+    struct WorkerQueue {
+        // 互斥锁，保护任务队列
+        std::mutex m_mutex;
+
+        // 任务队列
+        std::deque<ComputeJob> m_jobs;
+    };
+
+public:
+    /**
+     * @param numThreads 计算线程数，0则使用硬件并发线程数
+     */
+    explicit ComputeThreadPool(unsigned int numThreads = 0);
+    ~ComputeThreadPool();
+
+public:
+    /**
+     * @brief  提交计算任务
+     * @return 提交结果
+     * @param  job 计算任务
+     */
+    bool submit(const Job& job);
+
+    /**
+     * @note   后续任务在loop中执行，事件循环已释放时丢弃
+     * @brief  提交计算任务及完成后的后续任务
+     * @return 提交结果
+     * @param  job 计算任务
+     * @param  loop 后续任务所在事件循环，通常为提交任务的事件循环
+     * @param  continuation 后续任务
+     */
+    bool submit(const Job& job, const Net::EventLoopWkPtr& loop, const Job& continuation);
+
+    /**
+     * @note   计算结果以值传递给后续任务，后续任务在loop中执行
+     * @brief  提交有返回值的计算任务及处理结果的后续任务
+     * @return 提交结果
+     * @param  job 计算任务，形如R()
+     * @param  loop 后续任务所在事件循环
+     * @param  continuation 后续任务，形如void(R)
+     */
+    template <typename Func, typename Cont>
+    bool submitForResult(Func job, const Net::EventLoopWkPtr& loop, Cont continuation) {
+        using Result = typename std::result_of<Func()>::type;
+        auto result = std::make_shared<Result>();
+        return this->submit([job, result]() {
+            *result = job();
+        }, loop, [continuation, result]() {
+            continuation(std::move(*result));
+        });
+    }
+
+    /**
+     * @brief 停止计算线程池，等待已提交的任务执行完成
+     */
+    void stop();
+
+public:
+    /**
+     * @brief  获取计算线程数
+     * @return 计算线程数
+     */
+    inline std::size_t getThreadCount() const {
+        return m_threads.size();
+    }
+
+    /**
+     * @brief  获取待执行的任务数
+     * @return 待执行的任务数
+     */
+    inline uint64_t getPendingJobs() const {
+        return m_pendingJobs.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief  获取累计窃取的任务数
+     * @return 窃取的任务数
+     */
+    inline uint64_t getStealCount() const {
+        return m_stealCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief  获取累计投递到事件循环的后续任务批次数
+     * @return 后续任务批次数
+     */
+    inline uint64_t getContinuationBatches() const {
+        return m_batchCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief 计算线程主函数
+     * @param idx 计算线程索引
+     */
+    void workerMain(std::size_t idx);
+
+    /**
+     * @brief  将任务放入任务队列并唤醒空闲线程
+     * @return 放入结果
+     * @param  job 计算任务
+     */
+    bool enqueue(ComputeJob&& job);
+
+    /**
+     * @brief  从本线程队尾取出任务
+     * @return 是否取出任务
+     * @param  idx 计算线程索引
+     * @param  job 取出的任务
+     */
+    bool popLocal(std::size_t idx, ComputeJob& job);
+
+    /**
+     * @brief  从其他线程队首窃取任务
+     * @return 是否窃取到任务
+     * @param  idx 计算线程索引
+     * @param  job 窃取的任务
+     */
+    bool steal(std::size_t idx, ComputeJob& job);
+
+private:
+    // 计算线程池id
+    const std::string m_id;
+
+    // 计算线程
+    std::vector<std::thread> m_threads;
+
+    // 各计算线程的任务队列
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+
+    // 外部提交任务的轮询索引
+    std::atomic<unsigned int> m_nextIdx;
+
+    // 待执行的任务数
+    std::atomic<uint64_t> m_pendingJobs;
+
+    // 空闲等待的计算线程数
+    std::atomic<unsigned int> m_idleCount;
+
+    // 累计窃取的任务数
+    std::atomic<uint64_t> m_stealCount;
+
+    // 累计投递的后续任务批次数
+    std::atomic<uint64_t> m_batchCount;
+
+    // 是否已停止
+    std::atomic_bool m_isStopped;
+
+    // 空闲等待互斥锁及条件变量
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCv;
+};
+
+}; // namespace Thread
\ No newline at end of file
@@ -1,8 +1,12 @@
 #pragma once
 #include <mutex>
 #include <atomic>
+#include <string>
+#include <vector>
 #include <memory>
 #include <thread>
+#include <pthread.h>
+#include <condition_variable>
 #include "Common/TypeDef.h"
 #include "Utils/Utils.h"
 using namespace Utils;
@@ -25,17 +29,62 @@ public:
 
 public:
     /**
+     * @note   等价于start()后waitForStart()
      * @brief  运行事件循环线程
      * @return 运行结果
      */
     void run();
 
     /**
+     * @note   等价于requestQuit()后waitForQuit()
      * @brief  退出事件循环线程
      * @return 退出结果
      */
     void quit();
 
+    /**
+     * @note   多个线程可先全部启动再统一等待，使线程并发创建事件循环
+     * @brief  启动事件循环线程，不等待事件循环创建完成
+     * @return 启动结果
+     */
+    bool start();
+
+    /**
+     * @brief  等待事件循环创建完成
+     * @return 事件循环是否创建成功
+     */
+    bool waitForStart();
+
+    /**
+     * @note   多个线程可先全部通知退出再统一等待，使事件循环并发退出
+     * @brief  通知事件循环退出，不等待退出完成
+     * @return 通知结果
+     */
+    bool requestQuit();
+
+    /**
+     * @note   由事件循环结束信号唤醒，在事件循环线程中调用时不等待
+     * @brief  等待事件循环结束并回收线程
+     * @return 是否在超时前结束
+     */
+    bool waitForQuit();
+
+    /**
+     * @note   运行前或在线程初始化函数中设置在事件循环运行前生效，运行中设置立即生效；仅绑定单个CPU时记录到事件循环
+     * @brief  设置线程CPU亲和性
+     * @return 设置结果
+     * @param  cpus CPU编号列表，为空则不绑定
+     */
+    bool setCpuAffinity(const std::vector<int>& cpus);
+
+    /**
+     * @note   运行前或在线程初始化函数中设置在事件循环运行前生效，运行中设置立即生效；线程名最长15个字符，超出部分截断
+     * @brief  设置线程名
+     * @return 设置结果
+     * @param  name 线程名
+     */
+    bool setThreadName(const std::string& name);
+
 public:
     /**
      * @brief  获取事件循环
@@ -60,6 +109,15 @@ public:
         return m_threadId;
     }
 
+private:
+    /**
+     * @note   需持有互斥锁调用
+     * @brief  为线程应用线程名及CPU亲和性
+     * @return 应用结果
+     * @param  thread 线程句柄
+     */
+    bool applyThreadOptions(pthread_t thread);
+
 private:
     // 事件线程对象id
     std::string m_id;
@@ -67,6 +125,15 @@ private:
     // 事件循环线程互斥锁
     std::mutex m_mutex;
 
+    // 事件循环创建及结束条件变量，与m_mutex配合使用
+    std::condition_variable m_stateCv;
+
+    // 事件循环是否已创建，受m_mutex保护
+    bool m_isLoopCreated;
+
+    // 事件循环线程是否已结束，受m_mutex保护
+    bool m_isLoopExited;
+
     // 事件循环线程
     ThreadPtr m_thread;
 
@@ -84,6 +151,12 @@ private:
 
     // 事件循环
     Net::EventLoopPtr m_eventLoop;
+
+    // 线程名
+    std::string m_threadName;
+
+    // 线程绑定的CPU编号列表
+    std::vector<int> m_cpus;
 };
 
 }; // namespace Thread
\ No newline at end of file
@@ -1,10 +1,20 @@
 #pragma once
+#include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
 #include <string>
 #include <memory>
 #include <vector>
+#include <utility>
+#include <functional>
 #include "Utils/Utils.h"
 #include "Common/TypeDef.h"
+#include "Common/DataDef.h"
+#include "Common/ConfigDef.h"
+#include "Thread/SpscRing.h"
 using namespace Utils;
+using namespace Common;
 
 namespace Thread {
 
@@ -15,6 +25,56 @@ class EventLoopThreadPool : public Noncopyable, public std::enable_shared_from_t
 public:
     using Ptr = std::shared_ptr<EventLoopThreadPool>;
     using WkPtr = std::weak_ptr<EventLoopThreadPool>;
+    using MeshTask = std::function<void()>;
+    using DrainCb = std::function<void(const Net::EventLoopPtr& loop, bool isForce)>;
+
+    /**
+     * @note  扩缩容时整体替换，读取方持有快照期间不受并发扩缩容影响
+     * @brief 工作线程集合快照
+     */
+    struct WorkLoopSet {
+        // 事件循环工作线程列表
+        std::vector<EventLoopThreadPtr> m_threads;
+
+        // 工作线程序号，与线程名中的序号一致，扩缩容后不变
+        std::vector<unsigned int> m_serials;
+
+        // 一致性哈希环，元素为(虚拟节点哈希值, 工作线程索引)，按哈希值升序排列
+        std::vector<std::pair<uint64_t, std::size_t>> m_hashRing;
+    };
+    using WorkLoopSetPtr = std::shared_ptr<const WorkLoopSet>;
+
+    /**
+     * @brief 工作事件循环之间的单向消息通道
+     */
+    struct MeshChannel {
+        explicit MeshChannel(std::size_t capacity)
+            : m_ring(capacity),
+              m_hasOverflow(false),
+              m_needWakeup(false) {
+        }
+
+        // 无锁环形队列
+        SpscRing<MeshTask> m_ring;
+
+        // 队列已满时按顺序暂存的消息，仅发送方访问
+        std::deque<MeshTask> m_overflow;
+
+        // 是否有暂存的消息，接收方取出消息后据此唤醒发送方
+        std::atomic_bool m_hasOverflow;
+
+        // 本轮是否有新消息需要唤醒接收方，仅发送方访问
+        bool m_needWakeup;
+    };
+
+    /**
+     * @note  通道含按缓存行对齐的成员，C++11的new不保证扩展对齐，由posix_memalign()申请
+     * @brief 消息通道释放器
+     */
+    struct MeshChannelDeleter {
+        void operator()(MeshChannel* channel) const;
+    };
+    using MeshChannelPtr = std::unique_ptr<MeshChannel, MeshChannelDeleter>;
 
 public:
     explicit EventLoopThreadPool(unsigned int numWorkThreads = 0, const ThreadInitCb& cb = nullptr);
@@ -29,24 +89,248 @@ public:
     bool getMainEventLoop(Net::EventLoopWkPtr& eventLoop) const;
 
     /**
+     * @note   按选择策略选择；活跃连接数由分配连接的一方通过EventLoop::incActiveConnections()等维护
      * @brief  获取下一个工作线程事件循环
      * @return 获取结果
      * @param  eventLoop 事件循环
+     * @param  hashKey 一致性哈希键(如对端地址的哈希值)，其他策略忽略
+     */
+    bool getNextWorkEventLoop(Net::EventLoopWkPtr& eventLoop, uint64_t hashKey = 0) const;
+
+    /**
+     * @brief 设置工作事件循环选择策略
+     * @param policy 选择策略
+     */
+    inline void setPlacementPolicy(Placement_t policy) {
+        m_placementPolicy = policy;
+    }
+
+    /**
+     * @brief  获取工作事件循环选择策略
+     * @return 选择策略
+     */
+    inline Placement_t getPlacementPolicy() const {
+        return m_placementPolicy;
+    }
+
+    /**
+     * @note   无工作线程时返回主线程事件循环
+     * @brief  获取全部工作线程事件循环
+     * @return 获取结果
+     * @param  eventLoops 事件循环列表
+     */
+    bool getWorkEventLoops(std::vector<Net::EventLoopWkPtr>& eventLoops) const;
+
+    /**
+     * @brief  设置主线程CPU亲和性
+     * @return 设置结果
+     * @param  cpus CPU编号列表
+     */
+    bool setMainLoopCpus(const std::vector<int>& cpus);
+
+    /**
+     * @brief  设置工作线程CPU亲和性
+     * @return 设置结果
+     * @param  idx 工作线程索引，与getWorkEventLoops()返回的顺序一致
+     * @param  cpus CPU编号列表
+     */
+    bool setWorkLoopCpus(std::size_t idx, const std::vector<int>& cpus);
+
+    /**
+     * @note   第i个工作线程绑定到cpus[i % cpus.size()]；与TcpServer按CPU分发连接配合时，
+     *         第i个工作线程应绑定到第i号CPU
+     * @brief  将工作线程逐一绑定到单个CPU
+     * @return 设置结果
+     * @param  cpus CPU编号列表
+     */
+    bool pinWorkLoops(const std::vector<int>& cpus);
+
+    /**
+     * @note   无工作线程时设置主线程事件循环；忙轮询的事件循环应绑定到独占的CPU
+     * @brief  设置全部工作线程事件循环的忙轮询预算
+     * @return 设置结果
+     * @param  budgetUs 忙轮询预算(单位: 微秒)，0则不启用
+     */
+    bool setBusyPollBudget(uint64_t budgetUs);
+
+    /**
+     * @note   新线程并发启动，全部创建完成后加入选择范围，沿用线程初始化回调及忙轮询预算，不设置CPU亲和性；
+     *         一致性哈希按线程序号构建虚拟节点，扩容时仅约count / n的哈希键改变归属；启用消息网格后不可扩缩容
+     * @brief  运行时增加工作线程
+     * @return 增加结果
+     * @param  count 增加的工作线程数
+     */
+    bool addWorkLoops(unsigned int count);
+
+    /**
+     * @note   需在本线程池以外的线程中调用，阻塞至移除完成；依次移除最后加入的工作线程：
+     *         先移出选择范围，不再分配新连接，再在各事件循环中调用已注册的排空回调及drainCb(loop, false)关闭或迁移连接，
+     *         等待活跃连接数归零，超时后以isForce = true再次调用以强制关闭剩余连接，最后退出线程
+     * @brief  运行时移除工作线程
+     * @return 移除结果，至少保留一个工作线程
+     * @param  count 移除的工作线程数
+     * @param  drainCb 排空回调函数，在被移除的事件循环中执行
+     * @param  drainTimeout 等待活跃连接数归零的最长时长(单位: 秒)
+     */
+    bool removeWorkLoops(unsigned int count, const DrainCb& drainCb = nullptr, double drainTimeout = EV_LOOP_DRAIN_TIMEOUT);
+
+    /**
+     * @brief  获取当前工作线程数
+     * @return 工作线程数
+     */
+    std::size_t getWorkLoopCount() const;
+
+    /**
+     * @note   共享线程池的各服务分别注册，移除工作线程时全部调用，使各自管理的连接均被排空
+     * @brief  注册排空回调函数
+     * @return 回调id，用于注销
+     * @param  cb 排空回调函数，在被移除的事件循环中执行
+     */
+    uint64_t addDrainCallback(const DrainCb& cb);
+
+    /**
+     * @brief 注销排空回调函数
+     * @param id 回调id
+     */
+    void removeDrainCallback(uint64_t id);
+
+    /**
+     * @note   按工作线程绑定资源(如每个工作事件循环独立监听)的使用方在使用期间持有，期间扩缩容返回失败；可重复持有
+     * @brief  禁止扩缩容
+     */
+    void holdWorkLoopCount();
+
+    /**
+     * @brief 解除禁止扩缩容，与holdWorkLoopCount()成对调用
+     */
+    void releaseWorkLoopCount();
+
+    /**
+     * @note   需在工作线程以外的线程中调用且仅调用一次；为每对工作事件循环创建单生产者单消费者环形队列，
+     *         并在各工作事件循环中注册迭代钩子，用于接收消息及批量唤醒
+     * @brief  启用工作事件循环之间的消息网格
+     * @return 启用结果
+     * @param  ringCapacity 单个环形队列容量
+     */
+    bool enableMesh(std::size_t ringCapacity = EV_LOOP_MESH_RING_SIZE);
+
+    /**
+     * @note   在工作事件循环中调用时经消息网格发送，同一对事件循环之间的消息按发送顺序执行，
+     *         每轮迭代结束时对每个接收方最多唤醒一次；发给自身或在其他线程中调用时经任务队列投递
+     * @brief  向工作事件循环发送任务
+     * @return 发送结果
+     * @param  idx 接收方工作线程索引，与getWorkEventLoops()返回的顺序一致
+     * @param  task 任务
+     */
+    bool sendToLoop(std::size_t idx, const MeshTask& task);
+
+    /**
+     * @brief  获取当前线程所在工作事件循环的索引
+     * @return 当前线程是否为本线程池的工作线程
+     * @param  idx 工作线程索引
+     */
+    bool getCurrentWorkLoopIndex(std::size_t& idx) const;
+
+private:
+    /**
+     * @brief  获取工作线程集合快照
+     * @return 工作线程集合快照
+     */
+    inline WorkLoopSetPtr loadWorkLoopSet() const {
+        return std::atomic_load(&m_workLoopSet);
+    }
+
+    /**
+     * @brief  创建工作线程，线程名形如ev_work_1_2
+     * @return 工作线程
+     * @param  serial 工作线程序号
+     */
+    EventLoopThreadPtr createWorkThread(unsigned int serial) const;
+
+    /**
+     * @brief 按工作线程序号构建一致性哈希环
+     * @param workLoopSet 工作线程集合
+     */
+    static void BuildHashRing(WorkLoopSet& workLoopSet);
+
+    /**
+     * @brief  从工作线程集合中获取事件循环
+     * @return 获取结果
+     * @param  workLoopSet 工作线程集合
+     * @param  idx 工作线程索引
+     * @param  eventLoop 事件循环
      */
-    bool getNextWorkEventLoop(Net::EventLoopWkPtr& eventLoop) const;
+    bool getWorkEventLoop(const WorkLoopSet& workLoopSet, std::size_t idx, Net::EventLoopWkPtr& eventLoop) const;
+
+    /**
+     * @note   先执行其他事件循环发来的消息，再将暂存消息移入队列并唤醒接收方
+     * @brief  处理消息网格的一轮迭代
+     * @param  idx 当前工作线程索引
+     */
+    void handleMeshIteration(std::size_t idx);
+
+    /**
+     * @note   从轮询位置开始比较，负载相同时依次分配
+     * @brief  选择负载最小的工作线程索引
+     * @return 工作线程索引
+     * @param  workLoopSet 工作线程集合
+     * @param  policy 选择策略
+     */
+    std::size_t selectLeastLoaded(const WorkLoopSet& workLoopSet, Placement_t policy) const;
+
+    /**
+     * @brief  按一致性哈希选择工作线程索引
+     * @return 工作线程索引
+     * @param  workLoopSet 工作线程集合
+     * @param  hashKey 哈希键
+     */
+    std::size_t selectByHash(const WorkLoopSet& workLoopSet, uint64_t hashKey) const;
 
 private:
     // 事件循环线程池id
     const std::string m_id;
 
     // 事件循环工作循环索引
-    mutable unsigned int m_nextIdx { 0 };
+    mutable std::atomic<unsigned int> m_nextIdx { 0 };
+
+    // 工作事件循环选择策略
+    std::atomic<Placement_t> m_placementPolicy { Placement_t::PlacementRoundRobin };
+
+    // 线程初始化回调函数，扩容时沿用
+    ThreadInitCb m_threadInitCb;
+
+    // 工作事件循环忙轮询预算(单位: 微秒)，扩容时沿用
+    std::atomic<uint64_t> m_busyPollBudgetUs { 0 };
+
+    // 下一个工作线程序号
+    unsigned int m_nextSerial;
+
+    // 扩缩容及启用消息网格互斥锁
+    std::mutex m_resizeMutex;
+
+    // 禁止扩缩容的持有数，由m_resizeMutex保护
+    unsigned int m_countHolders;
+
+    // 排空回调函数互斥锁
+    std::mutex m_drainCbMutex;
+
+    // 下一个排空回调id
+    uint64_t m_nextDrainCbId;
+
+    // 已注册的排空回调函数，key = 回调id
+    std::map<uint64_t, DrainCb> m_drainCbs;
+
+    // 消息网格，第src * n + dst个通道为第src个工作事件循环发往第dst个的通道，需在工作线程退出后释放
+    std::vector<MeshChannelPtr> m_meshChannels;
+
+    // 消息网格中的工作事件循环
+    std::vector<Net::EventLoopWkPtr> m_meshLoops;
 
     // 事件循环主线程
     EventLoopThreadPtr m_eventLoopMainThread;
 
-    // 事件循环工作线程列表
-    std::vector<EventLoopThreadPtr> m_eventLoopWorkThreads;
+    // 工作线程集合快照，通过std::atomic_load()/std::atomic_store()读写
+    WorkLoopSetPtr m_workLoopSet;
 };
 
 }; // namespace Thread
\ No newline at end of file
@@ -0,0 +1,121 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include "Utils/Utils.h"
+using namespace Utils;
+
+namespace Thread {
+
+/**
+ * @note  仅允许一个生产者线程调用push()、一个消费者线程调用pop()；容量向上取整为2的幂；
+ *        读写位置分别位于独立的缓存行，并各自缓存对方的位置，减少跨核同步
+ * @brief 单生产者单消费者无锁环形队列
+ */
+template <typename T>
+class SpscRing : public Noncopyable {
+public:
+    explicit SpscRing(std::size_t capacity)
+        : m_mask(RoundUpPowerOfTwo(capacity) - 1),
+          m_buffer(m_mask + 1),
+          m_head(0),
+          m_cachedTail(0),
+          m_tail(0),
+          m_cachedHead(0) {
+    }
+
+public:
+    /**
+     * @note   仅生产者线程调用
+     * @brief  放入元素
+     * @return 放入结果，队列已满时返回false
+     * @param  item 元素
+     */
+    template <typename U>
+    bool push(U&& item) {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask) {
+                return false;
+            }
+        }
+
+        m_buffer[tail & m_mask] = std::forward<U>(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @note   仅消费者线程调用，取出后释放槽位中元素持有的资源
+     * @brief  取出元素
+     * @return 取出结果，队列为空时返回false
+     * @param  item 元素
+     */
+    bool pop(T& item) {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) {
+                return false;
+            }
+        }
+
+        item = std::move(m_buffer[head & m_mask]);
+        m_buffer[head & m_mask] = T();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief  队列是否为空
+     * @return 判断结果
+     */
+    inline bool empty() const {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief  获取队列容量
+     * @return 队列容量
+     */
+    inline std::size_t capacity() const {
+        return m_mask + 1;
+    }
+
+private:
+    /**
+     * @brief  向上取整为2的幂
+     * @return 取整结果
+     * @param  value 取整前的值
+     */
+    static std::size_t RoundUpPowerOfTwo(std::size_t value) {
+        std::size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+private:
+    // 位置掩码
+    const std::size_t m_mask;
+
+    // 元素槽位
+    std::vector<T> m_buffer;
+
+    // 读位置，消费者写入
+    alignas(64) std::atomic<std::size_t> m_head;
+
+    // 消费者缓存的写位置
+    std::size_t m_cachedTail;
+
+    // 写位置，生产者写入
+    alignas(64) std::atomic<std::size_t> m_tail;
+
+    // 生产者缓存的读位置
+    std::size_t m_cachedHead;
+};
+
+}; // namespace Thread
\ No newline at end of file
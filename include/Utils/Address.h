@@ -2,6 +2,7 @@
 #include <memory>
 #include <string>
 #include <cstdint>
+#include <sys/un.h>
 #include <netinet/in.h>
 #include "Common/DataDef.h"
 using namespace Common;
@@ -19,6 +20,15 @@ public:
 public:
     virtual ~Address() = default;
 
+public:
+    /**
+     * @brief  根据socket地址创建网络地址对象
+     * @return 网络地址对象，地址族不支持或地址无效时返回空
+     * @param  addr socket地址
+     * @param  len socket地址长度(Unix抽象地址需指定实际长度)
+     */
+    static Address::Ptr Create(const sockaddr_storage& addr, socklen_t len = sizeof(sockaddr_storage));
+
 public:
     /**
      * @brief  获取地址类型
@@ -31,7 +41,13 @@ public:
      * @return 获取结果
      * @param  addr socket地址
      */
-    virtual bool getSockAddr(sockaddr& addr) const = 0;
+    virtual bool getSockAddr(sockaddr_storage& addr) const = 0;
+
+    /**
+     * @brief  获取socket地址长度
+     * @return socket地址长度
+     */
+    virtual socklen_t getSockLen() const = 0;
 
     /**
      * @brief  获取ip地址
@@ -95,7 +111,15 @@ public:
      * @return 获取结果
      * @param  addr socket地址
      */
-    bool getSockAddr(sockaddr& addr) const override;
+    bool getSockAddr(sockaddr_storage& addr) const override;
+
+    /**
+     * @brief  获取socket地址长度
+     * @return socket地址长度
+     */
+    inline socklen_t getSockLen() const override {
+        return static_cast<socklen_t>(sizeof(m_addr));
+    }
 
     /**
      * @brief  获取ip地址（主机序）
@@ -163,7 +187,15 @@ public:
      * @return 获取结果
      * @param  addr socket地址
      */
-    bool getSockAddr(sockaddr& addr) const override;
+    bool getSockAddr(sockaddr_storage& addr) const override;
+
+    /**
+     * @brief  获取socket地址长度
+     * @return socket地址长度
+     */
+    inline socklen_t getSockLen() const override {
+        return static_cast<socklen_t>(sizeof(m_addr));
+    }
 
     /**
      * @brief  获取ip地址（主机序）
@@ -204,4 +236,100 @@ private:
     sockaddr_in6 m_addr;
 };
 
+/**
+ * @note  路径以'@'开头时为Linux抽象命名空间地址，不在文件系统中创建文件；未命名地址(如客户端socket)同样有效
+ * @brief Unix域套接字地址类
+ */
+class UnixAddress : public Address {
+public:
+    using Ptr = std::shared_ptr<UnixAddress>;
+    using WPtr = std::weak_ptr<UnixAddress>;
+
+public:
+    explicit UnixAddress(const std::string& path);
+    UnixAddress(const sockaddr_un& addr, socklen_t len);
+    ~UnixAddress() override = default;
+
+public:
+    /**
+     * @brief  获取地址类型
+     * @return 地址类型
+     */
+    inline Addr_t getAddrType() const override {
+        return Addr_t::Unix;
+    }
+
+    /**
+     * @brief  获取socket地址
+     * @return 获取结果
+     * @param  addr socket地址
+     */
+    bool getSockAddr(sockaddr_storage& addr) const override;
+
+    /**
+     * @brief  获取socket地址长度
+     * @return socket地址长度
+     */
+    inline socklen_t getSockLen() const override {
+        return m_len;
+    }
+
+    /**
+     * @note   返回套接字路径
+     * @brief  获取ip地址
+     * @return 获取结果
+     * @param  ip 套接字路径
+     */
+    bool getIpAddr(std::string& ip) const override;
+
+    /**
+     * @note   Unix域套接字无端口，固定为0
+     * @brief  获取端口
+     * @return 获取结果
+     * @param  port 端口
+     */
+    bool getPort(uint16_t& port) const override;
+
+    /**
+     * @brief  获取ip地址和端口
+     * @return 获取结果
+     * @param  ip 套接字路径
+     * @param  port 端口
+     */
+    bool getIpPort(std::string& ip, uint16_t& port) const override;
+
+    /**
+     * @brief  地址是否有效
+     * @return 判断结果
+     */
+    bool valid() const override;
+
+    /**
+     * @brief  打印套接字路径
+     * @return 套接字路径
+     */
+    std::string printIpPort() const override;
+
+    /**
+     * @brief  获取套接字路径，抽象地址以'@'开头，未命名地址为空
+     * @return 套接字路径
+     */
+    std::string getPath() const;
+
+    /**
+     * @brief  是否为抽象命名空间地址
+     * @return 判断结果
+     */
+    inline bool isAbstract() const {
+        return m_len > offsetof(sockaddr_un, sun_path) && '\0' == m_addr.sun_path[0];
+    }
+
+private:
+    // socket地址
+    sockaddr_un m_addr;
+
+    // socket地址长度
+    socklen_t m_len;
+};
+
 }; // namespace Utils
\ No newline at end of file
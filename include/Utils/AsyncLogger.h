@@ -0,0 +1,248 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+#include <sys/uio.h>
+#include "Utils/Utils.h"
+#include "Common/ConfigDef.h"
+
+namespace Utils {
+
+/**
+ * @note  仅允许一个生产者线程调用append()、一个消费者线程调用peek()/consume()；容量向上取整为2的幂；
+ *        一次append()的数据整体发布，消费者不会读到不完整的日志
+ * @brief 单生产者单消费者无锁字节环形缓冲区
+ */
+class LogRing : public Noncopyable {
+public:
+    using Ptr = std::shared_ptr<LogRing>;
+
+public:
+    explicit LogRing(std::size_t capacity);
+
+public:
+    /**
+     * @note   仅生产者线程调用
+     * @brief  追加数据
+     * @return 追加结果，剩余空间不足时返回false
+     * @param  data 数据
+     * @param  size 数据长度
+     */
+    bool append(const char* data, std::size_t size);
+
+    /**
+     * @note   仅消费者线程调用；可读数据跨越缓冲区末尾时分为两段
+     * @brief  获取可读数据
+     * @return 可读字节数
+     * @param  iov 可读数据段，至少2个元素
+     * @param  count 可读数据段数
+     */
+    std::size_t peek(struct iovec* iov, std::size_t& count);
+
+    /**
+     * @note  仅消费者线程调用
+     * @brief 释放已读数据
+     * @param size 已读字节数
+     */
+    void consume(std::size_t size);
+
+    /**
+     * @brief  获取可读字节数
+     * @return 可读字节数
+     */
+    inline std::size_t readableBytes() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief  获取缓冲区容量
+     * @return 缓冲区容量
+     */
+    inline std::size_t capacity() const {
+        return m_mask + 1;
+    }
+
+    /**
+     * @note  所属线程退出或后台写线程停止后关闭，消费者读完剩余数据后释放
+     * @brief 关闭缓冲区
+     */
+    inline void close() {
+        m_isClosed.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief  缓冲区是否已关闭
+     * @return 判断结果
+     */
+    inline bool isClosed() const {
+        return m_isClosed.load(std::memory_order_acquire);
+    }
+
+private:
+    // 位置掩码
+    const std::size_t m_mask;
+
+    // 数据存储区
+    std::unique_ptr<char[]> m_data;
+
+    // 是否已关闭
+    std::atomic_bool m_isClosed;
+
+    // 读位置，消费者写入
+    alignas(64) std::atomic<std::size_t> m_head;
+
+    // 生产者缓存的读位置
+    std::size_t m_cachedHead;
+
+    // 写位置，生产者写入
+    alignas(64) std::atomic<std::size_t> m_tail;
+};
+
+/**
+ * @note  各线程将日志追加到线程独立的环形缓冲区，后台写线程按刷新间隔或缓冲区过半时批量收集后交给输出回调函数，
+ *        文本日志通过writev()一次写入日志文件和标准输出；写日志的线程不加锁、不执行系统调用；
+ *        文本日志与二进制日志各使用一个实例，各线程在每个实例中各有一个环形缓冲区
+ * @brief 异步日志后台写线程
+ */
+class AsyncLogWriter : public Noncopyable {
+public:
+    /**
+     * @note  各线程缓冲区的数据按线程依次排列，每次append()的数据不会被拆分到两次回调中
+     * @brief 日志输出回调函数，在后台写线程中调用
+     * @param iov 日志数据段
+     * @param count 日志数据段数
+     */
+    using OutputCb = std::function<void(const struct iovec* iov, int count)>;
+
+public:
+    /**
+     * @brief  获取文本日志后台写线程
+     * @return 文本日志后台写线程
+     */
+    static AsyncLogWriter& Instance();
+
+    /**
+     * @brief  获取二进制日志后台写线程
+     * @return 二进制日志后台写线程
+     */
+    static AsyncLogWriter& BinaryInstance();
+
+    ~AsyncLogWriter();
+
+public:
+    /**
+     * @brief  启动后台写线程
+     * @return 启动结果，已启动时返回false
+     * @param  ringSize 每个线程的环形缓冲区容量(单位: 字节)
+     * @param  flushIntervalMs 刷新间隔(单位: 毫秒)
+     * @param  policy 缓冲区已满时的处理策略
+     * @param  outputCb 日志输出回调函数
+     */
+    bool start(std::size_t ringSize, int flushIntervalMs, LogOverflow_t policy, const OutputCb& outputCb);
+
+    /**
+     * @note  写出全部已追加的日志后返回；停止期间其他线程追加的日志可能丢失
+     * @brief 停止后台写线程
+     */
+    void stop();
+
+    /**
+     * @brief  追加一条日志
+     * @return 追加结果，未启动或丢弃时返回false
+     * @param  data 日志数据
+     * @param  size 日志长度
+     */
+    bool append(const char* data, std::size_t size);
+
+    /**
+     * @brief  后台写线程是否运行中
+     * @return 判断结果
+     */
+    inline bool isRunning() const {
+        return m_isRunning.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief  获取因缓冲区已满而丢弃的日志数
+     * @return 丢弃的日志数
+     */
+    inline uint64_t getDroppedCount() const {
+        return m_droppedCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    explicit AsyncLogWriter(std::size_t slot);
+
+    /**
+     * @note   首次调用或原缓冲区已随后台写线程停止而关闭时创建并注册
+     * @brief  获取当前线程的环形缓冲区
+     * @return 环形缓冲区
+     */
+    LogRing::Ptr getLocalRing();
+
+    /**
+     * @brief 唤醒后台写线程
+     */
+    void wakeup();
+
+    /**
+     * @brief 后台写线程函数
+     */
+    void threadFunc();
+
+    /**
+     * @brief  收集各线程缓冲区中的日志并写出
+     * @return 写出的字节数
+     */
+    std::size_t writeOnce();
+
+private:
+    // 实例序号，对应各线程中的环形缓冲区槽位
+    const std::size_t m_slot;
+
+    // 是否运行中
+    std::atomic_bool m_isRunning;
+
+    // 每个线程的环形缓冲区容量
+    std::size_t m_ringSize;
+
+    // 刷新间隔(单位: 毫秒)
+    int m_flushIntervalMs;
+
+    // 缓冲区已满时的处理策略
+    LogOverflow_t m_policy;
+
+    // 日志输出回调函数
+    OutputCb m_outputCb;
+
+    // 丢弃的日志数
+    std::atomic<uint64_t> m_droppedCount;
+
+    // 后台写线程
+    std::thread m_thread;
+
+    // 唤醒互斥锁
+    std::mutex m_wakeupMutex;
+
+    // 唤醒条件变量
+    std::condition_variable m_wakeupCond;
+
+    // 是否有待处理的唤醒，由m_wakeupMutex保护
+    bool m_isWakeup;
+
+    // 是否请求停止，由m_wakeupMutex保护
+    bool m_isStop;
+
+    // 环形缓冲区列表互斥锁，仅在线程注册及后台写线程收集时加锁
+    std::mutex m_ringMutex;
+
+    // 各线程的环形缓冲区
+    std::vector<LogRing::Ptr> m_rings;
+};
+
+}; // namespace Utils
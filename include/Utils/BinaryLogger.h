@@ -0,0 +1,253 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <ostream>
+#include <type_traits>
+#include "Utils/Utils.h"
+#include "Utils/Logger.h"
+#include "Common/ConfigDef.h"
+
+namespace Utils {
+
+// 二进制日志宏定义，fmt须为字符串字面量，以{}作为参数占位符；每个调用点首次执行时注册格式，之后仅记录格式id及参数
+#define LOG_BIN(level, fmt, ...)                                                                                                \
+    do {                                                                                                                        \
+        if (Logger::IsEnabled(level)) {                                                                                         \
+            static const uint32_t logFmtId = BinaryLogger::RegisterFormat(level, StringHelper::GetFileName(__FILE__), __LINE__, fmt); \
+            BinaryLogger::Write(logFmtId, ##__VA_ARGS__);                                                                       \
+        }                                                                                                                       \
+    } while (0)
+
+// 便捷宏定义，FATAL日志需立即输出并退出进程，使用LOG_FATAL
+#define LOG_BIN_DEBUG(fmt, ...) LOG_BIN(LogLevel::DEBUG, fmt, ##__VA_ARGS__)
+#define LOG_BIN_INFO(fmt, ...) LOG_BIN(LogLevel::INFO, fmt, ##__VA_ARGS__)
+#define LOG_BIN_WARN(fmt, ...) LOG_BIN(LogLevel::WARN, fmt, ##__VA_ARGS__)
+#define LOG_BIN_ERROR(fmt, ...) LOG_BIN(LogLevel::ERROR, fmt, ##__VA_ARGS__)
+
+/**
+ * @brief 二进制日志格式描述
+ */
+struct BinaryLogFormat {
+    // 日志级别
+    LogLevel m_level;
+
+    // 日志所在行
+    int m_line;
+
+    // 日志所在文件
+    std::string m_file;
+
+    // 格式字符串
+    std::string m_fmt;
+};
+
+/**
+ * @note  记录布局: [记录长度 u32][格式id u32][时间戳(单位: 纳秒) i64][参数类型 u8 + 参数值]...；
+ *        参数写入定长缓冲区，空间不足时截断字符串参数并丢弃之后的参数
+ * @brief 二进制日志记录编码器
+ */
+class BinaryLogEncoder : public Noncopyable {
+public:
+    /**
+     * @brief 参数类型
+     */
+    enum ArgType_t : uint8_t {
+        ArgInt = 1,
+        ArgUint = 2,
+        ArgDouble = 3,
+        ArgChar = 4,
+        ArgBool = 5,
+        ArgString = 6
+    };
+
+public:
+    BinaryLogEncoder(char* buf, std::size_t size, uint32_t fmtId, int64_t timeNs)
+        : m_begin(buf), m_pos(buf + sizeof(uint32_t)), m_end(buf + size) {
+        this->putRaw(fmtId);
+        this->putRaw(timeNs);
+    }
+
+public:
+    /**
+     * @brief 写入定长参数
+     * @param type 参数类型
+     * @param value 参数值
+     */
+    template <typename T>
+    void putArg(ArgType_t type, const T& value) {
+        if (m_pos + sizeof(uint8_t) + sizeof(T) <= m_end) {
+            *m_pos++ = static_cast<char>(type);
+            this->putRaw(value);
+        }
+    }
+
+    /**
+     * @brief 写入字符串参数
+     * @param data 字符串
+     * @param size 字符串长度
+     */
+    void putString(const char* data, std::size_t size) {
+        std::size_t headSize = sizeof(uint8_t) + sizeof(uint32_t);
+        if (m_pos + headSize > m_end) {
+            return;
+        }
+
+        auto len = static_cast<uint32_t>(std::min(size, static_cast<std::size_t>(m_end - m_pos) - headSize));
+        *m_pos++ = static_cast<char>(ArgString);
+        this->putRaw(len);
+        memcpy(m_pos, data, len);
+        m_pos += len;
+    }
+
+    /**
+     * @brief  完成编码，写入记录长度
+     * @return 记录长度
+     */
+    std::size_t finish() {
+        auto size = static_cast<uint32_t>(m_pos - m_begin);
+        memcpy(m_begin, &size, sizeof(size));
+        return size;
+    }
+
+private:
+    template <typename T>
+    void putRaw(const T& value) {
+        memcpy(m_pos, &value, sizeof(T));
+        m_pos += sizeof(T);
+    }
+
+private:
+    // 记录起始位置
+    char* m_begin;
+
+    // 写入位置
+    char* m_pos;
+
+    // 缓冲区结束位置
+    char* m_end;
+};
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && !std::is_same<T, char>::value>::type
+EncodeBinaryLogArg(BinaryLogEncoder& enc, T value) {
+    enc.putArg(BinaryLogEncoder::ArgInt, static_cast<int64_t>(value));
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value && !std::is_same<T, bool>::value
+    && !std::is_same<T, char>::value>::type
+EncodeBinaryLogArg(BinaryLogEncoder& enc, T value) {
+    enc.putArg(BinaryLogEncoder::ArgUint, static_cast<uint64_t>(value));
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value>::type EncodeBinaryLogArg(BinaryLogEncoder& enc, T value) {
+    enc.putArg(BinaryLogEncoder::ArgDouble, static_cast<double>(value));
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_enum<T>::value>::type EncodeBinaryLogArg(BinaryLogEncoder& enc, T value) {
+    enc.putArg(BinaryLogEncoder::ArgInt, static_cast<int64_t>(value));
+}
+
+inline void EncodeBinaryLogArg(BinaryLogEncoder& enc, char value) {
+    enc.putArg(BinaryLogEncoder::ArgChar, value);
+}
+
+inline void EncodeBinaryLogArg(BinaryLogEncoder& enc, bool value) {
+    enc.putArg(BinaryLogEncoder::ArgBool, static_cast<uint8_t>(value));
+}
+
+inline void EncodeBinaryLogArg(BinaryLogEncoder& enc, const char* value) {
+    nullptr == value ? enc.putString("(null)", 6) : enc.putString(value, strlen(value));
+}
+
+inline void EncodeBinaryLogArg(BinaryLogEncoder& enc, const std::string& value) {
+    enc.putString(value.data(), value.size());
+}
+
+inline void EncodeBinaryLogArgs(BinaryLogEncoder&) {
+}
+
+template <typename T, typename... Args>
+inline void EncodeBinaryLogArgs(BinaryLogEncoder& enc, const T& value, const Args&... args) {
+    EncodeBinaryLogArg(enc, value);
+    EncodeBinaryLogArgs(enc, args...);
+}
+
+/**
+ * @note  调用线程仅记录格式id、时间戳及参数原始字节，格式化推迟到后台写线程(文本方式)或离线解码(二进制文件方式)；
+ *        未启动时在调用线程中立即格式化并按文本日志输出
+ * @brief 二进制日志类
+ */
+class BinaryLogger : public NoncopyableConstructable {
+public:
+    /**
+     * @brief  注册日志格式
+     * @return 格式id，从1开始
+     * @param  level 日志级别
+     * @param  file 日志所在文件
+     * @param  line 日志所在行
+     * @param  fmt 格式字符串
+     */
+    static uint32_t RegisterFormat(LogLevel level, const char* file, int line, const char* fmt);
+
+    /**
+     * @brief 记录一条日志
+     * @param fmtId 格式id
+     * @param args 参数，支持整数、浮点数、字符、布尔值、枚举及字符串
+     */
+    template <typename... Args>
+    static void Write(uint32_t fmtId, const Args&... args) {
+        char buf[LOG_BINARY_RECORD_MAX];
+        BinaryLogEncoder enc(buf, sizeof(buf), fmtId, TimeHelper::GetCurrentTimeNs());
+        EncodeBinaryLogArgs(enc, args...);
+        Commit(buf, enc.finish());
+    }
+
+    /**
+     * @note   二进制文件方式每次启动时清空文件，写入的格式描述仅对本次启动有效
+     * @brief  启动二进制日志后台写线程
+     * @return 启动结果
+     * @param  mode 输出方式
+     * @param  path 二进制文件路径，仅二进制文件方式使用
+     * @param  ringSize 每个线程的环形缓冲区容量(单位: 字节)
+     * @param  flushIntervalMs 刷新间隔(单位: 毫秒)
+     * @param  policy 缓冲区已满时的处理策略
+     */
+    static bool Start(BinaryLogMode_t mode, const std::string& path = "", std::size_t ringSize = LOG_ASYNC_RING_SIZE,
+        int flushIntervalMs = LOG_ASYNC_FLUSH_INTERVAL, LogOverflow_t policy = LogOverflow_t::LogOverflowDrop);
+
+    /**
+     * @note  写出全部已缓存的日志后返回，之后在调用线程中立即格式化；应在其他线程停止写日志后调用
+     * @brief 停止二进制日志后台写线程
+     */
+    static void Stop();
+
+    /**
+     * @brief  获取因缓冲区已满而丢弃的日志数
+     * @return 丢弃的日志数
+     */
+    static uint64_t GetDroppedCount();
+
+    /**
+     * @brief  将二进制日志文件解码为文本
+     * @return 解码结果，文件无法读取或格式错误时返回false
+     * @param  path 二进制文件路径
+     * @param  out 文本输出流
+     * @param  count 解码的日志条数
+     */
+    static bool DecodeFile(const std::string& path, std::ostream& out, uint64_t& count);
+
+private:
+    /**
+     * @brief 提交编码完成的记录
+     * @param data 记录
+     * @param size 记录长度
+     */
+    static void Commit(const char* data, std::size_t size);
+};
+
+}; // namespace Utils
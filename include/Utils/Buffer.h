@@ -2,7 +2,10 @@
 #include <mutex>
 #include <vector>
 #include <memory>
+#include <sys/socket.h>
 #include "Common/ConfigDef.h"
+#include "Utils/Utils.h"
+#include "Memory/SlabPool.h"
 using namespace Common;
 
 namespace Utils {
@@ -14,16 +17,20 @@ namespace Utils {
  * | prependable bytes |  readable bytes  |  writable bytes  |
  * |                   |     (CONTENT)    |                  |
  * +-------------------+------------------+------------------+
- * 0        <=     m_readIdx    <=    m_writeIdx   <=    m_buffer.size()
+ * 0        <=     m_readIdx    <=    m_writeIdx   <=    m_capacity
+ *
+ * 存储空间在首次写入时才申请，指定内存池时从内存池中申请，否则通过malloc()申请；
+ * 数据读完后可通过releaseIfEmpty()归还存储空间
  */
-class Buffer {
+class Buffer : public Noncopyable {
 public:
     using Ptr = std::shared_ptr<Buffer>;
     using WkPtr = std::weak_ptr<Buffer>;
 
 public:
     explicit Buffer(std::size_t initSize = BUFFER_INIT_SIZE);
-    ~Buffer() = default;
+    explicit Buffer(Memory::SlabPool::Ptr pool, std::size_t initSize = BUFFER_INIT_SIZE);
+    ~Buffer();
 
 public:
     /**
@@ -44,6 +51,19 @@ public:
      */
     void shrink(std::size_t len);
 
+    /**
+     * @brief  缓冲区无可读数据时释放存储空间
+     * @return 是否释放了存储空间
+     */
+    bool releaseIfEmpty();
+
+    /**
+     * @note  需在新内存池所属线程中调用，可读数据复制到新存储空间，原存储空间归还原内存池
+     * @brief 将存储空间迁移到指定内存池
+     * @param pool 内存池
+     */
+    void rebindPool(Memory::SlabPool::Ptr pool);
+
     /**
      * @brief  获取缓冲区中可读数据起始地址
      * @return 可读数据起始地址
@@ -81,6 +101,16 @@ public:
      */
     ssize_t readFd(int fd, int& err);
 
+    /**
+     * @note   由调用方设置msg中的控制信息缓冲区，数据缓冲区由本函数设置；接收后可从msg中获取控制信息和标志位
+     * @brief  通过recvmsg()读取网络数据
+     * @return 读取数据长度
+     * @param  fd 网络文件描述符
+     * @param  msg 报文头
+     * @param  err 错误码
+     */
+    ssize_t readMsg(int fd, msghdr& msg, int& err);
+
     /**
      * @brief  写入网络数据
      * @return 写入数据长度
@@ -138,7 +168,7 @@ public:
      * @return 可写数据大小
      */
     inline std::size_t writableBytes() const {
-        return m_buffer.size() - m_writeIdx;
+        return nullptr == m_data ? 0 : m_capacity - m_writeIdx;
     }
 
     /**
@@ -165,7 +195,7 @@ public:
      * @return 缓冲区起始地址
      */
     inline const uint8_t* begin() const {
-        return m_buffer.data();
+        return m_data;
     }
 
     /**
@@ -173,7 +203,15 @@ public:
      * @return 缓冲区起始地址
      */
     inline uint8_t* begin() {
-        return m_buffer.data();
+        return m_data;
+    }
+
+    /**
+     * @brief  获取缓冲区存储空间大小
+     * @return 存储空间大小，未申请存储空间时为0
+     */
+    inline std::size_t capacity() const {
+        return m_capacity;
     }
 
     /**
@@ -203,8 +241,24 @@ public:
     }
 
 private:
-    // 缓冲区数据存储容器
-    std::vector<uint8_t> m_buffer;
+    /**
+     * @brief 重新申请存储空间并将可读数据拷贝到新空间前端
+     * @param size 申请大小
+     */
+    void reallocate(std::size_t size);
+
+private:
+    // 存储空间所属内存池，为空时通过malloc()申请
+    Memory::SlabPool::Ptr m_pool;
+
+    // 首次申请存储空间时的最小大小(含前置空间)
+    std::size_t m_initSize;
+
+    // 缓冲区数据存储空间
+    uint8_t* m_data;
+
+    // 缓冲区数据存储空间大小
+    std::size_t m_capacity;
 
     // 缓冲区可读数据的起始位置索引
     std::size_t m_readIdx;
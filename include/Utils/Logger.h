@@ -5,12 +5,16 @@
 #include <functional>
 #include <unordered_map>
 #include <utility>
+#include <sys/uio.h>
 #include "Utils/Utils.h"
+#include "Common/ConfigDef.h"
+#include "Common/LogConfig.h"
 
 namespace Utils {
 
-// 日志宏定义
-#define LOG(level) Logger(level, StringHelper::GetFileName(__FILE__), __LINE__)
+// 日志宏定义，级别未启用时不构造日志对象，也不对输出参数求值
+#define LOG(level) \
+    !Logger::IsEnabled(level) ? (void)0 : LogVoidify() & Logger(level, StringHelper::GetFileName(__FILE__), __LINE__)
 
 // 便捷宏定义
 #define LOG_DEBUG LOG(LogLevel::DEBUG)
@@ -30,17 +34,32 @@ enum class LogLevel {
     FATAL
 };
 
+/**
+ * @brief 日志类
+ */
+class Logger;
+
+/**
+ * @note  &的优先级低于<<，使条件表达式两侧均为void
+ * @brief 日志语句结果丢弃辅助类
+ */
+class LogVoidify {
+public:
+    void operator&(const Logger&) {
+    }
+};
+
 /**
  * @brief 日志类
  */
 class Logger : public Noncopyable {
 public:
-    using LogPrintCb = std::function<void(const std::string&, int, const std::string&)>;
+    using LogPrintCb = std::function<void(const char*, int, const std::string&)>;
     using LogPrintMap = std::unordered_map<LogLevel, LogPrintCb>;
 
 public:
-    Logger(LogLevel level, std::string file, int line)
-        : m_line(line), m_level(level), m_file(std::move(file)) {
+    Logger(LogLevel level, const char* file, int line)
+        : m_line(line), m_level(level), m_file(file) {
     }
 
     ~Logger() {
@@ -48,6 +67,17 @@ public:
     }
 
 public:
+    /**
+     * @note   编译期常量级别低于REACTOR_LOG_MIN_LEVEL时恒为false，日志语句被编译器整体移除
+     * @brief  日志级别是否启用
+     * @return 判断结果
+     * @param  level 日志级别
+     */
+    static inline bool IsEnabled(LogLevel level) {
+        return (LogLevel::FATAL == level || static_cast<int>(level) >= REACTOR_LOG_MIN_LEVEL)
+            && level >= m_lowestLevel.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief 设置最低日志级别
      * @param level 最低日志级别
@@ -64,6 +94,58 @@ public:
         m_enableWriteFile.store(enabled);
     }
 
+    /**
+     * @brief 设置是否将日志输出到标准输出
+     * @param enabled 是否输出到标准输出
+     */
+    static inline void enableWriteConsole(bool enabled = true) {
+        m_enableWriteConsole.store(enabled);
+    }
+
+    /**
+     * @note   启动后各线程的日志写入线程独立的环形缓冲区，由后台写线程批量写入文件和标准输出；
+     *         FATAL日志写出全部已缓存的日志后退出进程
+     * @brief  启动异步日志
+     * @return 启动结果，已启动时返回false
+     * @param  ringSize 每个线程的环形缓冲区容量(单位: 字节)
+     * @param  flushIntervalMs 后台写线程刷新间隔(单位: 毫秒)
+     * @param  policy 缓冲区已满时的处理策略
+     */
+    static bool StartAsync(std::size_t ringSize = LOG_ASYNC_RING_SIZE, int flushIntervalMs = LOG_ASYNC_FLUSH_INTERVAL,
+        LogOverflow_t policy = LogOverflow_t::LogOverflowDrop);
+
+    /**
+     * @note  日志文件输出对象为函数内静态对象，后台写线程启动前调用，使其在写线程之后析构；不受是否写入文件的设置影响
+     * @brief 创建日志文件输出对象
+     */
+    static void InitOutput();
+
+    /**
+     * @note  写出全部已缓存的日志后返回，之后恢复同步写日志；应在其他线程停止写日志后调用
+     * @brief 停止异步日志
+     */
+    static void StopAsync();
+
+    /**
+     * @brief  获取异步日志因缓冲区已满而丢弃的日志数
+     * @return 丢弃的日志数
+     */
+    static uint64_t GetDroppedCount();
+
+    /**
+     * @brief 输出一条格式化后的日志，异步日志启动时写入当前线程的环形缓冲区
+     * @param line 日志
+     */
+    static void Output(const std::string& line);
+
+    /**
+     * @note  按设置写入日志文件和标准输出，不经过异步日志缓冲区；供二进制日志输出格式化后的文本
+     * @brief 输出一批格式化后的日志
+     * @param iov 日志数据段
+     * @param count 日志数据段数
+     */
+    static void OutputBatch(const struct iovec* iov, int count);
+
 public:
     /**
      * @brief  支持各种类型的输入
@@ -100,7 +182,7 @@ private:
     LogLevel m_level;
 
     // 日志所在文件
-    std::string m_file;
+    const char* m_file;
 
     // 日志内容缓冲区
     std::ostringstream m_buffer;
@@ -112,6 +194,9 @@ private:
     // 日志输出文件标志位
     static std::atomic<bool> m_enableWriteFile;
 
+    // 日志输出标准输出标志位
+    static std::atomic<bool> m_enableWriteConsole;
+
     // 日志打印互斥量
     static std::mutex LogPrintCbLock;
 
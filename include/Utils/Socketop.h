@@ -1,4 +1,5 @@
 #pragma once
+#include <vector>
 #include "Common/DataDef.h"
 #include "Utils/Utils.h"
 #include "Utils/Address.h"
@@ -45,16 +46,19 @@ public:
     static bool ListenSocket(int fd, int backlog = SOMAXCONN);
 
     /**
-     * @note   仅tcp socket使用
+     * @note   仅面向连接的socket使用；通过accept4()接受，连接套接字为非阻塞并设置close-on-exec；
+     *         无待接受连接(EAGAIN)时不记录错误日志
      * @brief  接受连接
      * @return 接受连接结果
      * @param  fd 套接字描述符
      * @param  peerAddr 对端地址
      * @param  connfd 连接套接字描述符
+     * @param  errCode 失败时的错误码
      */
-    static bool AcceptSocket(int fd, Address::Ptr& peerAddr, int& connfd);
+    static bool AcceptSocket(int fd, Address::Ptr& peerAddr, int& connfd, int& errCode);
 
     /**
+     * @note   非阻塞套接字连接进行中(EINPROGRESS)时返回true，需等待可写后通过GetSocketError()确认连接结果
      * @brief  连接socket
      * @return 连接socket结果
      * @param  fd 套接字描述符
@@ -102,6 +106,14 @@ public:
      */
     static bool GetLocalPort(int fd, uint16_t& port);
 
+    /**
+     * @brief  获取本地地址
+     * @return 获取本地地址结果
+     * @param  fd 套接字描述符
+     * @param  addr 本地地址
+     */
+    static bool GetLocalAddr(int fd, Address::Ptr& addr);
+
     /**
      * @brief  获取本地地址和端口
      * @return 获取本地端口结果
@@ -174,6 +186,44 @@ public:
      */
     static bool IsReusePort(int fd);
 
+    /**
+     * @note   对SO_REUSEPORT监听组中的任一套接字设置即对整组生效；程序按处理数据包的CPU编号查表，
+     *         选择按绑定顺序排列的对应监听套接字，未列出的CPU返回越界索引，由内核按哈希选择
+     * @brief  为端口复用监听组设置按CPU分发连接的CBPF程序
+     * @return 设置结果
+     * @param  fd 套接字描述符
+     * @param  cpus 监听组中按绑定顺序排列的各监听套接字对应的CPU编号，不可重复
+     */
+    static bool AttachReusePortCbpf(int fd, const std::vector<int>& cpus);
+
+    /**
+     * @note   监听套接字设置后，端口复用组优先选择与处理数据包的CPU编号一致的套接字；
+     *         已连接套接字设置后作为接收处理所在CPU的提示，内核处理数据包时会更新该值
+     * @brief  设置套接字关联的CPU编号(SO_INCOMING_CPU)
+     * @return 设置结果
+     * @param  fd 套接字描述符
+     * @param  cpu CPU编号
+     */
+    static bool SetIncomingCpu(int fd, int cpu);
+
+    /**
+     * @brief  获取套接字关联的CPU编号(SO_INCOMING_CPU)
+     * @return 获取结果
+     * @param  fd 套接字描述符
+     * @param  cpu CPU编号，未关联时为-1
+     */
+    static bool GetIncomingCpu(int fd, int& cpu);
+
+    /**
+     * @note   阻塞读取及开启net.core.busy_poll时的epoll等待中，在网卡接收队列上忙轮询指定时长；
+     *         超过net.core.busy_read的值需CAP_NET_ADMIN权限
+     * @brief  设置套接字忙轮询时长(SO_BUSY_POLL)
+     * @return 设置结果
+     * @param  fd 套接字描述符
+     * @param  usec 忙轮询时长(单位: 微秒)
+     */
+    static bool SetBusyPoll(int fd, int usec);
+
     /**
      * @brief  设置套接字是否禁用Nagle算法
      * @return 设置结果
@@ -255,6 +305,71 @@ public:
      * @param  len 缓冲区长度
      */
     static ssize_t Write(int fd, const void* buf, size_t len);
+
+    /**
+     * @brief  批量接收报文
+     * @return 接收的报文数，失败返回-1
+     * @param  fd 套接字描述符
+     * @param  msgs 报文数组
+     * @param  vlen 报文数组长度
+     */
+    static int RecvMmsg(int fd, struct mmsghdr* msgs, unsigned int vlen);
+
+    /**
+     * @brief  批量发送报文
+     * @return 发送的报文数，失败返回-1
+     * @param  fd 套接字描述符
+     * @param  msgs 报文数组
+     * @param  vlen 报文数组长度
+     */
+    static int SendMmsg(int fd, struct mmsghdr* msgs, unsigned int vlen);
+
+    /**
+     * @note   非阻塞发送，对端关闭时不触发SIGPIPE
+     * @brief  发送报文
+     * @return 发送数据长度，失败返回-1
+     * @param  fd 套接字描述符
+     * @param  msg 报文
+     */
+    static ssize_t SendMsg(int fd, const struct msghdr* msg);
+
+    /**
+     * @note   非阻塞接收，接收到的文件描述符设置close-on-exec
+     * @brief  接收报文
+     * @return 接收数据长度，失败返回-1
+     * @param  fd 套接字描述符
+     * @param  msg 报文
+     */
+    static ssize_t RecvMsg(int fd, struct msghdr* msg);
+
+    /**
+     * @note   管道两端均为非阻塞并设置close-on-exec，容量设置失败时保持系统默认容量
+     * @brief  创建管道
+     * @return 创建结果
+     * @param  readFd 管道读端
+     * @param  writeFd 管道写端
+     * @param  capacity 期望的管道容量
+     */
+    static bool CreatePipe(int& readFd, int& writeFd, std::size_t capacity);
+
+    /**
+     * @note   非阻塞零拷贝移动数据，两端至少有一端为管道
+     * @brief  在两个文件描述符间移动数据
+     * @return 移动数据长度，对端关闭返回0，失败返回-1
+     * @param  fdIn 输入描述符
+     * @param  fdOut 输出描述符
+     * @param  len 最大移动长度
+     */
+    static ssize_t Splice(int fdIn, int fdOut, std::size_t len);
+
+    /**
+     * @note   内核不支持时返回失败
+     * @brief  设置UDP套接字是否启用GRO(接收端报文合并)
+     * @return 设置结果
+     * @param  fd 套接字描述符
+     * @param  enabled 是否启用
+     */
+    static bool SetUdpGro(int fd, bool enabled);
 };
 
 }; // namespace Utils
\ No newline at end of file
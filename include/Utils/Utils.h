@@ -60,6 +60,29 @@ public:
      * @return 字符串格式时间
      */
     static std::string PrintTime(const Timestamp& timestamp);
+
+    /**
+     * @note   格式：YYYY-MM-DD HH:MM:SS.fff；每个线程缓存已格式化的时间，秒数变化时仅改写秒数字段，
+     *         分钟变化时才调用localtime_r()；返回值指向线程独立的缓冲区，在本线程下次调用前有效
+     * @brief  格式化时间
+     * @return 格式化后的时间
+     * @param  timeNs 自1970-01-01起的时长(单位: 纳秒)
+     */
+    static const char* FormatTime(int64_t timeNs);
+
+    /**
+     * @note   粗粒度时钟精度为内核时钟节拍(通常为1~4毫秒)，读取开销更低
+     * @brief  获取当前时间
+     * @return 自1970-01-01起的时长(单位: 纳秒)
+     */
+    static int64_t GetCurrentTimeNs();
+
+    /**
+     * @note  影响GetCurrentTime()、GetCurrentTimeNs()及日志时间戳
+     * @brief 设置是否使用粗粒度时钟(CLOCK_REALTIME_COARSE)
+     * @param enabled 是否使用粗粒度时钟
+     */
+    static void SetCoarseClock(bool enabled = true);
 };
 
 /**
@@ -74,16 +97,6 @@ public:
      */
     static const char* GetFileName(const char* path);
 
-    /**
-     * @brief  获取唯一ID
-     * @return 唯一ID
-     * @param  localIp 本端IP
-     * @param  localPort 本端端口
-     * @param  peerIp 对端IP
-     * @param  peerPort 对端端口
-     */
-    static std::string GetUniqueId(const std::string& localIp, uint16_t localPort, const std::string& peerIp, uint16_t peerPort);
-
     /**
      * @brief  获取事件类型字符串
      * @return 事件类型字符串
@@ -16,6 +16,7 @@ namespace Net {
 Acceptor::Acceptor(EventLoop::WkPtr loop, const Address::Ptr& addr, const Socket_t& type, bool reuseport)
     : m_idleFd(::open("/dev/null", O_RDONLY | O_CLOEXEC)),
       m_isListening(false),
+      m_isSockListening(false),
       m_addr(addr),
       m_ownerLoop(std::move(loop)) {
     // 创建监听套接字
@@ -25,8 +26,11 @@ Acceptor::Acceptor(EventLoop::WkPtr loop, const Address::Ptr& addr, const Socket
     }
 
     m_sock = std::make_shared<Socket>(fd, type);
-    m_sock->setReuseAddr(true);
-    m_sock->setReusePort(reuseport);
+    // Unix域套接字不支持地址与端口复用选项
+    if (Addr_t::Unix != addr->getAddrType()) {
+        m_sock->setReuseAddr(true);
+        m_sock->setReusePort(reuseport);
+    }
     m_sock->bind(addr);
 
     // 创建channel
@@ -35,7 +39,8 @@ Acceptor::Acceptor(EventLoop::WkPtr loop, const Address::Ptr& addr, const Socket
 }
 
 Acceptor::~Acceptor() {
-    m_channel->close();
+    // 已停止监听时通道已关闭
+    this->stop();
     ::close(m_idleFd);
 
     LOG_DEBUG << "Acceptor deconstruct. fd: " << m_sock->getFd() << " addr: " << m_addr->printIpPort();
@@ -47,8 +52,7 @@ void Acceptor::listen() {
         return;
     }
 
-    if (!m_sock->listen()) {
-        LOG_ERROR << "Acceptor listen error. listen failed. addr: " << m_addr->printIpPort();
+    if (!this->listenSocket()) {
         return;
     }
 
@@ -66,10 +70,39 @@ void Acceptor::listen() {
     m_isListening = true;
 }
 
+bool Acceptor::listenSocket() {
+    if (m_isSockListening) {
+        return true;
+    }
+
+    if (!m_sock->listen()) {
+        LOG_ERROR << "Acceptor listen error. listen failed. addr: " << m_addr->printIpPort();
+        return false;
+    }
+
+    m_isSockListening = true;
+    return true;
+}
+
+void Acceptor::stop() {
+    if (!this->isListening()) {
+        return;
+    }
+
+    m_channel->close();
+    m_isListening = false;
+}
+
 /** ---------------------------------------------- TcpAcceptor ------------------------------------------------------ */
 
 TcpAcceptor::TcpAcceptor(const EventLoop::WkPtr& loop, const Address::Ptr& addr, bool reuseport)
-    : Acceptor(loop, addr, Socket_t::TCP, reuseport) {
+    : Acceptor(loop, addr, Socket_t::TCP, reuseport),
+      m_acceptBatchSize(ACCEPT_BATCH_SIZE) {
+}
+
+TcpAcceptor::TcpAcceptor(const EventLoop::WkPtr& loop, const Address::Ptr& addr, const Socket_t& type, bool reuseport)
+    : Acceptor(loop, addr, type, reuseport),
+      m_acceptBatchSize(ACCEPT_BATCH_SIZE) {
 }
 
 void TcpAcceptor::handleRead(Timestamp recvTime) {
@@ -78,13 +111,30 @@ void TcpAcceptor::handleRead(Timestamp recvTime) {
         return;
     }
 
-    Socket::Ptr connSock;
-    if (!m_sock->accept(connSock)) {
+    for (std::size_t idx = 0; idx < m_acceptBatchSize; ++idx) {
+        int errCode = 0;
+        Socket::Ptr connSock;
+        if (m_sock->accept(connSock, errCode)) {
+            // 新连接回调
+            m_newConnCb(connSock, recvTime);
+            continue;
+        }
+
+        // 已无待接受的连接
+        if (EAGAIN == errCode || EWOULDBLOCK == errCode) {
+            break;
+        }
+
+        // 连接在接受前被对端重置或被信号中断，继续接受下一个连接
+        if (ECONNABORTED == errCode || EINTR == errCode || EPROTO == errCode) {
+            continue;
+        }
+
         LOG_ERROR << "TcpAcceptor handleRead error. accept failed. addr: " << m_addr->printIpPort() << " errno: "
-            << errno << " error: " << strerror(errno);
+            << errCode << " error: " << strerror(errCode);
 
         // 连接数量达到上限
-        if (EMFILE == errno) {
+        if (EMFILE == errCode || ENFILE == errCode) {
             // 关闭连接socket
             ::close(m_idleFd);
             m_idleFd = ::accept(m_sock->getFd(), nullptr, nullptr);
@@ -93,11 +143,34 @@ void TcpAcceptor::handleRead(Timestamp recvTime) {
             ::close(m_idleFd);
             m_idleFd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
         }
+        break;
+    }
+}
+
+/** ---------------------------------------------- UnixAcceptor ------------------------------------------------------ */
+
+/**
+ * @brief  删除Unix域套接字文件路径地址对应的文件
+ * @return 输入的地址
+ * @param  addr Unix域套接字地址
+ */
+static const Address::Ptr& UnlinkUnixPath(const Address::Ptr& addr) {
+    auto unixAddr = std::dynamic_pointer_cast<UnixAddress>(addr);
+    if (nullptr == unixAddr) {
+        LOG_FATAL << "UnixAcceptor construct error. invalid unix address.";
     }
-    else {
-        // 新连接回调
-        m_newConnCb(connSock, recvTime);
+    else if (!unixAddr->isAbstract() && !unixAddr->getPath().empty()) {
+        ::unlink(unixAddr->getPath().c_str());
     }
+    return addr;
+}
+
+UnixAcceptor::UnixAcceptor(const EventLoop::WkPtr& loop, const Address::Ptr& addr, const Socket_t& type)
+    : TcpAcceptor(loop, UnlinkUnixPath(addr), type, false) {
+}
+
+UnixAcceptor::~UnixAcceptor() {
+    UnlinkUnixPath(m_addr);
 }
 
 } // namespace Net
\ No newline at end of file
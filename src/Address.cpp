@@ -1,6 +1,8 @@
 #include <cstring>
 #include <cstdlib>
 #include <stdexcept>
+#include <algorithm>
+#include <cstddef>
 #include <arpa/inet.h>
 #include "Utils/Logger.h"
 #include "Utils/Address.h"
@@ -8,6 +10,30 @@ using namespace Utils;
 
 namespace Utils {
 
+/** ------------------------------------ Address ------------------------------------------- */
+
+Address::Ptr Address::Create(const sockaddr_storage& addr, socklen_t len) {
+    Address::Ptr result;
+    try {
+        if (AF_INET == addr.ss_family) {
+            result = std::make_shared<IPv4Address>(*reinterpret_cast<const sockaddr_in*>(&addr));
+        }
+        else if (AF_INET6 == addr.ss_family) {
+            result = std::make_shared<IPv6Address>(*reinterpret_cast<const sockaddr_in6*>(&addr));
+        }
+        else if (AF_UNIX == addr.ss_family) {
+            result = std::make_shared<UnixAddress>(*reinterpret_cast<const sockaddr_un*>(&addr), len);
+        }
+        else {
+            LOG_ERROR << "Address create error. unsupported address family: " << addr.ss_family;
+        }
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "Address create error. " << e.what();
+    }
+    return result;
+}
+
 /** ------------------------------------ IPv4Address ------------------------------------------- */
 
 IPv4Address::IPv4Address(const std::string& ip, uint16_t port)
@@ -41,7 +67,7 @@ IPv4Address::IPv4Address(const sockaddr_in& addr)
     }
 }
 
-bool IPv4Address::getSockAddr(sockaddr& addr) const {
+bool IPv4Address::getSockAddr(sockaddr_storage& addr) const {
     if (!this->valid()) {
         LOG_ERROR << "Get socket address error. invalid address";
         return false;
@@ -152,7 +178,7 @@ IPv6Address::IPv6Address(const sockaddr_in6& addr)
     }
 }
 
-bool IPv6Address::getSockAddr(sockaddr& addr) const {
+bool IPv6Address::getSockAddr(sockaddr_storage& addr) const {
     if (!this->valid()) {
         LOG_ERROR << "Get socket address error. invalid address";
         return false;
@@ -245,4 +271,109 @@ std::string IPv6Address::printIpPort() const {
     }
 }
 
+/** ------------------------------------ UnixAddress ------------------------------------------- */
+
+UnixAddress::UnixAddress(const std::string& path)
+    : m_addr(),
+      m_len(0) {
+    memset(&m_addr, 0, sizeof(m_addr));
+
+    // 路径需为sun_path预留结尾'\0'
+    if (path.empty() || path.size() >= sizeof(m_addr.sun_path)) {
+        LOG_ERROR << "UnixAddress construct error. Invalid input param";
+        return;
+    }
+
+    m_addr.sun_family = AF_UNIX;
+    if ('@' == path[0]) {
+        // 抽象地址以'\0'开头，长度不含结尾'\0'
+        memcpy(m_addr.sun_path + 1, path.data() + 1, path.size() - 1);
+        m_len = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path.size());
+    }
+    else {
+        memcpy(m_addr.sun_path, path.data(), path.size());
+        m_len = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path.size() + 1);
+    }
+}
+
+UnixAddress::UnixAddress(const sockaddr_un& addr, socklen_t len)
+    : m_addr(addr),
+      m_len(std::min<socklen_t>(len, sizeof(sockaddr_un))) {
+    if (!this->UnixAddress::valid()) {
+        throw std::runtime_error("Invalid socket address");
+    }
+
+    // 文件路径地址按实际路径长度修正，未命名地址和抽象地址保留原长度
+    if (m_len > offsetof(sockaddr_un, sun_path) && '\0' != m_addr.sun_path[0]) {
+        std::size_t pathLen = strnlen(m_addr.sun_path, sizeof(m_addr.sun_path) - 1);
+        m_addr.sun_path[pathLen] = '\0';
+        m_len = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + pathLen + 1);
+    }
+}
+
+bool UnixAddress::getSockAddr(sockaddr_storage& addr) const {
+    if (!this->valid()) {
+        LOG_ERROR << "Get socket address error. invalid address";
+        return false;
+    }
+
+    memcpy(&addr, &m_addr, m_len);
+    return true;
+}
+
+bool UnixAddress::getIpAddr(std::string& ip) const {
+    if (!this->valid()) {
+        LOG_ERROR << "Get ip address error. invalid address";
+        return false;
+    }
+
+    ip = this->getPath();
+    return true;
+}
+
+bool UnixAddress::getPort(uint16_t& port) const {
+    if (!this->valid()) {
+        LOG_ERROR << "Get port error. invalid address";
+        return false;
+    }
+
+    port = 0;
+    return true;
+}
+
+bool UnixAddress::getIpPort(std::string& ip, uint16_t& port) const {
+    if (!this->valid()) {
+        LOG_ERROR << "Get ip address and port error. invalid address";
+        return false;
+    }
+
+    ip = this->getPath();
+    port = 0;
+    return true;
+}
+
+bool UnixAddress::valid() const {
+    return AF_UNIX == m_addr.sun_family && m_len >= offsetof(sockaddr_un, sun_path);
+}
+
+std::string UnixAddress::printIpPort() const {
+    if (!this->valid()) {
+        return "invalid unix address";
+    }
+
+    std::string path = this->getPath();
+    return path.empty() ? "unix:(unnamed)" : "unix:" + path;
+}
+
+std::string UnixAddress::getPath() const {
+    if (m_len <= offsetof(sockaddr_un, sun_path)) {
+        return "";
+    }
+
+    if (this->isAbstract()) {
+        return "@" + std::string(m_addr.sun_path + 1, m_len - offsetof(sockaddr_un, sun_path) - 1);
+    }
+    return std::string(m_addr.sun_path);
+}
+
 } // namespace Utils
\ No newline at end of file
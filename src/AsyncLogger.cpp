@@ -0,0 +1,270 @@
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include "Utils/AsyncLogger.h"
+
+namespace Utils {
+
+/**
+ * @brief  向上取整为2的幂
+ * @return 取整结果
+ * @param  value 取整前的值
+ */
+static std::size_t RoundUpPowerOfTwo(std::size_t value) {
+    std::size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * @note  线程退出时关闭缓冲区，由后台写线程读完剩余日志后释放
+ * @brief 线程环形缓冲区持有者
+ */
+struct LocalRingHolder {
+    ~LocalRingHolder() {
+        if (nullptr != m_ring) {
+            m_ring->close();
+        }
+    }
+
+    // 当前线程的环形缓冲区
+    LogRing::Ptr m_ring;
+};
+
+// 后台写线程实例数: 文本日志、二进制日志
+static constexpr std::size_t ASYNC_LOG_WRITER_COUNT = 2;
+
+static thread_local LocalRingHolder t_ringHolders[ASYNC_LOG_WRITER_COUNT];
+
+/** ---------------------------------------------- LogRing ------------------------------------------------------------- */
+
+LogRing::LogRing(std::size_t capacity)
+    : m_mask(RoundUpPowerOfTwo(capacity) - 1),
+      m_data(new char[m_mask + 1]),
+      m_isClosed(false),
+      m_head(0),
+      m_cachedHead(0),
+      m_tail(0) {
+}
+
+bool LogRing::append(const char* data, std::size_t size) {
+    std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_cachedHead + size > m_mask + 1) {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        if (tail - m_cachedHead + size > m_mask + 1) {
+            return false;
+        }
+    }
+
+    // 跨越缓冲区末尾时分两段拷贝
+    std::size_t pos = tail & m_mask;
+    std::size_t fstSize = std::min(size, m_mask + 1 - pos);
+    memcpy(m_data.get() + pos, data, fstSize);
+    memcpy(m_data.get(), data + fstSize, size - fstSize);
+    m_tail.store(tail + size, std::memory_order_release);
+    return true;
+}
+
+std::size_t LogRing::peek(struct iovec* iov, std::size_t& count) {
+    std::size_t head = m_head.load(std::memory_order_relaxed);
+    std::size_t size = m_tail.load(std::memory_order_acquire) - head;
+    count = 0;
+    if (0 == size) {
+        return 0;
+    }
+
+    std::size_t pos = head & m_mask;
+    std::size_t fstSize = std::min(size, m_mask + 1 - pos);
+    iov[count].iov_base = m_data.get() + pos;
+    iov[count++].iov_len = fstSize;
+    if (size > fstSize) {
+        iov[count].iov_base = m_data.get();
+        iov[count++].iov_len = size - fstSize;
+    }
+    return size;
+}
+
+void LogRing::consume(std::size_t size) {
+    m_head.store(m_head.load(std::memory_order_relaxed) + size, std::memory_order_release);
+}
+
+/** ---------------------------------------------- AsyncLogWriter ------------------------------------------------------ */
+
+AsyncLogWriter& AsyncLogWriter::Instance() {
+    static AsyncLogWriter instance(0);
+    return instance;
+}
+
+AsyncLogWriter& AsyncLogWriter::BinaryInstance() {
+    static AsyncLogWriter instance(1);
+    return instance;
+}
+
+AsyncLogWriter::AsyncLogWriter(std::size_t slot)
+    : m_slot(slot),
+      m_isRunning(false),
+      m_ringSize(LOG_ASYNC_RING_SIZE),
+      m_flushIntervalMs(LOG_ASYNC_FLUSH_INTERVAL),
+      m_policy(LogOverflow_t::LogOverflowDrop),
+      m_droppedCount(0),
+      m_isWakeup(false),
+      m_isStop(false) {
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    this->stop();
+}
+
+bool AsyncLogWriter::start(std::size_t ringSize, int flushIntervalMs, LogOverflow_t policy, const OutputCb& outputCb) {
+    if (m_isRunning || 0 == ringSize || flushIntervalMs <= 0 || nullptr == outputCb) {
+        return false;
+    }
+
+    m_ringSize = ringSize;
+    m_flushIntervalMs = flushIntervalMs;
+    m_policy = policy;
+    m_outputCb = outputCb;
+    {
+        std::lock_guard<std::mutex> lock(m_wakeupMutex);
+        m_isWakeup = false;
+        m_isStop = false;
+    }
+
+    m_thread = std::thread(&AsyncLogWriter::threadFunc, this);
+    m_isRunning.store(true, std::memory_order_release);
+    return true;
+}
+
+void AsyncLogWriter::stop() {
+    if (!m_isRunning.exchange(false)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeupMutex);
+        m_isStop = true;
+    }
+    m_wakeupCond.notify_one();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    // 关闭全部缓冲区，各线程再次启动后重新创建
+    std::lock_guard<std::mutex> lock(m_ringMutex);
+    for (auto& ring : m_rings) {
+        ring->close();
+    }
+    m_rings.clear();
+}
+
+bool AsyncLogWriter::append(const char* data, std::size_t size) {
+    if (!this->isRunning()) {
+        return false;
+    }
+
+    auto ring = this->getLocalRing();
+    if (size > ring->capacity()) {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 可读数据首次超过一半时唤醒后台写线程，避免在刷新间隔内写满
+    bool isHalfBefore = ring->readableBytes() >= ring->capacity() / 2;
+    while (!ring->append(data, size)) {
+        if (LogOverflow_t::LogOverflowDrop == m_policy || !this->isRunning()) {
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        this->wakeup();
+        std::this_thread::yield();
+    }
+
+    if (!isHalfBefore && ring->readableBytes() >= ring->capacity() / 2) {
+        this->wakeup();
+    }
+    return true;
+}
+
+LogRing::Ptr AsyncLogWriter::getLocalRing() {
+    auto& ring = t_ringHolders[m_slot].m_ring;
+    if (nullptr == ring || ring->isClosed()) {
+        ring = std::make_shared<LogRing>(m_ringSize);
+
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+        m_rings.push_back(ring);
+    }
+    return ring;
+}
+
+void AsyncLogWriter::wakeup() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeupMutex);
+        m_isWakeup = true;
+    }
+    m_wakeupCond.notify_one();
+}
+
+void AsyncLogWriter::threadFunc() {
+    bool isStop = false;
+    while (!isStop) {
+        {
+            std::unique_lock<std::mutex> lock(m_wakeupMutex);
+            m_wakeupCond.wait_for(lock, std::chrono::milliseconds(m_flushIntervalMs), [this]() {
+                return m_isWakeup || m_isStop;
+            });
+            m_isWakeup = false;
+            isStop = m_isStop;
+        }
+
+        // 单次最多收集LOG_ASYNC_IOV_MAX段，写满后继续收集直到全部写出
+        while (this->writeOnce() > 0) {
+        }
+    }
+}
+
+std::size_t AsyncLogWriter::writeOnce() {
+    std::vector<LogRing::Ptr> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+
+        // 移除所属线程已退出且已读完的缓冲区
+        m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [](const LogRing::Ptr& ring) {
+            return ring->isClosed() && 0 == ring->readableBytes();
+        }), m_rings.end());
+        rings = m_rings;
+    }
+
+    struct iovec iov[LOG_ASYNC_IOV_MAX];
+    std::vector<std::pair<LogRing::Ptr, std::size_t>> consumed;
+    std::size_t iovCount = 0;
+    std::size_t totalSize = 0;
+    for (auto& ring : rings) {
+        if (iovCount + 2 > static_cast<std::size_t>(LOG_ASYNC_IOV_MAX)) {
+            break;
+        }
+
+        std::size_t count = 0;
+        std::size_t size = ring->peek(iov + iovCount, count);
+        if (size > 0) {
+            iovCount += count;
+            totalSize += size;
+            consumed.emplace_back(ring, size);
+        }
+    }
+
+    if (0 == totalSize) {
+        return 0;
+    }
+
+    m_outputCb(iov, static_cast<int>(iovCount));
+    for (auto& pair : consumed) {
+        pair.first->consume(pair.second);
+    }
+    return totalSize;
+}
+
+} // namespace Utils
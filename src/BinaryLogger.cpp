@@ -0,0 +1,504 @@
+#include <mutex>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Utils/AsyncLogger.h"
+#include "Utils/BinaryLogger.h"
+
+namespace Utils {
+
+// 二进制日志文件头
+static const char BINARY_LOG_MAGIC[] = "RBINLOG1";
+static constexpr std::size_t BINARY_LOG_MAGIC_SIZE = sizeof(BINARY_LOG_MAGIC) - 1;
+
+// 格式描述记录的格式id
+static constexpr uint32_t BINARY_LOG_DEFINE_ID = 0;
+
+// 日志记录头长度: 记录长度 + 格式id
+static constexpr std::size_t BINARY_LOG_HEAD_SIZE = sizeof(uint32_t) + sizeof(uint32_t);
+
+// 已注册的日志格式，第i个对应格式id i + 1
+static std::mutex s_formatMutex;
+static std::vector<BinaryLogFormat> s_formats;
+
+/**
+ * @brief  获取日志级别前缀，与文本日志一致
+ * @return 日志级别前缀
+ * @param  level 日志级别
+ */
+static const char* GetLevelPrefix(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG: return "[DEBUG][";
+        case LogLevel::INFO: return "[INFO] [";
+        case LogLevel::WARN: return "[WARN] [";
+        case LogLevel::ERROR: return "[ERROR][";
+        default: return "[FATAL][";
+    }
+}
+
+/**
+ * @brief  从数据中读取定长值
+ * @return 读取结果，剩余数据不足时返回false
+ */
+template <typename T>
+static bool ReadRaw(const char*& pos, const char* end, T& value) {
+    if (pos + sizeof(T) > end) {
+        return false;
+    }
+
+    memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+/**
+ * @brief  从数据中读取长度前缀字符串
+ * @return 读取结果，剩余数据不足时返回false
+ */
+static bool ReadString(const char*& pos, const char* end, std::string& value) {
+    uint32_t len = 0;
+    if (!ReadRaw(pos, end, len) || pos + len > end) {
+        return false;
+    }
+
+    value.assign(pos, len);
+    pos += len;
+    return true;
+}
+
+/**
+ * @brief  读取一个参数并追加其文本
+ * @return 读取结果，没有剩余参数或参数错误时返回false
+ */
+static bool AppendArg(const char*& pos, const char* end, std::string& out) {
+    uint8_t type = 0;
+    if (!ReadRaw(pos, end, type)) {
+        return false;
+    }
+
+    char buf[32];
+    switch (type) {
+        case BinaryLogEncoder::ArgInt: {
+            int64_t value = 0;
+            if (!ReadRaw(pos, end, value)) {
+                return false;
+            }
+            out += std::to_string(value);
+            return true;
+        }
+        case BinaryLogEncoder::ArgUint: {
+            uint64_t value = 0;
+            if (!ReadRaw(pos, end, value)) {
+                return false;
+            }
+            out += std::to_string(value);
+            return true;
+        }
+        case BinaryLogEncoder::ArgDouble: {
+            double value = 0;
+            if (!ReadRaw(pos, end, value)) {
+                return false;
+            }
+            // 与输出流默认格式一致
+            snprintf(buf, sizeof(buf), "%g", value);
+            out += buf;
+            return true;
+        }
+        case BinaryLogEncoder::ArgChar: {
+            char value = 0;
+            if (!ReadRaw(pos, end, value)) {
+                return false;
+            }
+            out += value;
+            return true;
+        }
+        case BinaryLogEncoder::ArgBool: {
+            uint8_t value = 0;
+            if (!ReadRaw(pos, end, value)) {
+                return false;
+            }
+            out += value ? "1" : "0";
+            return true;
+        }
+        case BinaryLogEncoder::ArgString: {
+            std::string value;
+            if (!ReadString(pos, end, value)) {
+                return false;
+            }
+            out += value;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 将一条日志记录格式化为文本行
+ * @param format 日志格式
+ * @param record 日志记录，不含记录头
+ * @param size 日志记录长度
+ * @param out 追加的文本
+ */
+static void FormatRecord(const BinaryLogFormat& format, const char* record, std::size_t size, std::string& out) {
+    const char* pos = record;
+    const char* end = record + size;
+    int64_t timeNs = 0;
+    ReadRaw(pos, end, timeNs);
+
+    out += GetLevelPrefix(format.m_level);
+    out += TimeHelper::FormatTime(timeNs);
+    out += "][";
+    out += format.m_file;
+    out += ":";
+    out += std::to_string(format.m_line);
+    out += "] ";
+
+    // 按顺序替换{}占位符，参数不足时保留占位符
+    const std::string& fmt = format.m_fmt;
+    for (std::size_t idx = 0; idx < fmt.size(); ++idx) {
+        if ('{' == fmt[idx] && idx + 1 < fmt.size() && '}' == fmt[idx + 1] && AppendArg(pos, end, out)) {
+            ++idx;
+            continue;
+        }
+        out += fmt[idx];
+    }
+    out += '\n';
+}
+
+/**
+ * @brief  获取已注册的日志格式
+ * @return 获取结果
+ * @param  fmtId 格式id
+ * @param  format 日志格式
+ */
+static bool GetFormat(uint32_t fmtId, BinaryLogFormat& format) {
+    std::lock_guard<std::mutex> lock(s_formatMutex);
+    if (0 == fmtId || fmtId > s_formats.size()) {
+        return false;
+    }
+
+    format = s_formats[fmtId - 1];
+    return true;
+}
+
+/**
+ * @note  仅在后台写线程中访问
+ * @brief 二进制日志输出
+ */
+class BinaryLogSink : public Noncopyable {
+public:
+    static BinaryLogSink& Instance() {
+        static BinaryLogSink instance;
+        return instance;
+    }
+
+    ~BinaryLogSink() {
+        this->close();
+    }
+
+public:
+    /**
+     * @brief  打开输出
+     * @return 打开结果
+     * @param  mode 输出方式
+     * @param  path 二进制文件路径
+     */
+    bool open(BinaryLogMode_t mode, const std::string& path) {
+        this->close();
+        m_mode = mode;
+        m_isDefined.clear();
+        m_formats.clear();
+        if (BinaryLogMode_t::BinaryLogText == mode) {
+            return true;
+        }
+
+        m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (m_fd < 0) {
+            LOG_ERROR << "Binary log open error. path: " << path << " code: " << errno << ". msg: " << strerror(errno);
+            return false;
+        }
+
+        this->writeAll(BINARY_LOG_MAGIC, BINARY_LOG_MAGIC_SIZE);
+        return true;
+    }
+
+    /**
+     * @brief 关闭输出
+     */
+    void close() {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    /**
+     * @note  数据由完整的日志记录组成
+     * @brief 输出一批日志记录
+     * @param iov 日志数据段
+     * @param count 日志数据段数
+     */
+    void output(const struct iovec* iov, int count) {
+        m_records.clear();
+        for (int idx = 0; idx < count; ++idx) {
+            m_records.append(static_cast<const char*>(iov[idx].iov_base), iov[idx].iov_len);
+        }
+
+        m_output.clear();
+        const char* pos = m_records.data();
+        const char* end = pos + m_records.size();
+        while (pos + BINARY_LOG_HEAD_SIZE <= end) {
+            uint32_t size = 0;
+            uint32_t fmtId = 0;
+            memcpy(&size, pos, sizeof(size));
+            memcpy(&fmtId, pos + sizeof(size), sizeof(fmtId));
+            if (size < BINARY_LOG_HEAD_SIZE || pos + size > end) {
+                break;
+            }
+
+            const BinaryLogFormat* format = this->getFormat(fmtId);
+            if (nullptr != format) {
+                if (BinaryLogMode_t::BinaryLogText == m_mode) {
+                    FormatRecord(*format, pos + BINARY_LOG_HEAD_SIZE, size - BINARY_LOG_HEAD_SIZE, m_output);
+                }
+                else {
+                    this->defineFormat(fmtId, *format);
+                    m_output.append(pos, size);
+                }
+            }
+            pos += size;
+        }
+
+        if (m_output.empty()) {
+            return;
+        }
+
+        if (BinaryLogMode_t::BinaryLogText == m_mode) {
+            struct iovec text;
+            text.iov_base = const_cast<char*>(m_output.data());
+            text.iov_len = m_output.size();
+            Logger::OutputBatch(&text, 1);
+        }
+        else {
+            this->writeAll(m_output.data(), m_output.size());
+        }
+    }
+
+private:
+    BinaryLogSink() : m_mode(BinaryLogMode_t::BinaryLogText), m_fd(-1) {
+    }
+
+    /**
+     * @brief  获取日志格式，未缓存时从注册表中复制
+     * @return 日志格式，格式id无效时为nullptr
+     * @param  fmtId 格式id
+     */
+    const BinaryLogFormat* getFormat(uint32_t fmtId) {
+        if (0 == fmtId) {
+            return nullptr;
+        }
+
+        if (fmtId > m_formats.size()) {
+            std::lock_guard<std::mutex> lock(s_formatMutex);
+            m_formats = s_formats;
+        }
+        return fmtId > m_formats.size() ? nullptr : &m_formats[fmtId - 1];
+    }
+
+    /**
+     * @brief 格式首次出现时在其日志记录之前写入格式描述记录
+     * @param fmtId 格式id
+     * @param format 日志格式
+     */
+    void defineFormat(uint32_t fmtId, const BinaryLogFormat& format) {
+        if (fmtId < m_isDefined.size() && m_isDefined[fmtId]) {
+            return;
+        }
+
+        if (fmtId >= m_isDefined.size()) {
+            m_isDefined.resize(fmtId + 1, false);
+        }
+        m_isDefined[fmtId] = true;
+
+        auto level = static_cast<int32_t>(format.m_level);
+        auto line = static_cast<int32_t>(format.m_line);
+        auto fileLen = static_cast<uint32_t>(format.m_file.size());
+        auto fmtLen = static_cast<uint32_t>(format.m_fmt.size());
+        auto size = static_cast<uint32_t>(BINARY_LOG_HEAD_SIZE + sizeof(fmtId) + sizeof(level) + sizeof(line)
+            + sizeof(fileLen) + fileLen + sizeof(fmtLen) + fmtLen);
+        uint32_t defineId = BINARY_LOG_DEFINE_ID;
+
+        m_output.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        m_output.append(reinterpret_cast<const char*>(&defineId), sizeof(defineId));
+        m_output.append(reinterpret_cast<const char*>(&fmtId), sizeof(fmtId));
+        m_output.append(reinterpret_cast<const char*>(&level), sizeof(level));
+        m_output.append(reinterpret_cast<const char*>(&line), sizeof(line));
+        m_output.append(reinterpret_cast<const char*>(&fileLen), sizeof(fileLen));
+        m_output.append(format.m_file);
+        m_output.append(reinterpret_cast<const char*>(&fmtLen), sizeof(fmtLen));
+        m_output.append(format.m_fmt);
+    }
+
+    /**
+     * @brief 向二进制文件写入全部数据
+     * @param data 数据
+     * @param size 数据长度
+     */
+    void writeAll(const char* data, std::size_t size) {
+        while (m_fd >= 0 && size > 0) {
+            ssize_t n = ::write(m_fd, data, size);
+            if (n < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+                return;
+            }
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+    }
+
+private:
+    // 输出方式
+    BinaryLogMode_t m_mode;
+
+    // 二进制文件描述符
+    int m_fd;
+
+    // 各格式id是否已写入格式描述记录
+    std::vector<bool> m_isDefined;
+
+    // 已注册日志格式的缓存
+    std::vector<BinaryLogFormat> m_formats;
+
+    // 本批日志记录
+    std::string m_records;
+
+    // 本批输出数据
+    std::string m_output;
+};
+
+uint32_t BinaryLogger::RegisterFormat(LogLevel level, const char* file, int line, const char* fmt) {
+    BinaryLogFormat format;
+    format.m_level = level;
+    format.m_line = line;
+    format.m_file = nullptr == file ? "" : file;
+    format.m_fmt = nullptr == fmt ? "" : fmt;
+
+    std::lock_guard<std::mutex> lock(s_formatMutex);
+    s_formats.push_back(std::move(format));
+    return static_cast<uint32_t>(s_formats.size());
+}
+
+void BinaryLogger::Commit(const char* data, std::size_t size) {
+    auto& writer = AsyncLogWriter::BinaryInstance();
+    if (writer.isRunning()) {
+        writer.append(data, size);
+        return;
+    }
+
+    // 未启动时立即格式化
+    uint32_t fmtId = 0;
+    memcpy(&fmtId, data + sizeof(uint32_t), sizeof(fmtId));
+    BinaryLogFormat format;
+    if (GetFormat(fmtId, format)) {
+        std::string line;
+        FormatRecord(format, data + BINARY_LOG_HEAD_SIZE, size - BINARY_LOG_HEAD_SIZE, line);
+        Logger::Output(line);
+    }
+}
+
+bool BinaryLogger::Start(BinaryLogMode_t mode, const std::string& path, std::size_t ringSize, int flushIntervalMs, LogOverflow_t policy) {
+    // 先创建输出对象及日志文件，使其在后台写线程之后析构
+    auto& sink = BinaryLogSink::Instance();
+    Logger::InitOutput();
+
+    auto& writer = AsyncLogWriter::BinaryInstance();
+    if (writer.isRunning()) {
+        LOG_ERROR << "Binary log start error. already started.";
+        return false;
+    }
+
+    if (!sink.open(mode, path)) {
+        return false;
+    }
+
+    return writer.start(ringSize, flushIntervalMs, policy, [](const struct iovec* iov, int count) {
+        BinaryLogSink::Instance().output(iov, count);
+    });
+}
+
+void BinaryLogger::Stop() {
+    AsyncLogWriter::BinaryInstance().stop();
+    BinaryLogSink::Instance().close();
+}
+
+uint64_t BinaryLogger::GetDroppedCount() {
+    return AsyncLogWriter::BinaryInstance().getDroppedCount();
+}
+
+bool BinaryLogger::DecodeFile(const std::string& path, std::ostream& out, uint64_t& count) {
+    count = 0;
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < BINARY_LOG_MAGIC_SIZE || 0 != data.compare(0, BINARY_LOG_MAGIC_SIZE, BINARY_LOG_MAGIC)) {
+        return false;
+    }
+
+    std::vector<BinaryLogFormat> formats;
+    std::string line;
+    const char* pos = data.data() + BINARY_LOG_MAGIC_SIZE;
+    const char* end = data.data() + data.size();
+    while (pos + BINARY_LOG_HEAD_SIZE <= end) {
+        uint32_t size = 0;
+        uint32_t fmtId = 0;
+        memcpy(&size, pos, sizeof(size));
+        memcpy(&fmtId, pos + sizeof(size), sizeof(fmtId));
+        if (size < BINARY_LOG_HEAD_SIZE || pos + size > end) {
+            return false;
+        }
+
+        const char* recordPos = pos + BINARY_LOG_HEAD_SIZE;
+        const char* recordEnd = pos + size;
+        pos = recordEnd;
+
+        if (BINARY_LOG_DEFINE_ID == fmtId) {
+            uint32_t defineId = 0;
+            int32_t level = 0;
+            BinaryLogFormat format;
+            if (!ReadRaw(recordPos, recordEnd, defineId) || !ReadRaw(recordPos, recordEnd, level)
+                || !ReadRaw(recordPos, recordEnd, format.m_line) || !ReadString(recordPos, recordEnd, format.m_file)
+                || !ReadString(recordPos, recordEnd, format.m_fmt) || 0 == defineId) {
+                return false;
+            }
+
+            format.m_level = static_cast<LogLevel>(level);
+            if (defineId > formats.size()) {
+                formats.resize(defineId);
+            }
+            formats[defineId - 1] = std::move(format);
+            continue;
+        }
+
+        line.clear();
+        if (fmtId > formats.size()) {
+            line = "[UNKNOWN FORMAT " + std::to_string(fmtId) + "]\n";
+        }
+        else {
+            FormatRecord(formats[fmtId - 1], recordPos, recordEnd - recordPos, line);
+        }
+        out << line;
+        ++count;
+    }
+    return true;
+}
+
+} // namespace Utils
@@ -1,18 +1,39 @@
 #include <algorithm>
 #include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <unistd.h>
 #include <sys/uio.h>
+#include "Utils/Logger.h"
 #include "Utils/Socketop.h"
 #include "Utils/Buffer.h"
 
 namespace Utils {
 
 Buffer::Buffer(std::size_t initSize)
-    : m_buffer(BUFFER_PREPEND_SIZE + initSize), m_readIdx(BUFFER_PREPEND_SIZE), m_writeIdx(BUFFER_PREPEND_SIZE) {
+    : Buffer(nullptr, initSize) {
+}
+
+Buffer::Buffer(Memory::SlabPool::Ptr pool, std::size_t initSize)
+    : m_pool(std::move(pool)),
+      m_initSize(initSize),
+      m_data(nullptr),
+      m_capacity(0),
+      m_readIdx(BUFFER_PREPEND_SIZE),
+      m_writeIdx(BUFFER_PREPEND_SIZE) {
+}
+
+Buffer::~Buffer() {
+    if (nullptr != m_data) {
+        nullptr == m_pool ? ::free(m_data) : m_pool->freeMemory(m_data);
+    }
 }
 
 void Buffer::swap(Buffer& other) noexcept {
-    m_buffer.swap(other.m_buffer);
+    m_pool.swap(other.m_pool);
+    std::swap(m_initSize, other.m_initSize);
+    std::swap(m_data, other.m_data);
+    std::swap(m_capacity, other.m_capacity);
     std::swap(m_readIdx, other.m_readIdx);
     std::swap(m_writeIdx, other.m_writeIdx);
 }
@@ -20,28 +41,63 @@ void Buffer::swap(Buffer& other) noexcept {
 void Buffer::extend(std::size_t len) {
     std::size_t readable = this->readableBytes();
 
-    if (this->writableBytes() + this->prependableBytes() < len + BUFFER_PREPEND_SIZE) {
-        // 拷贝缓冲区原有数据
-        std::vector<uint8_t> newBuffer(m_buffer.size() + len);
-        std::copy_n(m_buffer.begin() + static_cast<int>(m_readIdx), readable, newBuffer.begin() + BUFFER_PREPEND_SIZE);
-
-        // 重置缓冲区
-        m_buffer = std::move(newBuffer);
-
+    if (nullptr == m_data) {
+        // 首次写入时申请存储空间
+        this->reallocate(std::max(BUFFER_PREPEND_SIZE + len, m_initSize));
+    }
+    else if (this->writableBytes() + this->prependableBytes() < len + BUFFER_PREPEND_SIZE) {
+        // 空间不足时按倍数扩容
+        this->reallocate(std::max(m_capacity * 2, BUFFER_PREPEND_SIZE + readable + len));
     }
     else {
         // 将可读数据拷贝到缓冲区前端
-        std::copy_n(m_buffer.begin() + static_cast<int>(m_readIdx), readable, m_buffer.begin() + BUFFER_PREPEND_SIZE);
+        std::memmove(m_data + BUFFER_PREPEND_SIZE, m_data + m_readIdx, readable);
+        m_readIdx = BUFFER_PREPEND_SIZE;
+        m_writeIdx = m_readIdx + readable;
     }
-
-    m_readIdx = BUFFER_PREPEND_SIZE;
-    m_writeIdx = m_readIdx + readable;
 }
 
 void Buffer::shrink(std::size_t len) {
-    Buffer other(BUFFER_PREPEND_SIZE + this->readableBytes() + len);
-    other.write(this->readBegin(), this->readableBytes());
-    this->swap(other);
+    if (nullptr == m_data || this->releaseIfEmpty()) {
+        return;
+    }
+
+    this->reallocate(BUFFER_PREPEND_SIZE + this->readableBytes() + len);
+}
+
+bool Buffer::releaseIfEmpty() {
+    if (nullptr == m_data || 0 != this->readableBytes()) {
+        return false;
+    }
+
+    nullptr == m_pool ? ::free(m_data) : m_pool->freeMemory(m_data);
+    m_data = nullptr;
+    m_capacity = 0;
+    m_readIdx = m_writeIdx = BUFFER_PREPEND_SIZE;
+    return true;
+}
+
+void Buffer::reallocate(std::size_t size) {
+    auto data = static_cast<uint8_t*>(nullptr == m_pool ? ::malloc(size) : m_pool->allocateMemory(size));
+    if (nullptr == data) {
+        LOG_FATAL << "Buffer reallocate error. allocate memory failed. size: " << size;
+        return;
+    }
+
+    // 内存池按规格分配，实际可用空间可能大于申请大小
+    std::size_t capacity = nullptr == m_pool ? size : Memory::SlabPool::GetBlockSize(data);
+
+    // 拷贝缓冲区原有数据
+    std::size_t readable = this->readableBytes();
+    if (nullptr != m_data) {
+        std::memcpy(data + BUFFER_PREPEND_SIZE, m_data + m_readIdx, readable);
+        nullptr == m_pool ? ::free(m_data) : m_pool->freeMemory(m_data);
+    }
+
+    m_data = data;
+    m_capacity = capacity;
+    m_readIdx = BUFFER_PREPEND_SIZE;
+    m_writeIdx = m_readIdx + readable;
 }
 
 const uint8_t* Buffer::peek(std::size_t& size) const {
@@ -59,6 +115,19 @@ void Buffer::read(std::vector<uint8_t>& buffer, std::size_t& len) {
     this->moveReadStartPos(len);
 }
 
+void Buffer::rebindPool(Memory::SlabPool::Ptr pool) {
+    if (pool == m_pool) {
+        return;
+    }
+
+    // 在新内存池中申请存储空间，交换后原存储空间随临时对象归还原内存池
+    Buffer other(std::move(pool), m_initSize);
+    if (this->readableBytes() > 0) {
+        other.write(this->readBegin(), this->readableBytes());
+    }
+    this->swap(other);
+}
+
 void Buffer::write(const uint8_t* data, std::size_t len) {
     this->ensureWritableBytes(len);
     std::copy_n(data, len, this->writeBegin());
@@ -88,8 +157,8 @@ ssize_t Buffer::readFd(int fd, int& err) {
     vec[0].iov_base = this->writeBegin();
     vec[0].iov_len = writable;
 
-    // 设置备用缓冲区
-    uint8_t backBuf[65536] = {0};
+    // 设置备用缓冲区，缓冲区未申请存储空间时数据全部读入备用缓冲区，再按实际读取大小拷贝
+    uint8_t backBuf[65536];
     constexpr std::size_t backBufSize = sizeof(backBuf);
     vec[1].iov_base = backBuf;
     vec[1].iov_len = backBufSize;
@@ -112,6 +181,39 @@ ssize_t Buffer::readFd(int fd, int& err) {
     return len;
 }
 
+ssize_t Buffer::readMsg(int fd, msghdr& msg, int& err) {
+    iovec vec[2] = {};
+
+    const std::size_t writable = this->writableBytes();
+    vec[0].iov_base = this->writeBegin();
+    vec[0].iov_len = writable;
+
+    uint8_t backBuf[65536];
+    constexpr std::size_t backBufSize = sizeof(backBuf);
+    vec[1].iov_base = backBuf;
+    vec[1].iov_len = backBufSize;
+
+    msg.msg_iov = vec;
+    msg.msg_iovlen = (writable < backBufSize) ? 2 : 1;
+
+    ssize_t len = Socketop::RecvMsg(fd, &msg);
+    msg.msg_iov = nullptr;
+    msg.msg_iovlen = 0;
+    if (-1 == len) {
+        err = errno;
+        return len;
+    }
+    else if (static_cast<std::size_t>(len) <= writable) {
+        this->moveWriteStartPos(len);
+    }
+    else {
+        this->moveWriteStartPos(writable);
+        this->write(backBuf, len - writable);
+    }
+
+    return len;
+}
+
 ssize_t Buffer::writeFd(int fd, int& err) {
     ssize_t len = Socketop::Write(fd, this->readBegin(), this->readableBytes());
     if (-1 == len) {
@@ -23,12 +23,21 @@ const static std::unordered_set<Event_t> ValidEvents = {
     Event_t::EvTypeWriteCloseError,
     Event_t::EvTypeAll};
 
-const static std::unordered_set<Event_t> ValidCbEvents = {
-    Event_t::EvTypeRead,
-    Event_t::EvTypeWrite,
-    Event_t::EvTypeClose,
-    Event_t::EvTypeError,
-    Event_t::EvTypeReadWrite};
+/**
+ * @brief  获取事件回调函数在回调数组中的索引
+ * @return 索引，不支持设置回调的事件类型返回-1
+ * @param  type 事件类型
+ */
+static int GetEventCbIdx(Event_t type) {
+    switch (type) {
+        case Event_t::EvTypeRead: return 0;
+        case Event_t::EvTypeWrite: return 1;
+        case Event_t::EvTypeClose: return 2;
+        case Event_t::EvTypeError: return 3;
+        case Event_t::EvTypeReadWrite: return 4;
+        default: return -1;
+    }
+}
 
 constexpr static int EvReadTypeCmp = static_cast<int>(Event_t::EvTypeRead);
 constexpr static int EvWriteTypeCmp = static_cast<int>(Event_t::EvTypeWrite);
@@ -136,8 +145,8 @@ bool Channel::handleEvent(Event_t type, Timestamp recvTime) {
     }
 
     /** 事件类型匹配则直接处理 */
-    auto evCbIter = m_evCbMap.find(type);
-    if (m_evCbMap.end() != evCbIter) {
+    int evCbIdx = GetEventCbIdx(type);
+    if (evCbIdx >= 0 && nullptr != m_evCbList[evCbIdx]) {
         return this->handleEventWithoutCheck(type, recvTime);
     }
 
@@ -173,7 +182,8 @@ bool Channel::handleEvent(Event_t type, Timestamp recvTime) {
 
 bool Channel::setEventCb(Event_t type, EventCb cb) {
     // 事件类型无效
-    if (ValidCbEvents.end() == ValidCbEvents.find(type)) {
+    int evCbIdx = GetEventCbIdx(type);
+    if (evCbIdx < 0) {
         LOG_ERROR << "Channel set event callback function error. support event type: "
             << "EvTypeRead | EvTypeWrite | EvTypeClose | EvTypeError | EvTypeReadWrite. "
             << "fd: " << m_fd << " event type: " << StringHelper::EventTypeToString(type);
@@ -187,7 +197,7 @@ bool Channel::setEventCb(Event_t type, EventCb cb) {
         return false;
     }
 
-    m_evCbMap[type] = std::move(cb);
+    m_evCbList[evCbIdx] = std::move(cb);
     return true;
 }
 
@@ -208,16 +218,16 @@ void Channel::setReadEnabled(bool enabled) {
 }
 
 bool Channel::handleEventWithoutCheck(Event_t type, Timestamp recvTime) {
-    auto evCbIter = m_evCbMap.find(type);
-    if (m_evCbMap.end() == evCbIter) {
+    int evCbIdx = GetEventCbIdx(type);
+    if (evCbIdx < 0 || nullptr == m_evCbList[evCbIdx]) {
         LOG_WARN << "Channel handle event warning. event callback function not regist. fd: "
             << m_fd << " event type: " << StringHelper::EventTypeToString(type);
         return false;
     }
 
     // 事件处理
-    LOG_INFO << "Channel handle event. fd: " << m_fd << " event type: " << StringHelper::EventTypeToString(type);
-    evCbIter->second(recvTime);
+    LOG_DEBUG << "Channel handle event. fd: " << m_fd << " event type: " << StringHelper::EventTypeToString(type);
+    m_evCbList[evCbIdx](recvTime);
     return true;
 }
 
@@ -0,0 +1,261 @@
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <pthread.h>
+#include <unordered_map>
+#include "Common/ConfigDef.h"
+#include "Utils/Logger.h"
+#include "Net/EventLoop.h"
+#include "Thread/ComputeThreadPool.h"
+
+namespace Thread {
+
+static uint64_t COMPUTE_THREAD_POOL_ID_KEY = 0;
+
+// 当前线程所属的计算线程池及其中的线程索引，非计算线程为空
+static thread_local ComputeThreadPool* t_currentPool = nullptr;
+static thread_local std::size_t t_workerIdx = 0;
+
+/**
+ * @brief 同一事件循环的待投递后续任务
+ */
+struct ContinuationBatch {
+    // 目标事件循环
+    Net::EventLoopWkPtr m_loop;
+
+    // 后续任务列表
+    std::shared_ptr<std::vector<ComputeThreadPool::Job>> m_jobs;
+};
+
+/**
+ * @brief  将后续任务批次投递到目标事件循环
+ * @return 投递结果
+ * @param  batch 后续任务批次
+ */
+static bool PostContinuationBatch(ContinuationBatch& batch) {
+    auto jobs = batch.m_jobs;
+    batch.m_jobs = std::make_shared<std::vector<ComputeThreadPool::Job>>();
+
+    auto loop = batch.m_loop.lock();
+    if (nullptr == loop) {
+        LOG_WARN << "Compute thread pool post continuation warning. event loop expired. dropped: " << jobs->size();
+        return false;
+    }
+
+    return loop->executeTaskInLoop([jobs]() {
+        for (const auto& job : *jobs) {
+            job();
+        }
+    });
+}
+
+ComputeThreadPool::ComputeThreadPool(unsigned int numThreads)
+    : m_id(COMPUTE_THD_POOL_PREFIX + std::to_string(++COMPUTE_THREAD_POOL_ID_KEY)),
+      m_nextIdx(0),
+      m_pendingJobs(0),
+      m_idleCount(0),
+      m_stealCount(0),
+      m_batchCount(0),
+      m_isStopped(false) {
+    if (0 == numThreads) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // 先创建全部任务队列，计算线程启动后即可相互窃取
+    for (unsigned int idx = 0; idx < numThreads; ++idx) {
+        m_queues.emplace_back(new WorkerQueue());
+    }
+
+    std::string poolIdx = std::to_string(COMPUTE_THREAD_POOL_ID_KEY);
+    for (unsigned int idx = 0; idx < numThreads; ++idx) {
+        m_threads.emplace_back(&ComputeThreadPool::workerMain, this, idx);
+
+        std::string name = (COMPUTE_THD_NAME_PREFIX + poolIdx + "_" + std::to_string(idx + 1)).substr(0, 15);
+        ::pthread_setname_np(m_threads.back().native_handle(), name.c_str());
+    }
+
+    LOG_DEBUG << "ComputeThreadPool construct. numThreads: " << numThreads << ". id: " << m_id;
+}
+
+ComputeThreadPool::~ComputeThreadPool() {
+    this->stop();
+    LOG_DEBUG << "ComputeThreadPool deconstruct. numThreads: " << m_threads.size() << ". id: " << m_id;
+}
+
+bool ComputeThreadPool::submit(const Job& job) {
+    if (nullptr == job) {
+        LOG_ERROR << "Compute thread pool submit error. job invalid. id: " << m_id;
+        return false;
+    }
+
+    ComputeJob computeJob;
+    computeJob.m_job = job;
+    return this->enqueue(std::move(computeJob));
+}
+
+bool ComputeThreadPool::submit(const Job& job, const Net::EventLoopWkPtr& loop, const Job& continuation) {
+    if (nullptr == job || nullptr == continuation || loop.expired()) {
+        LOG_ERROR << "Compute thread pool submit error. invalid input param. id: " << m_id;
+        return false;
+    }
+
+    ComputeJob computeJob;
+    computeJob.m_job = job;
+    computeJob.m_loop = loop;
+    computeJob.m_continuation = continuation;
+    return this->enqueue(std::move(computeJob));
+}
+
+void ComputeThreadPool::stop() {
+    if (this == t_currentPool) {
+        LOG_ERROR << "Compute thread pool stop error. can not stop in compute thread. id: " << m_id;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        m_isStopped = true;
+    }
+    m_idleCv.notify_all();
+
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+bool ComputeThreadPool::enqueue(ComputeJob&& job) {
+    // 停止后仅接受计算线程中提交的任务，保证已提交任务派生的任务能够执行完成
+    bool isWorker = this == t_currentPool;
+    if (m_isStopped && !isWorker) {
+        LOG_ERROR << "Compute thread pool submit error. pool stopped. id: " << m_id;
+        return false;
+    }
+
+    std::size_t idx = isWorker ? t_workerIdx : m_nextIdx.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    {
+        std::lock_guard<std::mutex> lock(m_queues[idx]->m_mutex);
+        m_queues[idx]->m_jobs.push_back(std::move(job));
+    }
+
+    // 先增加待执行任务数再检查空闲线程数，与空闲线程的检查顺序相反，避免遗漏唤醒
+    ++m_pendingJobs;
+    if (m_idleCount > 0) {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        m_idleCv.notify_one();
+    }
+    return true;
+}
+
+bool ComputeThreadPool::popLocal(std::size_t idx, ComputeJob& job) {
+    auto& queue = *m_queues[idx];
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+    if (queue.m_jobs.empty()) {
+        return false;
+    }
+
+    // 后进先出，最近提交的任务数据仍在缓存中
+    job = std::move(queue.m_jobs.back());
+    queue.m_jobs.pop_back();
+    --m_pendingJobs;
+    return true;
+}
+
+bool ComputeThreadPool::steal(std::size_t idx, ComputeJob& job) {
+    for (std::size_t offset = 1; offset < m_queues.size(); ++offset) {
+        auto& queue = *m_queues[(idx + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+        if (queue.m_jobs.empty()) {
+            continue;
+        }
+
+        // 从队首窃取最早提交的任务，减少与队列所有者的竞争
+        job = std::move(queue.m_jobs.front());
+        queue.m_jobs.pop_front();
+        --m_pendingJobs;
+        m_stealCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void ComputeThreadPool::workerMain(std::size_t idx) {
+    t_currentPool = this;
+    t_workerIdx = idx;
+
+    // 按目标事件循环合并的后续任务，及其中最早一个的缓存时间
+    std::unordered_map<Net::EventLoop*, ContinuationBatch> batches;
+    std::size_t cachedCount = 0;
+    auto cachedSince = std::chrono::steady_clock::now();
+    auto flushBatches = [this, &batches, &cachedCount]() {
+        for (auto& pair : batches) {
+            if (!pair.second.m_jobs->empty()) {
+                PostContinuationBatch(pair.second);
+                m_batchCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        cachedCount = 0;
+    };
+
+    while (true) {
+        ComputeJob job;
+        if (this->popLocal(idx, job) || this->steal(idx, job)) {
+            job.m_job();
+
+            // 缓存后续任务，达到批量上限时投递
+            auto loop = job.m_loop.lock();
+            if (nullptr != loop && nullptr != job.m_continuation) {
+                auto& batch = batches[loop.get()];
+                if (nullptr == batch.m_jobs) {
+                    batch.m_loop = loop;
+                    batch.m_jobs = std::make_shared<std::vector<Job>>();
+                }
+
+                if (0 == cachedCount++) {
+                    cachedSince = std::chrono::steady_clock::now();
+                }
+
+                batch.m_jobs->push_back(std::move(job.m_continuation));
+                if (batch.m_jobs->size() >= COMPUTE_CONTINUATION_BATCH_SIZE) {
+                    cachedCount -= batch.m_jobs->size();
+                    PostContinuationBatch(batch);
+                    m_batchCount.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            else if (nullptr != job.m_continuation) {
+                LOG_WARN << "Compute thread pool continuation warning. event loop expired. id: " << m_id;
+            }
+
+            // 仍有待执行任务且缓存未超时时继续执行，超时后先投递已缓存的后续任务，保证持续负载下的延迟上限
+            if (m_pendingJobs > 0) {
+                if (cachedCount > 0
+                    && std::chrono::steady_clock::now() - cachedSince >= std::chrono::microseconds(COMPUTE_CONTINUATION_BATCH_DELAY)) {
+                    flushBatches();
+                }
+                continue;
+            }
+        }
+
+        flushBatches();
+        batches.clear();
+
+        // 已停止且无待执行任务时退出
+        if (m_isStopped && 0 == m_pendingJobs) {
+            break;
+        }
+
+        // 等待新任务
+        std::unique_lock<std::mutex> lock(m_idleMutex);
+        ++m_idleCount;
+        m_idleCv.wait(lock, [this]() {
+            return m_pendingJobs > 0 || m_isStopped;
+        });
+        --m_idleCount;
+    }
+
+    t_currentPool = nullptr;
+}
+
+} // namespace Thread
\ No newline at end of file
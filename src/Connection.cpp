@@ -1,38 +1,45 @@
+#include <unistd.h>
 #include "Utils/Logger.h"
 #include "Utils/Socketop.h"
 #include "Net/Channel.h"
 #include "Net/EventLoop.h"
 #include "Net/Connection.h"
+#include "Net/TcpRelay.h"
 
 namespace Net {
 
 /** ---------------------------------------------- Connection ------------------------------------------------------ */
 
+static std::atomic<ConnectionId> ConnectionIdCounter{0};
+
+/**
+ * @brief  获取事件循环的slab内存池
+ * @return slab内存池，事件循环无效时返回空
+ * @param  loop 事件循环对象弱引用
+ */
+static Memory::SlabPool::Ptr GetLoopSlabPool(const EventLoopWkPtr& loop) {
+    auto strongLoop = loop.lock();
+    return nullptr == strongLoop ? nullptr : strongLoop->getSlabPool();
+}
+
 Connection::Connection(const EventLoopWkPtr& loop, const Socket::Ptr& sock)
-    : m_sock(sock),
+    : m_connId(++ConnectionIdCounter),
+      m_sock(sock),
+      m_inBuf(GetLoopSlabPool(loop)),
+      m_outBuf(GetLoopSlabPool(loop)),
       m_channel(nullptr),
       m_ownerLoop(loop),
-      m_connState(ConnState_t::ConnStateClosed) {
+      m_closeTimerId(0),
+      m_hasCloseTimer(false),
+      m_connState(ConnState_t::ConnStateClosed),
+      m_readBytes(0),
+      m_writtenBytes(0),
+      m_eventCount(0) {
 
     if (loop.expired() || nullptr == sock || (nullptr != sock && (!sock->isLocalAddrValid() || !sock->isRemoteAddrValid()))) {
         LOG_FATAL << "Connection construct error. invalid input param.";
     }
 
-    // 创建id
-    std::string localIp;
-    uint16_t localPort;
-    sock->getLocalAddr()->getIpPort(localIp, localPort);
-
-    std::string remoteIp;
-    uint16_t remotePort;
-    sock->getRemoteAddr()->getIpPort(remoteIp, remotePort);
-
-    m_connId = StringHelper::GetUniqueId(localIp, localPort, remoteIp, remotePort);
-
-    // 创建输入输出缓冲区
-    m_inBuf = std::make_shared<Buffer>();
-    m_outBuf = std::make_shared<Buffer>();
-
     // 设置默认回调函数
     m_connCb = [](const Connection::Ptr& conn, bool isConn) {
         LOG_WARN << "Connection connect callback function not regist. " << conn->getConnectionInfo();
@@ -50,43 +57,55 @@ bool Connection::open() {
         return true;
     }
 
-    // 创建channel
-    m_channel = std::make_shared<Channel>(m_ownerLoop, m_sock->getFd());
+    // 创建并打开channel
+    m_channel = this->createChannel();
+    if (!m_channel->open(Event_t::EvTypeRead)) {
+        LOG_ERROR << "Connection open error. open channel failed. " << this->getConnectionInfo();
+        return false;
+    }
+
+    m_connState.store(ConnState_t::ConnStateConnected);
+
+    // 执行连接建立回调函数，回调中可能重新设置回调函数，因此通过副本调用
+    if (nullptr != m_connCb) {
+        auto connCb = m_connCb;
+        connCb(this->shared_from_this(), true);
+    }
+    return true;
+}
+
+ChannelPtr Connection::createChannel() {
+    // 与连接对象一样从所属事件循环的slab内存池中分配
+    auto ownerLoop = this->getOwnerLoop();
+    auto loop = ownerLoop.lock();
+    auto channel = std::allocate_shared<Channel>(Memory::SlabAllocator<Channel>(loop->getSlabPool()), ownerLoop, m_sock->getFd());
 
     // 设置channel事件回调
     auto weakSelf = this->weak_from_this();
-    m_channel->setEventCb(Event_t::EvTypeRead, [weakSelf](Timestamp recvTime) {
+    channel->setEventCb(Event_t::EvTypeRead, [weakSelf](Timestamp recvTime) {
         if (!weakSelf.expired()) {
             weakSelf.lock()->handleRead(recvTime);
         }
     });
 
-    m_channel->setEventCb(Event_t::EvTypeWrite, [weakSelf](Timestamp recvTime) {
+    channel->setEventCb(Event_t::EvTypeWrite, [weakSelf](Timestamp recvTime) {
         if (!weakSelf.expired()) {
             weakSelf.lock()->handleWrite(recvTime);
         }
     });
 
-    m_channel->setEventCb(Event_t::EvTypeClose, [weakSelf](Timestamp recvTime) {
+    channel->setEventCb(Event_t::EvTypeClose, [weakSelf](Timestamp recvTime) {
         if (!weakSelf.expired()) {
             weakSelf.lock()->handleClose(recvTime);
         }
     });
 
-    m_channel->setEventCb(Event_t::EvTypeError, [weakSelf](Timestamp recvTime) {
+    channel->setEventCb(Event_t::EvTypeError, [weakSelf](Timestamp recvTime) {
         if (!weakSelf.expired()) {
             weakSelf.lock()->handleError(recvTime);
         }
     });
-
-    // 打开channel
-    if (!m_channel->open(Event_t::EvTypeRead)) {
-        LOG_ERROR << "Connection open error. open channel failed. " << this->getConnectionInfo();
-        return false;
-    }
-
-    m_connState.store(ConnState_t::ConnStateConnected);
-    return true;
+    return channel;
 }
 
 bool Connection::reconnect() {
@@ -97,8 +116,8 @@ bool Connection::reconnect() {
     }
 
     // 执行连接建立回调函数
-    if (nullptr != m_connCb && !m_ownerLoop.expired()) {
-        auto loop = m_ownerLoop.lock();
+    auto loop = this->getOwnerLoop().lock();
+    if (nullptr != m_connCb && nullptr != loop) {
         if (loop->isInCurrentThread()) {
             m_connCb(this->shared_from_this(), true);
         }
@@ -130,8 +149,8 @@ bool Connection::disconnect() {
     }
 
     // 执行连接断开回调函数
-    if (nullptr != m_connCb && !m_ownerLoop.expired()) {
-        auto loop = m_ownerLoop.lock();
+    auto loop = this->getOwnerLoop().lock();
+    if (nullptr != m_connCb && nullptr != loop) {
         if (loop->isInCurrentThread()) {
             m_connCb(this->shared_from_this(), false);
         }
@@ -156,26 +175,25 @@ bool Connection::close(double delay) {
         return true;
     }
 
-    auto ownerLoop = m_ownerLoop.lock();
+    auto ownerLoop = this->getOwnerLoop().lock();
     if (delay > 0) {
-        TimerId timerId;
-        auto strongSelf = this->shared_from_this();
-        ownerLoop->addTimerAfterSpecificTime(timerId, [strongSelf]() {
-            strongSelf->m_connState = ConnState_t::ConnStateClosed;
-            strongSelf->m_channel->close();
-        }, delay);
+        auto expires = std::chrono::system_clock::now()
+            + std::chrono::duration_cast<Timestamp::duration>(std::chrono::duration<double>(delay));
+        return this->armCloseTimer(ownerLoop, expires);
     }
     else {
         if (!ownerLoop->isInCurrentThread()) {
             auto strongSelf = this->shared_from_this();
             ownerLoop->executeTaskInLoop([strongSelf]() {
-                strongSelf->m_connState = ConnState_t::ConnStateClosed;
-                strongSelf->m_channel->close();
+                strongSelf->close(0);
             });
         }
         else {
+            // 迁移途中channel已注销，目标事件循环中不再注册
             m_connState = ConnState_t::ConnStateClosed;
-            m_channel->close();
+            if (nullptr != m_channel) {
+                m_channel->close();
+            }
         }
     }
 
@@ -183,26 +201,31 @@ bool Connection::close(double delay) {
 }
 
 bool Connection::send(const void* data, std::size_t size) {
+    if (ConnState_t::ConnStateMigrating == m_connState && this->bufferWhileMigrating(data, size)) {
+        return true;
+    }
+
     if (ConnState_t::ConnStateConnected != m_connState) {
         // 连接未打开
         LOG_ERROR << "Connection write data error. connection not connected. " << this->getConnectionInfo();
         return false;
     }
 
-    std::size_t writeSize = 0;
+    ssize_t writeSize = 0;
     std::size_t remainSize = size;
-    std::size_t cachedSize = m_outBuf->readableBytes();
+    std::size_t cachedSize = m_outBuf.readableBytes();
 
     // 写事件未打开，且输出缓冲区为空，直接写数据
     if (!m_channel->writeEnabled() && 0 == cachedSize) {
         writeSize = Socketop::Write(m_sock->getFd(), data, size);
         if (writeSize > 0) {
             // 写入成功, 调用回调函数
+            this->addTraffic(0, writeSize, 0);
             remainSize -= writeSize;
             if (0 == remainSize && nullptr != m_writeCb) {
                 if (nullptr != m_writeCb) {
                     auto weakSelf = this->weak_from_this();
-                    m_ownerLoop.lock()->executeTask([weakSelf]() {
+                    this->getOwnerLoop().lock()->executeTask([weakSelf]() {
                         if (!weakSelf.expired()) {
                             auto strongSelf = weakSelf.lock();
                             strongSelf->m_writeCb(strongSelf);
@@ -234,7 +257,7 @@ bool Connection::send(const void* data, std::size_t size) {
     }
 
     // 数据写入缓存
-    m_outBuf->write(static_cast<const uint8_t*>(data) + writeSize, size);
+    m_outBuf.write(static_cast<const uint8_t*>(data) + writeSize, remainSize);
     if (!m_channel->writeEnabled()) {
         m_channel->setWriteEnabled(true);
     }
@@ -248,7 +271,7 @@ std::string Connection::getConnectionInfo() const {
     }
 
     std::stringstream ss;
-    ss << "fd: " << m_sock->getFd() << " local addr: " << m_sock->getLocalAddr()->printIpPort()
+    ss << "id: " << m_connId << " fd: " << m_sock->getFd() << " local addr: " << m_sock->getLocalAddr()->printIpPort()
        << " remote addr: " << m_sock->getRemoteAddr()->printIpPort();
     return ss.str();
 }
@@ -264,18 +287,7 @@ bool Connection::enableRead() {
         return true;
     }
 
-    auto loop = m_ownerLoop.lock();
-    if (loop->isInCurrentThread()) {
-        m_channel->setReadEnabled(true);
-    }
-    else {
-        auto weakSelf = this->weak_from_this();
-        loop->executeTaskInLoop([weakSelf]() {
-            if (!weakSelf.expired()) {
-                weakSelf.lock()->m_channel->setReadEnabled(true);
-            }
-        });
-    }
+    this->updateReadEnabled(true);
 
     return true;
 }
@@ -291,33 +303,73 @@ bool Connection::disableRead() {
         return true;
     }
 
-    auto loop = m_ownerLoop.lock();
-    if (loop->isInCurrentThread()) {
-        m_channel->setReadEnabled(false);
-    }
-    else {
-        auto weakSelf = this->weak_from_this();
-        loop->executeTaskInLoop([weakSelf]() {
-            if (!weakSelf.expired()) {
-                weakSelf.lock()->m_channel->setReadEnabled(false);
-            }
-        });
+    this->updateReadEnabled(false);
+    return true;
+}
+
+bool Connection::bufferWhileMigrating(const void* data, std::size_t size) {
+    std::lock_guard<std::mutex> lock(m_loopMutex);
+    if (ConnState_t::ConnStateMigrating != m_connState) {
+        return false;
     }
+
+    m_outBuf.write(static_cast<const uint8_t*>(data), size);
     return true;
 }
 
+bool Connection::armCloseTimer(const EventLoopPtr& loop, Timestamp expires) {
+    // 到期时按连接当前所属事件循环关闭；持锁设置，其他线程中设置时定时器回调等待记录完成
+    auto strongSelf = this->shared_from_this();
+    std::lock_guard<std::mutex> lock(m_loopMutex);
+    m_hasCloseTimer = loop->addTimerAtSpecificTime(m_closeTimerId, [strongSelf]() {
+        {
+            std::lock_guard<std::mutex> lock(strongSelf->m_loopMutex);
+            strongSelf->m_hasCloseTimer = false;
+        }
+        strongSelf->close(0);
+    }, expires);
+    m_closeExpires = expires;
+    return m_hasCloseTimer;
+}
+
+void Connection::updateReadEnabled(bool enabled) {
+    auto loop = this->getOwnerLoop().lock();
+    if (nullptr == loop) {
+        return;
+    }
+
+    if (loop->isInCurrentThread()) {
+        // 迁移途中channel已注销，关闭后不再处理
+        if (ConnState_t::ConnStateConnected == m_connState && nullptr != m_channel) {
+            m_channel->setReadEnabled(enabled);
+        }
+        return;
+    }
+
+    auto weakSelf = this->weak_from_this();
+    loop->executeTaskInLoop([weakSelf, enabled]() {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->updateReadEnabled(enabled);
+        }
+    });
+}
+
 /** ---------------------------------------------- TcpConnection ------------------------------------------------------ */
 
 TcpConnection::TcpConnection(const EventLoopWkPtr& loop, const Socket::Ptr& sock)
     : Connection(loop, sock),
+      m_isMigrating(false),
       m_highWaterMark(64 * 1024 * 1024) {
 
-    if (Socket_t::TCP != m_sock->getType()) {
+    if (Socket_t::UDP == m_sock->getType()) {
         LOG_FATAL << "TcpConnection construct error. invalid socket type. fd: " << m_sock->getFd();
     }
 
-    // 设置tcp socket属性
-    m_sock->setKeepaliveEnabled(true);
+    // 设置tcp socket属性，Unix域套接字不支持keepalive
+    if (Addr_t::Unix != m_sock->getLocalAddr()->getAddrType()) {
+        m_sock->setKeepaliveEnabled(true);
+    }
     LOG_DEBUG << "TcpConnection construct. " << this->getConnectionInfo();
 }
 
@@ -325,27 +377,40 @@ TcpConnection::~TcpConnection() {
     LOG_DEBUG << "TcpConnection deconstruct. " << this->getConnectionInfo();
 }
 
+TcpConnection::Ptr TcpConnection::Create(const EventLoopWkPtr& loop, const Socket::Ptr& sock) {
+    auto slabPool = GetLoopSlabPool(loop);
+    if (Addr_t::Unix == sock->getLocalAddr()->getAddrType()) {
+        return std::allocate_shared<UnixConnection>(Memory::SlabAllocator<UnixConnection>(slabPool), loop, sock);
+    }
+    return std::allocate_shared<TcpConnection>(Memory::SlabAllocator<TcpConnection>(slabPool), loop, sock);
+}
+
 bool TcpConnection::send(const void* data, std::size_t size) {
+    if (ConnState_t::ConnStateMigrating == m_connState && this->bufferWhileMigrating(data, size)) {
+        return true;
+    }
+
     if (ConnState_t::ConnStateConnected != m_connState) {
         // 连接未打开
         LOG_ERROR << "Connection write data error. connection not connected. " << this->getConnectionInfo();
         return false;
     }
 
-    std::size_t writeSize = 0;
+    ssize_t writeSize = 0;
     std::size_t remainSize = size;
-    std::size_t cachedSize = m_outBuf->readableBytes();
+    std::size_t cachedSize = m_outBuf.readableBytes();
 
     // 写事件未打开，且输出缓冲区为空，直接写数据
     if (!m_channel->writeEnabled() && 0 == cachedSize) {
         writeSize = Socketop::Write(m_sock->getFd(), data, size);
         if (writeSize > 0) {
+            this->addTraffic(0, writeSize, 0);
             remainSize -= writeSize;
             if (0 == remainSize) {
                 // 写入成功, 调用回调函数
                 if (nullptr != m_writeCb) {
                     auto weakSelf = this->weak_from_this();
-                    m_ownerLoop.lock()->executeTask([weakSelf]() {
+                    this->getOwnerLoop().lock()->executeTask([weakSelf]() {
                         if (!weakSelf.expired()) {
                             auto strongSelf = std::dynamic_pointer_cast<TcpConnection>(weakSelf.lock());
                             strongSelf->m_writeCb(strongSelf);
@@ -379,7 +444,7 @@ bool TcpConnection::send(const void* data, std::size_t size) {
     auto waitWriteSize = cachedSize + remainSize;
     if (waitWriteSize >= m_highWaterMark && cachedSize < m_highWaterMark && nullptr != m_highWaterMarkCb) {
         auto weakSelf = this->weak_from_this();
-        m_ownerLoop.lock()->executeTask([weakSelf, waitWriteSize]() {
+        this->getOwnerLoop().lock()->executeTask([weakSelf, waitWriteSize]() {
             if (!weakSelf.expired()) {
                 auto strongSelf = std::dynamic_pointer_cast<TcpConnection>(weakSelf.lock());
                 strongSelf->m_highWaterMarkCb(strongSelf, waitWriteSize);
@@ -388,7 +453,7 @@ bool TcpConnection::send(const void* data, std::size_t size) {
     }
 
     // 剩余未写入数据写入缓存
-    m_outBuf->write(static_cast<const uint8_t*>(data) + writeSize, size);
+    m_outBuf.write(static_cast<const uint8_t*>(data) + writeSize, remainSize);
     if (!m_channel->writeEnabled()) {
         m_channel->setWriteEnabled(true);
     }
@@ -415,7 +480,7 @@ bool TcpConnection::shutdown() {
         }
     };
 
-    auto loop = m_ownerLoop.lock();
+    auto loop = this->getOwnerLoop().lock();
     if (loop->isInCurrentThread()) {
         shutdownCb();
     }
@@ -429,13 +494,129 @@ bool TcpConnection::shutdown() {
     return true;
 }
 
+bool TcpConnection::migrate(const EventLoopWkPtr& dstLoop, const MigrateCb& cb) {
+    auto srcLoop = this->getOwnerLoop().lock();
+    auto loop = dstLoop.lock();
+    if (nullptr == srcLoop || nullptr == loop || srcLoop == loop || !srcLoop->isInCurrentThread()) {
+        LOG_ERROR << "TcpConnection migrate error. invalid event loop or not in owner loop thread. " << this->getConnectionInfo();
+        return false;
+    }
+
+    if (ConnState_t::ConnStateConnected != m_connState || nullptr != m_relay || m_isMigrating) {
+        LOG_ERROR << "TcpConnection migrate error. connection not connected, relaying or migrating. " << this->getConnectionInfo();
+        return false;
+    }
+
+    // 排在已投递的任务之后注销，保证这些任务仍在原事件循环中执行
+    m_isMigrating = true;
+    auto strongSelf = std::dynamic_pointer_cast<TcpConnection>(this->shared_from_this());
+    srcLoop->executeTaskInLoop([strongSelf, dstLoop, cb]() {
+        strongSelf->detachFromLoop(dstLoop, cb);
+    });
+    return true;
+}
+
+void TcpConnection::detachFromLoop(const EventLoopWkPtr& dstLoop, const MigrateCb& cb) {
+    auto strongSelf = std::dynamic_pointer_cast<TcpConnection>(this->shared_from_this());
+    auto loop = dstLoop.lock();
+
+    // 排队期间连接可能已关闭或开始转发
+    if (ConnState_t::ConnStateConnected != m_connState || nullptr != m_relay || nullptr == loop) {
+        LOG_WARN << "TcpConnection migrate warning. connection state changed before detach. " << this->getConnectionInfo();
+        m_isMigrating = false;
+        if (nullptr != cb) {
+            cb(strongSelf, false);
+        }
+        return;
+    }
+
+    // 注销后原事件循环不再处理该连接的事件，套接字保持打开；未到期的延迟关闭定时器在目标事件循环中重新设置
+    Event_t evType = m_channel->getEvType();
+    m_channel->close();
+    m_channel = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_loopMutex);
+        if (m_hasCloseTimer) {
+            m_ownerLoop.lock()->delTimer(m_closeTimerId);
+        }
+        m_connState = ConnState_t::ConnStateMigrating;
+        m_ownerLoop = dstLoop;
+    }
+
+    loop->executeTaskInLoop([strongSelf, evType, cb]() {
+        strongSelf->attachToLoop(evType, cb);
+    });
+}
+
+void TcpConnection::attachToLoop(Event_t evType, const MigrateCb& cb) {
+    auto strongSelf = std::dynamic_pointer_cast<TcpConnection>(this->shared_from_this());
+    m_isMigrating = false;
+
+    // 迁移途中连接已被关闭
+    if (ConnState_t::ConnStateMigrating != m_connState) {
+        LOG_WARN << "TcpConnection migrate warning. connection closed during migration. " << this->getConnectionInfo();
+        if (nullptr != cb) {
+            cb(strongSelf, false);
+        }
+        return;
+    }
+
+    // 内核中未读取的数据在重新注册后触发可读事件
+    auto loop = this->getOwnerLoop().lock();
+    m_channel = this->createChannel();
+    if (!m_channel->open(evType)) {
+        LOG_ERROR << "TcpConnection migrate error. open channel failed. " << this->getConnectionInfo();
+        m_connState = ConnState_t::ConnStateError;
+        if (nullptr != cb) {
+            cb(strongSelf, false);
+        }
+        this->handleClose(std::chrono::system_clock::now());
+        return;
+    }
+
+    bool hasCloseTimer = false;
+    Timestamp closeExpires;
+    {
+        // 缓冲区存储迁移到目标事件循环的内存池，后续申请与释放均在本线程中复用
+        std::lock_guard<std::mutex> lock(m_loopMutex);
+        m_inBuf.rebindPool(loop->getSlabPool());
+        m_outBuf.rebindPool(loop->getSlabPool());
+
+        // 写出迁移期间暂存的数据
+        if (0 != m_outBuf.readableBytes() && !m_channel->writeEnabled()) {
+            m_channel->setWriteEnabled(true);
+        }
+        m_connState = ConnState_t::ConnStateConnected;
+        hasCloseTimer = m_hasCloseTimer;
+        closeExpires = m_closeExpires;
+    }
+
+    if (hasCloseTimer) {
+        this->armCloseTimer(loop, closeExpires);
+    }
+    LOG_DEBUG << "TcpConnection migrate success. " << this->getConnectionInfo();
+    if (nullptr != cb) {
+        cb(strongSelf, true);
+    }
+}
+
 void TcpConnection::handleRead(Timestamp recvTime) {
+    // 转发期间由转发对象读取数据
+    if (nullptr != m_relay) {
+        auto relay = m_relay;
+        relay->handleRead(std::dynamic_pointer_cast<TcpConnection>(this->shared_from_this()));
+        return;
+    }
+
     int errCode = 0;
-    auto readSize= m_inBuf->readFd(m_sock->getFd(), errCode);
+    auto readSize= m_inBuf.readFd(m_sock->getFd(), errCode);
 
     if (readSize > 0) {
-        // 调用读回调函数
-        m_readCb(this->shared_from_this(), m_inBuf, recvTime);
+        this->addTraffic(readSize, 0, 1);
+
+        // 调用读回调函数，数据处理完后归还输入缓冲区存储空间
+        m_readCb(this->shared_from_this(), this->getInputBuffer(), recvTime);
+        m_inBuf.releaseIfEmpty();
     }
     else if (0 == readSize) {
         // 读到0字节，对端关闭连接
@@ -455,17 +636,27 @@ void TcpConnection::handleWrite(Timestamp recvTime) {
         return;
     }
 
+    // 输出缓冲区为空时，写事件由转发对象开启
+    if (nullptr != m_relay && 0 == m_outBuf.readableBytes()) {
+        auto relay = m_relay;
+        relay->handleWrite(std::dynamic_pointer_cast<TcpConnection>(this->shared_from_this()));
+        return;
+    }
+
     int errCode = 0;
-    ssize_t writeSize = m_outBuf->writeFd(m_sock->getFd(), errCode);
+    ssize_t writeSize = m_outBuf.writeFd(m_sock->getFd(), errCode);
     if (writeSize > 0) {
-        if (0 == m_outBuf->readableBytes()) {
-            // 写完数据后，关闭写事件
+        this->addTraffic(0, writeSize, 1);
+
+        if (0 == m_outBuf.readableBytes()) {
+            // 写完数据后，关闭写事件并归还输出缓冲区存储空间
             m_channel->setWriteEnabled(false);
+            m_outBuf.releaseIfEmpty();
 
             // 调用写回调函数
             if (nullptr != m_writeCb) {
                 auto weakSelf = this->weak_from_this();
-                m_ownerLoop.lock()->executeTask([weakSelf]() {
+                this->getOwnerLoop().lock()->executeTask([weakSelf]() {
                     if (!weakSelf.expired()) {
                         auto strongSelf = std::dynamic_pointer_cast<TcpConnection>(weakSelf.lock());
                         strongSelf->m_writeCb(strongSelf);
@@ -477,13 +668,26 @@ void TcpConnection::handleWrite(Timestamp recvTime) {
             if (ConnState_t::ConnStateDisconnected == m_connState) {
                 m_sock->shutdown(SocketShutdown_t::ShutdownWrite);
             }
+
+            // 转发对象继续写出管道中的数据
+            if (nullptr != m_relay) {
+                auto relay = m_relay;
+                relay->handleWrite(std::dynamic_pointer_cast<TcpConnection>(this->shared_from_this()));
+            }
         }
     }
 }
 
 void TcpConnection::handleClose(Timestamp recvTime) {
+    // 解除转发关系，由转发对象处理另一端
+    if (nullptr != m_relay) {
+        auto relay = std::move(m_relay);
+        m_relay = nullptr;
+        relay->handleClose(std::dynamic_pointer_cast<TcpConnection>(this->shared_from_this()));
+    }
+
     auto weakSelf = this->weak_from_this();
-    m_ownerLoop.lock()->executeTask([weakSelf]() {
+    this->getOwnerLoop().lock()->executeTask([weakSelf]() {
         if (!weakSelf.expired()) {
             auto strongSelf = std::dynamic_pointer_cast<TcpConnection>(weakSelf.lock());
 
@@ -503,6 +707,141 @@ void TcpConnection::handleClose(Timestamp recvTime) {
 
 void TcpConnection::handleError(Timestamp recvTime) {
     LOG_ERROR << "TcpConnection handleError. " << this->getConnectionInfo() << " error: " << Socketop::GetSocketError(m_sock->getFd());
+
+    // 连接出错后不可再用，按关闭处理以通知上层回收连接
+    m_connState = ConnState_t::ConnStateError;
+    this->handleClose(recvTime);
+}
+
+/** ---------------------------------------------- UnixConnection ------------------------------------------------------ */
+
+UnixConnection::UnixConnection(const EventLoopWkPtr& loop, const Socket::Ptr& sock)
+    : TcpConnection(loop, sock) {
+    LOG_DEBUG << "UnixConnection construct. " << this->getConnectionInfo();
+}
+
+UnixConnection::~UnixConnection() {
+    // 关闭未被取出的文件描述符
+    for (int fd : m_recvFds) {
+        ::close(fd);
+    }
+
+    LOG_DEBUG << "UnixConnection deconstruct. " << this->getConnectionInfo();
+}
+
+bool UnixConnection::sendFds(const void* data, std::size_t size, const std::vector<int>& fds) {
+    if (ConnState_t::ConnStateConnected != m_connState) {
+        LOG_ERROR << "UnixConnection send fds error. connection not connected. " << this->getConnectionInfo();
+        return false;
+    }
+
+    if (nullptr == data || 0 == size || fds.empty() || fds.size() > UNIX_MAX_PASS_FDS) {
+        LOG_ERROR << "UnixConnection send fds error. invalid input param. " << this->getConnectionInfo();
+        return false;
+    }
+
+    // 输出缓冲区中仍有数据时，文件描述符会先于缓冲数据到达对端
+    if (m_channel->writeEnabled() || 0 != m_outBuf.readableBytes()) {
+        LOG_ERROR << "UnixConnection send fds error. output buffer not empty. " << this->getConnectionInfo();
+        return false;
+    }
+
+    char ctrl[CMSG_SPACE(sizeof(int) * UNIX_MAX_PASS_FDS)] = {};
+    iovec iov = {const_cast<void*>(data), size};
+    msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+
+    auto cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+    ::memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+
+    ssize_t writeSize = Socketop::SendMsg(m_sock->getFd(), &msg);
+    if (writeSize < 0) {
+        LOG_ERROR << "UnixConnection send fds error. errno: " << errno << ". error: " << strerror(errno) << " " << this->getConnectionInfo();
+        return false;
+    }
+
+    // 文件描述符已随首字节发送，剩余数据按普通数据发送
+    this->addTraffic(0, writeSize, 0);
+    if (static_cast<std::size_t>(writeSize) < size) {
+        return this->send(static_cast<const uint8_t*>(data) + writeSize, size - writeSize);
+    }
+
+    if (nullptr != m_writeCb) {
+        auto weakSelf = this->weak_from_this();
+        this->getOwnerLoop().lock()->executeTask([weakSelf]() {
+            if (!weakSelf.expired()) {
+                auto strongSelf = std::dynamic_pointer_cast<UnixConnection>(weakSelf.lock());
+                strongSelf->m_writeCb(strongSelf);
+            }
+        });
+    }
+    return true;
+}
+
+std::size_t UnixConnection::takeFds(std::vector<int>& fds) {
+    std::size_t count = m_recvFds.size();
+    fds.insert(fds.end(), m_recvFds.begin(), m_recvFds.end());
+    m_recvFds.clear();
+    return count;
+}
+
+void UnixConnection::handleRead(Timestamp recvTime) {
+    // 转发期间不传递文件描述符
+    if (nullptr != m_relay) {
+        TcpConnection::handleRead(recvTime);
+        return;
+    }
+
+    char ctrl[CMSG_SPACE(sizeof(int) * UNIX_MAX_PASS_FDS)] = {};
+    msghdr msg = {};
+    msg.msg_control = ctrl;
+    msg.msg_controllen = sizeof(ctrl);
+
+    int errCode = 0;
+    auto readSize = m_inBuf.readMsg(m_sock->getFd(), msg, errCode);
+
+    // 收集随数据到达的文件描述符
+    if (readSize >= 0) {
+        for (auto cmsg = CMSG_FIRSTHDR(&msg); nullptr != cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (SOL_SOCKET != cmsg->cmsg_level || SCM_RIGHTS != cmsg->cmsg_type) {
+                continue;
+            }
+
+            std::size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            for (std::size_t idx = 0; idx < count; ++idx) {
+                int fd = -1;
+                ::memcpy(&fd, CMSG_DATA(cmsg) + idx * sizeof(int), sizeof(int));
+                m_recvFds.push_back(fd);
+            }
+        }
+
+        if (0 != (msg.msg_flags & MSG_CTRUNC)) {
+            LOG_WARN << "UnixConnection handleRead warning. control message truncated, fds dropped. " << this->getConnectionInfo();
+        }
+        if (0 != (msg.msg_flags & MSG_TRUNC)) {
+            LOG_WARN << "UnixConnection handleRead warning. record truncated. " << this->getConnectionInfo();
+        }
+    }
+
+    if (readSize > 0) {
+        this->addTraffic(readSize, 0, 1);
+        m_readCb(this->shared_from_this(), this->getInputBuffer(), recvTime);
+        m_inBuf.releaseIfEmpty();
+    }
+    else if (0 == readSize) {
+        LOG_INFO << "Remote disconnect. " << this->getConnectionInfo();
+        this->handleClose(recvTime);
+    }
+    else if (EAGAIN != errCode && EWOULDBLOCK != errCode && EINTR != errCode) {
+        LOG_ERROR << "UnixConnection handleRead error. read failed. " << this->getConnectionInfo() << " error: " << errCode;
+        this->handleError(recvTime);
+    }
 }
 
 } // namespace Net
\ No newline at end of file
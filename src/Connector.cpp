@@ -0,0 +1,250 @@
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include "Common/ConfigDef.h"
+#include "Utils/Logger.h"
+#include "Utils/Socketop.h"
+#include "Net/Channel.h"
+#include "Net/EventLoop.h"
+#include "Net/Connector.h"
+
+namespace Net {
+
+TcpConnector::TcpConnector(EventLoopWkPtr loop, Address::Ptr peerAddr)
+    : m_ownerLoop(std::move(loop)),
+      m_peerAddr(std::move(peerAddr)),
+      m_isStarted(false),
+      m_state(ConnectorState_t::ConnectorDisconnected),
+      m_initRetryDelay(CONNECTOR_INIT_RETRY_DELAY),
+      m_maxRetryDelay(CONNECTOR_MAX_RETRY_DELAY),
+      m_retryDelay(CONNECTOR_INIT_RETRY_DELAY),
+      m_isRetryTimerSet(false),
+      m_retryTimerId(0),
+      m_retryCount(0) {
+    if (m_ownerLoop.expired() || nullptr == m_peerAddr || !m_peerAddr->valid()) {
+        LOG_FATAL << "TcpConnector construct error. invalid input param.";
+    }
+
+    LOG_DEBUG << "TcpConnector construct. peer addr: " << m_peerAddr->printIpPort();
+}
+
+TcpConnector::~TcpConnector() {
+    // 连接进行中时channel仍注册在事件循环中，需在事件循环线程中移除
+    auto loop = m_ownerLoop.lock();
+    if (nullptr != m_channel && nullptr != loop) {
+        ChannelPtr channel = m_channel;
+        Socket::Ptr sock = m_sock;
+        loop->executeTask([channel, sock]() {
+            channel->close();
+        });
+    }
+
+    LOG_DEBUG << "TcpConnector deconstruct. peer addr: " << m_peerAddr->printIpPort();
+}
+
+bool TcpConnector::start() {
+    auto loop = m_ownerLoop.lock();
+    if (nullptr == loop) {
+        LOG_ERROR << "TcpConnector start error. owner loop expired. peer addr: " << m_peerAddr->printIpPort();
+        return false;
+    }
+
+    m_isStarted = true;
+    auto weakSelf = this->weak_from_this();
+    return loop->executeTask([weakSelf]() {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->startInLoop();
+        }
+    });
+}
+
+bool TcpConnector::restart() {
+    auto loop = m_ownerLoop.lock();
+    if (nullptr == loop) {
+        LOG_ERROR << "TcpConnector restart error. owner loop expired. peer addr: " << m_peerAddr->printIpPort();
+        return false;
+    }
+
+    m_isStarted = true;
+    auto weakSelf = this->weak_from_this();
+    return loop->executeTask([weakSelf]() {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->stopInLoop();
+            strongSelf->m_retryDelay = strongSelf->m_initRetryDelay;
+            strongSelf->startInLoop();
+        }
+    });
+}
+
+void TcpConnector::stop() {
+    m_isStarted = false;
+
+    auto loop = m_ownerLoop.lock();
+    if (nullptr == loop) {
+        return;
+    }
+
+    auto weakSelf = this->weak_from_this();
+    loop->executeTask([weakSelf]() {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->stopInLoop();
+        }
+    });
+}
+
+void TcpConnector::startInLoop() {
+    if (!m_isStarted) {
+        return;
+    }
+
+    if (ConnectorState_t::ConnectorConnecting == m_state) {
+        LOG_WARN << "TcpConnector start warning. already connecting. peer addr: " << m_peerAddr->printIpPort();
+        return;
+    }
+
+    this->connect();
+}
+
+void TcpConnector::stopInLoop() {
+    // 取消重连定时器
+    if (m_isRetryTimerSet) {
+        m_ownerLoop.lock()->delTimer(m_retryTimerId);
+        m_isRetryTimerSet = false;
+    }
+
+    // 取消进行中的连接
+    if (ConnectorState_t::ConnectorConnecting == m_state) {
+        this->resetChannel();
+    }
+    m_state = ConnectorState_t::ConnectorDisconnected;
+}
+
+void TcpConnector::connect() {
+    int fd = -1;
+    if (!Socketop::CreateSocket(m_peerAddr->getAddrType(), Socket_t::TCP, true, fd)) {
+        int errCode = errno;
+        LOG_ERROR << "TcpConnector connect error. create socket failed. peer addr: " << m_peerAddr->printIpPort();
+        this->retry(errCode);
+        return;
+    }
+
+    auto sock = std::make_shared<Socket>(fd, Socket_t::TCP);
+    if (!sock->connect(m_peerAddr)) {
+        this->retry(errno);
+        return;
+    }
+
+    this->connecting(sock);
+}
+
+void TcpConnector::connecting(const Socket::Ptr& sock) {
+    m_state = ConnectorState_t::ConnectorConnecting;
+    m_sock = sock;
+    m_channel = std::make_shared<Channel>(m_ownerLoop, sock->getFd());
+
+    // 连接结果通过可写事件通知
+    auto weakSelf = this->weak_from_this();
+    m_channel->setEventCb(Event_t::EvTypeWrite, [weakSelf](Timestamp recvTime) {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->handleWrite(recvTime);
+        }
+    });
+
+    m_channel->setEventCb(Event_t::EvTypeError, [weakSelf](Timestamp recvTime) {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->handleError(recvTime);
+        }
+    });
+
+    if (!m_channel->open(Event_t::EvTypeWriteError)) {
+        LOG_ERROR << "TcpConnector connecting error. open channel failed. peer addr: " << m_peerAddr->printIpPort();
+        this->resetChannel();
+        this->retry(EIO);
+    }
+}
+
+Socket::Ptr TcpConnector::resetChannel() {
+    // channel在事件处理期间由事件循环持有，此处可直接释放
+    m_channel->close();
+    m_channel.reset();
+
+    Socket::Ptr sock = std::move(m_sock);
+    m_sock.reset();
+    return sock;
+}
+
+void TcpConnector::retry(int errCode) {
+    m_state = ConnectorState_t::ConnectorDisconnected;
+    if (m_isStarted && nullptr != m_failedCb) {
+        m_failedCb(errCode);
+    }
+
+    if (!m_isStarted) {
+        return;
+    }
+
+    // 指数退避，叠加随机抖动避免大量连接同时重连
+    int jitterPercent = RandomHelper::GetRandomAddr(-CONNECTOR_RETRY_JITTER_PERCENT, CONNECTOR_RETRY_JITTER_PERCENT);
+    double delay = m_retryDelay * (100 + jitterPercent) / 100.0;
+    m_retryDelay = std::min(m_retryDelay * 2, m_maxRetryDelay);
+    ++m_retryCount;
+
+    auto weakSelf = this->weak_from_this();
+    m_isRetryTimerSet = m_ownerLoop.lock()->addTimerAfterSpecificTime(m_retryTimerId, [weakSelf]() {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->m_isRetryTimerSet = false;
+            strongSelf->startInLoop();
+        }
+    }, delay);
+
+    LOG_INFO << "TcpConnector retry connect. peer addr: " << m_peerAddr->printIpPort() << " delay: " << delay << "s";
+}
+
+void TcpConnector::handleWrite(Timestamp recvTime) {
+    if (ConnectorState_t::ConnectorConnecting != m_state) {
+        return;
+    }
+
+    auto sock = this->resetChannel();
+    int errCode = Socketop::GetSocketError(sock->getFd());
+    if (0 != errCode) {
+        LOG_WARN << "TcpConnector connect failed. peer addr: " << m_peerAddr->printIpPort()
+            << " errno: " << errCode << ". error: " << strerror(errCode);
+        this->retry(errCode);
+        return;
+    }
+
+    // 获取本地地址，并排除本地端口与对端端口相同时的自连接
+    if (!sock->updateLocalAddr() || sock->printLocalAddr() == sock->printRemoteAddr()) {
+        LOG_WARN << "TcpConnector connect failed. invalid local address or self connect. peer addr: " << m_peerAddr->printIpPort();
+        this->retry(ECONNREFUSED);
+        return;
+    }
+
+    m_state = ConnectorState_t::ConnectorConnected;
+    m_retryDelay = m_initRetryDelay;
+
+    if (m_isStarted && nullptr != m_newConnCb) {
+        m_newConnCb(sock, recvTime);
+    }
+}
+
+void TcpConnector::handleError(Timestamp recvTime) {
+    if (ConnectorState_t::ConnectorConnecting != m_state) {
+        return;
+    }
+
+    auto sock = this->resetChannel();
+    int errCode = Socketop::GetSocketError(sock->getFd());
+    LOG_WARN << "TcpConnector handle error. peer addr: " << m_peerAddr->printIpPort()
+        << " errno: " << errCode << ". error: " << strerror(errCode);
+    this->retry(errCode);
+}
+
+} // namespace Net
\ No newline at end of file
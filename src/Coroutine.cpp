@@ -0,0 +1,293 @@
+#ifdef REACTOR_ENABLE_COROUTINE
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+#include "Utils/Logger.h"
+#include "Memory/SlabPool.h"
+#include "Net/Coroutine.h"
+
+namespace Net {
+
+// 协程帧前部保存所属内存池的区域大小，保持协程帧的对齐
+static constexpr std::size_t CO_FRAME_PREFIX_SIZE = alignof(std::max_align_t);
+static_assert(sizeof(Memory::SlabPool::Ptr) <= CO_FRAME_PREFIX_SIZE, "coroutine frame prefix too small");
+
+void* AllocateCoFrame(std::size_t size) {
+    Memory::SlabPool::Ptr pool;
+    auto loop = EventLoop::GetCurrentLoop();
+    if (nullptr != loop) {
+        pool = loop->getSlabPool();
+    }
+
+    void* mem = nullptr == pool ? ::malloc(CO_FRAME_PREFIX_SIZE + size) : pool->allocateMemory(CO_FRAME_PREFIX_SIZE + size);
+    if (nullptr == mem) {
+        LOG_ERROR << "Coroutine allocate frame error. size: " << size;
+        throw std::bad_alloc();
+    }
+
+    new (mem) Memory::SlabPool::Ptr(std::move(pool));
+    return static_cast<uint8_t*>(mem) + CO_FRAME_PREFIX_SIZE;
+}
+
+void FreeCoFrame(void* frame) {
+    if (nullptr == frame) {
+        return;
+    }
+
+    auto mem = static_cast<uint8_t*>(frame) - CO_FRAME_PREFIX_SIZE;
+    auto poolPtr = reinterpret_cast<Memory::SlabPool::Ptr*>(mem);
+    auto pool = std::move(*poolPtr);
+    poolPtr->~shared_ptr();
+
+    if (nullptr == pool) {
+        ::free(mem);
+    }
+    else {
+        pool->freeMemory(mem);
+    }
+}
+
+void ReportCoException(const std::exception_ptr& exception) {
+    try {
+        std::rethrow_exception(exception);
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "Coroutine detached error. unhandled exception: " << e.what();
+    }
+    catch (...) {
+        LOG_ERROR << "Coroutine detached error. unhandled unknown exception.";
+    }
+}
+
+/** ---------------------------------------------- CoStream ------------------------------------------------------------ */
+
+CoStream::Ptr CoStream::Create(const TcpConnection::Ptr& conn) {
+    if (nullptr == conn) {
+        LOG_ERROR << "CoStream create error. invalid connection.";
+        return nullptr;
+    }
+
+    auto loop = conn->getOwnerLoop().lock();
+    auto slabPool = nullptr == loop ? nullptr : loop->getSlabPool();
+    auto stream = std::allocate_shared<CoStream>(Memory::SlabAllocator<CoStream>(slabPool), conn);
+    stream->attach();
+    return stream;
+}
+
+CoStream::CoStream(const TcpConnection::Ptr& conn)
+    : m_conn(conn),
+      m_readSize(0),
+      m_isSending(false),
+      m_isWriteDone(false),
+      m_isClosed(ConnState_t::ConnStateConnected != conn->getConnState()) {
+}
+
+bool CoStream::shutdown() {
+    if (m_isClosed) {
+        return true;
+    }
+    return m_conn->shutdown();
+}
+
+void CoStream::attach() {
+    // 回调函数仅持有弱引用，协程化连接由等待中的协程持有
+    auto weakSelf = this->weak_from_this();
+
+    m_conn->setConnectCallback([weakSelf](const Connection::Ptr& conn, bool isConn) {
+        auto strongSelf = weakSelf.lock();
+        if (!isConn && nullptr != strongSelf) {
+            strongSelf->handleClose();
+        }
+    });
+
+    m_conn->setMessageCallback([weakSelf](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->handleMessage();
+        }
+        else {
+            buf->moveReadStartPos(buf->readableBytes());
+        }
+    });
+
+    m_conn->setWriteCompleteCallback([weakSelf](const Connection::Ptr& conn) {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->handleWriteComplete();
+        }
+    });
+}
+
+void CoStream::handleMessage() {
+    if (m_reader && this->isReadable(m_readSize)) {
+        auto reader = std::exchange(m_reader, nullptr);
+        reader.resume();
+    }
+}
+
+void CoStream::handleWriteComplete() {
+    if (!m_writer) {
+        return;
+    }
+
+    // send()中同步执行的写完成回调由写等待直接处理，不在send()调用栈中恢复协程
+    m_isWriteDone = true;
+    if (!m_isSending) {
+        auto writer = std::exchange(m_writer, nullptr);
+        writer.resume();
+    }
+}
+
+void CoStream::handleClose() {
+    if (m_isClosed) {
+        return;
+    }
+    m_isClosed = true;
+
+    // 先取出全部等待的协程，恢复的协程可能释放协程化连接
+    auto strongSelf = this->shared_from_this();
+    auto reader = std::exchange(m_reader, nullptr);
+    auto writer = m_isSending ? nullptr : std::exchange(m_writer, nullptr);
+
+    if (reader) {
+        reader.resume();
+    }
+
+    if (writer) {
+        writer.resume();
+    }
+}
+
+bool CoStream::isReadable(std::size_t size) const {
+    std::size_t readableBytes = m_conn->getInputBuffer()->readableBytes();
+    return 0 == size ? readableBytes > 0 : readableBytes >= size;
+}
+
+bool CoStream::ReadAwaiter::await_ready() {
+    return m_stream->m_isClosed || m_stream->isReadable(m_size);
+}
+
+bool CoStream::ReadAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    if (m_stream->m_reader) {
+        LOG_ERROR << "CoStream read error. another coroutine is reading. " << m_stream->m_conn->getConnectionInfo();
+        return false;
+    }
+
+    m_stream->m_reader = handle;
+    m_stream->m_readSize = m_size;
+    return true;
+}
+
+std::string CoStream::ReadAwaiter::await_resume() {
+    auto buf = m_stream->m_conn->getInputBuffer();
+    std::size_t readableBytes = buf->readableBytes();
+    std::size_t size = 0 == m_size ? readableBytes : m_size;
+    if (0 == size || readableBytes < size) {
+        return std::string();
+    }
+
+    std::string data(reinterpret_cast<const char*>(buf->readBegin()), size);
+    buf->moveReadStartPos(size);
+    return data;
+}
+
+bool CoStream::WriteAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    m_stream->m_isWriteDone = false;
+    if (m_stream->m_isClosed || m_stream->m_writer) {
+        LOG_ERROR << "CoStream write error. connection closed or another coroutine is writing. " << m_stream->m_conn->getConnectionInfo();
+        return false;
+    }
+
+    if (m_data.empty()) {
+        m_stream->m_isWriteDone = true;
+        return false;
+    }
+
+    m_stream->m_writer = handle;
+    m_stream->m_isSending = true;
+    bool result = m_stream->m_conn->send(m_data.data(), m_data.size());
+    m_stream->m_isSending = false;
+
+    // 发送失败、已全部写入或发送过程中连接断开时不挂起
+    if (!result || m_stream->m_isWriteDone || m_stream->m_isClosed) {
+        m_stream->m_writer = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool CoStream::WriteAwaiter::await_resume() const noexcept {
+    return m_stream->m_isWriteDone;
+}
+
+/** ---------------------------------------------- CoSleep / CoConnect ------------------------------------------------- */
+
+bool CoSleepAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    auto loop = m_loop.lock();
+    if (nullptr == loop) {
+        LOG_ERROR << "Coroutine sleep error. event loop expired.";
+        m_result = false;
+        return false;
+    }
+
+    TimerId timerId = 0;
+    m_result = loop->addTimerAfterSpecificTime(timerId, [handle]() {
+        handle.resume();
+    }, m_delay);
+    return m_result;
+}
+
+bool CoConnectAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    auto loop = m_loop.lock();
+    if (nullptr == loop || nullptr == m_peerAddr) {
+        LOG_ERROR << "Coroutine connect error. invalid input param.";
+        return false;
+    }
+
+    m_connector = std::make_shared<TcpConnector>(m_loop, m_peerAddr);
+    TcpConnector::WkPtr weakConnector = m_connector;
+    auto awaiter = this;
+
+    // 在连接器回调之外恢复协程，协程恢复后会释放连接器
+    m_connector->setNewConnCb([awaiter, handle, weakConnector](Socket::Ptr& connSock, Timestamp recvTime) {
+        auto conn = TcpConnection::Create(awaiter->m_loop, connSock);
+        conn->setConnectCallback([](const Connection::Ptr& conn, bool isConn) {});
+        if (conn->open()) {
+            awaiter->m_conn = conn;
+        }
+        else {
+            LOG_ERROR << "Coroutine connect error. open connection failed. " << conn->getConnectionInfo();
+        }
+
+        auto loop = awaiter->m_loop.lock();
+        auto connector = weakConnector.lock();
+        loop->executeTaskInLoop([handle, connector]() {
+            handle.resume();
+        });
+    });
+
+    m_connector->setFailedCb([awaiter, handle, weakConnector](int errCode) {
+        LOG_ERROR << "Coroutine connect error. peer: " << awaiter->m_peerAddr->printIpPort() << " errno: " << errCode;
+
+        auto connector = weakConnector.lock();
+        if (nullptr != connector) {
+            connector->stop();
+        }
+
+        auto loop = awaiter->m_loop.lock();
+        loop->executeTaskInLoop([handle, connector]() {
+            handle.resume();
+        });
+    });
+
+    if (!m_connector->start()) {
+        LOG_ERROR << "Coroutine connect error. start connector failed. peer: " << m_peerAddr->printIpPort();
+        m_connector = nullptr;
+        return false;
+    }
+    return true;
+}
+
+} // namespace Net
+
+#endif // REACTOR_ENABLE_COROUTINE
\ No newline at end of file
@@ -42,9 +42,11 @@ Timestamp EpPoller::poll(int timeoutMs, ChannelWrapperList& activeChannels, int&
         }
     }
     else if (0 == activeEventSize) {
-        // epoll_wait()超时
+        // epoll_wait()超时，忙轮询时的零超时轮询不记录
         errCode = ETIMEDOUT;
-        LOG_WARN << "Epoll poll warning. timeout. id: " << m_id << " code: " << errno << ". msg: " << strerror(errno);
+        if (0 != timeoutMs) {
+            LOG_WARN << "Epoll poll warning. timeout. id: " << m_id << " code: " << errno << ". msg: " << strerror(errno);
+        }
     }
     else {
         // 处理活跃的channel
@@ -122,7 +124,7 @@ bool EpPoller::updateChannel(Channel::Ptr channel) {
         return false;
     }
 
-    LOG_INFO << "Update channel success. id: " << m_id << " fd: " << fd << " state: " << StringHelper::StateTypeToString(state)
+    LOG_DEBUG << "Update channel success. id: " << m_id << " fd: " << fd << " state: " << StringHelper::StateTypeToString(state)
         << " event type: " << StringHelper::EventTypeToString(evType) << ".";
     return true;
 }
@@ -155,7 +157,7 @@ bool EpPoller::removeChannel(Channel::Ptr channel) {
         return false;
     }
 
-    LOG_INFO << "Remove channel success. id: " << m_id << " fd: " << fd << " state: " << StringHelper::StateTypeToString(state)
+    LOG_DEBUG << "Remove channel success. id: " << m_id << " fd: " << fd << " state: " << StringHelper::StateTypeToString(state)
         << " event type: " << StringHelper::EventTypeToString(evType) << ".";
     return true;
 }
@@ -178,7 +180,7 @@ bool EpPoller::operateControl(int fd, Event_t ev, PollerCtrl_t op) const {
         return false;
     }
     else {
-        LOG_INFO << "Epoll ctrl success. id: " << m_id << " fd: " << fd << " op: " << StringHelper::PollerCtrlTypeToString(op)
+        LOG_DEBUG << "Epoll ctrl success. id: " << m_id << " fd: " << fd << " op: " << StringHelper::PollerCtrlTypeToString(op)
             << " event type: " << StringHelper::EventTypeToString(ev) << ".";
         return true;
     }
@@ -1,3 +1,4 @@
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -15,13 +16,29 @@ using namespace Factory;
 
 namespace Net {
 
+// 当前线程中运行的事件循环
+static thread_local EventLoop* t_currentLoop = nullptr;
+
 EventLoop::EventLoop(std::string id)
     : m_id(std::move(id)),
       m_threadId(std::this_thread::get_id()),
       m_running(false),
+      m_quitRequested(false),
       m_waiting(false),
       m_poller(nullptr),
-      m_wakeupChannel(nullptr) {
+      m_wakeupChannel(nullptr),
+      m_isRunningHooks(false),
+      m_slabPool(std::make_shared<Memory::SlabPool>(m_id + PREFIX_SIGN + SLAB_POOL_PREFIX + "1")),
+      m_activeConnCount(0),
+      m_iterationLatency(0),
+      m_latencyUpdateNs(0),
+      m_boundCpu(-1),
+      m_busyPollBudget(0),
+      m_spinNs(0),
+      m_sleepNs(0),
+      m_spinPolls(0),
+      m_spinHits(0),
+      m_blockPolls(0) {
     LOG_DEBUG << "Eventloop construct. id: " << m_id;
 }
 
@@ -109,14 +126,44 @@ bool EventLoop::loop() {
 
     // 启动事件循环
     m_running = true;
+
+    // 先置运行标志再检查退出请求，与quit()的顺序相反，保证启动前的退出请求不会丢失
+    if (m_quitRequested.exchange(false)) {
+        m_running = false;
+        LOG_INFO << "Eventloop stop before start. quit requested. id: " << m_id;
+        return true;
+    }
+
+    t_currentLoop = this;
+    auto pollStart = std::chrono::steady_clock::now();
+    auto spinDeadline = pollStart;
     while (m_running) {
         // 事件相关参数重置
         int errCode = 0;
         m_activeChannels.clear();
 
-        // 等待事件触发
+        // 忙轮询期限内以零超时轮询，否则阻塞等待事件触发
+        uint64_t busyPollBudget = m_busyPollBudget.load(std::memory_order_relaxed);
+        bool isSpinning = busyPollBudget > 0 && pollStart < spinDeadline;
+
         m_waiting = true;
-        Timestamp returnTime = m_poller->poll(POLLER_DEFAULT_WAIT_TIME, m_activeChannels, errCode);
+        Timestamp returnTime = m_poller->poll(isSpinning ? 0 : POLLER_DEFAULT_WAIT_TIME, m_activeChannels, errCode);
+
+        // 更新忙轮询统计
+        auto pollEnd = std::chrono::steady_clock::now();
+        uint64_t pollNs = std::chrono::duration_cast<std::chrono::nanoseconds>(pollEnd - pollStart).count();
+        if (isSpinning) {
+            m_spinNs.store(m_spinNs.load(std::memory_order_relaxed) + pollNs, std::memory_order_relaxed);
+            m_spinPolls.store(m_spinPolls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (!m_activeChannels.empty()) {
+                m_spinHits.store(m_spinHits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        }
+        else {
+            m_sleepNs.store(m_sleepNs.load(std::memory_order_relaxed) + pollNs, std::memory_order_relaxed);
+            m_blockPolls.store(m_blockPolls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        pollStart = pollEnd;
 
         if (0 != errCode) {
             if (EINTR == errCode || ETIMEDOUT == errCode) {
@@ -126,10 +173,16 @@ bool EventLoop::loop() {
             else {
                 LOG_ERROR << "Eventloop loop error. poll failed. id: " << m_id << " errno: " << errno << ", error: " << strerror(errno);
                 m_waiting = false;
+                t_currentLoop = nullptr;
                 return false;
             }
         }
 
+        // 有事件时延长忙轮询期限
+        if (busyPollBudget > 0) {
+            spinDeadline = pollEnd + std::chrono::microseconds(busyPollBudget);
+        }
+
         // 处理事件
         for (const auto& channelWrapper : m_activeChannels) {
             channelWrapper->m_channel->handleEvent(channelWrapper->m_activeEvType, returnTime);
@@ -137,14 +190,52 @@ bool EventLoop::loop() {
 
         // 处理其他EventLoop分配给当前EventLoop的任务
         this->handleTask();
+
+        // 执行迭代钩子
+        m_isRunningHooks = true;
+        for (const auto& hook : m_iterationHooks) {
+            hook();
+        }
+        m_isRunningHooks = false;
         m_waiting = false;
+
+        // 更新单轮事件处理耗时
+        pollStart = std::chrono::steady_clock::now();
+        uint64_t sample = std::chrono::duration_cast<std::chrono::nanoseconds>(pollStart - pollEnd).count();
+        uint64_t latency = m_iterationLatency.load(std::memory_order_relaxed);
+        m_iterationLatency.store(latency - latency / 8 + sample / 8, std::memory_order_relaxed);
+        m_latencyUpdateNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(pollStart.time_since_epoch()).count(),
+            std::memory_order_relaxed);
     }
 
+    t_currentLoop = nullptr;
+    m_quitRequested = false;
     LOG_INFO << "Eventloop stop. id: " << m_id;
     return true;
 }
 
+uint64_t EventLoop::getIterationLatency() const {
+    uint64_t latency = m_iterationLatency.load(std::memory_order_relaxed);
+    if (!m_waiting || 0 == latency) {
+        return latency;
+    }
+
+    // 阻塞等待期间无就绪事件，按等待时长衰减
+    int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t halfLives = (nowNs - m_latencyUpdateNs.load(std::memory_order_relaxed)) / (EV_LOOP_LATENCY_HALF_LIFE * 1000000LL);
+    if (halfLives <= 0) {
+        return latency;
+    }
+    return halfLives >= 64 ? 0 : latency >> halfLives;
+}
+
+EventLoop* EventLoop::GetCurrentLoop() {
+    return t_currentLoop;
+}
+
 void EventLoop::quit() {
+    m_quitRequested = true;
+
     // 防止重复退出事件循环
     if (!m_running) {
         LOG_WARN << "Eventloop quit warning. quited already. id: " << m_id;
@@ -284,6 +375,21 @@ bool EventLoop::executeTaskInLoop(const Task& task, bool highPriority) {
     return true;
 }
 
+bool EventLoop::addIterationHook(const Task& hook) {
+    if (nullptr == hook) {
+        LOG_ERROR << "Eventloop add iteration hook error. hook invalid. id: " << m_id;
+        return false;
+    }
+
+    if (!this->isInCurrentThread()) {
+        LOG_ERROR << "Eventloop add iteration hook error. not in loop thread. id: " << m_id;
+        return false;
+    }
+
+    m_iterationHooks.push_back(hook);
+    return true;
+}
+
 bool EventLoop::addTimerAtSpecificTime(TimerQueue::TimerId& id, const TimerTask::Task& cb, Timestamp expires, double intervalSec) const {
     if (nullptr == m_timerQueue) {
         LOG_ERROR << "Eventloop add timer error. timer queue invalid. id: " << m_id;
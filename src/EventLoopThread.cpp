@@ -1,5 +1,7 @@
+#include <sched.h>
+#include <cstring>
+#include <chrono>
 #include <utility>
-#include <condition_variable>
 #include "Common/ConfigDef.h"
 #include "Utils/Logger.h"
 #include "Net/EventLoop.h"
@@ -9,6 +11,8 @@ namespace Thread {
 
 EventLoopThread::EventLoopThread(std::string id, ThreadInitCb cb)
     : m_id(std::move(id)),
+      m_isLoopCreated(false),
+      m_isLoopExited(false),
       m_thread(nullptr),
       m_threadInitCb(std::move(cb)),
       m_threadStartFlag(false),
@@ -18,16 +22,26 @@ EventLoopThread::EventLoopThread(std::string id, ThreadInitCb cb)
 }
 
 EventLoopThread::~EventLoopThread() {
-    if (!m_threadExitFlag) {
+    // 已启动但未等待创建完成时先等待，保证退出请求能够送达事件循环
+    if (nullptr != m_thread && !m_threadStartFlag) {
+        this->waitForStart();
+    }
+
+    if (m_threadStartFlag && !m_threadExitFlag) {
         this->quit();
     }
 
-    // 等待线程退出
+    // 等待线程退出，在事件循环线程中析构时无法回收自身
     if (nullptr != m_thread) {
         if (m_thread->joinable()) {
-            LOG_DEBUG << "event loop thread start join.";
-            m_thread->join();
-            LOG_DEBUG << "event loop thread join success.";
+            if (m_thread->get_id() == std::this_thread::get_id()) {
+                m_thread->detach();
+            }
+            else {
+                LOG_DEBUG << "event loop thread start join.";
+                m_thread->join();
+                LOG_DEBUG << "event loop thread join success.";
+            }
         }
         m_thread.reset();
     }
@@ -42,18 +56,27 @@ EventLoopThread::~EventLoopThread() {
 }
 
 void EventLoopThread::run() {
-    // 校验线程是否重复运行
-    if (m_threadStartFlag) {
-        LOG_WARN << "Event loop thread run warning. thread is already running. id: " << m_id << " thread id: " << m_threadId;
-        return;
+    if (this->start()) {
+        this->waitForStart();
+    }
+}
+
+void EventLoopThread::quit() {
+    if (this->requestQuit()) {
+        this->waitForQuit();
     }
+}
 
-    // 创建事件循环线程
-    std::condition_variable cv;
-    std::atomic_bool waitReady(false);
+bool EventLoopThread::start() {
+    // 校验线程是否重复运行
+    if (nullptr != m_thread) {
+        LOG_WARN << "Event loop thread start warning. thread is already running. id: " << m_id;
+        return false;
+    }
 
+    // 创建事件循环线程，创建完成及事件循环结束时通过条件变量通知
     auto weakSelf = this->weak_from_this();
-    m_thread = std::make_shared<std::thread>([weakSelf, &cv, &waitReady]() {
+    m_thread = std::make_shared<std::thread>([weakSelf]() {
         auto threadId = std::this_thread::get_id();
         auto strongSelf = weakSelf.lock();
 
@@ -63,100 +86,200 @@ void EventLoopThread::run() {
         }
 
         // 创建事件循环
+        bool isCreated = false;
         {
             std::stringstream ss;
             ss << PREFIX_SIGN << EV_LOOP_PREFIX << "1";
 
-            // 确保等待线程先获得互斥锁
-            while (!waitReady) {
-                std::this_thread::yield();
-            }
-
             std::lock_guard<std::mutex> lock(strongSelf->m_mutex);
+            strongSelf->m_threadId = threadId;
 
-            strongSelf->m_eventLoop = std::make_shared<Net::EventLoop>(strongSelf->m_id + ss.str());
-            if (!strongSelf->m_eventLoop->init()) {
+            auto eventLoop = std::make_shared<Net::EventLoop>(strongSelf->m_id + ss.str());
+            if (eventLoop->init()) {
+                strongSelf->m_eventLoop = eventLoop;
+                isCreated = true;
+            }
+            else {
                 LOG_ERROR << "Event loop thread run error. event loop init failed. id: " << strongSelf->m_id
                     << " thread id: " << threadId;
-                return;
+                strongSelf->m_isLoopExited = true;
+                strongSelf->m_isLoopCreated = true;
             }
+        }
 
-            // 运行初始化函数
+        if (isCreated) {
+            // 运行初始化函数，不持有互斥锁，其中可设置线程名及CPU亲和性
             if (nullptr != strongSelf->m_threadInitCb) {
                 strongSelf->m_threadInitCb(strongSelf->m_eventLoop);
             }
 
-            strongSelf->m_threadId = threadId;
+            // 设置线程名及CPU亲和性，事件循环运行前生效
+            std::lock_guard<std::mutex> lock(strongSelf->m_mutex);
+            strongSelf->applyThreadOptions(pthread_self());
+            strongSelf->m_isLoopCreated = true;
         }
+        strongSelf->m_stateCv.notify_all();
 
-        // 通知主线程事件循环创建完成
-        cv.notify_one();
+        if (!isCreated) {
+            return;
+        }
 
         // 运行事件循环
         if (!strongSelf->m_eventLoop->loop()) {
             LOG_ERROR << "Event loop thread run error. event loop loop failed. id: " << strongSelf->m_id
                 << " thread id: " << threadId;
         }
+
+        // 通知等待退出的线程
+        {
+            std::lock_guard<std::mutex> lock(strongSelf->m_mutex);
+            strongSelf->m_isLoopExited = true;
+        }
+        strongSelf->m_stateCv.notify_all();
     });
+    return true;
+}
+
+bool EventLoopThread::waitForStart() {
+    if (nullptr == m_thread) {
+        LOG_ERROR << "Event loop thread wait for start error. thread is not started. id: " << m_id;
+        return false;
+    }
 
+    // 等待eventloop创建完成
+    bool isCreated = false;
     {
-        // 等待eventloop创建完成
         std::unique_lock<std::mutex> lock(m_mutex);
-        waitReady = true;
-        cv.wait(lock);
+        m_stateCv.wait(lock, [this]() { return m_isLoopCreated; });
+        isCreated = nullptr != m_eventLoop;
     }
 
     m_threadStartFlag = true;
     LOG_DEBUG << "Event loop thread running. id: " << m_id << " thread id: " << m_threadId;
+    return isCreated;
 }
 
-void EventLoopThread::quit() {
+bool EventLoopThread::requestQuit() {
     // 判断线程是否未运行
     if (!m_threadStartFlag) {
         LOG_ERROR << "Event loop thread quit error. thread is not running. id: " << m_id;
-        return;
+        return false;
     }
 
     // 校验线程是否已经退出
     if (m_threadExitFlag) {
         LOG_WARN << "Event loop thread quit warning. thread is already quit. id: " << m_id << " thread id: " << m_threadId;
-        return;
+        return false;
     }
 
     m_threadExitFlag = true;
 
-    // 退出事件循环
+    // 退出事件循环，事件循环尚未进入loop()时由其在启动时处理退出请求
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (nullptr != m_eventLoop) {
+        m_eventLoop->quit();
+    }
+    return true;
+}
+
+bool EventLoopThread::waitForQuit() {
+    if (nullptr == m_thread) {
+        return true;
+    }
+
+    // 在事件循环线程中退出时，事件循环在本轮处理结束后退出，无需等待
+    if (m_thread->get_id() == std::this_thread::get_id()) {
+        LOG_INFO << "Event loop thread quit in loop thread. id: " << m_id << " thread id: " << m_threadId;
+        return true;
+    }
+
+    // 跨线程退出时等待事件循环结束信号
+    bool isExited = false;
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        isExited = m_stateCv.wait_for(lock, std::chrono::milliseconds(EV_LOOP_THD_QUIT_TIMEOUT), [this]() {
+            return m_isLoopExited;
+        });
+    }
 
-        do {
-            // 事件循环无效
-            if (nullptr == m_eventLoop) {
-                break;
-            }
+    if (!isExited) {
+        LOG_WARN << "Event loop thread quit warning. wait for loop exit timeout. id: " << m_id << " thread id: " << m_threadId;
+        return false;
+    }
 
-            // 事件循环已退出
-            if (!m_eventLoop->isRunning()) {
-                break;
-            }
+    if (m_thread->joinable()) {
+        m_thread->join();
+    }
 
-            // 退出事件循环
-            m_eventLoop->quit();
+    LOG_INFO << "Event loop thread quit. id: " << m_id << " thread id: " << m_threadId;
+    return true;
+}
 
-        } while(false);
+bool EventLoopThread::setCpuAffinity(const std::vector<int>& cpus) {
+    for (int cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            LOG_ERROR << "Event loop thread set cpu affinity error. invalid cpu: " << cpu << " id: " << m_id;
+            return false;
+        }
     }
 
-    // 跨线程退出时确保线程安全退出
-    if (!m_eventLoop->isInCurrentThread()) {
-        // 最长等待3秒，超时后则不在等待
-        for (int count = 0; count < 3; ++count) {
-            if (m_eventLoop->isWaiting()) {
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-            }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cpus = cpus;
+
+    // 线程未运行或在初始化函数中调用时在启动时设置
+    if (!m_isLoopCreated || nullptr == m_thread || nullptr == m_eventLoop || m_threadExitFlag) {
+        return true;
+    }
+    return this->applyThreadOptions(m_thread->native_handle());
+}
+
+bool EventLoopThread::setThreadName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threadName = name;
+
+    // 线程未运行或在初始化函数中调用时在启动时设置
+    if (!m_isLoopCreated || nullptr == m_thread || nullptr == m_eventLoop || m_threadExitFlag) {
+        return true;
+    }
+    return this->applyThreadOptions(m_thread->native_handle());
+}
+
+bool EventLoopThread::applyThreadOptions(pthread_t thread) {
+    bool result = true;
+
+    // 设置线程名，内核限制最长15个字符
+    if (!m_threadName.empty()) {
+        std::string name = m_threadName.substr(0, 15);
+        int ret = ::pthread_setname_np(thread, name.c_str());
+        if (0 != ret) {
+            LOG_ERROR << "Event loop thread set name error. name: " << name << " error: " << strerror(ret) << " id: " << m_id;
+            result = false;
         }
     }
 
-    LOG_INFO << "Event loop thread quit. id: " << m_id << " thread id: " << m_threadId;
+    // 设置CPU亲和性，仅绑定单个CPU时事件循环可确定所在CPU
+    int boundCpu = -1;
+    if (!m_cpus.empty()) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (int cpu : m_cpus) {
+            CPU_SET(cpu, &cpuSet);
+        }
+
+        int ret = ::pthread_setaffinity_np(thread, sizeof(cpuSet), &cpuSet);
+        if (0 != ret) {
+            LOG_ERROR << "Event loop thread set cpu affinity error. error: " << strerror(ret) << " id: " << m_id;
+            result = false;
+        }
+        else if (1 == m_cpus.size()) {
+            boundCpu = m_cpus.front();
+        }
+    }
+
+    if (nullptr != m_eventLoop) {
+        m_eventLoop->setBoundCpu(boundCpu);
+    }
+    return result;
 }
 
 } // namespace Thread
\ No newline at end of file
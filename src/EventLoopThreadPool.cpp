@@ -1,60 +1,320 @@
+#include <new>
+#include <limits>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <future>
 #include <sstream>
+#include <algorithm>
 #include "Utils/Logger.h"
 #include "Common/ConfigDef.h"
+#include "Net/EventLoop.h"
 #include "Thread/EventLoopThread.h"
 #include "Thread/EventLoopThreadPool.h"
 
 namespace Thread {
 
+void EventLoopThreadPool::MeshChannelDeleter::operator()(MeshChannel* channel) const {
+    channel->~MeshChannel();
+    free(channel);
+}
+
 static uint64_t EVENT_LOOP_THREAD_POOL_ID_KEY = 0;
 
+// 当前线程所属的启用消息网格的线程池及其中的工作线程索引
+static thread_local const EventLoopThreadPool* t_meshPool = nullptr;
+static thread_local std::size_t t_meshIdx = 0;
+
+// 当前线程本轮迭代是否已完成消息网格的发送处理
+static thread_local bool t_meshFlushed = false;
+
+/**
+ * @note  splitmix64终结函数，使相近的输入在哈希环上均匀分布
+ * @brief 混合64位哈希值
+ * @return 混合后的哈希值
+ * @param  key 哈希值
+ */
+static uint64_t MixHash(uint64_t key) {
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+}
+
 EventLoopThreadPool::EventLoopThreadPool(unsigned int numWorkThreads, const ThreadInitCb& cb)
-    : m_id(EV_LOOP_THD_POOL_PREFIX + std::to_string(++EVENT_LOOP_THREAD_POOL_ID_KEY)) {
-    // 创建线程
+    : m_id(EV_LOOP_THD_POOL_PREFIX + std::to_string(++EVENT_LOOP_THREAD_POOL_ID_KEY)),
+      m_threadInitCb(cb),
+      m_nextSerial(1),
+      m_countHolders(0),
+      m_nextDrainCbId(0) {
+    // 创建线程，线程名形如ev_main_1、ev_work_1_2，便于在top -H、perf等工具中区分
+    auto workLoopSet = std::make_shared<WorkLoopSet>();
     {
-        int threadIdx = 1;
         std::stringstream ss;
-        ss << m_id << PREFIX_SIGN << EV_LOOP_MAIN_THD_PREFIX << threadIdx;
+        ss << m_id << PREFIX_SIGN << EV_LOOP_MAIN_THD_PREFIX << 1;
 
         // 创建主线程
         m_eventLoopMainThread = std::make_shared<EventLoopThread>(ss.str(), cb);
+        m_eventLoopMainThread->setThreadName(EV_LOOP_MAIN_THD_NAME_PREFIX + std::to_string(EVENT_LOOP_THREAD_POOL_ID_KEY));
 
         // 创建工作线程
         for (unsigned int i = 0; i < numWorkThreads; ++i) {
-            ss.str("");
-            ss << m_id << PREFIX_SIGN << EV_LOOP_WORK_THD_PREFIX << threadIdx++;
-            m_eventLoopWorkThreads.emplace_back(std::make_shared<EventLoopThread>(ss.str(), cb));
+            workLoopSet->m_serials.push_back(m_nextSerial);
+            workLoopSet->m_threads.emplace_back(this->createWorkThread(m_nextSerial++));
         }
     }
 
-    // 运行线程
+    // 构建一致性哈希环
+    BuildHashRing(*workLoopSet);
+
+    // 运行线程，先启动全部线程使事件循环并发创建，再统一等待创建完成
     {
-        // 运行主线程
-        m_eventLoopMainThread->run();
+        m_eventLoopMainThread->start();
+        for (auto& loop : workLoopSet->m_threads) {
+            loop->start();
+        }
 
-        // 运行工作线程
-        for (auto& loop : m_eventLoopWorkThreads) {
-            loop->run();
+        m_eventLoopMainThread->waitForStart();
+        for (auto& loop : workLoopSet->m_threads) {
+            loop->waitForStart();
         }
     }
+    std::atomic_store(&m_workLoopSet, WorkLoopSetPtr(workLoopSet));
 
     LOG_DEBUG << "EventLoopThreadPool construct. numThreads: " << numWorkThreads << ". id: " << m_id;
 }
 
 EventLoopThreadPool::~EventLoopThreadPool() {
-    // 退出主线程
+    auto workLoopSet = this->loadWorkLoopSet();
+
+    // 先通知全部事件循环退出，再统一等待结束，使事件循环并发退出
+    if (nullptr != m_eventLoopMainThread) {
+        m_eventLoopMainThread->requestQuit();
+    }
+
+    for (auto& loop : workLoopSet->m_threads) {
+        if (nullptr != loop) {
+            loop->requestQuit();
+        }
+    }
+
     if (nullptr != m_eventLoopMainThread) {
-        m_eventLoopMainThread->quit();
+        m_eventLoopMainThread->waitForQuit();
     }
 
-    // 退出工作线程
-    for (auto& loop : m_eventLoopWorkThreads) {
+    for (auto& loop : workLoopSet->m_threads) {
         if (nullptr != loop) {
-            loop->quit();
+            loop->waitForQuit();
         }
     }
 
-    LOG_DEBUG << "EventLoopThreadPool deconstruct. numThreads: " << m_eventLoopWorkThreads.size() << ". id: " << m_id;
+    LOG_DEBUG << "EventLoopThreadPool deconstruct. numThreads: " << workLoopSet->m_threads.size() << ". id: " << m_id;
+}
+
+EventLoopThreadPtr EventLoopThreadPool::createWorkThread(unsigned int serial) const {
+    std::stringstream ss;
+    ss << m_id << PREFIX_SIGN << EV_LOOP_WORK_THD_PREFIX << serial;
+
+    auto thread = std::make_shared<EventLoopThread>(ss.str(), m_threadInitCb);
+    std::string poolIdx = m_id.substr(EV_LOOP_THD_POOL_PREFIX.size());
+    thread->setThreadName(EV_LOOP_WORK_THD_NAME_PREFIX + poolIdx + "_" + std::to_string(serial));
+    return thread;
+}
+
+void EventLoopThreadPool::BuildHashRing(WorkLoopSet& workLoopSet) {
+    // 虚拟节点由线程序号决定，增删工作线程时其余线程的虚拟节点不变
+    workLoopSet.m_hashRing.clear();
+    for (std::size_t idx = 0; idx < workLoopSet.m_serials.size(); ++idx) {
+        for (unsigned int node = 0; node < EV_LOOP_HASH_VIRTUAL_NODES; ++node) {
+            workLoopSet.m_hashRing.emplace_back(MixHash((static_cast<uint64_t>(workLoopSet.m_serials[idx]) << 32) | node), idx);
+        }
+    }
+    std::sort(workLoopSet.m_hashRing.begin(), workLoopSet.m_hashRing.end());
+}
+
+bool EventLoopThreadPool::addWorkLoops(unsigned int count) {
+    std::lock_guard<std::mutex> lock(m_resizeMutex);
+    if (0 == count || !m_meshChannels.empty() || m_countHolders > 0) {
+        LOG_ERROR << "Add work loops error. invalid count, mesh enabled or resize held. count: " << count << ". id: " << m_id;
+        return false;
+    }
+
+    auto oldSet = this->loadWorkLoopSet();
+    auto newSet = std::make_shared<WorkLoopSet>(*oldSet);
+
+    // 先启动全部新线程，再统一等待创建完成
+    std::vector<EventLoopThreadPtr> threads;
+    for (unsigned int i = 0; i < count; ++i) {
+        newSet->m_serials.push_back(m_nextSerial);
+        threads.emplace_back(this->createWorkThread(m_nextSerial++));
+        threads.back()->start();
+    }
+
+    uint64_t budgetUs = m_busyPollBudgetUs;
+    for (auto& thread : threads) {
+        Net::EventLoopWkPtr eventLoop;
+        if (!thread->waitForStart() || !thread->getEventLoop(eventLoop) || eventLoop.expired()) {
+            LOG_ERROR << "Add work loops error. start work thread failed. id: " << m_id;
+            for (auto& startedThread : threads) {
+                startedThread->quit();
+            }
+            return false;
+        }
+
+        if (budgetUs > 0) {
+            eventLoop.lock()->setBusyPollBudget(budgetUs);
+        }
+        newSet->m_threads.push_back(thread);
+    }
+
+    // 新线程全部就绪后再加入选择范围
+    BuildHashRing(*newSet);
+    std::atomic_store(&m_workLoopSet, WorkLoopSetPtr(newSet));
+
+    LOG_INFO << "Add work loops success. count: " << count << " numThreads: " << newSet->m_threads.size() << ". id: " << m_id;
+    return true;
+}
+
+bool EventLoopThreadPool::removeWorkLoops(unsigned int count, const DrainCb& drainCb, double drainTimeout) {
+    std::lock_guard<std::mutex> lock(m_resizeMutex);
+    auto oldSet = this->loadWorkLoopSet();
+    if (0 == count || count >= oldSet->m_threads.size() || !m_meshChannels.empty() || m_countHolders > 0) {
+        LOG_ERROR << "Remove work loops error. invalid count, mesh enabled or resize held. count: " << count
+            << " numThreads: " << oldSet->m_threads.size() << ". id: " << m_id;
+        return false;
+    }
+
+    for (const auto& thread : oldSet->m_threads) {
+        if (thread->getThreadId() == std::this_thread::get_id()) {
+            LOG_ERROR << "Remove work loops error. called in work thread. id: " << m_id;
+            return false;
+        }
+    }
+
+    // 先移出选择范围，此后仅已投递的任务可能在被移除的事件循环中创建连接
+    auto newSet = std::make_shared<WorkLoopSet>(*oldSet);
+    std::size_t remainCount = oldSet->m_threads.size() - count;
+    std::vector<EventLoopThreadPtr> threads(newSet->m_threads.begin() + remainCount, newSet->m_threads.end());
+    newSet->m_threads.resize(remainCount);
+    newSet->m_serials.resize(remainCount);
+    BuildHashRing(*newSet);
+    std::atomic_store(&m_workLoopSet, WorkLoopSetPtr(newSet));
+
+    // 依次调用已注册的排空回调及本次指定的排空回调
+    std::vector<DrainCb> drainCbs;
+    {
+        std::lock_guard<std::mutex> cbLock(m_drainCbMutex);
+        for (auto& pair : m_drainCbs) {
+            drainCbs.push_back(pair.second);
+        }
+    }
+    if (nullptr != drainCb) {
+        drainCbs.push_back(drainCb);
+    }
+
+    auto drainAll = [drainCbs](const Net::EventLoopPtr& loop, bool isForce) {
+        for (auto& cb : drainCbs) {
+            cb(loop, isForce);
+        }
+    };
+
+    std::vector<Net::EventLoopPtr> loops;
+    for (auto& thread : threads) {
+        Net::EventLoopWkPtr eventLoop;
+        thread->getEventLoop(eventLoop);
+        auto loop = eventLoop.lock();
+        if (nullptr != loop) {
+            loops.push_back(loop);
+        }
+    }
+
+    // 在各事件循环中开始排空，等待全部事件循环的活跃连接数归零
+    if (!drainCbs.empty()) {
+        for (auto& loop : loops) {
+            loop->executeTask([drainAll, loop]() {
+                drainAll(loop, false);
+            });
+        }
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(static_cast<int64_t>(drainTimeout * 1000));
+    auto isDrained = [&loops]() {
+        for (auto& loop : loops) {
+            if (loop->getActiveConnections() > 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+    while (!isDrained() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(EV_LOOP_DRAIN_CHECK_INTERVAL));
+    }
+
+    // 超时后强制关闭剩余连接，等待执行完成后再退出事件循环
+    for (auto& loop : loops) {
+        uint64_t activeConnections = loop->getActiveConnections();
+        if (0 == activeConnections) {
+            continue;
+        }
+
+        LOG_WARN << "Remove work loops warning. drain timeout, force close. active connections: " << activeConnections << ". id: " << m_id;
+        if (!drainCbs.empty()) {
+            auto done = std::make_shared<std::promise<void>>();
+            auto future = done->get_future();
+            loop->executeTask([drainAll, loop, done]() {
+                drainAll(loop, true);
+                done->set_value();
+            });
+            future.wait();
+        }
+    }
+    loops.clear();
+
+    // 先通知全部事件循环退出，再统一等待结束
+    for (auto& thread : threads) {
+        thread->requestQuit();
+    }
+
+    for (auto& thread : threads) {
+        thread->waitForQuit();
+    }
+
+    LOG_INFO << "Remove work loops success. count: " << count << " numThreads: " << remainCount << ". id: " << m_id;
+    return true;
+}
+
+std::size_t EventLoopThreadPool::getWorkLoopCount() const {
+    return this->loadWorkLoopSet()->m_threads.size();
+}
+
+uint64_t EventLoopThreadPool::addDrainCallback(const DrainCb& cb) {
+    std::lock_guard<std::mutex> lock(m_drainCbMutex);
+    uint64_t id = ++m_nextDrainCbId;
+    m_drainCbs[id] = cb;
+    return id;
+}
+
+void EventLoopThreadPool::removeDrainCallback(uint64_t id) {
+    std::lock_guard<std::mutex> lock(m_drainCbMutex);
+    m_drainCbs.erase(id);
+}
+
+void EventLoopThreadPool::holdWorkLoopCount() {
+    std::lock_guard<std::mutex> lock(m_resizeMutex);
+    ++m_countHolders;
+}
+
+void EventLoopThreadPool::releaseWorkLoopCount() {
+    std::lock_guard<std::mutex> lock(m_resizeMutex);
+    if (m_countHolders > 0) {
+        --m_countHolders;
+    }
+}
+
+bool EventLoopThreadPool::getWorkEventLoop(const WorkLoopSet& workLoopSet, std::size_t idx, Net::EventLoopWkPtr& eventLoop) const {
+    if (idx >= workLoopSet.m_threads.size() || nullptr == workLoopSet.m_threads[idx]) {
+        return false;
+    }
+    return workLoopSet.m_threads[idx]->getEventLoop(eventLoop);
 }
 
 bool EventLoopThreadPool::getMainEventLoop(Net::EventLoopWkPtr& eventLoop) const {
@@ -67,27 +327,325 @@ bool EventLoopThreadPool::getMainEventLoop(Net::EventLoopWkPtr& eventLoop) const
     return true;
 }
 
-bool EventLoopThreadPool::getNextWorkEventLoop(Net::EventLoopWkPtr& eventLoop) const {
-    if (m_eventLoopWorkThreads.empty()) {
+bool EventLoopThreadPool::getNextWorkEventLoop(Net::EventLoopWkPtr& eventLoop, uint64_t hashKey) const {
+    // 持有快照期间并发扩缩容不影响本次选择
+    auto workLoopSet = this->loadWorkLoopSet();
+    if (workLoopSet->m_threads.empty()) {
         return this->getMainEventLoop(eventLoop);
     }
 
-    // 获取有效工作线程索引
-    m_nextIdx = (m_nextIdx >= (m_eventLoopWorkThreads.size() - 1) ? 0 : m_nextIdx + 1);
-
-    // 获取工作线程
-    auto eventLoopWorkThread = m_eventLoopWorkThreads[m_nextIdx];
-    if (nullptr == eventLoopWorkThread) {
-        LOG_ERROR << "Get next work event loop error. work thread invalid. id" << m_id;
-        return false;
+    // 按选择策略获取工作线程索引
+    std::size_t idx = 0;
+    auto policy = m_placementPolicy.load();
+    switch (policy) {
+        case Placement_t::PlacementLeastConnections:
+        case Placement_t::PlacementLeastLatency: {
+            idx = this->selectLeastLoaded(*workLoopSet, policy);
+            break;
+        }
+        case Placement_t::PlacementConsistentHash: {
+            idx = this->selectByHash(*workLoopSet, hashKey);
+            break;
+        }
+        default: {
+            idx = m_nextIdx.fetch_add(1, std::memory_order_relaxed) % workLoopSet->m_threads.size();
+            break;
+        }
     }
 
     // 获取事件循环
-    if (!eventLoopWorkThread->getEventLoop(eventLoop)) {
+    if (!this->getWorkEventLoop(*workLoopSet, idx, eventLoop)) {
         LOG_ERROR << "Get next work event loop error. get event loop failed. id" << m_id;
         return false;
     }
     return true;
 }
 
+bool EventLoopThreadPool::setMainLoopCpus(const std::vector<int>& cpus) {
+    if (nullptr == m_eventLoopMainThread) {
+        LOG_ERROR << "Set main loop cpus error. main thread invalid. id: " << m_id;
+        return false;
+    }
+    return m_eventLoopMainThread->setCpuAffinity(cpus);
+}
+
+bool EventLoopThreadPool::setWorkLoopCpus(std::size_t idx, const std::vector<int>& cpus) {
+    auto workLoopSet = this->loadWorkLoopSet();
+    if (idx >= workLoopSet->m_threads.size() || nullptr == workLoopSet->m_threads[idx]) {
+        LOG_ERROR << "Set work loop cpus error. work thread invalid. idx: " << idx << " id: " << m_id;
+        return false;
+    }
+    return workLoopSet->m_threads[idx]->setCpuAffinity(cpus);
+}
+
+bool EventLoopThreadPool::pinWorkLoops(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        LOG_ERROR << "Pin work loops error. cpu list empty. id: " << m_id;
+        return false;
+    }
+
+    bool result = true;
+    auto workLoopSet = this->loadWorkLoopSet();
+    for (std::size_t idx = 0; idx < workLoopSet->m_threads.size(); ++idx) {
+        if (nullptr == workLoopSet->m_threads[idx] || !workLoopSet->m_threads[idx]->setCpuAffinity(std::vector<int>{cpus[idx % cpus.size()]})) {
+            result = false;
+        }
+    }
+    return result;
+}
+
+bool EventLoopThreadPool::setBusyPollBudget(uint64_t budgetUs) {
+    m_busyPollBudgetUs = budgetUs;
+    std::vector<Net::EventLoopWkPtr> eventLoops;
+    if (!this->getWorkEventLoops(eventLoops)) {
+        LOG_ERROR << "Set busy poll budget error. get work event loops failed. id: " << m_id;
+        return false;
+    }
+
+    for (const auto& eventLoop : eventLoops) {
+        auto loop = eventLoop.lock();
+        if (nullptr != loop) {
+            loop->setBusyPollBudget(budgetUs);
+        }
+    }
+    return true;
+}
+
+bool EventLoopThreadPool::enableMesh(std::size_t ringCapacity) {
+    std::lock_guard<std::mutex> lock(m_resizeMutex);
+    if (!m_meshChannels.empty() || nullptr != t_meshPool) {
+        LOG_ERROR << "Enable mesh error. already enabled or called in work thread. id: " << m_id;
+        return false;
+    }
+
+    if (this->getWorkLoopCount() < 2 || 0 == ringCapacity) {
+        LOG_ERROR << "Enable mesh error. at least two work threads required. id: " << m_id;
+        return false;
+    }
+
+    std::vector<Net::EventLoopWkPtr> eventLoops;
+    if (!this->getWorkEventLoops(eventLoops)) {
+        LOG_ERROR << "Enable mesh error. get work event loops failed. id: " << m_id;
+        return false;
+    }
+
+    // 创建两两之间的通道，发给自身的通道为空
+    std::size_t loopCount = eventLoops.size();
+    m_meshChannels.resize(loopCount * loopCount);
+    for (std::size_t src = 0; src < loopCount; ++src) {
+        for (std::size_t dst = 0; dst < loopCount; ++dst) {
+            if (src == dst) {
+                continue;
+            }
+
+            void* mem = nullptr;
+            if (0 != posix_memalign(&mem, alignof(MeshChannel), sizeof(MeshChannel))) {
+                LOG_ERROR << "Enable mesh error. posix_memalign() failed. id: " << m_id;
+                m_meshChannels.clear();
+                return false;
+            }
+            m_meshChannels[src * loopCount + dst].reset(new (mem) MeshChannel(ringCapacity));
+        }
+    }
+    m_meshLoops = eventLoops;
+
+    // 在各工作事件循环中注册迭代钩子，等待全部注册完成后返回
+    for (std::size_t idx = 0; idx < loopCount; ++idx) {
+        auto loop = eventLoops[idx].lock();
+        auto done = std::make_shared<std::promise<void>>();
+        auto future = done->get_future();
+        loop->executeTask([this, idx, loop, done]() {
+            t_meshPool = this;
+            t_meshIdx = idx;
+            loop->addIterationHook([this, idx]() {
+                this->handleMeshIteration(idx);
+            });
+            done->set_value();
+        });
+        future.wait();
+    }
+
+    LOG_DEBUG << "Enable mesh success. loops: " << loopCount << " ring capacity: " << ringCapacity << ". id: " << m_id;
+    return true;
+}
+
+bool EventLoopThreadPool::sendToLoop(std::size_t idx, const MeshTask& task) {
+    if (nullptr == task || idx >= m_meshLoops.size()) {
+        LOG_ERROR << "Send to loop error. invalid input param. idx: " << idx << ". id: " << m_id;
+        return false;
+    }
+
+    // 非工作线程或发给自身时经任务队列投递
+    if (this != t_meshPool || idx == t_meshIdx) {
+        auto loop = m_meshLoops[idx].lock();
+        if (nullptr == loop) {
+            LOG_ERROR << "Send to loop error. event loop expired. idx: " << idx << ". id: " << m_id;
+            return false;
+        }
+        return loop->executeTaskInLoop(task);
+    }
+
+    // 已有暂存消息时继续暂存，保证消息顺序
+    auto& channel = *m_meshChannels[t_meshIdx * m_meshLoops.size() + idx];
+    if (!channel.m_overflow.empty() || !channel.m_ring.push(task)) {
+        channel.m_overflow.push_back(task);
+        channel.m_hasOverflow = true;
+    }
+    channel.m_needWakeup = true;
+
+    // 本轮发送处理已完成(在其后的迭代钩子中发送)时立即唤醒
+    auto loop = m_meshLoops[t_meshIdx].lock();
+    if (t_meshFlushed && nullptr != loop && loop->isRunningHooks()) {
+        loop->wakeup();
+    }
+    return true;
+}
+
+bool EventLoopThreadPool::getCurrentWorkLoopIndex(std::size_t& idx) const {
+    if (this == t_meshPool) {
+        idx = t_meshIdx;
+        return true;
+    }
+
+    // 未启用消息网格时按线程id查找
+    auto workLoopSet = this->loadWorkLoopSet();
+    for (std::size_t workIdx = 0; workIdx < workLoopSet->m_threads.size(); ++workIdx) {
+        auto& thread = workLoopSet->m_threads[workIdx];
+        if (nullptr != thread && thread->getThreadId() == std::this_thread::get_id()) {
+            idx = workIdx;
+            return true;
+        }
+    }
+    return false;
+}
+
+void EventLoopThreadPool::handleMeshIteration(std::size_t idx) {
+    std::size_t loopCount = m_meshLoops.size();
+    bool needSelfWakeup = false;
+    t_meshFlushed = false;
+
+    // 执行其他事件循环发来的消息，每个通道最多取出一个队列容量，避免单个发送方长期占用
+    for (std::size_t src = 0; src < loopCount; ++src) {
+        if (src == idx) {
+            continue;
+        }
+
+        auto& channel = *m_meshChannels[src * loopCount + idx];
+        MeshTask task;
+        std::size_t count = 0;
+        while (count < channel.m_ring.capacity() && channel.m_ring.pop(task)) {
+            task();
+            ++count;
+        }
+
+        if (count > 0 && !channel.m_ring.empty()) {
+            needSelfWakeup = true;
+        }
+
+        // 发送方有暂存消息时唤醒发送方继续移入队列
+        if (count > 0 && channel.m_hasOverflow) {
+            auto srcLoop = m_meshLoops[src].lock();
+            if (nullptr != srcLoop) {
+                srcLoop->wakeup();
+            }
+        }
+    }
+
+    // 将暂存消息移入队列，每个接收方最多唤醒一次
+    for (std::size_t dst = 0; dst < loopCount; ++dst) {
+        if (dst == idx) {
+            continue;
+        }
+
+        auto& channel = *m_meshChannels[idx * loopCount + dst];
+        while (!channel.m_overflow.empty() && channel.m_ring.push(channel.m_overflow.front())) {
+            channel.m_overflow.pop_front();
+            channel.m_needWakeup = true;
+        }
+        if (channel.m_overflow.empty()) {
+            channel.m_hasOverflow = false;
+        }
+
+        if (channel.m_needWakeup) {
+            channel.m_needWakeup = false;
+            auto dstLoop = m_meshLoops[dst].lock();
+            if (nullptr != dstLoop) {
+                dstLoop->wakeup();
+            }
+        }
+    }
+    t_meshFlushed = true;
+
+    if (needSelfWakeup) {
+        auto loop = m_meshLoops[idx].lock();
+        if (nullptr != loop) {
+            loop->wakeup();
+        }
+    }
+}
+
+std::size_t EventLoopThreadPool::selectLeastLoaded(const WorkLoopSet& workLoopSet, Placement_t policy) const {
+    std::size_t threadCount = workLoopSet.m_threads.size();
+    std::size_t startIdx = m_nextIdx.fetch_add(1, std::memory_order_relaxed) % threadCount;
+    std::size_t bestIdx = startIdx;
+    uint64_t bestLoad = std::numeric_limits<uint64_t>::max();
+
+    for (std::size_t offset = 0; offset < threadCount; ++offset) {
+        std::size_t idx = (startIdx + offset) % threadCount;
+
+        Net::EventLoopWkPtr eventLoop;
+        if (!this->getWorkEventLoop(workLoopSet, idx, eventLoop)) {
+            continue;
+        }
+
+        auto loop = eventLoop.lock();
+        if (nullptr == loop) {
+            continue;
+        }
+
+        uint64_t load = Placement_t::PlacementLeastConnections == policy ? loop->getActiveConnections() : loop->getIterationLatency();
+        if (load < bestLoad) {
+            bestLoad = load;
+            bestIdx = idx;
+        }
+    }
+    return bestIdx;
+}
+
+std::size_t EventLoopThreadPool::selectByHash(const WorkLoopSet& workLoopSet, uint64_t hashKey) const {
+    // 顺时针查找第一个虚拟节点，超过最大值时回到起点
+    const auto& hashRing = workLoopSet.m_hashRing;
+    auto iter = std::upper_bound(hashRing.begin(), hashRing.end(), std::make_pair(MixHash(hashKey), std::numeric_limits<std::size_t>::max()));
+    if (hashRing.end() == iter) {
+        iter = hashRing.begin();
+    }
+    return iter->second;
+}
+
+bool EventLoopThreadPool::getWorkEventLoops(std::vector<Net::EventLoopWkPtr>& eventLoops) const {
+    eventLoops.clear();
+
+    auto workLoopSet = this->loadWorkLoopSet();
+    if (workLoopSet->m_threads.empty()) {
+        Net::EventLoopWkPtr eventLoop;
+        if (!this->getMainEventLoop(eventLoop)) {
+            return false;
+        }
+
+        eventLoops.emplace_back(eventLoop);
+        return true;
+    }
+
+    for (const auto& eventLoopWorkThread : workLoopSet->m_threads) {
+        Net::EventLoopWkPtr eventLoop;
+        if (nullptr == eventLoopWorkThread || !eventLoopWorkThread->getEventLoop(eventLoop)) {
+            LOG_ERROR << "Get work event loops error. get event loop failed. id" << m_id;
+            return false;
+        }
+
+        eventLoops.emplace_back(eventLoop);
+    }
+    return true;
+}
+
 } // namespace Thread
\ No newline at end of file
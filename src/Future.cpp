@@ -0,0 +1,31 @@
+#include "Utils/Logger.h"
+#include "Net/EventLoop.h"
+#include "Net/Future.h"
+
+namespace Net {
+
+EventLoopWkPtr FutureExecutor::CurrentLoop() {
+    auto loop = EventLoop::GetCurrentLoop();
+    return nullptr == loop ? EventLoopWkPtr() : loop->weak_from_this();
+}
+
+Memory::SlabPool::Ptr FutureExecutor::CurrentSlabPool() {
+    auto loop = EventLoop::GetCurrentLoop();
+    return nullptr == loop ? nullptr : loop->getSlabPool();
+}
+
+bool FutureExecutor::Dispatch(const EventLoopWkPtr& loop, const Task& task) {
+    auto strongLoop = loop.lock();
+    if (nullptr == strongLoop) {
+        LOG_WARN << "Future dispatch continuation warning. event loop expired. continuation dropped.";
+        return false;
+    }
+
+    if (strongLoop->isInCurrentThread()) {
+        task();
+        return true;
+    }
+    return strongLoop->executeTaskInLoop(task);
+}
+
+} // namespace Net
\ No newline at end of file
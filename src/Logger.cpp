@@ -1,15 +1,20 @@
-#include <fstream>
+#include <cerrno>
+#include <vector>
 #include <iostream>
+#include <fcntl.h>
 #include <unistd.h>
+#include <sys/uio.h>
 #include "Utils/Logger.h"
+#include "Utils/AsyncLogger.h"
 
 namespace Utils {
 
-#define CURRANT_TIME TimeHelper::GetCurrentTime()
+#define CURRANT_TIME TimeHelper::FormatTime(TimeHelper::GetCurrentTimeNs())
 
 std::mutex Logger::LogPrintCbLock;
 Logger::LogPrintMap Logger::LogPrintCbMap;
 std::atomic<bool> Logger::m_enableWriteFile{true};
+std::atomic<bool> Logger::m_enableWriteConsole{true};
 std::atomic<LogLevel> Logger::m_lowestLevel{LogLevel::DEBUG};
 
 class LogFileWriter : public Noncopyable {
@@ -20,20 +25,58 @@ public:
     }
 
     void write(const std::string& str) {
-        if (m_logFile.is_open()) {
-            m_logFile << str;
-            m_logFile.flush();
+        struct iovec iov;
+        iov.iov_base = const_cast<char*>(str.data());
+        iov.iov_len = str.size();
+        WriteAll(m_logFd, &iov, 1);
+    }
+
+    void writev(const struct iovec* iov, int count) {
+        WriteAll(m_logFd, iov, count);
+    }
+
+    /**
+     * @note  写入不完整时从中断处继续写入，写入失败时放弃
+     * @brief 向文件描述符写入全部数据段
+     * @param fd 文件描述符
+     * @param iov 数据段
+     * @param count 数据段数
+     */
+    static void WriteAll(int fd, const struct iovec* iov, int count) {
+        if (fd < 0 || count <= 0) {
+            return;
+        }
+
+        std::vector<struct iovec> pending(iov, iov + count);
+        std::size_t idx = 0;
+        while (idx < pending.size()) {
+            ssize_t n = ::writev(fd, pending.data() + idx, static_cast<int>(pending.size() - idx));
+            if (n < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+                return;
+            }
+
+            auto written = static_cast<std::size_t>(n);
+            while (idx < pending.size() && written >= pending[idx].iov_len) {
+                written -= pending[idx++].iov_len;
+            }
+            if (idx < pending.size()) {
+                pending[idx].iov_base = static_cast<char*>(pending[idx].iov_base) + written;
+                pending[idx].iov_len -= written;
+            }
         }
     }
 
     ~LogFileWriter() {
-        if (m_logFile.is_open()) {
-            m_logFile.close();
+        if (m_logFd >= 0) {
+            ::close(m_logFd);
         }
     }
 
 private:
-    LogFileWriter() {
+    LogFileWriter() : m_logFd(-1) {
         // 获取可执行程序路径
         char buf[1024];
         ssize_t count = readlink("/proc/self/exe", buf, sizeof(buf) - 1);
@@ -52,17 +95,62 @@ private:
 
         // 创建日志文件
         std::string logFilePath = exeDir + "/log_" + TimeHelper::GetCurrentData() + ".log";
-        m_logFile.open(logFilePath, std::ios::out | std::ios::app);
-        if (!m_logFile.is_open()) {
+        m_logFd = ::open(logFilePath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (m_logFd < 0) {
             std::cerr << "Create log file error. open log file failed" << std::endl;
             return;
         }
     }
 
 private:
-    std::ofstream m_logFile;
+    int m_logFd;
 };
 
+void Logger::InitOutput() {
+    LogFileWriter::Instance();
+}
+
+bool Logger::StartAsync(std::size_t ringSize, int flushIntervalMs, LogOverflow_t policy) {
+    // 先创建日志文件，使其在后台写线程之后析构
+    Logger::InitOutput();
+
+    return AsyncLogWriter::Instance().start(ringSize, flushIntervalMs, policy, &Logger::OutputBatch);
+}
+
+void Logger::OutputBatch(const struct iovec* iov, int count) {
+    if (m_enableWriteFile) {
+        LogFileWriter::Instance().writev(iov, count);
+    }
+
+    if (m_enableWriteConsole) {
+        LogFileWriter::WriteAll(STDOUT_FILENO, iov, count);
+    }
+}
+
+void Logger::StopAsync() {
+    AsyncLogWriter::Instance().stop();
+}
+
+uint64_t Logger::GetDroppedCount() {
+    return AsyncLogWriter::Instance().getDroppedCount();
+}
+
+void Logger::Output(const std::string& line) {
+    if (AsyncLogWriter::Instance().isRunning()) {
+        AsyncLogWriter::Instance().append(line.data(), line.size());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(LogPrintCbLock);
+    if (m_enableWriteFile) {
+        LogFileWriter::Instance().write(line);
+    }
+
+    if (m_enableWriteConsole) {
+        std::cout << line;
+    }
+}
+
 void Logger::flush() const {
     if (m_level < m_lowestLevel) {
         return;
@@ -74,69 +162,50 @@ void Logger::flush() const {
     }
     else {
         // 第一次日志打印进入此逻辑
-        LogPrintCbMap[LogLevel::DEBUG] = [](const std::string& file, int line, const std::string& str) {
-            std::lock_guard<std::mutex> lock(LogPrintCbLock);
-
+        LogPrintCbMap[LogLevel::DEBUG] = [](const char* file, int line, const std::string& str) {
             std::stringstream ss;
             ss << "[DEBUG][" << CURRANT_TIME << "][" << file << ":" << line << "] " << str << std::endl;
 
-            if (m_enableWriteFile) {
-                LogFileWriter::Instance().write(ss.str());
-            }
-
-            std::cout << ss.str();
+            Output(ss.str());
         };
 
-        LogPrintCbMap[LogLevel::INFO] = [](const std::string& file, int line, const std::string& str) {
-            std::lock_guard<std::mutex> lock(LogPrintCbLock);
-
+        LogPrintCbMap[LogLevel::INFO] = [](const char* file, int line, const std::string& str) {
             std::stringstream ss;
             ss << "[INFO] [" << CURRANT_TIME << "][" << file << ":" << line << "] " << str << std::endl;
 
-            if (m_enableWriteFile) {
-                LogFileWriter::Instance().write(ss.str());
-            }
-
-            std::cout << ss.str();
+            Output(ss.str());
         };
 
-        LogPrintCbMap[LogLevel::WARN] = [](const std::string& file, int line, const std::string& str) {
-            std::lock_guard<std::mutex> lock(LogPrintCbLock);
-
+        LogPrintCbMap[LogLevel::WARN] = [](const char* file, int line, const std::string& str) {
             std::stringstream ss;
             ss << "[WARN] [" << CURRANT_TIME << "][" << file << ":" << line << "] " << str << std::endl;
 
-            if (m_enableWriteFile) {
-                LogFileWriter::Instance().write(ss.str());
-            }
-
-            std::cout << ss.str();
+            Output(ss.str());
         };
 
-        LogPrintCbMap[LogLevel::ERROR] = [](const std::string& file, int line, const std::string& str) {
-            std::lock_guard<std::mutex> lock(LogPrintCbLock);
-
+        LogPrintCbMap[LogLevel::ERROR] = [](const char* file, int line, const std::string& str) {
             std::stringstream ss;
             ss << "[ERROR][" << CURRANT_TIME << "][" << file << ":" << line << "] " << str << std::endl;
 
-            if (m_enableWriteFile) {
-                LogFileWriter::Instance().write(ss.str());
-            }
-
-            std::cout << ss.str();
+            Output(ss.str());
         };
 
-        LogPrintCbMap[LogLevel::FATAL] = [](const std::string& file, int line, const std::string& str) {
-            std::lock_guard<std::mutex> lock(LogPrintCbLock);
-
+        LogPrintCbMap[LogLevel::FATAL] = [](const char* file, int line, const std::string& str) {
             std::stringstream ss;
             ss << "[FATAL][" << CURRANT_TIME << "][" << file << ":" << line << "] " << str << std::endl;
 
-            if (m_enableWriteFile) {
-                LogFileWriter::Instance().write(ss.str());
+            // 先写出异步日志中已缓存的日志，再同步写入本条日志，避免缓冲区已满时被丢弃
+            StopAsync();
+
+            std::string fatalLine = ss.str();
+            struct iovec iov;
+            iov.iov_base = const_cast<char*>(fatalLine.data());
+            iov.iov_len = fatalLine.size();
+            {
+                std::lock_guard<std::mutex> lock(LogPrintCbLock);
+                std::cout.flush();
+                OutputBatch(&iov, 1);
             }
-
-            std::cout << ss.str();
             std::exit(EXIT_FAILURE);
         };
 
@@ -50,9 +50,11 @@ Timestamp PPoller::poll(int timeoutMs, ChannelWrapperList& activeChannels, int&
         }
     }
     else if (0 == activeEventSize) {
-        // poll()超时
+        // poll()超时，忙轮询时的零超时轮询不记录
         errCode = ETIMEDOUT;
-        LOG_WARN << "Poll poll warning. timeout. id: " << m_id << " code: " << errno << ". msg: " << strerror(errno);
+        if (0 != timeoutMs) {
+            LOG_WARN << "Poll poll warning. timeout. id: " << m_id << " code: " << errno << ". msg: " << strerror(errno);
+        }
     }
     else {
         // 处理活跃的channel
@@ -110,7 +112,7 @@ bool PPoller::updateChannel(Channel::Ptr channel) {
         return false;
     }
 
-    LOG_INFO << "Update channel success. id: " << m_id << " fd: " << fd << " state: " << StringHelper::StateTypeToString(state)
+    LOG_DEBUG << "Update channel success. id: " << m_id << " fd: " << fd << " state: " << StringHelper::StateTypeToString(state)
         << " event type: " << StringHelper::EventTypeToString(evType) << ".";
     return true;
 }
@@ -134,7 +136,7 @@ bool PPoller::removeChannel(Channel::Ptr channel) {
         m_channelMap.erase(fd);
     }
 
-    LOG_INFO << "Remove channel success. id: " << m_id << " fd: " << fd << " state: " << StringHelper::StateTypeToString(state)
+    LOG_DEBUG << "Remove channel success. id: " << m_id << " fd: " << fd << " state: " << StringHelper::StateTypeToString(state)
         << " event type: " << StringHelper::EventTypeToString(evType) << ".";
     return true;
 }
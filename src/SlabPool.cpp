@@ -0,0 +1,163 @@
+#include <cstdlib>
+#include <algorithm>
+#include <utility>
+#include "Utils/Logger.h"
+#include "Memory/SlabPool.h"
+
+namespace Memory {
+
+SlabPool::SlabPool(std::string id)
+    : m_id(std::move(id)),
+      m_ownerThreadId(std::this_thread::get_id()),
+      m_remoteFreeBlocks(nullptr),
+      m_chunks(nullptr),
+      m_chunkBytes(0) {
+    m_freeBlocks.fill(nullptr);
+    LOG_DEBUG << "Construct slab pool. id: " << m_id;
+}
+
+SlabPool::~SlabPool() {
+    // 内存块通过分配器持有内存池强引用，析构时所有内存块均已释放，直接释放内存页
+    int chunkCount = 0;
+    for (auto chunk = m_chunks; nullptr != chunk; /* void */) {
+        auto next = chunk->next;
+        ::free(chunk);
+        chunk = next;
+        ++chunkCount;
+    }
+
+    LOG_DEBUG << "Destruct slab pool. id: " << m_id << " chunk count: " << chunkCount << " chunk bytes: " << m_chunkBytes;
+}
+
+SlabPool::Memory SlabPool::allocateMemory(std::size_t size) {
+    uint32_t classIdx = GetClassIdx(size);
+    if (SLAB_POOL_LARGE_CLASS == classIdx || !this->isInOwnerThread()) {
+        return AllocateLargeMemory(size);
+    }
+
+    // 本地空闲链表为空时，先回收其他线程释放的内存块，仍为空则申请新的内存页
+    if (nullptr == m_freeBlocks[classIdx]) {
+        this->reclaimRemoteBlocks();
+
+        if (nullptr == m_freeBlocks[classIdx] && !this->refillBlocks(classIdx)) {
+            LOG_ERROR << "Slab pool allocate memory error. refill blocks failed. id: " << m_id << " size: " << size;
+            return nullptr;
+        }
+    }
+
+    auto block = m_freeBlocks[classIdx];
+    m_freeBlocks[classIdx] = block->next;
+    return block;
+}
+
+void SlabPool::freeMemory(Memory data) {
+    if (nullptr == data) {
+        return;
+    }
+
+    auto header = reinterpret_cast<SlabBlockHeaderPtr>(static_cast<uint8_t*>(data) - sizeof(SlabBlockHeader_dt));
+    if (SLAB_POOL_LARGE_CLASS == header->classIdx) {
+        ::free(header);
+        return;
+    }
+
+    if (this != header->pool) {
+        LOG_ERROR << "Slab pool free memory error. memory not belong to pool. id: " << m_id << " addr: " << data;
+        return;
+    }
+
+    auto block = static_cast<SlabFreeBlockPtr>(data);
+    if (this->isInOwnerThread()) {
+        block->next = m_freeBlocks[header->classIdx];
+        m_freeBlocks[header->classIdx] = block;
+        return;
+    }
+
+    // 其他线程释放的内存块挂到无锁链表，仅所属线程会整体摘取该链表，不存在ABA问题
+    block->next = m_remoteFreeBlocks.load(std::memory_order_relaxed);
+    while (!m_remoteFreeBlocks.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed)) {
+        // void
+    }
+}
+
+std::size_t SlabPool::GetBlockSize(Memory data) {
+    if (nullptr == data) {
+        return 0;
+    }
+
+    auto header = reinterpret_cast<SlabBlockHeaderPtr>(static_cast<uint8_t*>(data) - sizeof(SlabBlockHeader_dt));
+    return header->size;
+}
+
+uint32_t SlabPool::GetClassIdx(std::size_t size) {
+    if (size > SLAB_POOL_MAX_BLOCK_SIZE) {
+        return SLAB_POOL_LARGE_CLASS;
+    }
+
+    uint32_t classIdx = 0;
+    for (std::size_t blockSize = SLAB_POOL_MIN_BLOCK_SIZE; blockSize < size; blockSize <<= 1) {
+        ++classIdx;
+    }
+    return classIdx;
+}
+
+SlabPool::Memory SlabPool::AllocateLargeMemory(std::size_t size) {
+    auto header = static_cast<SlabBlockHeaderPtr>(::malloc(sizeof(SlabBlockHeader_dt) + size));
+    if (nullptr == header) {
+        LOG_ERROR << "Slab pool allocate large memory error. malloc() failed. size: " << size;
+        return nullptr;
+    }
+
+    header->pool = nullptr;
+    header->classIdx = SLAB_POOL_LARGE_CLASS;
+    header->size = static_cast<uint32_t>(size);
+    return reinterpret_cast<uint8_t*>(header) + sizeof(SlabBlockHeader_dt);
+}
+
+void SlabPool::reclaimRemoteBlocks() {
+    auto block = m_remoteFreeBlocks.exchange(nullptr, std::memory_order_acquire);
+    while (nullptr != block) {
+        auto next = block->next;
+        auto header = reinterpret_cast<SlabBlockHeaderPtr>(reinterpret_cast<uint8_t*>(block) - sizeof(SlabBlockHeader_dt));
+
+        block->next = m_freeBlocks[header->classIdx];
+        m_freeBlocks[header->classIdx] = block;
+        block = next;
+    }
+}
+
+bool SlabPool::refillBlocks(uint32_t classIdx) {
+    std::size_t blockSize = SLAB_POOL_MIN_BLOCK_SIZE << classIdx;
+    std::size_t stride = sizeof(SlabBlockHeader_dt) + blockSize;
+    std::size_t chunkSize = std::max(SLAB_POOL_CHUNK_SIZE, sizeof(SlabChunk_dt) + stride);
+
+    auto chunk = static_cast<SlabChunkPtr>(::malloc(chunkSize));
+    if (nullptr == chunk) {
+        LOG_ERROR << "Slab pool refill blocks error. malloc() failed. id: " << m_id << " chunk size: " << chunkSize;
+        return false;
+    }
+
+    chunk->next = m_chunks;
+    chunk->size = chunkSize;
+    m_chunks = chunk;
+    m_chunkBytes += chunkSize;
+
+    // 将内存页切分为同规格内存块并加入空闲链表
+    auto start = reinterpret_cast<uint8_t*>(chunk) + sizeof(SlabChunk_dt);
+    auto end = reinterpret_cast<uint8_t*>(chunk) + chunkSize;
+    for (/* void */; start + stride <= end; start += stride) {
+        auto header = reinterpret_cast<SlabBlockHeaderPtr>(start);
+        header->pool = this;
+        header->classIdx = classIdx;
+        header->size = static_cast<uint32_t>(blockSize);
+
+        auto block = reinterpret_cast<SlabFreeBlockPtr>(start + sizeof(SlabBlockHeader_dt));
+        block->next = m_freeBlocks[classIdx];
+        m_freeBlocks[classIdx] = block;
+    }
+
+    LOG_DEBUG << "Slab pool refill blocks. id: " << m_id << " block size: " << blockSize << " chunk size: " << chunkSize;
+    return true;
+}
+
+} // namespace Memory
\ No newline at end of file
@@ -50,31 +50,28 @@ bool Socket::listen() const {
     return true;
 }
 
-bool Socket::accept(Socket::Ptr& connSock) const {
+bool Socket::accept(Socket::Ptr& connSock, int& errCode) const {
     if (!this->isLocalAddrValid()) {
         LOG_ERROR << "Socket accept error. local address not set.";
+        errCode = EINVAL;
         return false;
     }
-    else if (Socket_t::TCP != m_type) {
+    else if (Socket_t::TCP != m_type && Socket_t::SEQPACKET != m_type) {
         LOG_ERROR << "Socket accept error. invalid socket type.";
+        errCode = EINVAL;
         return false;
     }
 
     int connfd = 0;
     Address::Ptr peerAddr;
-    if (!Socketop::AcceptSocket(m_fd, peerAddr, connfd)) {
-        LOG_ERROR << "Socket accept error. addr: " << m_localAddr->printIpPort();
+    if (!Socketop::AcceptSocket(m_fd, peerAddr, connfd, errCode)) {
         return false;
     }
 
-    // 创建socket
+    // 创建socket，本端地址沿用监听地址，无需逐个查询
     connSock = std::make_shared<Socket>(connfd, m_type);
     connSock->m_localAddr = this->m_localAddr;
     connSock->m_peerAddr = peerAddr;
-
-    // 设置socket属性
-    Socketop::SetCloexec(connfd, Socketop::IsCloexec(m_fd));
-    Socketop::SetBlocking(connfd, Socketop::IsBlocking(m_fd));
     return true;
 }
 
@@ -93,6 +90,17 @@ bool Socket::connect(const Address::Ptr& peerAddr) {
     return true;
 }
 
+bool Socket::updateLocalAddr() {
+    Address::Ptr localAddr;
+    if (!Socketop::GetLocalAddr(m_fd, localAddr)) {
+        LOG_ERROR << "Socket update local address error. fd: " << m_fd;
+        return false;
+    }
+
+    m_localAddr = localAddr;
+    return true;
+}
+
 void Socket::setReuseAddr(bool enabled) const {
     if (!Socketop::SetReuseAddr(m_fd, enabled)) {
         LOG_ERROR << "Socket set reuse addr error. fd: " << m_fd;
@@ -144,4 +152,16 @@ void Socket::setKeepaliveEnabled(bool enabled) const {
     }
 }
 
+void Socket::setIncomingCpu(int cpu) const {
+    if (!Socketop::SetIncomingCpu(m_fd, cpu)) {
+        LOG_ERROR << "Socket set incoming cpu error. fd: " << m_fd << " cpu: " << cpu;
+    }
+}
+
+void Socket::setBusyPoll(int usec) const {
+    if (!Socketop::SetBusyPoll(m_fd, usec)) {
+        LOG_ERROR << "Socket set busy poll error. fd: " << m_fd << " usec: " << usec;
+    }
+}
+
 } // namespace Net
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <sys/uio.h>
 #include <sys/socket.h>
 #include <netinet/tcp.h>
+#include <netinet/udp.h>
+#include <linux/filter.h>
 #include "Utils/Logger.h"
 #include "Utils/Socketop.h"
 
@@ -13,7 +15,7 @@ namespace Utils {
 
 bool Socketop::CreateSocket(Addr_t addrType, Socket_t sockType, bool isNonblock, int& fd) {
     int type = isNonblock ? (static_cast<int>(sockType) | SOCK_NONBLOCK | SOCK_CLOEXEC) : static_cast<int>(sockType) | SOCK_CLOEXEC;
-    int protocol = Socket_t::TCP == sockType ? IPPROTO_TCP : IPPROTO_UDP;
+    int protocol = Addr_t::Unix == addrType ? 0 : (Socket_t::UDP == sockType ? IPPROTO_UDP : IPPROTO_TCP);
 
     fd = ::socket(static_cast<int>(addrType), type, protocol);
     if (fd < 0) {
@@ -37,9 +39,9 @@ bool Socketop::BindSocket(int fd, const Address::Ptr& addr) {
         return false;
     }
 
-    sockaddr sockAddr = {};
+    sockaddr_storage sockAddr = {};
     addr->getSockAddr(sockAddr);
-    if (::bind(fd, &sockAddr, static_cast<socklen_t>(sizeof(struct sockaddr_in))) < 0) {
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&sockAddr), addr->getSockLen()) < 0) {
         LOG_ERROR << "Socket bind address error. fd: " << fd << " errno: " << errno << ". error: " << strerror(errno);
         return false;
     }
@@ -59,35 +61,33 @@ bool Socketop::ListenSocket(int fd, int backlog) {
     return true;
 }
 
-bool Socketop::AcceptSocket(int fd, Address::Ptr& peerAddr, int& connfd) {
+bool Socketop::AcceptSocket(int fd, Address::Ptr& peerAddr, int& connfd, int& errCode) {
     if (fd < 0) {
         LOG_ERROR << "Socket accept error. invalid input param: " << fd;
+        errCode = EBADF;
         return false;
     }
 
-    sockaddr sockAddr = {};
+    sockaddr_storage sockAddr = {};
     socklen_t sockLen = sizeof(sockAddr);
 
-    connfd = ::accept(fd, &sockAddr, &sockLen);
+    connfd = ::accept4(fd, reinterpret_cast<sockaddr*>(&sockAddr), &sockLen, SOCK_NONBLOCK | SOCK_CLOEXEC);
     if (connfd < 0) {
-        LOG_ERROR << "Socket accept error. fd: " << fd << " errno: " << errno << ". error: " << strerror(errno);
+        errCode = errno;
+        if (EAGAIN != errCode && EWOULDBLOCK != errCode) {
+            LOG_ERROR << "Socket accept error. fd: " << fd << " errno: " << errCode << ". error: " << strerror(errCode);
+        }
         return false;
     }
 
-    Addr_t addrType;
-    if (!Socketop::GetSocketFamilyType(fd, addrType)) {
-        LOG_ERROR << "Socket accept error. Get socket family type error. fd: " << fd;
+    peerAddr = Address::Create(sockAddr, sockLen);
+    if (nullptr == peerAddr) {
+        LOG_ERROR << "Socket accept error. invalid peer address. fd: " << fd;
 
         ::close(connfd);
+        errCode = EINVAL;
         return false;
     }
-
-    if (Addr_t::IPv4 == addrType) {
-        peerAddr = std::make_shared<IPv4Address>(*reinterpret_cast<sockaddr_in*>(&sockAddr));
-    }
-    else {
-        peerAddr = std::make_shared<IPv6Address>(*reinterpret_cast<sockaddr_in6*>(&sockAddr));
-    }
     return true;
 }
 
@@ -97,10 +97,15 @@ bool Socketop::ConnectSocket(int fd, const Address::Ptr& peerAddr) {
         return false;
     }
 
-    sockaddr sockAddr = {};
+    sockaddr_storage sockAddr = {};
     peerAddr->getSockAddr(sockAddr);
 
-    if (::connect(fd, &sockAddr, sizeof(sockAddr)) < 0) {
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&sockAddr), peerAddr->getSockLen()) < 0) {
+        // 非阻塞socket连接进行中
+        if (EINPROGRESS == errno) {
+            return true;
+        }
+
         LOG_ERROR << "Socket connect error. fd: " << fd << " errno: " << errno << ". error: " << strerror(errno);
         return false;
     }
@@ -235,6 +240,24 @@ bool Socketop::GetLocalPort(int fd, uint16_t& port) {
     return true;
 }
 
+bool Socketop::GetLocalAddr(int fd, Address::Ptr& addr) {
+    if (fd < 0) {
+        LOG_ERROR << "Socket get local addr error. invalid input param: " << fd;
+        return false;
+    }
+
+    sockaddr_storage sockAddr = {};
+    socklen_t len = sizeof(sockAddr);
+
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&sockAddr), &len) == -1) {
+        LOG_ERROR << "Socket get local addr error. fd: " << fd << " errno: " << errno << ". error: " << strerror(errno);
+        return false;
+    }
+
+    addr = Address::Create(sockAddr, len);
+    return nullptr != addr;
+}
+
 bool Socketop::GetLocalIpAddrPort(int fd, std::string& ipAddr, uint16_t& port) {
     if (fd < 0) {
         LOG_ERROR << "Socket get local ip addr and port error. invalid input param: " << fd;
@@ -482,6 +505,34 @@ bool Socketop::SetReusePort(int fd, bool enabled) {
 #endif
 }
 
+bool Socketop::AttachReusePortCbpf(int fd, const std::vector<int>& cpus) {
+    if (fd < 0 || cpus.empty() || 2 * cpus.size() + 2 > BPF_MAXINSNS) {
+        LOG_ERROR << "Socket attach reuse port cbpf error. invalid input param. fd: " << fd << " group size: " << cpus.size();
+        return false;
+    }
+
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+    // A = 当前CPU编号; 依次比较各监听套接字的CPU，相等时返回其索引; 均不相等时返回组大小
+    std::vector<sock_filter> code;
+    code.push_back({BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)});
+    for (std::size_t idx = 0; idx < cpus.size(); ++idx) {
+        code.push_back({BPF_JMP | BPF_JEQ | BPF_K, 0, 1, static_cast<uint32_t>(cpus[idx])});
+        code.push_back({BPF_RET | BPF_K, 0, 0, static_cast<uint32_t>(idx)});
+    }
+    code.push_back({BPF_RET | BPF_K, 0, 0, static_cast<uint32_t>(cpus.size())});
+    sock_fprog prog = {static_cast<unsigned short>(code.size()), code.data()};
+
+    if (::setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0) {
+        LOG_ERROR << "Socket attach reuse port cbpf error. fd: " << fd << " errno: " << errno << ". error: " << strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    LOG_ERROR << "Socket attach reuse port cbpf error. not supported on this platform. fd: " << fd;
+    return false;
+#endif
+}
+
 bool Socketop::IsReusePort(int fd) {
     if (fd < 0) {
         LOG_ERROR << "Socket is reuse port error. fd invalid. fd: " << fd;
@@ -504,6 +555,61 @@ bool Socketop::IsReusePort(int fd) {
 #endif
 }
 
+bool Socketop::SetIncomingCpu(int fd, int cpu) {
+    if (fd < 0 || cpu < 0) {
+        LOG_ERROR << "Socket set incoming cpu error. invalid input param. fd: " << fd << " cpu: " << cpu;
+        return false;
+    }
+
+#ifdef SO_INCOMING_CPU
+    if (::setsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu)) < 0) {
+        LOG_ERROR << "Socket set incoming cpu error. fd: " << fd << " errno: " << errno << ". error: " << strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    LOG_ERROR << "Socket set incoming cpu error. not supported on this platform. fd: " << fd;
+    return false;
+#endif
+}
+
+bool Socketop::GetIncomingCpu(int fd, int& cpu) {
+    if (fd < 0) {
+        LOG_ERROR << "Socket get incoming cpu error. fd invalid. fd: " << fd;
+        return false;
+    }
+
+#ifdef SO_INCOMING_CPU
+    socklen_t optLen = sizeof(cpu);
+    if (::getsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, &optLen) < 0) {
+        LOG_ERROR << "Socket get incoming cpu error. fd: " << fd << " errno: " << errno << ". error: " << strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    LOG_ERROR << "Socket get incoming cpu error. not supported on this platform. fd: " << fd;
+    return false;
+#endif
+}
+
+bool Socketop::SetBusyPoll(int fd, int usec) {
+    if (fd < 0 || usec < 0) {
+        LOG_ERROR << "Socket set busy poll error. invalid input param. fd: " << fd << " usec: " << usec;
+        return false;
+    }
+
+#ifdef SO_BUSY_POLL
+    if (::setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec)) < 0) {
+        LOG_ERROR << "Socket set busy poll error. fd: " << fd << " errno: " << errno << ". error: " << strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    LOG_ERROR << "Socket set busy poll error. not supported on this platform. fd: " << fd;
+    return false;
+#endif
+}
+
 bool Socketop::SetNodelay(int fd, bool enabled) {
     if (fd < 0) {
         LOG_ERROR << "Socket set nodelay error. invalid input param. fd: " << fd;
@@ -546,7 +652,7 @@ bool Socketop::SetBlocking(int fd, bool enabled) {
     }
 
     int flags = ::fcntl(fd, F_GETFL, 0);
-    if (!enabled) {
+    if (enabled) {
         flags &= ~O_NONBLOCK;
     }
     else {
@@ -562,7 +668,7 @@ bool Socketop::SetBlocking(int fd, bool enabled) {
 
 bool Socketop::IsCloexec(int fd) {
     int flags = ::fcntl(fd, F_GETFD, 0);
-    return 0 == (flags & FD_CLOEXEC);
+    return flags >= 0 && 0 != (flags & FD_CLOEXEC);
 }
 
 bool Socketop::SetCloexec(int fd, bool enabled) {
@@ -608,4 +714,54 @@ ssize_t Socketop::Write(int fd, const void* buf, size_t len) {
     return ::write(fd, buf, len);
 }
 
+int Socketop::RecvMmsg(int fd, struct mmsghdr* msgs, unsigned int vlen) {
+    return ::recvmmsg(fd, msgs, vlen, MSG_DONTWAIT, nullptr);
+}
+
+int Socketop::SendMmsg(int fd, struct mmsghdr* msgs, unsigned int vlen) {
+    return ::sendmmsg(fd, msgs, vlen, MSG_DONTWAIT);
+}
+
+ssize_t Socketop::SendMsg(int fd, const struct msghdr* msg) {
+    return ::sendmsg(fd, msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+}
+
+ssize_t Socketop::RecvMsg(int fd, struct msghdr* msg) {
+    return ::recvmsg(fd, msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+}
+
+bool Socketop::CreatePipe(int& readFd, int& writeFd, std::size_t capacity) {
+    int fds[2] = {-1, -1};
+    if (::pipe2(fds, O_NONBLOCK | O_CLOEXEC) < 0) {
+        LOG_ERROR << "Create pipe error. errno: " << errno << ". error: " << strerror(errno);
+        return false;
+    }
+
+    if (::fcntl(fds[1], F_SETPIPE_SZ, static_cast<int>(capacity)) < 0) {
+        LOG_WARN << "Set pipe capacity warning. errno: " << errno << ". error: " << strerror(errno) << " capacity: " << capacity;
+    }
+
+    readFd = fds[0];
+    writeFd = fds[1];
+    return true;
+}
+
+ssize_t Socketop::Splice(int fdIn, int fdOut, std::size_t len) {
+    return ::splice(fdIn, nullptr, fdOut, nullptr, len, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+}
+
+bool Socketop::SetUdpGro(int fd, bool enabled) {
+#ifdef UDP_GRO
+    int optval = enabled ? 1 : 0;
+    if (::setsockopt(fd, SOL_UDP, UDP_GRO, &optval, sizeof(optval)) < 0) {
+        LOG_WARN << "Socket set udp gro error. errno: " << errno << ". error: " << strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    LOG_WARN << "Socket set udp gro error. UDP_GRO not supported.";
+    return false;
+#endif
+}
+
 } // namespace Utils
\ No newline at end of file
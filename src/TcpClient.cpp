@@ -0,0 +1,266 @@
+#include <string>
+#include <functional>
+#include "Utils/Logger.h"
+#include "Net/EventLoop.h"
+#include "Net/TcpClient.h"
+
+namespace Net {
+
+/**
+ * @brief  从线程池中选择客户端所属的工作事件循环
+ * @return 工作事件循环，线程池无效时为空
+ * @param  pool 事件循环线程池
+ * @param  peerAddr 对端地址
+ */
+static EventLoopWkPtr SelectWorkLoop(const EventLoopThreadPool::Ptr& pool, const Address::Ptr& peerAddr) {
+    EventLoopWkPtr loop;
+    uint64_t hashKey = nullptr == peerAddr ? 0 : std::hash<std::string>()(peerAddr->printIpPort());
+    if (nullptr == pool || !pool->getNextWorkEventLoop(loop, hashKey)) {
+        LOG_ERROR << "Tcp client select work loop error. invalid event loop thread pool.";
+    }
+    return loop;
+}
+
+TcpClient::TcpClient(const EventLoopWkPtr& loop, Address::Ptr peerAddr)
+    : m_ownerLoop(loop),
+      m_peerAddr(std::move(peerAddr)),
+      m_connector(std::make_shared<TcpConnector>(loop, m_peerAddr)),
+      m_isConnect(false),
+      m_isRetry(false),
+      m_drainCbId(0),
+      m_initRetryDelay(CONNECTOR_INIT_RETRY_DELAY),
+      m_maxRetryDelay(CONNECTOR_MAX_RETRY_DELAY) {
+    LOG_DEBUG << "Tcp client construct. peer addr: " << m_peerAddr->printIpPort();
+}
+
+TcpClient::TcpClient(const EventLoopThreadPool::Ptr& pool, Address::Ptr peerAddr)
+    : TcpClient(SelectWorkLoop(pool, peerAddr), peerAddr) {
+    m_pool = pool;
+}
+
+TcpClient::~TcpClient() {
+    auto pool = m_pool.lock();
+    if (nullptr != pool && 0 != m_drainCbId) {
+        pool->removeDrainCallback(m_drainCbId);
+    }
+
+    this->getConnector()->stop();
+
+    auto conn = this->getConnection();
+    if (nullptr != conn) {
+        conn->close(0);
+    }
+
+    LOG_DEBUG << "Tcp client destruct. peer addr: " << m_peerAddr->printIpPort();
+}
+
+bool TcpClient::connect() {
+    auto weakSelf = this->weak_from_this();
+    auto connector = this->getConnector();
+    connector->setNewConnCb([weakSelf](Socket::Ptr& connSock, Timestamp recvTime) {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->onNewConnection(connSock, recvTime);
+        }
+    });
+
+    // 共享的线程池移除所属事件循环时迁移连接及连接器
+    auto pool = m_pool.lock();
+    if (nullptr != pool && 0 == m_drainCbId) {
+        m_drainCbId = pool->addDrainCallback([weakSelf](const EventLoopPtr& loop, bool isForce) {
+            auto strongSelf = weakSelf.lock();
+            if (nullptr != strongSelf) {
+                strongSelf->drainInLoop(loop, isForce);
+            }
+        });
+    }
+
+    m_isConnect = true;
+    return connector->start();
+}
+
+void TcpClient::disconnect() {
+    m_isConnect = false;
+
+    auto conn = this->getConnection();
+    if (nullptr != conn) {
+        conn->shutdown();
+    }
+}
+
+void TcpClient::stop() {
+    m_isConnect = false;
+    this->getConnector()->stop();
+}
+
+void TcpClient::onNewConnection(Socket::Ptr& connSock, Timestamp recvTime) {
+    EventLoopWkPtr ownerLoop;
+    {
+        std::lock_guard<std::mutex> lock(m_connMutex);
+        ownerLoop = m_ownerLoop;
+    }
+
+    auto loop = ownerLoop.lock();
+    if (nullptr == loop) {
+        LOG_ERROR << "Tcp client new connection error. owner loop expired. peer addr: " << m_peerAddr->printIpPort();
+        return;
+    }
+
+    // 与服务端连接一致，从所属事件循环的slab内存池中分配
+    auto conn = TcpConnection::Create(ownerLoop, connSock);
+    conn->setConnectCallback(m_connCb);
+    conn->setMessageCallback(m_readCb);
+    conn->setWriteCompleteCallback(m_writeCb);
+
+    auto weakSelf = this->weak_from_this();
+    conn->setCloseCallback([weakSelf](const Connection::Ptr& conn) {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->onConnectionClosed(conn);
+        }
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(m_connMutex);
+        m_conn = conn;
+    }
+    this->countConnection(loop);
+
+    if (!conn->open()) {
+        LOG_ERROR << "Tcp client new connection error. open connection failed. " << conn->getConnectionInfo();
+    }
+}
+
+void TcpClient::onConnectionClosed(const Connection::Ptr& conn) {
+    bool isCurrent = false;
+    {
+        std::lock_guard<std::mutex> lock(m_connMutex);
+        if (m_conn == conn) {
+            m_conn.reset();
+            isCurrent = true;
+        }
+    }
+
+    if (isCurrent) {
+        this->uncountConnection(nullptr);
+    }
+
+    // 连接被动断开后按配置重连
+    if (m_isRetry && m_isConnect) {
+        LOG_INFO << "Tcp client reconnect. peer addr: " << m_peerAddr->printIpPort();
+        this->getConnector()->restart();
+    }
+}
+
+void TcpClient::drainInLoop(const EventLoopPtr& loop, bool isForce) {
+    auto conn = this->getConnection();
+    auto connector = this->getConnector();
+    EventLoopWkPtr ownerLoop;
+    {
+        std::lock_guard<std::mutex> lock(m_connMutex);
+        ownerLoop = m_ownerLoop;
+    }
+
+    if (isForce) {
+        if (nullptr != conn && conn->getOwnerLoop().lock() == loop) {
+            LOG_WARN << "Tcp client drain warning. force close connection. " << conn->getConnectionInfo();
+            conn->close(0);
+        }
+        return;
+    }
+
+    // 被移除的事件循环已不在选择范围内，不会再次被选中
+    auto pool = m_pool.lock();
+    EventLoopWkPtr dstLoop;
+    if (ownerLoop.lock() != loop || nullptr == pool || !pool->getNextWorkEventLoop(dstLoop, std::hash<std::string>()(m_peerAddr->printIpPort()))
+        || dstLoop.lock() == loop) {
+        return;
+    }
+
+    // 重建连接器，进行中的连接在目标事件循环中重新发起
+    bool isConnecting = m_isConnect && nullptr == conn;
+    connector->stop();
+    auto newConnector = this->createConnector(dstLoop);
+    {
+        std::lock_guard<std::mutex> lock(m_connMutex);
+        m_ownerLoop = dstLoop;
+        m_connector = newConnector;
+    }
+    if (isConnecting) {
+        newConnector->start();
+    }
+
+    if (nullptr == conn || conn->getOwnerLoop().lock() != loop) {
+        return;
+    }
+
+    // 迁移成功后计入目标事件循环，失败时保持计数，由超时后的强制关闭处理
+    auto weakSelf = this->weak_from_this();
+    bool result = conn->migrate(dstLoop, [weakSelf](const Connection::Ptr& conn, bool result) {
+        auto strongSelf = weakSelf.lock();
+        auto loop = conn->getOwnerLoop().lock();
+        if (result && nullptr != strongSelf && nullptr != loop) {
+            strongSelf->countConnection(loop);
+        }
+    });
+
+    if (!result) {
+        LOG_WARN << "Tcp client drain warning. migrate connection failed, shutdown. " << conn->getConnectionInfo();
+        conn->shutdown();
+        return;
+    }
+
+    // 活跃连接数在原事件循环注销连接后扣减，使排空等待覆盖迁移过程
+    auto strongSelf = this->shared_from_this();
+    loop->executeTaskInLoop([strongSelf, loop]() {
+        strongSelf->uncountConnection(loop);
+    });
+}
+
+TcpConnector::Ptr TcpClient::createConnector(const EventLoopWkPtr& loop) {
+    auto connector = std::make_shared<TcpConnector>(loop, m_peerAddr);
+    {
+        std::lock_guard<std::mutex> lock(m_connMutex);
+        connector->setRetryDelay(m_initRetryDelay, m_maxRetryDelay);
+    }
+
+    auto weakSelf = this->weak_from_this();
+    connector->setNewConnCb([weakSelf](Socket::Ptr& connSock, Timestamp recvTime) {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->onNewConnection(connSock, recvTime);
+        }
+    });
+    return connector;
+}
+
+void TcpClient::countConnection(const EventLoopPtr& loop) {
+    if (m_pool.expired()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_connMutex);
+    auto countedLoop = m_countedLoop.lock();
+    if (countedLoop == loop) {
+        return;
+    }
+
+    if (nullptr != countedLoop) {
+        countedLoop->decActiveConnections();
+    }
+    loop->incActiveConnections();
+    m_countedLoop = loop;
+}
+
+void TcpClient::uncountConnection(const EventLoopPtr& loop) {
+    std::lock_guard<std::mutex> lock(m_connMutex);
+    auto countedLoop = m_countedLoop.lock();
+    if (nullptr == countedLoop || (nullptr != loop && countedLoop != loop)) {
+        return;
+    }
+
+    countedLoop->decActiveConnections();
+    m_countedLoop.reset();
+}
+
+} // namespace Net
\ No newline at end of file
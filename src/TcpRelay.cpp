@@ -0,0 +1,317 @@
+#include <cstring>
+#include <unistd.h>
+#include "Utils/Logger.h"
+#include "Utils/Socketop.h"
+#include "Net/Channel.h"
+#include "Net/EventLoop.h"
+#include "Net/TcpRelay.h"
+
+namespace Net {
+
+TcpRelay::TcpRelay(const TcpConnection::Ptr& first, const TcpConnection::Ptr& second)
+    : m_isSpliceEnabled(true),
+      m_isStarted(false),
+      m_isFinished(false) {
+
+    if (nullptr == first || nullptr == second || first == second) {
+        LOG_FATAL << "TcpRelay construct error. invalid input param.";
+    }
+
+    m_ownerLoop = first->getOwnerLoop();
+    m_pipes[0].m_src = first;
+    m_pipes[0].m_dst = second;
+    m_pipes[1].m_src = second;
+    m_pipes[1].m_dst = first;
+    LOG_DEBUG << "TcpRelay construct. " << first->getConnectionInfo() << " <-> " << second->getConnectionInfo();
+}
+
+TcpRelay::~TcpRelay() {
+    for (auto& pipe : m_pipes) {
+        if (pipe.m_pipeReadFd >= 0) {
+            ::close(pipe.m_pipeReadFd);
+        }
+        if (pipe.m_pipeWriteFd >= 0) {
+            ::close(pipe.m_pipeWriteFd);
+        }
+    }
+
+    LOG_DEBUG << "TcpRelay deconstruct. forward bytes: " << m_pipes[0].m_bytes << " backward bytes: " << m_pipes[1].m_bytes;
+}
+
+bool TcpRelay::start() {
+    if (m_isStarted) {
+        LOG_WARN << "TcpRelay start warning. already started.";
+        return true;
+    }
+
+    auto first = m_pipes[0].m_src.lock();
+    auto second = m_pipes[1].m_src.lock();
+    if (nullptr == first || nullptr == second) {
+        LOG_ERROR << "TcpRelay start error. connection expired.";
+        return false;
+    }
+
+    auto loop = m_ownerLoop.lock();
+    if (nullptr == loop || !loop->isInCurrentThread() || second->getOwnerLoop().lock() != loop) {
+        LOG_ERROR << "TcpRelay start error. connections must belong to the current event loop. "
+            << first->getConnectionInfo() << " <-> " << second->getConnectionInfo();
+        return false;
+    }
+
+    if (ConnState_t::ConnStateConnected != first->getConnState() || ConnState_t::ConnStateConnected != second->getConnState()
+        || nullptr != first->m_relay || nullptr != second->m_relay) {
+        LOG_ERROR << "TcpRelay start error. connection not connected or already relayed. "
+            << first->getConnectionInfo() << " <-> " << second->getConnectionInfo();
+        return false;
+    }
+
+    // 每个方向一个管道
+    if (m_isSpliceEnabled) {
+        for (auto& pipe : m_pipes) {
+            if (!Socketop::CreatePipe(pipe.m_pipeReadFd, pipe.m_pipeWriteFd, TCP_RELAY_PIPE_SIZE)) {
+                LOG_WARN << "TcpRelay start warning. create pipe failed, fallback to copy.";
+                m_isSpliceEnabled = false;
+                break;
+            }
+        }
+    }
+
+    m_isStarted = true;
+    auto self = this->shared_from_this();
+    first->m_relay = self;
+    second->m_relay = self;
+
+    // 先转发输入缓冲区中已读取的数据，再开启读事件
+    for (auto& pipe : m_pipes) {
+        auto src = pipe.m_src.lock();
+        auto dst = pipe.m_dst.lock();
+
+        std::size_t size = 0;
+        auto data = src->m_inBuf.peek(size);
+        if (size > 0) {
+            dst->send(data, size);
+            src->m_inBuf.moveReadStartPos(size);
+            pipe.m_bytes += size;
+        }
+        src->m_inBuf.releaseIfEmpty();
+
+        this->flush(pipe);
+    }
+    return true;
+}
+
+void TcpRelay::stop() {
+    if (!m_isStarted || m_isFinished) {
+        return;
+    }
+
+    auto self = this->shared_from_this();
+    for (auto& pipe : m_pipes) {
+        pipe.m_isFinished = true;
+    }
+    this->finish();
+}
+
+void TcpRelay::handleRead(const TcpConnection::Ptr& conn) {
+    auto self = this->shared_from_this();
+    auto& pipe = (m_pipes[0].m_src.lock() == conn) ? m_pipes[0] : m_pipes[1];
+    if (pipe.m_isSrcEof || m_isFinished) {
+        conn->m_channel->setReadEnabled(false);
+        return;
+    }
+
+    if (!m_isSpliceEnabled) {
+        this->copyRead(pipe);
+        return;
+    }
+
+    // 管道已满时等待目的端写出
+    if (pipe.m_pending >= TCP_RELAY_PIPE_SIZE) {
+        this->flush(pipe);
+        return;
+    }
+
+    ssize_t readSize = Socketop::Splice(conn->getFd(), pipe.m_pipeWriteFd, TCP_RELAY_PIPE_SIZE - pipe.m_pending);
+    if (readSize > 0) {
+        pipe.m_pending += readSize;
+    }
+    else if (0 == readSize) {
+        // 对端关闭写方向，管道中数据写完后半关闭目的端
+        LOG_DEBUG << "TcpRelay remote shutdown. " << conn->getConnectionInfo();
+        pipe.m_isSrcEof = true;
+    }
+    else if (EAGAIN == errno || EINTR == errno) {
+        // 管道已满或暂无数据
+    }
+    else if (EINVAL == errno && 0 == pipe.m_bytes && 0 == pipe.m_pending) {
+        // 套接字不支持splice，改为复制转发
+        LOG_WARN << "TcpRelay splice not supported, fallback to copy. " << conn->getConnectionInfo();
+        m_isSpliceEnabled = false;
+        this->copyRead(pipe);
+        return;
+    }
+    else {
+        LOG_ERROR << "TcpRelay handleRead error. errno: " << errno << ". error: " << strerror(errno) << " " << conn->getConnectionInfo();
+        this->finish();
+        return;
+    }
+
+    this->flush(pipe);
+}
+
+void TcpRelay::handleWrite(const TcpConnection::Ptr& conn) {
+    auto self = this->shared_from_this();
+    auto& pipe = (m_pipes[0].m_dst.lock() == conn) ? m_pipes[0] : m_pipes[1];
+    if (m_isFinished) {
+        return;
+    }
+    this->flush(pipe);
+}
+
+void TcpRelay::handleClose(const TcpConnection::Ptr& conn) {
+    auto self = this->shared_from_this();
+    if (m_isFinished) {
+        return;
+    }
+
+    // 发往关闭连接的数据丢弃，来自关闭连接的数据写完后结束
+    for (auto& pipe : m_pipes) {
+        if (pipe.m_dst.lock() == conn) {
+            pipe.m_isFinished = true;
+        }
+        else {
+            pipe.m_isSrcEof = true;
+        }
+    }
+
+    auto& pipe = (m_pipes[0].m_src.lock() == conn) ? m_pipes[0] : m_pipes[1];
+    this->flush(pipe);
+}
+
+void TcpRelay::copyRead(RelayPipe& pipe) {
+    auto src = pipe.m_src.lock();
+    auto dst = pipe.m_dst.lock();
+    if (nullptr == src || nullptr == dst) {
+        this->finish();
+        return;
+    }
+
+    int errCode = 0;
+    auto readSize = src->m_inBuf.readFd(src->getFd(), errCode);
+    if (readSize > 0) {
+        std::size_t size = 0;
+        auto data = src->m_inBuf.peek(size);
+        dst->send(data, size);
+        src->m_inBuf.moveReadStartPos(size);
+        src->m_inBuf.releaseIfEmpty();
+        pipe.m_bytes += size;
+    }
+    else if (0 == readSize) {
+        LOG_DEBUG << "TcpRelay remote shutdown. " << src->getConnectionInfo();
+        pipe.m_isSrcEof = true;
+    }
+    else if (EAGAIN != errCode && EWOULDBLOCK != errCode && EINTR != errCode) {
+        LOG_ERROR << "TcpRelay copy read error. error: " << errCode << " " << src->getConnectionInfo();
+        this->finish();
+        return;
+    }
+
+    this->flush(pipe);
+}
+
+void TcpRelay::flush(RelayPipe& pipe) {
+    if (m_isFinished || pipe.m_isFinished) {
+        if (!m_isFinished && m_pipes[0].m_isFinished && m_pipes[1].m_isFinished) {
+            this->finish();
+        }
+        return;
+    }
+
+    auto src = pipe.m_src.lock();
+    auto dst = pipe.m_dst.lock();
+    if (nullptr == dst) {
+        this->finish();
+        return;
+    }
+
+    // 输出缓冲区中的数据先于管道中的数据写出
+    if (pipe.m_pending > 0 && 0 == dst->m_outBuf.readableBytes()) {
+        ssize_t writeSize = Socketop::Splice(pipe.m_pipeReadFd, dst->getFd(), pipe.m_pending);
+        if (writeSize > 0) {
+            pipe.m_pending -= writeSize;
+            pipe.m_bytes += writeSize;
+        }
+        else if (writeSize < 0 && EAGAIN != errno && EINTR != errno) {
+            LOG_ERROR << "TcpRelay flush error. errno: " << errno << ". error: " << strerror(errno) << " " << dst->getConnectionInfo();
+            this->finish();
+            return;
+        }
+    }
+
+    bool isSrcReadable = nullptr != src && !pipe.m_isSrcEof && ConnState_t::ConnStateConnected == src->getConnState();
+    if (pipe.m_pending > 0 || 0 != dst->m_outBuf.readableBytes()) {
+        // 目的端阻塞，暂停读取来源端，等待目的端可写
+        if (isSrcReadable && src->m_channel->readEnabled()) {
+            src->m_channel->setReadEnabled(false);
+        }
+        if (!dst->m_channel->writeEnabled()) {
+            dst->m_channel->setWriteEnabled(true);
+        }
+        return;
+    }
+
+    // 数据已全部写出
+    if (dst->m_channel->writeEnabled()) {
+        dst->m_channel->setWriteEnabled(false);
+    }
+
+    if (isSrcReadable) {
+        if (!src->m_channel->readEnabled()) {
+            src->m_channel->setReadEnabled(true);
+        }
+        return;
+    }
+
+    // 来源端已结束，半关闭目的端
+    if (nullptr != src && ConnState_t::ConnStateConnected == src->getConnState() && src->m_channel->readEnabled()) {
+        src->m_channel->setReadEnabled(false);
+    }
+    if (ConnState_t::ConnStateConnected == dst->getConnState()) {
+        dst->m_sock->shutdown(SocketShutdown_t::ShutdownWrite);
+    }
+    pipe.m_isFinished = true;
+
+    if (m_pipes[0].m_isFinished && m_pipes[1].m_isFinished) {
+        this->finish();
+    }
+}
+
+void TcpRelay::finish() {
+    if (m_isFinished) {
+        return;
+    }
+
+    auto self = this->shared_from_this();
+    m_isFinished = true;
+
+    // 关闭仍处于转发中的连接，已关闭的连接已解除转发关系
+    auto now = std::chrono::system_clock::now();
+    for (auto& pipe : m_pipes) {
+        auto conn = pipe.m_src.lock();
+        if (nullptr == conn || self != conn->m_relay) {
+            continue;
+        }
+
+        conn->m_relay = nullptr;
+        if (ConnState_t::ConnStateClosed != conn->getConnState()) {
+            conn->handleClose(now);
+        }
+    }
+
+    LOG_DEBUG << "TcpRelay finished. forward bytes: " << m_pipes[0].m_bytes << " backward bytes: " << m_pipes[1].m_bytes;
+    if (nullptr != m_finishCb) {
+        m_finishCb(self);
+    }
+}
+
+} // namespace Net
\ No newline at end of file
@@ -1,14 +1,60 @@
+#include <algorithm>
 #include "Utils/Logger.h"
+#include "Utils/Socketop.h"
 #include "Net/EventLoop.h"
 #include "Net/TcpServer.h"
 
 namespace Net {
 
+/**
+ * @note  连接关闭回调在连接所属事件循环中执行，直接从分片中移除
+ * @brief 设置连接关闭时从分片中移除的回调函数
+ * @param conn 连接
+ * @param shard 连接所属分片
+ */
+static void SetShardCloseCallback(const Connection::Ptr& conn, const TcpServer::ConnectionShard::Ptr& shard) {
+    TcpServer::ConnectionShard::WkPtr weakShard = shard;
+    conn->setCloseCallback([weakShard](const Connection::Ptr& conn) {
+        auto shard = weakShard.lock();
+        if (nullptr != shard && 0 != shard->m_connMap.erase(conn->getConnectionId())) {
+            auto ownerLoop = shard->m_ownerLoop.lock();
+            if (nullptr != ownerLoop) {
+                ownerLoop->decActiveConnections();
+            }
+        }
+    });
+}
+
 TcpServer::TcpServer(Address::Ptr addr, const ThreadInitCb& cb, unsigned int numWorkThreads, bool reuseport)
+    : TcpServer(std::make_shared<EventLoopThreadPool>(numWorkThreads, cb), std::move(addr), reuseport) {
+}
+
+TcpServer::TcpServer(const EventLoopThreadPool::Ptr& pool, Address::Ptr addr, bool reuseport)
     : m_isStarted(false),
       m_isReusePort(reuseport),
       m_addr(std::move(addr)),
-      m_workLoopThreadPool(std::make_shared<EventLoopThreadPool>(numWorkThreads, cb)) {
+      m_workLoopThreadPool(pool),
+      m_acceptMode(AcceptMode_t::AcceptMainLoop),
+      m_isCpuSteering(false),
+      m_isIncomingCpu(false),
+      m_socketBusyPollUs(0),
+      m_drainCbId(0),
+      m_isMigrateOnDrain(false),
+      m_rebalanceTimerId(0),
+      m_migratedCount(0) {
+    if (nullptr == m_workLoopThreadPool) {
+        LOG_FATAL << "Tcp server construct error. invalid event loop thread pool. server info: " << m_addr->printIpPort();
+    }
+
+    // 为每个工作事件循环创建连接管理分片
+    std::vector<EventLoop::WkPtr> workLoops;
+    if (!m_workLoopThreadPool->getWorkEventLoops(workLoops)) {
+        LOG_FATAL << "Tcp server construct error. get work event loops failed. server info: " << m_addr->printIpPort();
+    }
+
+    for (const auto& workLoop : workLoops) {
+        this->getConnectionShard(workLoop.lock());
+    }
 
     LOG_DEBUG << "Tcp server construct. server info: " << m_addr->printIpPort();
 }
@@ -30,23 +76,130 @@ void TcpServer::run() {
         m_isStarted = true;
     }
 
+    // 共享的线程池移除工作事件循环时排空本服务在其中的连接
+    auto weakSelf = this->weak_from_this();
+    m_drainCbId = m_workLoopThreadPool->addDrainCallback([weakSelf](const EventLoopPtr& loop, bool isForce) {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->drainConnectionsInLoop(loop, isForce);
+        }
+    });
+
+    if (AcceptMode_t::AcceptPerWorker == m_acceptMode) {
+        // 监听套接字与工作事件循环一一对应，监听期间禁止扩缩容
+        m_workLoopThreadPool->holdWorkLoopCount();
+        if (Addr_t::Unix != m_addr->getAddrType() && this->listenInWorkLoops()) {
+            return;
+        }
+
+        LOG_WARN << "Tcp server run warning. per worker accept not available, fallback to main loop. server info: "
+            << m_addr->printIpPort();
+        m_workAcceptors.clear();
+        m_workLoopThreadPool->releaseWorkLoopCount();
+    }
+
+    this->listenInMainLoop();
+}
+
+void TcpServer::listenInMainLoop() {
     // 创建acceptor
     EventLoop::WkPtr mainLoop;
     m_workLoopThreadPool->getMainEventLoop(mainLoop);
-    m_acceptor = std::make_shared<TcpAcceptor>(mainLoop, m_addr, m_isReusePort);
+    if (Addr_t::Unix == m_addr->getAddrType()) {
+        m_acceptor = std::make_shared<UnixAcceptor>(mainLoop, m_addr);
+    }
+    else {
+        m_acceptor = std::make_shared<TcpAcceptor>(mainLoop, m_addr, m_isReusePort);
+    }
 
     auto weakSelf = this->weak_from_this();
     mainLoop.lock()->executeTask([weakSelf]() {
         auto strongSelf = std::dynamic_pointer_cast<TcpServer>(weakSelf.lock());
         strongSelf->m_acceptor->setNewConnCb([weakSelf](Socket::Ptr& connSock, Timestamp recvTime) {
+            // 停止监听的任务执行前接受的连接直接关闭
             auto strongSelf = weakSelf.lock();
-            strongSelf->onNewConnection(connSock, recvTime);
+            if (nullptr != strongSelf && strongSelf->m_isStarted) {
+                strongSelf->onNewConnection(connSock, recvTime);
+            }
         });
 
         strongSelf->m_acceptor->listen();
     });
 }
 
+bool TcpServer::listenInWorkLoops() {
+    std::vector<EventLoop::WkPtr> workLoops;
+    if (!m_workLoopThreadPool->getWorkEventLoops(workLoops)) {
+        LOG_ERROR << "Tcp server listen error. get work event loops failed. server info: " << m_addr->printIpPort();
+        return false;
+    }
+
+    // 按工作事件循环顺序在调用线程中依次绑定并开始监听，监听顺序即端口复用监听组中的索引
+    for (const auto& workLoop : workLoops) {
+        auto acceptor = std::make_shared<TcpAcceptor>(workLoop, m_addr, true);
+        if (!Socketop::IsReusePort(acceptor->getFd())) {
+            LOG_ERROR << "Tcp server listen error. reuse port not enabled. server info: " << m_addr->printIpPort();
+            return false;
+        }
+
+        // 内核在监听组中优先选择与处理数据包的CPU一致的监听套接字
+        int boundCpu = workLoop.lock()->getBoundCpu();
+        if (m_isIncomingCpu && boundCpu >= 0) {
+            Socketop::SetIncomingCpu(acceptor->getFd(), boundCpu);
+        }
+
+        if (!acceptor->listenSocket()) {
+            LOG_ERROR << "Tcp server listen error. listen failed. server info: " << m_addr->printIpPort();
+            return false;
+        }
+        m_workAcceptors.push_back(acceptor);
+    }
+
+    // 各工作事件循环需一对一绑定到不同CPU，否则按CPU分发无意义，使用内核哈希
+    if (m_isCpuSteering) {
+        std::vector<int> cpus;
+        for (const auto& workLoop : workLoops) {
+            int boundCpu = workLoop.lock()->getBoundCpu();
+            if (boundCpu < 0 || cpus.end() != std::find(cpus.begin(), cpus.end(), boundCpu)) {
+                break;
+            }
+            cpus.push_back(boundCpu);
+        }
+
+        if (cpus.size() != workLoops.size()) {
+            LOG_WARN << "Tcp server listen warning. work loops not pinned to distinct cpus, use kernel hash. server info: "
+                << m_addr->printIpPort();
+        }
+        else if (!Socketop::AttachReusePortCbpf(m_workAcceptors.front()->getFd(), cpus)) {
+            LOG_WARN << "Tcp server listen warning. attach cpu steering program failed, use kernel hash. server info: "
+                << m_addr->printIpPort();
+        }
+    }
+
+    // 接受的连接直接在本事件循环中创建，无需跨线程投递
+    auto weakSelf = this->weak_from_this();
+    for (std::size_t idx = 0; idx < workLoops.size(); ++idx) {
+        auto loop = workLoops[idx].lock();
+        auto shard = this->getConnectionShard(loop);
+        TcpAcceptor::Ptr acceptor = m_workAcceptors[idx];
+
+        loop->executeTask([weakSelf, shard, acceptor]() {
+            acceptor->setNewConnCb([weakSelf, shard](Socket::Ptr& connSock, Timestamp recvTime) {
+                // 停止监听的任务执行前接受的连接直接关闭
+                auto strongSelf = weakSelf.lock();
+                auto ownerLoop = shard->m_ownerLoop.lock();
+                if (nullptr != strongSelf && nullptr != ownerLoop && strongSelf->m_isStarted) {
+                    ownerLoop->incActiveConnections();
+                    strongSelf->newConnectionInLoop(shard, connSock);
+                }
+            });
+
+            acceptor->listen();
+        });
+    }
+    return true;
+}
+
 void TcpServer::shutdown() {
     if (!m_isStarted) {
         LOG_WARN << "Tcp server shutdown warning. already shutdown. server info: " << m_addr->printIpPort();
@@ -56,46 +209,400 @@ void TcpServer::shutdown() {
         m_isStarted = false;
     }
 
-    // 关闭tcp服务管理的所有连接
-    for (auto& pair : m_connMap) {
-        auto conn = pair.second;
-        conn->getOwnerLoop().lock()->executeTask([conn]() {
+    // 停止接受新连接，不等待其他事件循环，避免在工作事件循环中关闭时互相等待；停止前接受的连接由回调直接关闭
+    EventLoop::WkPtr mainLoop;
+    m_workLoopThreadPool->getMainEventLoop(mainLoop);
+    if (0 != m_rebalanceTimerId && !mainLoop.expired()) {
+        mainLoop.lock()->delTimer(m_rebalanceTimerId);
+        m_rebalanceTimerId = 0;
+    }
+
+    if (nullptr != m_acceptor && !mainLoop.expired()) {
+        TcpAcceptor::Ptr acceptor = m_acceptor;
+        mainLoop.lock()->executeTask([acceptor]() {
+            acceptor->stop();
+        });
+    }
+
+    // 全部工作事件循环中的监听器停止后才允许扩缩容
+    if (!m_workAcceptors.empty()) {
+        auto pool = m_workLoopThreadPool;
+        auto remainCount = std::make_shared<std::atomic<std::size_t>>(m_workAcceptors.size());
+        auto stopDone = [pool, remainCount]() {
+            if (1 == remainCount->fetch_sub(1)) {
+                pool->releaseWorkLoopCount();
+            }
+        };
+
+        for (auto& acceptor : m_workAcceptors) {
+            auto ownerLoop = acceptor->getOwnerLoop().lock();
+            TcpAcceptor::Ptr workAcceptor = acceptor;
+            if (nullptr == ownerLoop || !ownerLoop->executeTask([workAcceptor, stopDone]() {
+                workAcceptor->stop();
+                stopDone();
+            })) {
+                stopDone();
+            }
+        }
+        m_workAcceptors.clear();
+    }
+
+    if (0 != m_drainCbId) {
+        m_workLoopThreadPool->removeDrainCallback(m_drainCbId);
+        m_drainCbId = 0;
+    }
+
+    // 关闭tcp服务管理的所有连接，在分片所属事件循环中执行
+    ConnectionShardMap connShards;
+    {
+        std::lock_guard<std::mutex> lock(m_shardMutex);
+        connShards = m_connShards;
+    }
+
+    for (auto& pair : connShards) {
+        auto shard = pair.second;
+        auto ownerLoop = shard->m_ownerLoop.lock();
+        if (nullptr == ownerLoop) {
+            continue;
+        }
+
+        ownerLoop->executeTask([shard, ownerLoop]() {
+            ConnectionMap connMap;
+            connMap.swap(shard->m_connMap);
+
+            for (auto& connPair : connMap) {
+                connPair.second->close(0);
+            }
+            ownerLoop->decActiveConnections(connMap.size());
+        });
+    }
+}
+
+bool TcpServer::addWorkLoops(unsigned int count) {
+    return m_workLoopThreadPool->addWorkLoops(count);
+}
+
+bool TcpServer::removeWorkLoops(unsigned int count, double drainTimeout) {
+    // 连接由启动时注册到线程池的排空回调处理
+    bool result = m_workLoopThreadPool->removeWorkLoops(count, nullptr, drainTimeout);
+    this->removeExpiredShards();
+    return result;
+}
+
+void TcpServer::removeExpiredShards() {
+    std::lock_guard<std::mutex> lock(m_shardMutex);
+    for (auto iter = m_connShards.begin(); iter != m_connShards.end();) {
+        if (iter->second->m_ownerLoop.expired()) {
+            iter = m_connShards.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+}
+
+TcpServer::ConnectionShard::Ptr TcpServer::getConnectionShard(const EventLoopPtr& loop) {
+    std::lock_guard<std::mutex> lock(m_shardMutex);
+    auto& shard = m_connShards[loop.get()];
+
+    // 事件循环地址可能被释放后新建的事件循环复用，所属事件循环不一致时重建分片
+    if (nullptr == shard || shard->m_ownerLoop.lock() != loop) {
+        shard = std::make_shared<ConnectionShard>();
+        shard->m_ownerLoop = loop;
+    }
+    return shard;
+}
+
+void TcpServer::drainConnectionsInLoop(const EventLoopPtr& loop, bool isForce) {
+    auto shard = this->getConnectionShard(loop);
+    if (isForce) {
+        ConnectionMap connMap;
+        connMap.swap(shard->m_connMap);
+
+        for (auto& connPair : connMap) {
+            connPair.second->close(0);
+        }
+        loop->decActiveConnections(connMap.size());
+        return;
+    }
+
+    // 迁移到保留的事件循环(已不在选择范围内的事件循环不会被选中)，迁移失败或不迁移时关闭写方向，
+    // 对端读完剩余数据后关闭连接，由关闭回调从分片中移除
+    ConnectionMap connMap = shard->m_connMap;
+    for (auto& connPair : connMap) {
+        EventLoopWkPtr dstLoop;
+        if (m_isMigrateOnDrain && m_workLoopThreadPool->getNextWorkEventLoop(dstLoop) && this->migrateConnection(connPair.second, dstLoop)) {
+            continue;
+        }
+
+        auto conn = std::dynamic_pointer_cast<TcpConnection>(connPair.second);
+        if (nullptr != conn) {
+            conn->shutdown();
+        }
+    }
+}
+
+bool TcpServer::migrateConnection(const Connection::Ptr& conn, const EventLoopWkPtr& dstLoop) {
+    auto tcpConn = std::dynamic_pointer_cast<TcpConnection>(conn);
+    auto srcLoop = nullptr == conn ? nullptr : conn->getOwnerLoop().lock();
+    auto loop = dstLoop.lock();
+    if (nullptr == tcpConn || nullptr == srcLoop || nullptr == loop) {
+        LOG_ERROR << "Tcp server migrate connection error. invalid input param. server info: " << m_addr->printIpPort();
+        return false;
+    }
+
+    if (srcLoop->isInCurrentThread()) {
+        return this->migrateConnectionInLoop(tcpConn, srcLoop, dstLoop);
+    }
+
+    // 分片由所属事件循环独占访问，在原事件循环中检查并迁移
+    auto weakSelf = this->weak_from_this();
+    return srcLoop->executeTaskInLoop([weakSelf, tcpConn, srcLoop, dstLoop]() {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->migrateConnectionInLoop(tcpConn, srcLoop, dstLoop);
+        }
+    });
+}
+
+bool TcpServer::migrateConnectionInLoop(const TcpConnection::Ptr& conn, const EventLoopPtr& srcLoop, const EventLoopWkPtr& dstLoop) {
+    auto loop = dstLoop.lock();
+    if (nullptr == loop || conn->getOwnerLoop().lock() != srcLoop) {
+        LOG_ERROR << "Tcp server migrate connection error. connection moved or target loop expired. " << conn->getConnectionInfo();
+        return false;
+    }
+
+    auto srcShard = this->getConnectionShard(srcLoop);
+    auto dstShard = this->getConnectionShard(loop);
+    if (0 == srcShard->m_connMap.count(conn->getConnectionId())) {
+        LOG_ERROR << "Tcp server migrate connection error. connection not managed by server. " << conn->getConnectionInfo();
+        return false;
+    }
+
+    auto weakSelf = this->weak_from_this();
+    bool result = conn->migrate(dstLoop, [weakSelf, srcShard, dstShard](const Connection::Ptr& conn, bool result) {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr == strongSelf) {
+            return;
+        }
+
+        // 失败时在原事件循环中执行，连接仍可用则放回原分片
+        auto shard = result ? dstShard : srcShard;
+        auto ownerLoop = shard->m_ownerLoop.lock();
+        if (nullptr == ownerLoop || ConnState_t::ConnStateConnected != conn->getConnState()) {
+            return;
+        }
+
+        // 迁移期间服务已关闭
+        if (!strongSelf->m_isStarted) {
             conn->close(0);
+            return;
+        }
+
+        SetShardCloseCallback(conn, shard);
+        shard->m_connMap[conn->getConnectionId()] = conn;
+        ownerLoop->incActiveConnections();
+        if (result) {
+            ++strongSelf->m_migratedCount;
+        }
+    });
+
+    if (!result) {
+        return false;
+    }
+
+    // 立即从原分片移除，活跃连接数在原事件循环注销连接后扣减，使排空等待覆盖迁移过程
+    srcShard->m_connMap.erase(conn->getConnectionId());
+    srcShard->m_lastTraffic.erase(conn->getConnectionId());
+    srcShard->m_connLoad.erase(conn->getConnectionId());
+    srcLoop->executeTaskInLoop([srcLoop]() {
+        srcLoop->decActiveConnections();
+    });
+    return true;
+}
+
+bool TcpServer::enableRebalance(double intervalSec, double ratio) {
+    EventLoop::WkPtr mainLoop;
+    if (0 != m_rebalanceTimerId || intervalSec <= 0 || ratio < 1 || !m_workLoopThreadPool->getMainEventLoop(mainLoop)) {
+        LOG_ERROR << "Tcp server enable rebalance error. already enabled or invalid input param. server info: " << m_addr->printIpPort();
+        return false;
+    }
+
+    auto weakSelf = this->weak_from_this();
+    return mainLoop.lock()->addTimerAfterSpecificTime(m_rebalanceTimerId, [weakSelf, ratio]() {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->rebalance(ratio);
+        }
+    }, intervalSec, intervalSec);
+}
+
+void TcpServer::rebalance(double ratio) {
+    // 共享的线程池可能已直接移除工作事件循环
+    this->removeExpiredShards();
+
+    std::vector<ConnectionShard::Ptr> shards;
+    {
+        std::lock_guard<std::mutex> lock(m_shardMutex);
+        for (auto& pair : m_connShards) {
+            if (!pair.second->m_ownerLoop.expired()) {
+                shards.push_back(pair.second);
+            }
+        }
+    }
+
+    if (shards.size() < 2) {
+        return;
+    }
+
+    // 按上一间隔的负载选择最忙与最闲的分片
+    ConnectionShard::Ptr hotShard = shards.front();
+    ConnectionShard::Ptr coldShard = shards.front();
+    for (auto& shard : shards) {
+        if (shard->m_load > hotShard->m_load) {
+            hotShard = shard;
+        }
+        if (shard->m_load < coldShard->m_load) {
+            coldShard = shard;
+        }
+    }
+
+    // 仅迁移负载不超过差值一半的连接，迁移后两者的负载差不会反向扩大
+    uint64_t hotLoad = hotShard->m_load;
+    uint64_t coldLoad = coldShard->m_load;
+    auto hotLoop = hotShard->m_ownerLoop.lock();
+    if (nullptr != hotLoop && hotLoad - coldLoad >= TCP_REBALANCE_MIN_LOAD && hotLoad > coldLoad * ratio) {
+        uint64_t maxLoad = (hotLoad - coldLoad) / 2;
+        auto weakSelf = this->weak_from_this();
+        EventLoopWkPtr coldLoop = coldShard->m_ownerLoop;
+        hotLoop->executeTask([weakSelf, hotShard, coldLoop, maxLoad]() {
+            auto strongSelf = weakSelf.lock();
+            if (nullptr == strongSelf) {
+                return;
+            }
+
+            Connection::Ptr hotConn;
+            uint64_t hotConnLoad = 0;
+            for (auto& pair : hotShard->m_connLoad) {
+                auto connIter = hotShard->m_connMap.find(pair.first);
+                if (hotShard->m_connMap.end() != connIter && pair.second > hotConnLoad && pair.second <= maxLoad) {
+                    hotConn = connIter->second;
+                    hotConnLoad = pair.second;
+                }
+            }
+
+            if (nullptr != hotConn) {
+                LOG_DEBUG << "Tcp server rebalance. migrate connection, load: " << hotConnLoad << ". " << hotConn->getConnectionInfo();
+                strongSelf->migrateConnection(hotConn, coldLoop);
+            }
         });
     }
-    m_connMap.clear();
+
+    // 在各分片所属事件循环中采样，供下一轮使用
+    for (auto& shard : shards) {
+        auto ownerLoop = shard->m_ownerLoop.lock();
+        if (nullptr != ownerLoop) {
+            ownerLoop->executeTask([shard]() {
+                SampleShardLoad(shard);
+            });
+        }
+    }
+}
+
+void TcpServer::SampleShardLoad(const ConnectionShard::Ptr& shard) {
+    uint64_t shardLoad = 0;
+    std::unordered_map<ConnectionId, uint64_t> lastTraffic;
+    shard->m_connLoad.clear();
+
+    for (auto& pair : shard->m_connMap) {
+        auto& conn = pair.second;
+        uint64_t traffic = conn->getReadBytes() + conn->getWrittenBytes() + conn->getEventCount() * TCP_REBALANCE_EVENT_WEIGHT;
+
+        // 新加入或刚迁入的连接以本次采样为基准，避免累计流量被计入单个间隔
+        auto iter = shard->m_lastTraffic.find(pair.first);
+        uint64_t load = shard->m_lastTraffic.end() == iter ? 0 : traffic - iter->second;
+        lastTraffic[pair.first] = traffic;
+        shard->m_connLoad[pair.first] = load;
+        shardLoad += load;
+    }
+
+    shard->m_lastTraffic.swap(lastTraffic);
+    shard->m_load = shardLoad;
 }
 
 void TcpServer::onNewConnection(Socket::Ptr& connSock, Timestamp recvTime) {
-    // 获取工作线程
+    // 获取工作线程，一致性哈希按对端ip选择，同一客户端的连接固定在同一工作线程
+    uint64_t hashKey = 0;
+    if (Placement_t::PlacementConsistentHash == m_workLoopThreadPool->getPlacementPolicy()) {
+        std::string remoteIp;
+        auto remoteAddr = connSock->getRemoteAddr();
+        if (nullptr != remoteAddr && remoteAddr->getIpAddr(remoteIp)) {
+            hashKey = std::hash<std::string>()(remoteIp);
+        }
+    }
+
     EventLoop::WkPtr workLoop;
-    m_workLoopThreadPool->getNextWorkEventLoop(workLoop);
+    if (!m_workLoopThreadPool->getNextWorkEventLoop(workLoop, hashKey) || workLoop.expired()) {
+        LOG_ERROR << "Tcp server new connection error. get work event loop failed. server info: " << m_addr->printIpPort();
+        return;
+    }
 
-    // 保存新连接
-    auto conn = std::make_shared<TcpConnection>(workLoop, connSock);
-    m_connMap[conn->getConnectionId()] = conn;
+    auto loop = workLoop.lock();
+    auto shard = this->getConnectionShard(loop);
+
+    // 选择后立即计入活跃连接数，使连续到达的连接按最新负载分配
+    loop->incActiveConnections();
+
+    // 连接的创建与注册均在工作线程中执行
+    auto weakSelf = this->weak_from_this();
+    Socket::Ptr sock = connSock;
+    loop->executeTask([weakSelf, shard, sock, loop]() {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr == strongSelf) {
+            LOG_ERROR << "Tcp server new connection error. server expired.";
+            loop->decActiveConnections();
+            return;
+        }
+
+        strongSelf->newConnectionInLoop(shard, sock);
+    });
+}
+
+void TcpServer::newConnectionInLoop(const ConnectionShard::Ptr& shard, const Socket::Ptr& connSock) {
+    auto loop = shard->m_ownerLoop.lock();
+    if (nullptr == loop) {
+        LOG_ERROR << "Tcp server new connection error. owner loop expired. server info: " << m_addr->printIpPort();
+        return;
+    }
+
+    int boundCpu = loop->getBoundCpu();
+    if (m_isIncomingCpu && boundCpu >= 0) {
+        connSock->setIncomingCpu(boundCpu);
+    }
+
+    int socketBusyPollUs = m_socketBusyPollUs;
+    if (socketBusyPollUs > 0) {
+        connSock->setBusyPoll(socketBusyPollUs);
+    }
+
+    // 连接对象、控制块及内嵌的输入输出缓冲区在所属事件循环的slab内存池中一次分配
+    auto conn = TcpConnection::Create(shard->m_ownerLoop, connSock);
 
     // 设置新连接回调函数
     conn->setConnectCallback(m_connCb);
     conn->setMessageCallback(m_readCb);
     conn->setWriteCompleteCallback(m_writeCb);
 
-    EventLoop::WkPtr mainLoop;
-    m_workLoopThreadPool->getMainEventLoop(mainLoop);
+    // 连接关闭时从分片中移除
+    SetShardCloseCallback(conn, shard);
 
-    auto weakSelf = this->weak_from_this();
-    conn->setCloseCallback([weakSelf, mainLoop](const Connection::Ptr& conn) {
-        // 将connection移除放在主线程中执行
-        std::string connId = conn->getConnectionId();
-        mainLoop.lock()->executeTask([weakSelf, connId]() {
-            weakSelf.lock()->m_connMap.erase(connId);
-        });
-    });
-
-    // 启动新连接
-    workLoop.lock()->executeTask([conn]() {
-        conn->open();
-    });
+    // 保存并启动新连接
+    shard->m_connMap[conn->getConnectionId()] = conn;
+    if (!conn->open()) {
+        LOG_ERROR << "Tcp server new connection error. open connection failed. " << conn->getConnectionInfo();
+        shard->m_connMap.erase(conn->getConnectionId());
+        loop->decActiveConnections();
+    }
 }
 
 } // namespace App
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "Utils/Logger.h"
+#include "Net/EventLoop.h"
+#include "Net/UdpServer.h"
+
+namespace Net {
+
+UdpServer::UdpServer(Address::Ptr addr, const ThreadInitCb& cb, unsigned int numWorkThreads)
+    : UdpServer(std::make_shared<EventLoopThreadPool>(numWorkThreads, cb), std::move(addr)) {
+}
+
+UdpServer::UdpServer(const EventLoopThreadPool::Ptr& pool, Address::Ptr addr)
+    : m_isStarted(false),
+      m_isGroEnabled(false),
+      m_isGsoEnabled(false),
+      m_addr(std::move(addr)),
+      m_workLoopThreadPool(pool) {
+    if (nullptr == m_workLoopThreadPool) {
+        LOG_FATAL << "Udp server construct error. invalid event loop thread pool. server info: " << m_addr->printIpPort();
+    }
+    LOG_DEBUG << "Udp server construct. server info: " << m_addr->printIpPort();
+}
+
+UdpServer::~UdpServer() {
+    if (m_isStarted) {
+        this->shutdown();
+    }
+
+    LOG_DEBUG << "Udp server destruct. server info: " << m_addr->printIpPort();
+}
+
+void UdpServer::run() {
+    if (m_isStarted) {
+        LOG_WARN << "Udp server run warning. already started. server info: " << m_addr->printIpPort();
+        return;
+    }
+    else {
+        m_isStarted = true;
+    }
+
+    // 套接字与工作事件循环一一对应，运行期间禁止扩缩容
+    m_workLoopThreadPool->holdWorkLoopCount();
+    std::vector<EventLoop::WkPtr> workLoops;
+    if (!m_workLoopThreadPool->getWorkEventLoops(workLoops)) {
+        LOG_ERROR << "Udp server run error. get work event loops failed. server info: " << m_addr->printIpPort();
+        m_workLoopThreadPool->releaseWorkLoopCount();
+        m_isStarted = false;
+        return;
+    }
+
+    // 每个工作事件循环绑定一个套接字，套接字的打开和收发均在所属事件循环中执行
+    for (const auto& workLoop : workLoops) {
+        auto sock = std::make_shared<UdpSocket>(workLoop, m_addr, true);
+        sock->setMessageCallback(m_readCb);
+        sock->setGroEnabled(m_isGroEnabled);
+        sock->setGsoEnabled(m_isGsoEnabled);
+        m_sockets.push_back(sock);
+
+        workLoop.lock()->executeTask([sock]() {
+            if (!sock->open()) {
+                LOG_ERROR << "Udp server run error. open udp socket failed. local addr: " << sock->getLocalAddr()->printIpPort();
+            }
+        });
+    }
+}
+
+void UdpServer::shutdown() {
+    if (!m_isStarted) {
+        LOG_WARN << "Udp server shutdown warning. already shutdown. server info: " << m_addr->printIpPort();
+        return;
+    }
+    else {
+        m_isStarted = false;
+    }
+
+    std::vector<EventLoop::WkPtr> workLoops;
+    m_workLoopThreadPool->getWorkEventLoops(workLoops);
+    for (std::size_t idx = 0; idx < m_sockets.size() && idx < workLoops.size(); ++idx) {
+        auto loop = workLoops[idx].lock();
+        if (nullptr == loop) {
+            continue;
+        }
+
+        auto sock = m_sockets[idx];
+        loop->executeTask([sock]() {
+            sock->close();
+        });
+    }
+
+    // 关闭任务持有套接字，清空后再次启动时只统计新建的套接字
+    m_sockets.clear();
+    m_workLoopThreadPool->releaseWorkLoopCount();
+}
+
+uint64_t UdpServer::getRecvCount() const {
+    uint64_t count = 0;
+    for (const auto& sock : m_sockets) {
+        count += sock->getRecvCount();
+    }
+    return count;
+}
+
+uint64_t UdpServer::getDropCount() const {
+    uint64_t count = 0;
+    for (const auto& sock : m_sockets) {
+        count += sock->getDropCount();
+    }
+    return count;
+}
+
+} // namespace Net
\ No newline at end of file
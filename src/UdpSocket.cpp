@@ -0,0 +1,326 @@
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <netinet/udp.h>
+#include "Utils/Logger.h"
+#include "Utils/Socketop.h"
+#include "Net/Channel.h"
+#include "Net/EventLoop.h"
+#include "Net/UdpSocket.h"
+
+namespace Net {
+
+UdpSocket::UdpSocket(EventLoopWkPtr loop, Address::Ptr localAddr, bool reuseport)
+    : m_ownerLoop(std::move(loop)),
+      m_localAddr(std::move(localAddr)),
+      m_isReusePort(reuseport),
+      m_isGroEnabled(false),
+      m_isGsoEnabled(false),
+      m_slotSize(UDP_DATAGRAM_BUFFER_SIZE),
+      m_recvCount(0),
+      m_dropCount(0) {
+    if (m_ownerLoop.expired() || nullptr == m_localAddr || !m_localAddr->valid()) {
+        LOG_FATAL << "UdpSocket construct error. invalid input param.";
+    }
+
+    LOG_DEBUG << "UdpSocket construct. local addr: " << m_localAddr->printIpPort();
+}
+
+UdpSocket::~UdpSocket() {
+    // channel注册在事件循环中，需在事件循环线程中移除
+    auto loop = m_ownerLoop.lock();
+    if (nullptr != m_channel && nullptr != loop) {
+        ChannelPtr channel = m_channel;
+        Socket::Ptr sock = m_sock;
+        loop->executeTask([channel, sock]() {
+            channel->close();
+        });
+    }
+
+    LOG_DEBUG << "UdpSocket deconstruct. local addr: " << m_localAddr->printIpPort();
+}
+
+bool UdpSocket::open() {
+    if (nullptr != m_sock) {
+        LOG_WARN << "UdpSocket open warning. already opened. local addr: " << m_localAddr->printIpPort();
+        return true;
+    }
+
+    int fd = -1;
+    if (!Socketop::CreateSocket(m_localAddr->getAddrType(), Socket_t::UDP, true, fd)) {
+        LOG_ERROR << "UdpSocket open error. create socket failed. local addr: " << m_localAddr->printIpPort();
+        return false;
+    }
+
+    auto sock = std::make_shared<Socket>(fd, Socket_t::UDP);
+    sock->setReuseAddr(true);
+    sock->setReusePort(m_isReusePort);
+    if (!sock->bind(m_localAddr)) {
+        LOG_ERROR << "UdpSocket open error. bind failed. local addr: " << m_localAddr->printIpPort();
+        return false;
+    }
+
+    // GRO合并后的报文最大可达64KB，接收槽位需相应扩大
+    if (m_isGroEnabled && !Socketop::SetUdpGro(fd, true)) {
+        LOG_WARN << "UdpSocket open warning. udp gro not supported. local addr: " << m_localAddr->printIpPort();
+        m_isGroEnabled = false;
+    }
+    m_slotSize = m_isGroEnabled ? UDP_GRO_BUFFER_SIZE : UDP_DATAGRAM_BUFFER_SIZE;
+    m_recvBuf.resize(m_slotSize * UDP_BATCH_SIZE);
+    m_batch.reserve(UDP_BATCH_SIZE);
+
+    // 报文头指向固定的槽位，每次接收前只需重置长度字段
+    for (std::size_t idx = 0; idx < UDP_BATCH_SIZE; ++idx) {
+        m_recvIovecs[idx].iov_base = m_recvBuf.data() + idx * m_slotSize;
+        m_recvIovecs[idx].iov_len = m_slotSize;
+
+        auto& hdr = m_recvMsgs[idx].msg_hdr;
+        ::memset(&hdr, 0, sizeof(hdr));
+        hdr.msg_name = &m_peerAddrs[idx];
+        hdr.msg_iov = &m_recvIovecs[idx];
+        hdr.msg_iovlen = 1;
+        hdr.msg_control = m_isGroEnabled ? m_recvCtrls[idx].data() : nullptr;
+    }
+
+    m_sock = sock;
+    m_channel = std::make_shared<Channel>(m_ownerLoop, fd);
+
+    auto weakSelf = this->weak_from_this();
+    m_channel->setEventCb(Event_t::EvTypeRead, [weakSelf](Timestamp recvTime) {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->handleRead(recvTime);
+        }
+    });
+
+    m_channel->setEventCb(Event_t::EvTypeError, [weakSelf](Timestamp recvTime) {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->handleError(recvTime);
+        }
+    });
+
+    if (!m_channel->open(Event_t::EvTypeRead)) {
+        LOG_ERROR << "UdpSocket open error. open channel failed. local addr: " << m_localAddr->printIpPort();
+        m_channel.reset();
+        m_sock.reset();
+        return false;
+    }
+
+    LOG_DEBUG << "UdpSocket open. fd: " << fd << " local addr: " << m_localAddr->printIpPort() << " gro: " << m_isGroEnabled;
+    return true;
+}
+
+void UdpSocket::close() {
+    if (nullptr == m_channel) {
+        return;
+    }
+
+    // channel在事件处理期间由事件循环持有，此处可直接释放
+    m_channel->close();
+    m_channel.reset();
+    m_sock.reset();
+}
+
+bool UdpSocket::sendTo(const sockaddr_storage& peerAddr, const void* data, std::size_t size) {
+    if (nullptr == m_sock) {
+        LOG_ERROR << "UdpSocket send error. socket not opened. local addr: " << m_localAddr->printIpPort();
+        return false;
+    }
+
+    iovec iov = {const_cast<void*>(data), size};
+    msghdr msg = {};
+    msg.msg_name = const_cast<sockaddr_storage*>(&peerAddr);
+    msg.msg_namelen = sizeof(peerAddr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    if (Socketop::SendMsg(m_sock->getFd(), &msg) < 0) {
+        ++m_dropCount;
+        LOG_DEBUG << "UdpSocket send error. errno: " << errno << ". error: " << strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+bool UdpSocket::sendTo(const Address::Ptr& peerAddr, const void* data, std::size_t size) {
+    if (nullptr == peerAddr || !peerAddr->valid()) {
+        LOG_ERROR << "UdpSocket send error. invalid peer address.";
+        return false;
+    }
+
+    sockaddr_storage sockAddr = {};
+    peerAddr->getSockAddr(sockAddr);
+    return this->sendTo(sockAddr, data, size);
+}
+
+std::size_t UdpSocket::sendBatch(const DatagramBatch& batch) {
+    if (nullptr == m_sock) {
+        LOG_ERROR << "UdpSocket send batch error. socket not opened. local addr: " << m_localAddr->printIpPort();
+        return 0;
+    }
+
+    std::array<iovec, UDP_BATCH_SIZE> iovecs;
+    std::array<mmsghdr, UDP_BATCH_SIZE> msgs;
+    std::size_t sentCount = 0;
+
+    while (sentCount < batch.size()) {
+        auto count = std::min(batch.size() - sentCount, UDP_BATCH_SIZE);
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            const auto& datagram = batch[sentCount + idx];
+            iovecs[idx].iov_base = const_cast<uint8_t*>(datagram.m_data);
+            iovecs[idx].iov_len = datagram.m_size;
+
+            auto& hdr = msgs[idx].msg_hdr;
+            ::memset(&hdr, 0, sizeof(hdr));
+            hdr.msg_name = const_cast<sockaddr_storage*>(datagram.m_peerAddr);
+            hdr.msg_namelen = sizeof(sockaddr_storage);
+            hdr.msg_iov = &iovecs[idx];
+            hdr.msg_iovlen = 1;
+        }
+
+        int sent = Socketop::SendMmsg(m_sock->getFd(), msgs.data(), static_cast<unsigned int>(count));
+        if (sent <= 0) {
+            // 发送缓冲区已满或出错，丢弃剩余报文
+            LOG_DEBUG << "UdpSocket send batch error. errno: " << errno << ". error: " << strerror(errno);
+            break;
+        }
+        sentCount += static_cast<std::size_t>(sent);
+    }
+
+    m_dropCount += batch.size() - sentCount;
+    return sentCount;
+}
+
+std::size_t UdpSocket::sendSegments(const sockaddr_storage& peerAddr, const void* data, std::size_t size, uint16_t segmentSize) {
+    if (nullptr == m_sock || 0 == segmentSize) {
+        LOG_ERROR << "UdpSocket send segments error. socket not opened or invalid segment size.";
+        return 0;
+    }
+
+    auto begin = static_cast<const uint8_t*>(data);
+    std::size_t segmentCount = (size + segmentSize - 1) / segmentSize;
+
+    // 每次GSO发送最多UDP_GSO_MAX_SEGMENTS个分段且不超过单个UDP报文上限，内核不支持时回退到用户态切分
+    std::size_t sentCount = 0;
+    std::size_t gsoBytes = std::min(UDP_GSO_MAX_SEGMENTS, UDP_GSO_MAX_BYTES / segmentSize) * segmentSize;
+    while (m_isGsoEnabled && gsoBytes > 0 && sentCount < segmentCount) {
+        std::size_t offset = sentCount * segmentSize;
+        std::size_t len = std::min(size - offset, gsoBytes);
+        if (!this->sendGso(peerAddr, begin + offset, len, segmentSize)) {
+            break;
+        }
+        sentCount += (len + segmentSize - 1) / segmentSize;
+    }
+
+    DatagramBatch batch;
+    batch.reserve(segmentCount - sentCount);
+    for (std::size_t offset = sentCount * segmentSize; offset < size; offset += segmentSize) {
+        batch.push_back({begin + offset, std::min<std::size_t>(segmentSize, size - offset), &peerAddr});
+    }
+    return sentCount + this->sendBatch(batch);
+}
+
+bool UdpSocket::sendGso(const sockaddr_storage& peerAddr, const uint8_t* data, std::size_t size, uint16_t segmentSize) {
+#ifdef UDP_SEGMENT
+    char ctrl[CMSG_SPACE(sizeof(uint16_t))] = {};
+    iovec iov = {const_cast<uint8_t*>(data), size};
+    msghdr msg = {};
+    msg.msg_name = const_cast<sockaddr_storage*>(&peerAddr);
+    msg.msg_namelen = sizeof(peerAddr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    // 仅剩一个分段时无需携带分段信息
+    if (size > segmentSize) {
+        msg.msg_control = ctrl;
+        msg.msg_controllen = sizeof(ctrl);
+
+        auto cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        ::memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+    }
+
+    if (Socketop::SendMsg(m_sock->getFd(), &msg) >= 0) {
+        return true;
+    }
+
+    if (EAGAIN != errno && EWOULDBLOCK != errno) {
+        LOG_WARN << "UdpSocket send gso error. disable gso. errno: " << errno << ". error: " << strerror(errno);
+        m_isGsoEnabled = false;
+    }
+    return false;
+#else
+    m_isGsoEnabled = false;
+    return false;
+#endif
+}
+
+void UdpSocket::handleRead(Timestamp recvTime) {
+    for (int round = 0; round < UDP_READ_BATCH_ROUNDS && nullptr != m_sock; ++round) {
+        for (auto& msg : m_recvMsgs) {
+            msg.msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            msg.msg_hdr.msg_controllen = m_isGroEnabled ? sizeof(m_recvCtrls[0]) : 0;
+            msg.msg_hdr.msg_flags = 0;
+        }
+
+        int count = Socketop::RecvMmsg(m_sock->getFd(), m_recvMsgs.data(), UDP_BATCH_SIZE);
+        if (count <= 0) {
+            if (count < 0 && EAGAIN != errno && EWOULDBLOCK != errno && EINTR != errno) {
+                LOG_ERROR << "UdpSocket handleRead error. errno: " << errno << ". error: " << strerror(errno);
+            }
+            break;
+        }
+
+        m_batch.clear();
+        for (int idx = 0; idx < count; ++idx) {
+            const auto& hdr = m_recvMsgs[idx].msg_hdr;
+            if (0 != (hdr.msg_flags & MSG_TRUNC)) {
+                ++m_dropCount;
+                continue;
+            }
+
+            // GRO合并的报文按控制信息中的分段大小拆分
+            std::size_t size = m_recvMsgs[idx].msg_len;
+            std::size_t segmentSize = size;
+#ifdef UDP_GRO
+            for (auto cmsg = CMSG_FIRSTHDR(&hdr); nullptr != cmsg; cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&hdr), cmsg)) {
+                if (SOL_UDP == cmsg->cmsg_level && UDP_GRO == cmsg->cmsg_type) {
+                    int groSize = 0;
+                    ::memcpy(&groSize, CMSG_DATA(cmsg), sizeof(groSize));
+                    segmentSize = groSize > 0 ? static_cast<std::size_t>(groSize) : size;
+                }
+            }
+#endif
+
+            auto data = static_cast<const uint8_t*>(m_recvIovecs[idx].iov_base);
+            if (segmentSize >= size) {
+                m_batch.push_back({data, size, &m_peerAddrs[idx]});
+                continue;
+            }
+
+            for (std::size_t offset = 0; offset < size; offset += segmentSize) {
+                m_batch.push_back({data + offset, std::min(segmentSize, size - offset), &m_peerAddrs[idx]});
+            }
+        }
+
+        m_recvCount += m_batch.size();
+        if (!m_batch.empty() && nullptr != m_readCb) {
+            m_readCb(this->shared_from_this(), m_batch, recvTime);
+        }
+
+        // 未读满一批说明接收队列已空
+        if (static_cast<std::size_t>(count) < UDP_BATCH_SIZE) {
+            break;
+        }
+    }
+}
+
+void UdpSocket::handleError(Timestamp recvTime) {
+    LOG_ERROR << "UdpSocket handleError. local addr: " << m_localAddr->printIpPort()
+        << " error: " << (nullptr == m_sock ? 0 : Socketop::GetSocketError(m_sock->getFd()));
+}
+
+} // namespace Net
\ No newline at end of file
@@ -0,0 +1,498 @@
+#include <algorithm>
+#include "Utils/Logger.h"
+#include "Net/EventLoop.h"
+#include "Net/UpstreamPool.h"
+
+namespace Net {
+
+UpstreamPool::UpstreamPool(const std::vector<EventLoopWkPtr>& loops)
+    : UpstreamPool(loops, Options()) {
+}
+
+UpstreamPool::UpstreamPool(const std::vector<EventLoopWkPtr>& loops, const Options& options)
+    : m_options(options),
+      m_readCb(nullptr) {
+    // 管线化上限和最大连接数至少为1
+    m_options.m_maxPipeline = std::max<std::size_t>(m_options.m_maxPipeline, 1);
+    m_options.m_maxTotal = std::max<std::size_t>(m_options.m_maxTotal, 1);
+
+    for (const auto& loop : loops) {
+        auto strongLoop = loop.lock();
+        if (nullptr == strongLoop) {
+            LOG_ERROR << "Upstream pool construct error. event loop expired.";
+            continue;
+        }
+
+        auto shard = std::make_shared<PoolShard>();
+        shard->m_ownerLoop = loop;
+        m_shards.emplace(strongLoop.get(), shard);
+    }
+
+    LOG_DEBUG << "Upstream pool construct. shard count: " << m_shards.size();
+}
+
+UpstreamPool::~UpstreamPool() {
+    // 分片仅允许在所属事件循环中访问，关闭任务只持有分片，不访问已析构的连接池
+    for (auto& item : m_shards) {
+        PoolShard::Ptr shard = item.second;
+        auto closeTask = [shard]() {
+            auto waiters = UpstreamPool::closeShard(shard);
+            if (!waiters.empty()) {
+                LOG_WARN << "Upstream pool destruct warning. drop waiting requests. count: " << waiters.size();
+            }
+        };
+
+        auto loop = shard->m_ownerLoop.lock();
+        if (nullptr == loop) {
+            closeTask();
+            continue;
+        }
+
+        loop->delTimer(shard->m_evictTimerId);
+        loop->executeTask(closeTask);
+    }
+
+    LOG_DEBUG << "Upstream pool destruct. shard count: " << m_shards.size();
+}
+
+bool UpstreamPool::start() {
+    if (m_options.m_idleTimeout <= 0) {
+        return true;
+    }
+
+    // 按超时时长的一半周期性回收空闲连接
+    double interval = std::max(m_options.m_idleTimeout / 2, 0.01);
+    auto weakSelf = this->weak_from_this();
+    for (auto& item : m_shards) {
+        auto loop = item.second->m_ownerLoop.lock();
+        if (nullptr == loop) {
+            LOG_ERROR << "Upstream pool start error. event loop expired.";
+            return false;
+        }
+
+        PoolShard::WkPtr weakShard = item.second;
+        bool isAdded = loop->addTimerAfterSpecificTime(item.second->m_evictTimerId, [weakSelf, weakShard]() {
+            auto strongSelf = weakSelf.lock();
+            auto strongShard = weakShard.lock();
+            if (nullptr != strongSelf && nullptr != strongShard) {
+                strongSelf->evictIdleConnections(strongShard);
+            }
+        }, interval, interval);
+
+        if (!isAdded) {
+            LOG_ERROR << "Upstream pool start error. add evict timer failed.";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void UpstreamPool::stop() {
+    // 持有连接池强引用，保证关闭任务执行前连接池不被析构
+    auto strongSelf = this->shared_from_this();
+    for (auto& item : m_shards) {
+        auto loop = item.second->m_ownerLoop.lock();
+        if (nullptr == loop) {
+            continue;
+        }
+
+        loop->delTimer(item.second->m_evictTimerId);
+
+        PoolShard::Ptr shard = item.second;
+        loop->executeTask([strongSelf, shard]() {
+            auto waiters = strongSelf->closeShard(shard);
+            for (auto& cb : waiters) {
+                cb(nullptr);
+            }
+        });
+    }
+}
+
+bool UpstreamPool::acquire(const EventLoopPtr& loop, const Address::Ptr& addr, const AcquireCb& cb) {
+    if (nullptr == loop || nullptr == addr || !addr->valid() || nullptr == cb) {
+        LOG_ERROR << "Upstream pool acquire error. invalid input param.";
+        return false;
+    }
+
+    auto shard = this->getShard(loop.get());
+    if (nullptr == shard) {
+        LOG_ERROR << "Upstream pool acquire error. event loop not in pool. upstream: " << addr->printIpPort();
+        return false;
+    }
+
+    if (loop->isInCurrentThread()) {
+        this->acquireInLoop(shard, addr, cb);
+        return true;
+    }
+
+    auto weakSelf = this->weak_from_this();
+    return loop->executeTask([weakSelf, shard, addr, cb]() {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr == strongSelf) {
+            cb(nullptr);
+            return;
+        }
+        strongSelf->acquireInLoop(shard, addr, cb);
+    });
+}
+
+void UpstreamPool::release(const TcpConnection::Ptr& conn, bool reusable) {
+    if (nullptr == conn) {
+        return;
+    }
+
+    auto loop = conn->getOwnerLoop().lock();
+    if (nullptr == loop) {
+        LOG_ERROR << "Upstream pool release error. owner loop expired. " << conn->getConnectionInfo();
+        return;
+    }
+
+    auto shard = this->getShard(loop.get());
+    if (nullptr == shard) {
+        LOG_ERROR << "Upstream pool release error. event loop not in pool. " << conn->getConnectionInfo();
+        return;
+    }
+
+    if (loop->isInCurrentThread()) {
+        this->releaseInLoop(shard, conn, reusable);
+        return;
+    }
+
+    auto weakSelf = this->weak_from_this();
+    loop->executeTask([weakSelf, shard, conn, reusable]() {
+        auto strongSelf = weakSelf.lock();
+        if (nullptr != strongSelf) {
+            strongSelf->releaseInLoop(shard, conn, reusable);
+        }
+    });
+}
+
+UpstreamPool::PoolShard::Ptr UpstreamPool::getShard(const EventLoop* loop) const {
+    auto iter = m_shards.find(loop);
+    return m_shards.end() == iter ? nullptr : iter->second;
+}
+
+UpstreamPool::UpstreamGroup::Ptr UpstreamPool::findGroup(const PoolShard::Ptr& shard, ConnectionId connId) const {
+    // 单个事件循环内的上游地址数量有限，直接遍历
+    for (auto& item : shard->m_groups) {
+        if (item.second->m_conns.end() != item.second->m_conns.find(connId)) {
+            return item.second;
+        }
+    }
+    return nullptr;
+}
+
+void UpstreamPool::acquireInLoop(const PoolShard::Ptr& shard, const Address::Ptr& addr, const AcquireCb& cb) {
+    auto& group = shard->m_groups[addr->printIpPort()];
+    if (nullptr == group) {
+        group = std::make_shared<UpstreamGroup>();
+        group->m_addr = addr;
+    }
+
+    // 存在等待中的请求时排队，保证请求按获取顺序分配连接
+    auto upstreamConn = group->m_waiters.empty() ? this->pickConnection(group) : nullptr;
+    if (nullptr != upstreamConn) {
+        ++upstreamConn->m_inflight;
+        auto conn = upstreamConn->m_conn;
+        cb(conn);
+        return;
+    }
+
+    auto strongGroup = group;
+    strongGroup->m_waiters.push_back(cb);
+    this->dispatchWaiters(shard, strongGroup);
+}
+
+void UpstreamPool::releaseInLoop(const PoolShard::Ptr& shard, const TcpConnection::Ptr& conn, bool reusable) {
+    ConnectionId connId = conn->getConnectionId();
+    auto group = this->findGroup(shard, connId);
+    if (nullptr == group) {
+        // 连接已被关闭或回收
+        return;
+    }
+
+    auto& upstreamConn = group->m_conns[connId];
+    if (upstreamConn.m_inflight > 0) {
+        --upstreamConn.m_inflight;
+    }
+    upstreamConn.m_lastActive = std::chrono::steady_clock::now();
+
+    if (!reusable || ConnState_t::ConnStateConnected != conn->getConnState()) {
+        this->evictConnection(group, connId);
+    }
+    else if (0 == upstreamConn.m_inflight && group->m_waiters.empty()) {
+        // 空闲连接超过上限时关闭当前连接
+        std::size_t idleCount = std::count_if(group->m_conns.begin(), group->m_conns.end(),
+            [](const std::pair<const ConnectionId, UpstreamConn>& item) {
+                return 0 == item.second.m_inflight;
+            });
+
+        if (idleCount > m_options.m_maxIdle) {
+            this->evictConnection(group, connId);
+        }
+    }
+
+    this->dispatchWaiters(shard, group);
+}
+
+UpstreamPool::UpstreamConn* UpstreamPool::pickConnection(const UpstreamGroup::Ptr& group) const {
+    UpstreamConn* picked = nullptr;
+    for (auto& item : group->m_conns) {
+        auto& upstreamConn = item.second;
+        if (upstreamConn.m_inflight >= m_options.m_maxPipeline
+            || ConnState_t::ConnStateConnected != upstreamConn.m_conn->getConnState()) {
+            continue;
+        }
+
+        if (nullptr == picked || upstreamConn.m_inflight < picked->m_inflight) {
+            picked = &upstreamConn;
+        }
+    }
+    return picked;
+}
+
+void UpstreamPool::dispatchWaiters(const PoolShard::Ptr& shard, const UpstreamGroup::Ptr& group) {
+    while (!group->m_waiters.empty()) {
+        auto upstreamConn = this->pickConnection(group);
+        if (nullptr == upstreamConn) {
+            break;
+        }
+
+        ++upstreamConn->m_inflight;
+        auto conn = upstreamConn->m_conn;
+        auto cb = std::move(group->m_waiters.front());
+        group->m_waiters.pop_front();
+        cb(conn);
+    }
+
+    // 剩余请求按管线化上限折算所需连接数，未达到最大连接数时新建连接；
+    // 连接同步失败时连接器数不变，停止新建，避免描述符或端口耗尽时循环不退出
+    while (group->m_waiters.size() > group->m_connectors.size() * m_options.m_maxPipeline
+        && group->m_conns.size() + group->m_connectors.size() < m_options.m_maxTotal) {
+        if (!this->connectUpstream(shard, group)) {
+            break;
+        }
+    }
+}
+
+bool UpstreamPool::connectUpstream(const PoolShard::Ptr& shard, const UpstreamGroup::Ptr& group) {
+    auto loop = shard->m_ownerLoop.lock();
+    if (nullptr == loop) {
+        LOG_ERROR << "Upstream pool connect error. owner loop expired. upstream: " << group->m_addr->printIpPort();
+        return false;
+    }
+
+    auto connector = std::make_shared<TcpConnector>(shard->m_ownerLoop, group->m_addr);
+    auto& pending = group->m_connectors[connector.get()];
+    pending.m_connector = connector;
+
+    auto weakSelf = this->weak_from_this();
+    PoolShard::WkPtr weakShard = shard;
+    UpstreamGroup::WkPtr weakGroup = group;
+    TcpConnector::WkPtr weakConnector = connector;
+
+    connector->setNewConnCb([weakSelf, weakShard, weakGroup, weakConnector](Socket::Ptr& connSock, Timestamp recvTime) {
+        auto strongSelf = weakSelf.lock();
+        auto strongShard = weakShard.lock();
+        auto strongGroup = weakGroup.lock();
+        auto strongConnector = weakConnector.lock();
+        if (nullptr != strongSelf && nullptr != strongShard && nullptr != strongGroup && nullptr != strongConnector) {
+            strongSelf->onConnected(strongShard, strongGroup, strongConnector, connSock);
+        }
+    });
+
+    // 连接失败时不重连，由后续请求重新发起连接
+    auto failedCb = [weakSelf, weakShard, weakGroup, weakConnector]() {
+        auto strongSelf = weakSelf.lock();
+        auto strongShard = weakShard.lock();
+        auto strongGroup = weakGroup.lock();
+        auto strongConnector = weakConnector.lock();
+        if (nullptr != strongSelf && nullptr != strongShard && nullptr != strongGroup && nullptr != strongConnector) {
+            strongSelf->onConnectFailed(strongShard, strongGroup, strongConnector);
+        }
+    };
+
+    connector->setFailedCb([failedCb](int errCode) {
+        failedCb();
+    });
+
+    // 连接建立或失败时删除超时定时器
+    if (!loop->addTimerAfterSpecificTime(pending.m_timerId, failedCb, m_options.m_connectTimeout)) {
+        LOG_WARN << "Upstream pool connect warning. add connect timer failed. upstream: " << group->m_addr->printIpPort();
+    }
+
+    if (!connector->start()) {
+        LOG_ERROR << "Upstream pool connect error. start connector failed. upstream: " << group->m_addr->printIpPort();
+        UpstreamPool::removeConnector(shard, group, connector.get());
+        return false;
+    }
+
+    // 同步失败时连接器已被移除
+    return group->m_connectors.end() != group->m_connectors.find(connector.get());
+}
+
+void UpstreamPool::onConnected(const PoolShard::Ptr& shard, const UpstreamGroup::Ptr& group, const TcpConnector::Ptr& connector, Socket::Ptr& connSock) {
+    if (!UpstreamPool::removeConnector(shard, group, connector.get())) {
+        // 连接已超时或连接池已停止
+        return;
+    }
+
+    auto loop = shard->m_ownerLoop.lock();
+    if (nullptr == loop) {
+        LOG_ERROR << "Upstream pool new connection error. owner loop expired. upstream: " << group->m_addr->printIpPort();
+        return;
+    }
+
+    // 与服务端连接一致，从所属事件循环的slab内存池中分配
+    auto conn = TcpConnection::Create(shard->m_ownerLoop, connSock);
+    if (nullptr != m_readCb) {
+        conn->setMessageCallback(m_readCb);
+    }
+    else {
+        conn->setMessageCallback([](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+            buf->moveReadStartPos(buf->readableBytes());
+        });
+    }
+
+    auto weakSelf = this->weak_from_this();
+    PoolShard::WkPtr weakShard = shard;
+    conn->setCloseCallback([weakSelf, weakShard](const Connection::Ptr& conn) {
+        auto strongSelf = weakSelf.lock();
+        auto strongShard = weakShard.lock();
+        if (nullptr != strongSelf && nullptr != strongShard) {
+            strongSelf->onConnectionClosed(strongShard, conn);
+        }
+    });
+
+    if (!conn->open()) {
+        LOG_ERROR << "Upstream pool new connection error. open connection failed. " << conn->getConnectionInfo();
+        this->dispatchWaiters(shard, group);
+        return;
+    }
+
+    UpstreamConn upstreamConn;
+    upstreamConn.m_conn = conn;
+    upstreamConn.m_lastActive = std::chrono::steady_clock::now();
+    group->m_conns.emplace(conn->getConnectionId(), upstreamConn);
+
+    LOG_DEBUG << "Upstream pool new connection. " << conn->getConnectionInfo();
+    this->dispatchWaiters(shard, group);
+}
+
+void UpstreamPool::onConnectFailed(const PoolShard::Ptr& shard, const UpstreamGroup::Ptr& group, const TcpConnector::Ptr& connector) {
+    if (!UpstreamPool::removeConnector(shard, group, connector.get())) {
+        // 连接已建立或已处理
+        return;
+    }
+
+    connector->stop();
+    LOG_WARN << "Upstream pool connect failed. upstream: " << group->m_addr->printIpPort();
+
+    // 既无已建立连接也无进行中的连接时，等待中的请求无法完成，以空连接回调
+    if (!group->m_conns.empty() || !group->m_connectors.empty()) {
+        return;
+    }
+
+    std::deque<AcquireCb> waiters;
+    waiters.swap(group->m_waiters);
+    for (auto& cb : waiters) {
+        cb(nullptr);
+    }
+}
+
+void UpstreamPool::onConnectionClosed(const PoolShard::Ptr& shard, const Connection::Ptr& conn) {
+    ConnectionId connId = conn->getConnectionId();
+    auto group = this->findGroup(shard, connId);
+    if (nullptr == group) {
+        return;
+    }
+
+    LOG_DEBUG << "Upstream pool connection closed. " << conn->getConnectionInfo();
+    group->m_conns.erase(connId);
+    this->dispatchWaiters(shard, group);
+}
+
+bool UpstreamPool::removeConnector(const PoolShard::Ptr& shard, const UpstreamGroup::Ptr& group, const TcpConnector* connector) {
+    auto iter = group->m_connectors.find(connector);
+    if (group->m_connectors.end() == iter) {
+        return false;
+    }
+
+    auto loop = shard->m_ownerLoop.lock();
+    if (nullptr != loop && 0 != iter->second.m_timerId) {
+        loop->delTimer(iter->second.m_timerId);
+    }
+
+    group->m_connectors.erase(iter);
+    return true;
+}
+
+void UpstreamPool::evictConnection(const UpstreamGroup::Ptr& group, ConnectionId connId) {
+    auto iter = group->m_conns.find(connId);
+    if (group->m_conns.end() == iter) {
+        return;
+    }
+
+    auto conn = iter->second.m_conn;
+    group->m_conns.erase(iter);
+
+    if (ConnState_t::ConnStateClosed != conn->getConnState()) {
+        conn->close(0);
+    }
+}
+
+std::deque<UpstreamPool::AcquireCb> UpstreamPool::closeShard(const PoolShard::Ptr& shard) {
+    std::deque<AcquireCb> waiters;
+    for (auto& item : shard->m_groups) {
+        auto& group = item.second;
+        while (!group->m_connectors.empty()) {
+            auto connector = group->m_connectors.begin()->second.m_connector;
+            UpstreamPool::removeConnector(shard, group, connector.get());
+            connector->stop();
+        }
+
+        while (!group->m_conns.empty()) {
+            UpstreamPool::evictConnection(group, group->m_conns.begin()->first);
+        }
+
+        std::move(group->m_waiters.begin(), group->m_waiters.end(), std::back_inserter(waiters));
+        group->m_waiters.clear();
+    }
+
+    shard->m_groups.clear();
+    return waiters;
+}
+
+void UpstreamPool::evictIdleConnections(const PoolShard::Ptr& shard) {
+    auto now = std::chrono::steady_clock::now();
+    auto idleTimeout = std::chrono::duration<double>(m_options.m_idleTimeout);
+
+    for (auto iter = shard->m_groups.begin(); iter != shard->m_groups.end(); /* void */) {
+        auto group = iter->second;
+
+        std::vector<ConnectionId> evictIds;
+        for (auto& item : group->m_conns) {
+            auto& upstreamConn = item.second;
+            if (ConnState_t::ConnStateConnected != upstreamConn.m_conn->getConnState()
+                || (0 == upstreamConn.m_inflight && now - upstreamConn.m_lastActive > idleTimeout)) {
+                evictIds.push_back(item.first);
+            }
+        }
+
+        for (auto connId : evictIds) {
+            LOG_DEBUG << "Upstream pool evict connection. upstream: " << group->m_addr->printIpPort() << " connection id: " << connId;
+            this->evictConnection(group, connId);
+        }
+
+        // 释放不再使用的连接组
+        if (group->m_conns.empty() && group->m_connectors.empty() && group->m_waiters.empty()) {
+            iter = shard->m_groups.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+}
+
+} // namespace Net
\ No newline at end of file
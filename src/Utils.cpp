@@ -1,24 +1,36 @@
+#include <atomic>
 #include <chrono>
 #include <random>
-#include <iomanip>
-#include <sstream>
 #include <unordered_map>
 #include <ctime>
+#include <climits>
 #include <sys/stat.h>
 #include "Utils/Utils.h"
+#include "Common/ConfigDef.h"
 
 namespace Utils {
 
-std::string TimeHelper::GetCurrentTime() {
-    auto now = std::chrono::system_clock::now();
+// 是否使用粗粒度时钟
+static std::atomic<bool> s_isCoarseClock{false};
+
+/**
+ * @brief 线程独立的时间格式化缓存
+ */
+struct TimeFormatCache {
+    // 已格式化的秒数
+    int64_t m_second = INT64_MIN;
+
+    // 已格式化的分钟数
+    int64_t m_minute = INT64_MIN;
 
-    auto now_time_t = std::chrono::system_clock::to_time_t(now);
-    auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-    std::tm now_tm = *std::localtime(&now_time_t);
+    // 格式化后的时间
+    char m_buf[TIME_FORMAT_SIZE] = {0};
+};
 
-    std::ostringstream oss;
-    oss << std::put_time(&now_tm, "%Y-%m-%d %H:%M:%S") << '.' << std::setfill('0') << std::setw(3) << now_ms.count();
-    return oss.str();
+static thread_local TimeFormatCache t_timeCache;
+
+std::string TimeHelper::GetCurrentTime() {
+    return FormatTime(GetCurrentTimeNs());
 }
 
 std::string TimeHelper::GetCurrentData() {
@@ -33,19 +45,47 @@ std::string TimeHelper::GetCurrentData() {
 }
 
 std::string TimeHelper::PrintTime(const Timestamp& timestamp) {
-    auto fmtTime = std::chrono::system_clock::to_time_t(timestamp);
+    return FormatTime(std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count());
+}
 
-    std::tm tm = {};
-    localtime_r(&fmtTime, &tm);
+const char* TimeHelper::FormatTime(int64_t timeNs) {
+    auto& cache = t_timeCache;
+    int64_t second = timeNs / 1000000000;
+    int64_t minute = second / 60;
+    int ms = static_cast<int>(timeNs / 1000000 % 1000);
+
+    if (minute != cache.m_minute) {
+        // 时区偏移均为整分钟，分钟不变时仅秒数字段变化
+        auto fmtTime = static_cast<time_t>(second);
+        std::tm tm = {};
+        localtime_r(&fmtTime, &tm);
+        strftime(cache.m_buf, sizeof(cache.m_buf), "%Y-%m-%d %H:%M:%S", &tm);
+        cache.m_buf[19] = '.';
+        cache.m_minute = minute;
+        cache.m_second = second;
+    }
+    else if (second != cache.m_second) {
+        int sec = static_cast<int>(second % 60);
+        cache.m_buf[17] = static_cast<char>('0' + sec / 10);
+        cache.m_buf[18] = static_cast<char>('0' + sec % 10);
+        cache.m_second = second;
+    }
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+    cache.m_buf[20] = static_cast<char>('0' + ms / 100);
+    cache.m_buf[21] = static_cast<char>('0' + ms / 10 % 10);
+    cache.m_buf[22] = static_cast<char>('0' + ms % 10);
+    cache.m_buf[23] = '\0';
+    return cache.m_buf;
+}
 
-    auto since_epoch = timestamp.time_since_epoch();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch).count() % 1000;
-    oss << "." << std::setfill('0') << std::setw(3) << ms;
+int64_t TimeHelper::GetCurrentTimeNs() {
+    struct timespec ts;
+    clock_gettime(s_isCoarseClock.load(std::memory_order_relaxed) ? CLOCK_REALTIME_COARSE : CLOCK_REALTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
 
-    return oss.str();
+void TimeHelper::SetCoarseClock(bool enabled) {
+    s_isCoarseClock.store(enabled, std::memory_order_relaxed);
 }
 
 const char* StringHelper::GetFileName(const char* path) {
@@ -57,12 +97,6 @@ const char* StringHelper::GetFileName(const char* path) {
     return file;
 }
 
-std::string StringHelper::GetUniqueId(const std::string& localIp, uint16_t localPort, const std::string& peerIp, uint16_t peerPort) {
-    std::stringstream ss;
-    ss << localIp << ":" << localPort << "-" << peerIp << ":" << peerPort;
-    return ss.str();
-}
-
 std::string StringHelper::EventTypeToString(Event_t event) {
     static const std::unordered_map<Event_t, std::string> EventTypeStrings = {
         {Event_t::EvTypeNone, "None"},
@@ -172,9 +206,9 @@ uint8_t* MemoryAddrHelper::GetAlignAddr(const uint8_t* addr, uint32_t align) {
 
 int RandomHelper::GetRandomAddr(int low, int high) {
     // 随机设备，用于生成种子
-    static std::random_device rd;
-    // 梅森旋转算法引擎
-    static std::mt19937 gen(rd());
+    thread_local std::random_device rd;
+    // 梅森旋转算法引擎，每个线程独立一份，可在多个事件循环线程中并发调用
+    thread_local std::mt19937 gen(rd());
 
     std::uniform_int_distribution<> dis(low, high);
     return dis(gen);
@@ -2,10 +2,47 @@
 #include <random>
 #include <memory>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <unistd.h>
+#include <Utils/Logger.h>
 #include <Utils/Buffer.h>
 using namespace Utils;
 
+/**
+ * @brief 获取进程常驻内存大小(单位: KB)
+ */
+static std::size_t GetRssKb() {
+    std::size_t pages = 0;
+    std::size_t rssPages = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> pages >> rssPages;
+    return rssPages * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+/**
+ * @brief 模拟空闲连接：每个连接的输入输出缓冲区各收发一次数据后进入空闲状态
+ * @return 空闲后的常驻内存增量(单位: KB)
+ */
+static std::size_t IdleConnectionsRss(std::size_t connCount, bool releaseIdle) {
+    const std::string message(512, 'x');
+    auto pool = std::make_shared<Memory::SlabPool>("TEST_SLAB_POOL");
+
+    std::size_t rssStart = GetRssKb();
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    buffers.reserve(connCount * 2);
+    for (std::size_t idx = 0; idx < connCount * 2; ++idx) {
+        std::unique_ptr<Buffer> buffer(new Buffer(pool));
+        buffer->write(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+        buffer->moveReadStartPos(buffer->readableBytes());
+        if (releaseIdle) {
+            buffer->releaseIfEmpty();
+        }
+        buffers.emplace_back(std::move(buffer));
+    }
+    return GetRssKb() - rssStart;
+}
+
 void FuncTestFst() {
     std::cout << "NET BUFFER TEST FIRST -----------------------------" << std::endl;
 
@@ -43,9 +80,35 @@ void FuncTestSnd() {
     std::cout << "writable bytes: " << buffer->writableBytes() << std::endl;
 }
 
+void FuncTestTrd() {
+    std::cout << "NET BUFFER TEST THIRD (IDLE CONNECTION FOOTPRINT) -----------------------------" << std::endl;
+
+    Buffer buffer(std::make_shared<Memory::SlabPool>("TEST_SLAB_POOL"));
+    std::cout << "capacity before write: " << buffer.capacity() << std::endl;
+
+    // 大消息处理完后存储空间可归还
+    const std::string bigMessage(10 * 1024 * 1024, 'x');
+    buffer.write(reinterpret_cast<const uint8_t*>(bigMessage.data()), bigMessage.size());
+    std::cout << "capacity after 10MB write: " << buffer.capacity() << std::endl;
+    buffer.moveReadStartPos(buffer.readableBytes());
+    buffer.releaseIfEmpty();
+    std::cout << "capacity after drain and release: " << buffer.capacity() << std::endl;
+
+    // 100k空闲连接的缓冲区内存占用
+    const std::size_t connCount = 100000;
+    std::size_t releaseRss = IdleConnectionsRss(connCount, true);
+    std::size_t keepRss = IdleConnectionsRss(connCount, false);
+    std::cout << "idle connections: " << connCount << " rss kept buffers: " << keepRss << " KB"
+        << " rss released buffers: " << releaseRss << " KB" << std::endl;
+}
+
 int main() {
+    Logger::SetLowestLevel(LogLevel::ERROR);
+    Logger::enableWriteFile(false);
+
     FuncTestFst();
     FuncTestSnd();
+    FuncTestTrd();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <Utils/Logger.h>
+#include <Net/EventLoop.h>
+#include <Net/TcpServer.h>
+using namespace Net;
+using namespace Utils;
+
+static const char* TEST_SERVER_IP = "127.0.0.1";
+
+/**
+ * @brief 阻塞方式连接服务端
+ * @return 连接套接字，失败返回-1
+ */
+static int ConnectServer(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, TEST_SERVER_IP, &addr.sin_addr);
+
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+
+    int optval = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &optval, sizeof(optval));
+    return fd;
+}
+
+/**
+ * @brief 获取排序后样本的百分位值
+ * @return 百分位值
+ */
+static double Percentile(const std::vector<double>& sorted, double ratio) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    std::size_t idx = static_cast<std::size_t>(ratio * (sorted.size() - 1));
+    return sorted[idx];
+}
+
+/**
+ * @note  客户端逐条发送消息并等待回显，两次请求之间间隔gapUs微秒
+ * @brief 测试回显往返时延及服务端事件循环的忙轮询统计
+ */
+static void MeasureLatency(uint16_t port, uint64_t budgetUs, int gapUs, std::size_t roundCount) {
+    auto addr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port);
+    auto server = std::make_shared<TcpServer>(addr, nullptr, 1);
+    server->setBusyPoll(budgetUs);
+
+    // 记录连接所属的工作事件循环
+    std::mutex mutex;
+    EventLoopWkPtr connLoop;
+    server->setConnectCallback([&mutex, &connLoop](const Connection::Ptr& conn, bool isConn) {
+        if (isConn) {
+            std::lock_guard<std::mutex> lock(mutex);
+            connLoop = conn->getOwnerLoop();
+        }
+    });
+    server->setMessageCallback([](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        std::size_t size = 0;
+        auto data = buf->peek(size);
+        conn->send(data, size);
+        buf->moveReadStartPos(size);
+    });
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    int fd = ConnectServer(port);
+    if (fd < 0) {
+        std::cout << "connect server failed. port: " << port << std::endl;
+        server->shutdown();
+        return;
+    }
+
+    // 预热后开始统计
+    char message[64] = {};
+    std::vector<double> samples;
+    samples.reserve(roundCount);
+    for (std::size_t idx = 0; idx < roundCount + 1000; ++idx) {
+        if (gapUs > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(gapUs));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (::send(fd, message, sizeof(message), MSG_NOSIGNAL) != sizeof(message)) {
+            break;
+        }
+
+        std::size_t recvSize = 0;
+        while (recvSize < sizeof(message)) {
+            ssize_t ret = ::recv(fd, message + recvSize, sizeof(message) - recvSize, 0);
+            if (ret <= 0) {
+                break;
+            }
+            recvSize += ret;
+        }
+
+        if (idx >= 1000) {
+            samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        }
+    }
+    ::close(fd);
+
+    // 获取工作事件循环的忙轮询统计
+    EventLoop::BusyPollStats stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto loop = connLoop.lock();
+        if (nullptr != loop) {
+            loop->getBusyPollStats(stats);
+        }
+    }
+
+    std::sort(samples.begin(), samples.end());
+    std::cout << "budget: " << budgetUs << " us gap: " << gapUs << " us  rtt p50: " << Percentile(samples, 0.5)
+        << " us p99: " << Percentile(samples, 0.99) << " us p99.9: " << Percentile(samples, 0.999) << " us" << std::endl;
+    std::cout << "    loop spin: " << stats.m_spinNs / 1000000 << " ms (" << stats.m_spinPolls << " polls, " << stats.m_spinHits
+        << " hits)  sleep: " << stats.m_sleepNs / 1000000 << " ms (" << stats.m_blockPolls << " polls)" << std::endl;
+
+    server->shutdown();
+}
+
+void FuncTestFst() {
+    std::cout << "BUSY POLL TEST FIRST (BACK TO BACK PING PONG) -----------------------------" << std::endl;
+
+    MeasureLatency(9621, 0, 0, 20000);
+    MeasureLatency(9622, 200, 0, 20000);
+}
+
+void FuncTestSnd() {
+    std::cout << "BUSY POLL TEST SECOND (PACED PING PONG) -----------------------------" << std::endl;
+
+    // 请求间隔小于忙轮询预算时，事件循环在两次请求之间保持轮询，不进入休眠
+    MeasureLatency(9623, 0, 50, 5000);
+    MeasureLatency(9624, 200, 50, 5000);
+}
+
+int main() {
+    Logger::SetLowestLevel(LogLevel::ERROR);
+    Logger::enableWriteFile(false);
+
+    FuncTestFst();
+    FuncTestSnd();
+    return 0;
+}
\ No newline at end of file
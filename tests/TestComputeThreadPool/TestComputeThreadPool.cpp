@@ -0,0 +1,158 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <Utils/Logger.h>
+#include <Net/EventLoop.h>
+#include <Thread/EventLoopThread.h>
+#include <Thread/ComputeThreadPool.h>
+using namespace Net;
+using namespace Utils;
+using namespace Thread;
+
+/**
+ * @brief 等待条件满足
+ * @return 是否在超时前满足条件
+ */
+template <typename Cond>
+static bool WaitFor(Cond cond, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!cond()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * @brief 模拟耗时计算
+ * @return 计算结果
+ */
+static uint64_t BusyCompute(int durationUs) {
+    uint64_t value = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(durationUs);
+    while (std::chrono::steady_clock::now() < deadline) {
+        for (int idx = 0; idx < 100; ++idx) {
+            value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+    }
+    return value;
+}
+
+/**
+ * @note  事件循环中处理jobCount个耗时计算，期间每毫秒向事件循环投递一个探测任务
+ * @brief 测试事件循环对探测任务的最大响应时延
+ * @return 最大响应时延(单位: 微秒)
+ */
+static double MeasureLoopStall(const EventLoopWkPtr& loop, const ComputeThreadPool::Ptr& pool, int jobCount) {
+    std::atomic<int> doneCount(0);
+    loop.lock()->executeTask([loop, pool, jobCount, &doneCount]() {
+        for (int idx = 0; idx < jobCount; ++idx) {
+            if (nullptr == pool) {
+                BusyCompute(2000);
+                ++doneCount;
+            }
+            else {
+                pool->submit([]() { BusyCompute(2000); }, loop, [&doneCount]() { ++doneCount; });
+            }
+        }
+    });
+
+    double maxDelay = 0;
+    while (doneCount < jobCount) {
+        std::atomic_bool probed(false);
+        auto start = std::chrono::steady_clock::now();
+        loop.lock()->executeTask([&probed]() { probed = true; });
+        WaitFor([&probed]() { return probed.load(); }, 10000);
+        maxDelay = std::max(maxDelay, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return maxDelay;
+}
+
+void FuncTestFst() {
+    std::cout << "COMPUTE THREAD POOL TEST FIRST (LOOP RESPONSIVENESS) -----------------------------" << std::endl;
+
+    auto loopThread = std::make_shared<EventLoopThread>("COMPUTE_TEST_FST");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    auto pool = std::make_shared<ComputeThreadPool>(4);
+    double inlineDelay = MeasureLoopStall(loop, nullptr, 100);
+    double offloadDelay = MeasureLoopStall(loop, pool, 100);
+    std::cout << "max probe delay  inline: " << inlineDelay / 1000 << " ms  offloaded: " << offloadDelay / 1000 << " ms" << std::endl;
+}
+
+void FuncTestSnd() {
+    std::cout << "COMPUTE THREAD POOL TEST SECOND (CONTINUATION BATCHING) -----------------------------" << std::endl;
+
+    auto loopThread = std::make_shared<EventLoopThread>("COMPUTE_TEST_SND");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    // 后续任务应在提交任务的事件循环中执行，且合并投递
+    const int jobCount = 10000;
+    auto pool = std::make_shared<ComputeThreadPool>(2);
+    std::atomic<int> doneCount(0);
+    std::atomic<int> wrongThreadCount(0);
+    std::atomic<uint64_t> resultSum(0);
+    loop.lock()->executeTask([loop, pool, &doneCount, &wrongThreadCount, &resultSum]() {
+        for (int idx = 0; idx < jobCount; ++idx) {
+            pool->submitForResult([idx]() { return static_cast<uint64_t>(idx); }, loop,
+                [loop, &doneCount, &wrongThreadCount, &resultSum](uint64_t result) {
+                    if (!loop.lock()->isInCurrentThread()) {
+                        ++wrongThreadCount;
+                    }
+                    resultSum += result;
+                    ++doneCount;
+                });
+        }
+    });
+
+    WaitFor([&doneCount]() { return doneCount >= jobCount; }, 10000);
+    std::cout << "continuations: " << doneCount << " / " << jobCount << "  result sum: " << resultSum
+        << " (expected " << static_cast<uint64_t>(jobCount) * (jobCount - 1) / 2 << ")" << std::endl;
+    std::cout << "ran outside caller loop: " << wrongThreadCount << "  loop tasks posted: " << pool->getContinuationBatches() << std::endl;
+}
+
+void FuncTestTrd() {
+    std::cout << "COMPUTE THREAD POOL TEST THIRD (WORK STEALING) -----------------------------" << std::endl;
+
+    // 一个任务在计算线程中派生全部子任务，子任务进入同一线程队列，由其他线程窃取执行
+    const int subJobCount = 400;
+    for (unsigned int threadCount : {1u, 4u}) {
+        auto pool = std::make_shared<ComputeThreadPool>(threadCount);
+        std::atomic<int> doneCount(0);
+
+        auto start = std::chrono::steady_clock::now();
+        pool->submit([pool, &doneCount]() {
+            for (int idx = 0; idx < subJobCount; ++idx) {
+                pool->submit([&doneCount]() {
+                    // 模拟等待I/O的阻塞计算
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    ++doneCount;
+                });
+            }
+        });
+        WaitFor([&doneCount]() { return doneCount >= subJobCount; }, 30000);
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "threads: " << threadCount << "  sub jobs: " << doneCount << "  elapsed: " << elapsed
+            << " ms  stolen: " << pool->getStealCount() << std::endl;
+    }
+}
+
+int main() {
+    Logger::SetLowestLevel(LogLevel::ERROR);
+    Logger::enableWriteFile(false);
+
+    FuncTestFst();
+    FuncTestSnd();
+    FuncTestTrd();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <iostream>
+#include <Utils/Logger.h>
+#include <Net/TcpServer.h>
+#include <Net/Coroutine.h>
+#include <Thread/EventLoopThread.h>
+using namespace Net;
+using namespace Utils;
+using namespace Thread;
+
+static const char* TEST_SERVER_IP = "127.0.0.1";
+
+/**
+ * @brief 等待条件满足
+ * @return 是否在超时前满足条件
+ */
+template <typename Cond>
+static bool WaitFor(Cond cond, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!cond()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * @brief 编码长度前缀消息
+ */
+static std::string EncodeFrame(const std::string& body) {
+    uint32_t size = static_cast<uint32_t>(body.size());
+    std::string frame(reinterpret_cast<const char*>(&size), sizeof(size));
+    return frame + body;
+}
+
+/**
+ * @brief 服务端会话，按长度前缀读取完整消息后原样返回
+ */
+static CoTask<> EchoSession(CoStream::Ptr stream) {
+    while (true) {
+        std::string header = co_await stream->readExactly(sizeof(uint32_t));
+        if (header.empty()) {
+            break;
+        }
+
+        uint32_t size = 0;
+        memcpy(&size, header.data(), sizeof(size));
+        std::string body = co_await stream->readExactly(size);
+        if (body.empty() || !co_await stream->write(header + body)) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 创建协程回显服务端
+ */
+static TcpServer::Ptr CreateCoEchoServer(uint16_t port) {
+    auto addr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port);
+    auto server = std::make_shared<TcpServer>(addr, nullptr, 1);
+    server->setConnectCallback([](const Connection::Ptr& conn, bool isConn) {
+        if (isConn) {
+            CoSpawn(EchoSession(CoStream::Create(std::dynamic_pointer_cast<TcpConnection>(conn))));
+        }
+    });
+    return server;
+}
+
+/**
+ * @brief  读取一条长度前缀消息
+ * @return 消息体，连接断开时为空
+ */
+static CoTask<std::string> ReadFrame(CoStream::Ptr stream) {
+    std::string header = co_await stream->readExactly(sizeof(uint32_t));
+    if (header.empty()) {
+        co_return std::string();
+    }
+
+    uint32_t size = 0;
+    memcpy(&size, header.data(), sizeof(size));
+    co_return co_await stream->readExactly(size);
+}
+
+/**
+ * @brief 客户端会话，连接后逐条发送消息并校验回显
+ */
+static CoTask<> ClientSession(EventLoopWkPtr loop, uint16_t port, int count, std::atomic<int>* echoCount, std::atomic_bool* finished) {
+    auto conn = co_await CoConnect(loop, std::make_shared<IPv4Address>(TEST_SERVER_IP, port));
+    if (nullptr == conn) {
+        *finished = true;
+        co_return;
+    }
+
+    auto stream = CoStream::Create(conn);
+    for (int idx = 0; idx < count; ++idx) {
+        // 消息长度递增，覆盖单次读取不足一条消息的情况
+        std::string body(static_cast<std::size_t>(idx * 37 % 4096 + 1), static_cast<char>('a' + idx % 26));
+        if (!co_await stream->write(EncodeFrame(body))) {
+            break;
+        }
+
+        std::string reply = co_await ReadFrame(stream);
+        if (reply != body) {
+            break;
+        }
+        ++*echoCount;
+    }
+
+    stream->shutdown();
+    *finished = true;
+}
+
+void FuncTestFst() {
+    std::cout << "COROUTINE TEST FIRST (CONNECT, READ EXACTLY AND WRITE) -----------------------------" << std::endl;
+
+    const uint16_t port = 9631;
+    auto server = CreateCoEchoServer(port);
+    server->run();
+
+    auto loopThread = std::make_shared<EventLoopThread>("COROUTINE_TEST_FST");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    const int count = 10000;
+    std::atomic<int> echoCount(0);
+    std::atomic_bool finished(false);
+    auto start = std::chrono::steady_clock::now();
+    loop.lock()->executeTask([loop, &echoCount, &finished]() {
+        CoSpawn(ClientSession(loop, port, count, &echoCount, &finished));
+    });
+
+    WaitFor([&finished]() { return finished.load(); }, 30000);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "echo: " << echoCount << " / " << count << "  round trips/s: " << echoCount / elapsed
+        << "  client loop slab bytes: " << loop.lock()->getSlabPool()->getChunkBytes() << std::endl;
+    server->shutdown();
+}
+
+void FuncTestSnd() {
+    std::cout << "COROUTINE TEST SECOND (SLEEP) -----------------------------" << std::endl;
+
+    auto loopThread = std::make_shared<EventLoopThread>("COROUTINE_TEST_SND");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    std::atomic<double> elapsed(0);
+    std::atomic_bool inLoop(false);
+    loop.lock()->executeTask([loop, &elapsed, &inLoop]() {
+        CoSpawn([](EventLoopWkPtr loop, std::atomic<double>* elapsed, std::atomic_bool* inLoop) -> CoTask<> {
+            auto start = std::chrono::steady_clock::now();
+            for (int idx = 0; idx < 5; ++idx) {
+                co_await CoSleep(loop, 0.02);
+            }
+            *inLoop = loop.lock()->isInCurrentThread();
+            *elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }(loop, &elapsed, &inLoop));
+    });
+
+    WaitFor([&elapsed]() { return elapsed > 0; }, 3000);
+    std::cout << "slept 5 x 20 ms: " << elapsed << " ms  resumed in loop thread: " << (inLoop ? "yes" : "no") << std::endl;
+}
+
+void FuncTestTrd() {
+    std::cout << "COROUTINE TEST THIRD (CONNECT FAILED) -----------------------------" << std::endl;
+
+    auto loopThread = std::make_shared<EventLoopThread>("COROUTINE_TEST_TRD");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    // 端口无监听，连接失败后不重连，立即返回空连接
+    std::atomic<int> echoCount(0);
+    std::atomic_bool finished(false);
+    loop.lock()->executeTask([loop, &echoCount, &finished]() {
+        CoSpawn(ClientSession(loop, 9632, 1, &echoCount, &finished));
+    });
+
+    bool returned = WaitFor([&finished]() { return finished.load(); }, 3000);
+    std::cout << "connect returned: " << (returned ? "yes" : "no") << "  echo: " << echoCount << std::endl;
+}
+
+int main() {
+    Logger::SetLowestLevel(LogLevel::FATAL);
+    Logger::enableWriteFile(false);
+
+    FuncTestFst();
+    FuncTestSnd();
+    FuncTestTrd();
+    return 0;
+}
\ No newline at end of file
@@ -60,6 +60,29 @@ void FuncTest() {
             std::this_thread::sleep_for(std::chrono::seconds(1));
         }
     }
+
+    {
+        std::cout << "NET EVENTLOOP THREAD TEST FOURTH -----------------------------" << std::endl;
+
+        // 在线程初始化函数中设置线程名，测试是否可正常启动并生效
+        EventLoopThread* rawThd = nullptr;
+        EventLoopThread::Ptr evThd = std::make_shared<EventLoopThread>("EV_THD_FTH_TEST", [&rawThd](EventLoop::WkPtr loop) {
+            rawThd->setThreadName("ev_init_name");
+        });
+        rawThd = evThd.get();
+        evThd->run();
+
+        EventLoop::WkPtr evLoopWkPtr;
+        if (evThd->getEventLoop(evLoopWkPtr)) {
+            evLoopWkPtr.lock()->executeTask([]() {
+                char name[16] = {};
+                ::pthread_getname_np(pthread_self(), name, sizeof(name));
+                std::cout << "Set thread name in init callback success. name: " << name << std::endl;
+            });
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
 }
 
 int main() {
@@ -1,4 +1,12 @@
+#include <map>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <vector>
+#include <sstream>
 #include <iostream>
+#include <sched.h>
+#include <pthread.h>
 #include <Net/EventLoop.h>
 #include <Thread/EventLoopThread.h>
 #include <Thread/EventLoopThreadPool.h>
@@ -51,6 +59,211 @@ void FuncTest() {
 
         std::this_thread::sleep_for(std::chrono::seconds(3));
     }
+
+    {
+        std::cout << "NET EVENTLOOP THREAD POOL TEST THIRD (PLACEMENT POLICY) -----------------------------" << std::endl;
+
+        EventLoopThreadPool::Ptr evThdPool = std::make_shared<EventLoopThreadPool>(4);
+        std::vector<EventLoop::WkPtr> workLoops;
+        evThdPool->getWorkEventLoops(workLoops);
+
+        // 选择count次，打印各工作事件循环被选中的次数，每次选中后计入活跃连接数
+        auto selectAndPrint = [&evThdPool, &workLoops](const std::string& name, std::size_t count, bool countConn) {
+            std::map<std::string, std::size_t> distribution;
+            for (const auto& workLoop : workLoops) {
+                distribution[workLoop.lock()->getId()] = 0;
+            }
+
+            for (std::size_t idx = 0; idx < count; ++idx) {
+                EventLoop::WkPtr evLoopWkPtr;
+                evThdPool->getNextWorkEventLoop(evLoopWkPtr, idx);
+                ++distribution[evLoopWkPtr.lock()->getId()];
+                if (countConn) {
+                    evLoopWkPtr.lock()->incActiveConnections();
+                }
+            }
+
+            std::cout << name << ":";
+            for (const auto& pair : distribution) {
+                std::cout << " " << pair.second;
+            }
+            std::cout << std::endl;
+        };
+
+        evThdPool->setPlacementPolicy(Placement_t::PlacementRoundRobin);
+        selectAndPrint("round robin selections", 8, false);
+
+        // 第一个工作事件循环已有12个连接，新连接优先分配到其余事件循环直到负载均衡
+        evThdPool->setPlacementPolicy(Placement_t::PlacementLeastConnections);
+        for (int idx = 0; idx < 12; ++idx) {
+            workLoops.front().lock()->incActiveConnections();
+        }
+        selectAndPrint("least connections selections (first loop preloaded 12)", 36, true);
+        std::cout << "active connections after selections:";
+        for (const auto& workLoop : workLoops) {
+            std::cout << " " << workLoop.lock()->getActiveConnections();
+        }
+        std::cout << std::endl;
+
+        // 第二个工作事件循环持续处理耗时任务，单轮处理耗时升高后不再被选中
+        for (int idx = 0; idx < 20; ++idx) {
+            workLoops[1].lock()->executeTaskInLoop([]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(6));
+        }
+        std::cout << "iteration latency (ns):";
+        for (const auto& workLoop : workLoops) {
+            std::cout << " " << workLoop.lock()->getIterationLatency();
+        }
+        std::cout << std::endl;
+        evThdPool->setPlacementPolicy(Placement_t::PlacementLeastLatency);
+        selectAndPrint("least latency selections (second loop busy)", 30, false);
+
+        // 第二个工作事件循环空闲后单轮处理耗时随等待时长衰减，重新参与分配
+        std::this_thread::sleep_for(std::chrono::milliseconds(64 * EV_LOOP_LATENCY_HALF_LIFE));
+        std::cout << "iteration latency after idle (ns):";
+        for (const auto& workLoop : workLoops) {
+            std::cout << " " << workLoop.lock()->getIterationLatency();
+        }
+        std::cout << std::endl;
+        selectAndPrint("least latency selections (second loop idle)", 30, false);
+
+        // 同一哈希键始终选中同一事件循环，不同哈希键大致均匀分布
+        evThdPool->setPlacementPolicy(Placement_t::PlacementConsistentHash);
+        EventLoop::WkPtr firstSelected;
+        EventLoop::WkPtr secondSelected;
+        evThdPool->getNextWorkEventLoop(firstSelected, 12345);
+        evThdPool->getNextWorkEventLoop(secondSelected, 12345);
+        std::cout << "consistent hash same key same loop: " << (firstSelected.lock() == secondSelected.lock() ? "yes" : "no") << std::endl;
+        selectAndPrint("consistent hash selections", 40000, false);
+    }
+
+    {
+        std::cout << "NET EVENTLOOP THREAD POOL TEST FOURTH (CPU AFFINITY AND THREAD NAME) -----------------------------" << std::endl;
+
+        // 取进程可用的CPU列表
+        std::vector<int> cpus;
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        if (0 == ::sched_getaffinity(0, sizeof(cpuSet), &cpuSet)) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &cpuSet)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+        std::cout << "available cpus: " << cpus.size() << std::endl;
+
+        EventLoopThreadPool::Ptr evThdPool = std::make_shared<EventLoopThreadPool>(2);
+        std::cout << "pin work loops: " << (evThdPool->pinWorkLoops(cpus) ? "success" : "failed") << std::endl;
+
+        // 在各工作线程中读取线程名、亲和性及当前运行的CPU
+        std::vector<EventLoop::WkPtr> workLoops;
+        evThdPool->getWorkEventLoops(workLoops);
+        for (const auto& workLoop : workLoops) {
+            auto loop = workLoop.lock();
+            auto promise = std::make_shared<std::promise<std::string>>();
+            auto result = promise->get_future();
+            loop->executeTask([promise, loop]() {
+                char name[16] = {};
+                ::pthread_getname_np(::pthread_self(), name, sizeof(name));
+
+                cpu_set_t threadCpuSet;
+                CPU_ZERO(&threadCpuSet);
+                ::pthread_getaffinity_np(::pthread_self(), sizeof(threadCpuSet), &threadCpuSet);
+
+                std::stringstream ss;
+                ss << "thread name: " << name << " affinity cpus: " << CPU_COUNT(&threadCpuSet)
+                    << " bound cpu: " << loop->getBoundCpu() << " running on cpu: " << ::sched_getcpu();
+                promise->set_value(ss.str());
+            });
+            std::cout << result.get() << std::endl;
+        }
+    }
+
+    {
+        std::cout << "NET EVENTLOOP THREAD POOL TEST FIFTH (FAST START AND STOP) -----------------------------" << std::endl;
+
+        // 事件循环并发创建，退出由事件循环结束信号唤醒，无需按秒轮询
+        for (int round = 0; round < 3; ++round) {
+            auto start = std::chrono::steady_clock::now();
+            auto evThdPool = std::make_shared<EventLoopThreadPool>(64);
+            auto started = std::chrono::steady_clock::now();
+
+            std::vector<EventLoop::WkPtr> workLoops;
+            evThdPool->getWorkEventLoops(workLoops);
+            evThdPool.reset();
+            auto stopped = std::chrono::steady_clock::now();
+
+            std::size_t aliveCount = 0;
+            for (const auto& workLoop : workLoops) {
+                aliveCount += workLoop.expired() ? 0 : 1;
+            }
+
+            std::cout << "64 loops  start: " << std::chrono::duration<double, std::milli>(started - start).count()
+                << " ms  stop: " << std::chrono::duration<double, std::milli>(stopped - started).count()
+                << " ms  loops alive after stop: " << aliveCount << std::endl;
+        }
+    }
+
+    {
+        std::cout << "NET EVENTLOOP THREAD POOL TEST SIXTH (RUNTIME RESIZE) -----------------------------" << std::endl;
+
+        auto evThdPool = std::make_shared<EventLoopThreadPool>(2);
+        evThdPool->setPlacementPolicy(Placement_t::PlacementConsistentHash);
+
+        // 记录每个哈希键分配到的事件循环
+        const uint64_t keyCount = 10000;
+        auto placeKeys = [evThdPool, keyCount]() {
+            std::vector<const EventLoop*> placement;
+            for (uint64_t key = 0; key < keyCount; ++key) {
+                EventLoop::WkPtr workLoop;
+                evThdPool->getNextWorkEventLoop(workLoop, key);
+                placement.push_back(workLoop.lock().get());
+            }
+            return placement;
+        };
+
+        auto before = placeKeys();
+        evThdPool->addWorkLoops(2);
+        auto grown = placeKeys();
+
+        // 扩容后仅迁往新事件循环的哈希键改变归属
+        std::vector<EventLoop::WkPtr> workLoops;
+        evThdPool->getWorkEventLoops(workLoops);
+        std::size_t movedCount = 0;
+        std::size_t movedToOldCount = 0;
+        for (uint64_t key = 0; key < keyCount; ++key) {
+            if (before[key] != grown[key]) {
+                ++movedCount;
+                movedToOldCount += (grown[key] == workLoops[0].lock().get() || grown[key] == workLoops[1].lock().get()) ? 1 : 0;
+            }
+        }
+        std::cout << "grow 2 -> " << evThdPool->getWorkLoopCount() << "  keys moved: " << movedCount << " / " << keyCount
+            << "  moved between old loops: " << movedToOldCount << std::endl;
+
+        // 被移除的事件循环中模拟活跃连接，排空回调中关闭
+        for (std::size_t idx = 2; idx < workLoops.size(); ++idx) {
+            workLoops[idx].lock()->incActiveConnections();
+        }
+
+        std::atomic<int> drainCount(0);
+        auto start = std::chrono::steady_clock::now();
+        bool removed = evThdPool->removeWorkLoops(2, [&drainCount](const EventLoop::Ptr& loop, bool isForce) {
+            ++drainCount;
+            loop->decActiveConnections();
+        }, 3);
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        auto shrunk = placeKeys();
+        std::cout << "shrink " << workLoops.size() << " -> " << evThdPool->getWorkLoopCount() << "  result: " << removed
+            << "  drained loops: " << drainCount << "  elapsed: " << elapsed << " ms  placement restored: "
+            << (before == shrunk ? "yes" : "no") << "  removed loops alive: " << !workLoops[2].expired() + !workLoops[3].expired() << std::endl;
+
+        // 至少保留一个工作线程
+        std::cout << "remove all rejected: " << !evThdPool->removeWorkLoops(2) << std::endl;
+    }
 }
 
 int main() {
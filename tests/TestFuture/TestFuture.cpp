@@ -0,0 +1,165 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <Utils/Logger.h>
+#include <Net/EventLoop.h>
+#include <Net/Future.h>
+#include <Thread/EventLoopThread.h>
+using namespace Net;
+using namespace Utils;
+using namespace Thread;
+
+/**
+ * @brief 等待条件满足
+ * @return 是否在超时前满足条件
+ */
+template <typename Cond>
+static bool WaitFor(Cond cond, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!cond()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * @brief 创建并启动事件循环线程
+ */
+static EventLoopWkPtr StartLoop(std::vector<EventLoopThread::Ptr>& threads, const std::string& name) {
+    auto loopThread = std::make_shared<EventLoopThread>(name);
+    loopThread->run();
+    threads.push_back(loopThread);
+
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+    return loop;
+}
+
+/**
+ * @brief 在调用方事件循环中连续发起跨事件循环调用，每次结果返回后发起下一次
+ */
+static void SubmitChain(const EventLoopWkPtr& target, int remaining, std::atomic<int>* doneCount, std::atomic<int>* wrongThreadCount) {
+    auto caller = EventLoop::GetCurrentLoop();
+    target.lock()->submit([remaining]() {
+        return remaining * 2;
+    }).then([caller, target, remaining, doneCount, wrongThreadCount](int result) {
+        if (EventLoop::GetCurrentLoop() != caller || result != remaining * 2) {
+            ++*wrongThreadCount;
+        }
+        ++*doneCount;
+
+        if (remaining > 1) {
+            SubmitChain(target, remaining - 1, doneCount, wrongThreadCount);
+        }
+    });
+}
+
+void FuncTestFst() {
+    std::cout << "FUTURE TEST FIRST (CONTINUATION ON CALLER LOOP) -----------------------------" << std::endl;
+
+    std::vector<EventLoopThread::Ptr> threads;
+    auto caller = StartLoop(threads, "FUTURE_TEST_CALLER");
+    auto target = StartLoop(threads, "FUTURE_TEST_TARGET");
+
+    const int count = 100000;
+    std::atomic<int> doneCount(0);
+    std::atomic<int> wrongThreadCount(0);
+    auto start = std::chrono::steady_clock::now();
+    caller.lock()->executeTask([target, &doneCount, &wrongThreadCount]() {
+        SubmitChain(target, count, &doneCount, &wrongThreadCount);
+    });
+
+    WaitFor([&doneCount]() { return doneCount >= count; }, 30000);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "round trips: " << doneCount << " / " << count << "  per second: " << doneCount / elapsed
+        << "  wrong thread or result: " << wrongThreadCount << std::endl;
+}
+
+void FuncTestSnd() {
+    std::cout << "FUTURE TEST SECOND (WHEN ALL FAN OUT) -----------------------------" << std::endl;
+
+    std::vector<EventLoopThread::Ptr> threads;
+    auto caller = StartLoop(threads, "FUTURE_TEST_FAN_CALLER");
+    std::vector<EventLoopWkPtr> shards;
+    for (int idx = 0; idx < 4; ++idx) {
+        shards.push_back(StartLoop(threads, "FUTURE_TEST_SHARD_" + std::to_string(idx)));
+    }
+
+    // 每个分片计算各自区间的和，汇总结果在调用方事件循环中按分片顺序返回
+    std::atomic_bool finished(false);
+    std::atomic_bool inCaller(false);
+    std::vector<uint64_t> sums;
+    caller.lock()->executeTask([shards, &finished, &inCaller, &sums]() {
+        std::vector<Future<uint64_t>> futures;
+        for (std::size_t idx = 0; idx < shards.size(); ++idx) {
+            futures.push_back(shards[idx].lock()->submit([idx]() {
+                uint64_t sum = 0;
+                for (uint64_t value = idx * 1000000; value < (idx + 1) * 1000000; ++value) {
+                    sum += value;
+                }
+                return sum;
+            }));
+        }
+
+        auto caller = EventLoop::GetCurrentLoop();
+        WhenAll(futures).then([caller, &finished, &inCaller, &sums](std::vector<uint64_t> results) {
+            inCaller = EventLoop::GetCurrentLoop() == caller;
+            sums = std::move(results);
+            finished = true;
+        });
+    });
+
+    WaitFor([&finished]() { return finished.load(); }, 10000);
+    uint64_t total = 0;
+    for (auto sum : sums) {
+        total += sum;
+    }
+    std::cout << "shards: " << sums.size() << "  total: " << total << " (expected " << 3999999ULL * 4000000ULL / 2
+        << ")  continuation in caller loop: " << (inCaller ? "yes" : "no") << std::endl;
+}
+
+void FuncTestTrd() {
+    std::cout << "FUTURE TEST THIRD (NON LOOP CALLER) -----------------------------" << std::endl;
+
+    std::vector<EventLoopThread::Ptr> threads;
+    auto target = StartLoop(threads, "FUTURE_TEST_PLAIN");
+
+    // 非事件循环线程中设置的后续任务在设置结果的线程中执行，结果先于后续任务就绪时同样可以执行
+    auto future = target.lock()->submit([]() { return std::string("computed in loop"); });
+    WaitFor([&future]() { return future.isReady(); }, 3000);
+
+    std::atomic_bool inTarget(false);
+    std::string result;
+    future.then([target, &inTarget, &result](std::string value) {
+        inTarget = target.lock()->isInCurrentThread();
+        result = value;
+    });
+    std::cout << "result: " << result << "  ran in target loop: " << (inTarget ? "yes" : "no") << std::endl;
+
+    // 先设置后续任务再设置结果，结果同样就绪
+    Promise<int> promise;
+    auto waited = promise.getFuture();
+    int waitedValue = 0;
+    waited.thenInline([&waitedValue](int value) {
+        waitedValue = value;
+    });
+    bool readyBefore = waited.isReady();
+    promise.setValue(7);
+    std::cout << "continuation first  ready before value: " << (readyBefore ? "yes" : "no")
+        << "  ready after value: " << (waited.isReady() ? "yes" : "no") << "  value: " << waitedValue << std::endl;
+}
+
+int main() {
+    Logger::SetLowestLevel(LogLevel::ERROR);
+    Logger::enableWriteFile(false);
+
+    FuncTestFst();
+    FuncTestSnd();
+    FuncTestTrd();
+    return 0;
+}
\ No newline at end of file
@@ -1,6 +1,12 @@
+#include <ctime>
+#include <chrono>
 #include <thread>
+#include <vector>
+#include <iomanip>
+#include <sstream>
 #include <iostream>
 #include <Utils/Logger.h>
+#include <Utils/BinaryLogger.h>
 using namespace Utils;
 
 void FuncTestFst() {
@@ -59,10 +65,210 @@ void FuncTestTrd() {
     thd4.join();
 }
 
+/**
+ * @brief  多线程写日志
+ * @return 每秒写日志条数
+ */
+static double MeasureLogRate(int threadCount, int lineCount) {
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int idx = 0; idx < threadCount; ++idx) {
+        threads.emplace_back([lineCount, idx]() {
+            for (int i = 0; i < lineCount; ++i) {
+                LOG_INFO << "Log rate test. thread: " << idx << " line: " << i << " payload: " << 3.1415926;
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return threadCount * lineCount / elapsed;
+}
+
+void FuncTestFth() {
+    std::cout << "LOG TEST FOURTH (ASYNC BACKEND) -----------------------------" << std::endl;
+
+    const int threadCount = 4;
+    const int lineCount = 50000;
+    Logger::SetLowestLevel(LogLevel::INFO);
+    Logger::enableWriteConsole(false);
+
+    double syncRate = MeasureLogRate(threadCount, lineCount);
+
+    Logger::StartAsync(LOG_ASYNC_RING_SIZE, LOG_ASYNC_FLUSH_INTERVAL, LogOverflow_t::LogOverflowBlock);
+    double asyncRate = MeasureLogRate(threadCount, lineCount);
+    Logger::StopAsync();
+    std::cout << "lines/s  sync: " << syncRate << "  async (block): " << asyncRate
+        << "  dropped: " << Logger::GetDroppedCount() << std::endl;
+
+    // 缓冲区远小于写入量，超出部分丢弃并计数
+    Logger::StartAsync(4096, LOG_ASYNC_FLUSH_INTERVAL, LogOverflow_t::LogOverflowDrop);
+    double dropRate = MeasureLogRate(threadCount, lineCount);
+    Logger::StopAsync();
+    std::cout << "lines/s  async (drop, 4 KB ring): " << dropRate << "  dropped: " << Logger::GetDroppedCount() << std::endl;
+
+    Logger::enableWriteConsole(true);
+}
+
+/**
+ * @brief  参数求值计数
+ * @return 求值次数
+ */
+static int CountEvaluation(int& count) {
+    return ++count;
+}
+
+void FuncTestFif() {
+    std::cout << "LOG TEST FIFTH (DISABLED STATEMENTS) -----------------------------" << std::endl;
+
+    const int loopCount = 10000000;
+    int evalCount = 0;
+    Logger::SetLowestLevel(LogLevel::WARN);
+
+    // 级别未启用时不构造日志对象，也不对输出参数求值
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loopCount; ++i) {
+        LOG_DEBUG << "Disabled debug. value: " << CountEvaluation(evalCount);
+        LOG_INFO << "Disabled info. value: " << CountEvaluation(evalCount);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "disabled statements: " << 2 * loopCount << "  arguments evaluated: " << evalCount
+        << "  ns/statement: " << elapsed / (2 * loopCount) << "  compile-time min level: " << REACTOR_LOG_MIN_LEVEL << std::endl;
+}
+
+void FuncTestSix() {
+    std::cout << "LOG TEST SIXTH (BINARY LOGGING) -----------------------------" << std::endl;
+
+    const int loopCount = 1000000;
+    const std::string path = "/tmp/TestLog.blog";
+    Logger::SetLowestLevel(LogLevel::INFO);
+    Logger::enableWriteConsole(false);
+
+    // 文本异步日志: 调用线程格式化
+    Logger::StartAsync(LOG_ASYNC_RING_SIZE, LOG_ASYNC_FLUSH_INTERVAL, LogOverflow_t::LogOverflowBlock);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loopCount; ++i) {
+        LOG_INFO << "Order update. id: " << i << " price: " << 101.25 << " side: " << 'B' << " symbol: " << "IF2612";
+    }
+    auto textElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    Logger::StopAsync();
+
+    // 二进制日志: 调用线程仅记录格式id及参数
+    BinaryLogger::Start(BinaryLogMode_t::BinaryLogRaw, path, LOG_ASYNC_RING_SIZE, LOG_ASYNC_FLUSH_INTERVAL, LogOverflow_t::LogOverflowBlock);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loopCount; ++i) {
+        LOG_BIN_INFO("Order update. id: {} price: {} side: {} symbol: {}", i, 101.25, 'B', "IF2612");
+    }
+    auto binaryElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    BinaryLogger::Stop();
+
+    std::cout << "ns/call  text async: " << textElapsed / loopCount << "  binary: " << binaryElapsed / loopCount
+        << "  dropped: " << BinaryLogger::GetDroppedCount() << std::endl;
+
+    // 离线解码
+    std::ostringstream decoded;
+    uint64_t decodedCount = 0;
+    bool result = BinaryLogger::DecodeFile(path, decoded, decodedCount);
+    std::string text = decoded.str();
+    std::cout << "decode result: " << result << "  decoded: " << decodedCount << " / " << loopCount
+        << "  last line: " << text.substr(text.rfind('\n', text.size() - 2) + 1) << std::flush;
+
+    // 后台写线程格式化为文本，未启动时在调用线程中格式化
+    Logger::enableWriteConsole(true);
+    BinaryLogger::Start(BinaryLogMode_t::BinaryLogText);
+    LOG_BIN_WARN("Binary text mode. enabled: {} count: {} ratio: {} missing: {}", true, -3, 0.5);
+    BinaryLogger::Stop();
+    LOG_BIN_WARN("Binary log not started. formatted in caller, value: {}", 42u);
+}
+
+/**
+ * @brief  逐条调用localtime_r()、put_time()及ostringstream格式化时间，作为对比基准
+ * @return 格式化后的时间
+ */
+static std::string FormatTimeByStream(int64_t timeNs) {
+    auto fmtTime = static_cast<time_t>(timeNs / 1000000000);
+    std::tm tm = {};
+    localtime_r(&fmtTime, &tm);
+
+    std::ostringstream oss;
+    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << '.' << std::setfill('0') << std::setw(3) << timeNs / 1000000 % 1000;
+    return oss.str();
+}
+
+void FuncTestSev() {
+    std::cout << "LOG TEST SEVENTH (TIMESTAMP CACHE) -----------------------------" << std::endl;
+
+    // 跨越秒、分钟、日期边界时与逐条格式化结果一致
+    int64_t baseNs = TimeHelper::GetCurrentTimeNs();
+    int mismatch = 0;
+    for (int64_t offsetMs = 0; offsetMs < 2 * 86400 * 1000; offsetMs += 997) {
+        int64_t timeNs = baseNs + offsetMs * 1000000;
+        if (FormatTimeByStream(timeNs) != TimeHelper::FormatTime(timeNs)) {
+            ++mismatch;
+        }
+    }
+    std::cout << "format mismatch: " << mismatch << "  now: " << TimeHelper::GetCurrentTime() << std::endl;
+
+    const int loopCount = 1000000;
+    std::size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loopCount; ++i) {
+        checksum += FormatTimeByStream(TimeHelper::GetCurrentTimeNs()).size();
+    }
+    auto streamElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loopCount; ++i) {
+        checksum += TimeHelper::FormatTime(TimeHelper::GetCurrentTimeNs())[22];
+    }
+    auto cacheElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    TimeHelper::SetCoarseClock(true);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loopCount; ++i) {
+        checksum += TimeHelper::FormatTime(TimeHelper::GetCurrentTimeNs())[22];
+    }
+    auto coarseElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    TimeHelper::SetCoarseClock(false);
+
+    std::cout << "ns/timestamp  stream: " << streamElapsed / loopCount << "  cached: " << cacheElapsed / loopCount
+        << "  cached + coarse clock: " << coarseElapsed / loopCount << "  (checksum " << checksum << ")" << std::endl;
+
+    // 日志吞吐量: 同步写文件、异步写文件，分别使用精确时钟和粗粒度时钟
+    const int threadCount = 4;
+    const int lineCount = 50000;
+    Logger::SetLowestLevel(LogLevel::INFO);
+    Logger::enableWriteConsole(false);
+
+    double syncRate = MeasureLogRate(threadCount, lineCount);
+    Logger::StartAsync(LOG_ASYNC_RING_SIZE, LOG_ASYNC_FLUSH_INTERVAL, LogOverflow_t::LogOverflowBlock);
+    double asyncRate = MeasureLogRate(threadCount, lineCount);
+    Logger::StopAsync();
+
+    TimeHelper::SetCoarseClock(true);
+    double syncCoarseRate = MeasureLogRate(threadCount, lineCount);
+    Logger::StartAsync(LOG_ASYNC_RING_SIZE, LOG_ASYNC_FLUSH_INTERVAL, LogOverflow_t::LogOverflowBlock);
+    double asyncCoarseRate = MeasureLogRate(threadCount, lineCount);
+    Logger::StopAsync();
+    TimeHelper::SetCoarseClock(false);
+
+    std::cout << "lines/s  sync: " << syncRate << "  async: " << asyncRate << "  sync + coarse clock: " << syncCoarseRate
+        << "  async + coarse clock: " << asyncCoarseRate << std::endl;
+
+    Logger::enableWriteConsole(true);
+}
+
 int main() {
     FuncTestFst();
     FuncTestSnd();
     FuncTestTrd();
+    FuncTestFth();
+    FuncTestFif();
+    FuncTestSix();
+    FuncTestSev();
 
     return 0;
 }
\ No newline at end of file
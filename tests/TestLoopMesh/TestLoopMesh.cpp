@@ -0,0 +1,159 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <iostream>
+#include <Utils/Logger.h>
+#include <Net/EventLoop.h>
+#include <Thread/EventLoopThreadPool.h>
+using namespace Net;
+using namespace Utils;
+using namespace Thread;
+
+/**
+ * @brief 等待条件满足
+ * @return 是否在超时前满足条件
+ */
+template <typename Cond>
+static bool WaitFor(Cond cond, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!cond()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * @brief 全互联发送测试上下文
+ */
+struct MeshContext {
+    MeshContext(std::size_t loopCount, uint64_t messageCount)
+        : m_loopCount(loopCount),
+          m_messageCount(messageCount),
+          m_nextSeq(loopCount * loopCount, 0),
+          m_sentSeq(loopCount * loopCount, 0) {
+    }
+
+    // 工作事件循环数
+    std::size_t m_loopCount;
+
+    // 每对事件循环之间的消息数
+    uint64_t m_messageCount;
+
+    // 接收方期望的下一个序号，第src * n + dst个仅由第dst个事件循环访问
+    std::vector<uint64_t> m_nextSeq;
+
+    // 发送方已发送的序号，第src * n + dst个仅由第src个事件循环访问
+    std::vector<uint64_t> m_sentSeq;
+
+    // 已接收的消息数
+    std::atomic<uint64_t> m_recvCount{0};
+
+    // 乱序的消息数
+    std::atomic<uint64_t> m_outOfOrderCount{0};
+};
+
+/**
+ * @note  每次向每个接收方发送一批消息后重新投递自身，使发送与接收交替进行
+ * @brief 在第src个工作事件循环中发送消息
+ */
+static void SendBatch(const EventLoopThreadPool::Ptr& pool, const std::vector<EventLoopWkPtr>& loops,
+    const std::shared_ptr<MeshContext>& ctx, std::size_t src, bool useMesh) {
+    const uint64_t batchSize = 256;
+    bool finished = true;
+
+    for (std::size_t dst = 0; dst < ctx->m_loopCount; ++dst) {
+        if (dst == src) {
+            continue;
+        }
+
+        auto& sentSeq = ctx->m_sentSeq[src * ctx->m_loopCount + dst];
+        for (uint64_t count = 0; count < batchSize && sentSeq < ctx->m_messageCount; ++count) {
+            uint64_t seq = sentSeq++;
+            std::size_t channelIdx = src * ctx->m_loopCount + dst;
+            auto task = [ctx, channelIdx, seq]() {
+                if (ctx->m_nextSeq[channelIdx]++ != seq) {
+                    ++ctx->m_outOfOrderCount;
+                }
+                ++ctx->m_recvCount;
+            };
+
+            if (useMesh) {
+                pool->sendToLoop(dst, task);
+            }
+            else {
+                loops[dst].lock()->executeTaskInLoop(task);
+            }
+        }
+
+        if (sentSeq < ctx->m_messageCount) {
+            finished = false;
+        }
+    }
+
+    if (!finished) {
+        loops[src].lock()->executeTaskInLoop([pool, loops, ctx, src, useMesh]() {
+            SendBatch(pool, loops, ctx, src, useMesh);
+        });
+    }
+}
+
+/**
+ * @brief  测试全部工作事件循环两两互发消息的吞吐量
+ * @return 每秒投递消息数
+ */
+static double MeasureAllToAll(std::size_t loopCount, uint64_t messageCount, bool useMesh, std::size_t ringCapacity) {
+    auto pool = std::make_shared<EventLoopThreadPool>(loopCount);
+    if (useMesh && !pool->enableMesh(ringCapacity)) {
+        std::cout << "enable mesh failed" << std::endl;
+        return 0;
+    }
+
+    std::vector<EventLoopWkPtr> loops;
+    pool->getWorkEventLoops(loops);
+    auto ctx = std::make_shared<MeshContext>(loopCount, messageCount);
+    uint64_t totalCount = loopCount * (loopCount - 1) * messageCount;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t src = 0; src < loopCount; ++src) {
+        loops[src].lock()->executeTask([pool, loops, ctx, src, useMesh]() {
+            SendBatch(pool, loops, ctx, src, useMesh);
+        });
+    }
+    WaitFor([&ctx, totalCount]() { return ctx->m_recvCount >= totalCount; }, 60000);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << (useMesh ? "spsc mesh" : "task queue") << " (ring " << ringCapacity << "): received " << ctx->m_recvCount
+        << " / " << totalCount << " out of order: " << ctx->m_outOfOrderCount << " elapsed: " << elapsed << " s" << std::endl;
+    return static_cast<double>(ctx->m_recvCount) / elapsed;
+}
+
+void FuncTestFst() {
+    std::cout << "LOOP MESH TEST FIRST (ALL TO ALL THROUGHPUT) -----------------------------" << std::endl;
+
+    const std::size_t loopCount = 4;
+    const uint64_t messageCount = 200000;
+    double queueRate = MeasureAllToAll(loopCount, messageCount, false, EV_LOOP_MESH_RING_SIZE);
+    double meshRate = MeasureAllToAll(loopCount, messageCount, true, EV_LOOP_MESH_RING_SIZE);
+    std::cout << "messages/s  task queue: " << queueRate << "  spsc mesh: " << meshRate << std::endl;
+}
+
+void FuncTestSnd() {
+    std::cout << "LOOP MESH TEST SECOND (RING OVERFLOW KEEPS ORDER) -----------------------------" << std::endl;
+
+    // 环形队列远小于单批发送量，超出部分暂存后按顺序移入
+    MeasureAllToAll(3, 20000, true, 16);
+}
+
+int main() {
+    Logger::SetLowestLevel(LogLevel::ERROR);
+    Logger::enableWriteFile(false);
+
+    FuncTestFst();
+    FuncTestSnd();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <iostream>
+#include <Utils/Logger.h>
+#include <Net/TcpServer.h>
+#include <Net/TcpClient.h>
+#include <Thread/EventLoopThread.h>
+using namespace Net;
+using namespace Utils;
+using namespace Thread;
+
+static const char* TEST_SERVER_IP = "127.0.0.1";
+
+/**
+ * @brief 等待条件满足
+ * @return 是否在超时前满足条件
+ */
+template <typename Cond>
+static bool WaitFor(Cond cond, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!cond()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * @brief 创建回显服务端
+ */
+static TcpServer::Ptr CreateEchoServer(uint16_t port) {
+    auto addr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port);
+    auto server = std::make_shared<TcpServer>(addr, nullptr, 1);
+    server->setConnectCallback([](const Connection::Ptr& conn, bool isConn) {});
+    server->setMessageCallback([](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        std::size_t size = 0;
+        auto data = buf->peek(size);
+        conn->send(data, size);
+        buf->moveReadStartPos(size);
+    });
+    return server;
+}
+
+void FuncTestFst() {
+    std::cout << "TCP CLIENT TEST FIRST (CONNECT AND ECHO) -----------------------------" << std::endl;
+
+    const uint16_t port = 9201;
+    auto server = CreateEchoServer(port);
+    server->run();
+
+    auto loopThread = std::make_shared<EventLoopThread>("TCP_CLIENT_TEST_FST");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    std::atomic_bool connected(false);
+    std::atomic_bool replied(false);
+    auto client = std::make_shared<TcpClient>(loop, std::make_shared<IPv4Address>(TEST_SERVER_IP, port));
+    client->setConnectCallback([&connected](const Connection::Ptr& conn, bool isConn) {
+        connected = isConn;
+        if (isConn) {
+            std::cout << "client connected. " << conn->getConnectionInfo() << std::endl;
+            conn->send("hello reactor", strlen("hello reactor"));
+        }
+    });
+    client->setMessageCallback([&replied](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        std::size_t size = 0;
+        auto data = buf->peek(size);
+        std::cout << "client received: " << std::string(reinterpret_cast<const char*>(data), size) << std::endl;
+        buf->moveReadStartPos(size);
+        replied = true;
+    });
+    client->connect();
+
+    bool finished = WaitFor([&replied]() { return replied.load(); }, 3000);
+    std::cout << "echo finished: " << (finished ? "yes" : "no") << std::endl;
+
+    client->disconnect();
+    client->stop();
+    server->shutdown();
+}
+
+void FuncTestSnd() {
+    std::cout << "TCP CLIENT TEST SECOND (RECONNECT BACKOFF) -----------------------------" << std::endl;
+
+    const uint16_t port = 9202;
+    auto loopThread = std::make_shared<EventLoopThread>("TCP_CLIENT_TEST_SND");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    // 服务端未启动，连接失败后按指数退避重连
+    std::atomic_bool connected(false);
+    auto client = std::make_shared<TcpClient>(loop, std::make_shared<IPv4Address>(TEST_SERVER_IP, port));
+    client->setRetryDelay(0.05, 0.4);
+    client->setConnectCallback([&connected](const Connection::Ptr& conn, bool isConn) {
+        connected = isConn;
+    });
+    client->connect();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    std::cout << "retry count before server start: " << client->getConnector()->getRetryCount() << std::endl;
+
+    // 启动服务端后客户端自动连接成功
+    auto server = CreateEchoServer(port);
+    server->run();
+
+    bool finished = WaitFor([&connected]() { return connected.load(); }, 3000);
+    std::cout << "reconnected: " << (finished ? "yes" : "no")
+        << " retry count: " << client->getConnector()->getRetryCount() << std::endl;
+
+    client->stop();
+    server->shutdown();
+}
+
+int main() {
+    Logger::SetLowestLevel(LogLevel::FATAL);
+    Logger::enableWriteFile(false);
+
+    FuncTestFst();
+    FuncTestSnd();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <Utils/Logger.h>
+#include <Net/TcpRelay.h>
+#include <Net/TcpServer.h>
+#include <Net/TcpClient.h>
+using namespace Net;
+using namespace Utils;
+
+static const char* TEST_SERVER_IP = "127.0.0.1";
+
+/**
+ * @brief 等待条件满足
+ * @return 是否在超时前满足条件
+ */
+template <typename Cond>
+static bool WaitFor(Cond cond, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!cond()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * @brief 转发服务端上下文
+ */
+struct RelayContext {
+    // 是否启用零拷贝转发
+    bool m_isSpliceEnabled = true;
+
+    // 到上游的客户端
+    std::mutex m_mutex;
+    std::vector<TcpClient::Ptr> m_clients;
+
+    // 已结束的转发数
+    std::atomic<uint64_t> m_finishCount{0};
+
+    // 已结束转发的客户端到上游数据长度
+    std::atomic<uint64_t> m_forwardBytes{0};
+};
+
+/**
+ * @note  新连接暂停读取，连接上游成功后开始双向转发
+ * @brief 创建转发服务端
+ */
+static TcpServer::Ptr CreateRelayServer(uint16_t port, uint16_t upstreamPort, RelayContext& ctx) {
+    auto addr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port);
+    auto upstreamAddr = std::make_shared<IPv4Address>(TEST_SERVER_IP, upstreamPort);
+    auto server = std::make_shared<TcpServer>(addr, nullptr, 1);
+    server->setConnectCallback([&ctx, upstreamAddr](const Connection::Ptr& conn, bool isConn) {
+        if (!isConn) {
+            return;
+        }
+
+        conn->disableRead();
+        TcpConnection::WkPtr weakDownstream = std::dynamic_pointer_cast<TcpConnection>(conn);
+        auto client = std::make_shared<TcpClient>(conn->getOwnerLoop(), upstreamAddr);
+        client->setRetryEnabled(false);
+        client->setConnectCallback([&ctx, weakDownstream](const Connection::Ptr& upstream, bool isConn) {
+            auto downstream = weakDownstream.lock();
+            if (!isConn || nullptr == downstream) {
+                return;
+            }
+
+            auto relay = std::make_shared<TcpRelay>(downstream, std::dynamic_pointer_cast<TcpConnection>(upstream));
+            relay->setSpliceEnabled(ctx.m_isSpliceEnabled);
+            relay->setFinishCallback([&ctx](const TcpRelay::Ptr& relay) {
+                ctx.m_forwardBytes += relay->getForwardBytes();
+                ++ctx.m_finishCount;
+            });
+            relay->start();
+        });
+
+        {
+            std::lock_guard<std::mutex> lock(ctx.m_mutex);
+            ctx.m_clients.push_back(client);
+        }
+        client->connect();
+    });
+    return server;
+}
+
+/**
+ * @brief 创建阻塞监听套接字
+ */
+static int ListenRaw(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    int optval = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, TEST_SERVER_IP, &addr.sin_addr);
+    if (0 != ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) || 0 != ::listen(fd, 16)) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief 创建阻塞连接套接字
+ */
+static int ConnectRaw(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, TEST_SERVER_IP, &addr.sin_addr);
+    if (0 != ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief 读取数据直到对端关闭
+ * @return 读取数据长度
+ */
+static uint64_t ReadUntilEof(int fd, std::string* data = nullptr) {
+    static thread_local char buf[256 * 1024];
+    uint64_t total = 0;
+    while (true) {
+        ssize_t size = ::read(fd, buf, sizeof(buf));
+        if (size <= 0) {
+            break;
+        }
+        total += size;
+        if (nullptr != data) {
+            data->append(buf, size);
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief 发送全部数据
+ * @return 发送结果
+ */
+static bool SendAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t ret = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (ret <= 0) {
+            return false;
+        }
+        data += ret;
+        size -= ret;
+    }
+    return true;
+}
+
+void FuncTestFst() {
+    std::cout << "TCP RELAY TEST FIRST (HALF CLOSE) -----------------------------" << std::endl;
+
+    const uint16_t port = 9601;
+    const uint16_t upstreamPort = 9611;
+    const std::size_t requestSize = 1024 * 1024;
+
+    // 上游读到结束后才应答，验证半关闭经转发传递
+    int listenFd = ListenRaw(upstreamPort);
+    std::atomic<uint64_t> upstreamRecv(0);
+    std::thread upstream([listenFd, &upstreamRecv]() {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        upstreamRecv = ReadUntilEof(fd);
+        std::string response = "response for " + std::to_string(upstreamRecv) + " bytes";
+        SendAll(fd, response.data(), response.size());
+        ::close(fd);
+    });
+
+    RelayContext ctx;
+    auto server = CreateRelayServer(port, upstreamPort, ctx);
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    int fd = ConnectRaw(port);
+    std::string request(requestSize, 'q');
+    SendAll(fd, request.data(), request.size());
+    ::shutdown(fd, SHUT_WR);
+
+    std::string response;
+    ReadUntilEof(fd, &response);
+    ::close(fd);
+    upstream.join();
+    ::close(listenFd);
+
+    bool finished = WaitFor([&ctx]() { return ctx.m_finishCount >= 1; }, 3000);
+    std::cout << "upstream received: " << upstreamRecv << " / " << requestSize << std::endl;
+    std::cout << "client received: " << response << std::endl;
+    std::cout << "relay finished: " << (finished ? "yes" : "no") << std::endl;
+
+    server->shutdown();
+}
+
+/**
+ * @brief 测试经转发服务端发送数据到上游的吞吐量
+ * @return 吞吐量(单位: MB/s)
+ */
+static double MeasureThroughput(uint16_t port, uint16_t upstreamPort, bool spliceEnabled, uint64_t totalSize) {
+    int listenFd = ListenRaw(upstreamPort);
+    std::atomic<uint64_t> upstreamRecv(0);
+    std::thread upstream([listenFd, &upstreamRecv]() {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        upstreamRecv = ReadUntilEof(fd);
+        ::close(fd);
+    });
+
+    RelayContext ctx;
+    ctx.m_isSpliceEnabled = spliceEnabled;
+    auto server = CreateRelayServer(port, upstreamPort, ctx);
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::vector<char> chunk(256 * 1024, 'd');
+    auto start = std::chrono::steady_clock::now();
+    int fd = ConnectRaw(port);
+    for (uint64_t sent = 0; sent < totalSize; sent += chunk.size()) {
+        SendAll(fd, chunk.data(), chunk.size());
+    }
+    ::shutdown(fd, SHUT_WR);
+    ReadUntilEof(fd);
+    upstream.join();
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ::close(fd);
+    ::close(listenFd);
+
+    WaitFor([&ctx]() { return ctx.m_finishCount >= 1; }, 3000);
+    std::cout << (spliceEnabled ? "splice" : "copy") << " relay upstream received: " << upstreamRecv << " / " << totalSize
+        << " relay forward bytes: " << ctx.m_forwardBytes << std::endl;
+
+    server->shutdown();
+    return static_cast<double>(upstreamRecv) / elapsed / (1024 * 1024);
+}
+
+void FuncTestSnd() {
+    std::cout << "TCP RELAY TEST SECOND (LOOPBACK THROUGHPUT) -----------------------------" << std::endl;
+
+    const uint64_t totalSize = 1024ULL * 1024 * 1024;
+    double spliceRate = MeasureThroughput(9602, 9612, true, totalSize);
+    double copyRate = MeasureThroughput(9603, 9613, false, totalSize);
+    std::cout << "throughput  splice: " << spliceRate << " MB/s  copy: " << copyRate << " MB/s" << std::endl;
+}
+
+void FuncTestTrd() {
+    std::cout << "TCP RELAY TEST THIRD (BACKPRESSURE) -----------------------------" << std::endl;
+
+    const uint16_t port = 9604;
+    const uint16_t upstreamPort = 9614;
+
+    // 上游暂不读取，转发服务端应停止读取客户端，客户端最终发送阻塞
+    int listenFd = ListenRaw(upstreamPort);
+    std::atomic_bool startRead(false);
+    std::atomic<uint64_t> upstreamRecv(0);
+    std::thread upstream([listenFd, &startRead, &upstreamRecv]() {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        while (!startRead) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        upstreamRecv = ReadUntilEof(fd);
+        ::close(fd);
+    });
+
+    RelayContext ctx;
+    auto server = CreateRelayServer(port, upstreamPort, ctx);
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    int fd = ConnectRaw(port);
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    // 持续发送直到连续阻塞
+    std::vector<char> chunk(64 * 1024, 'b');
+    uint64_t sentBytes = 0;
+    auto lastProgress = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - lastProgress < std::chrono::milliseconds(300)) {
+        ssize_t ret = ::send(fd, chunk.data(), chunk.size(), MSG_NOSIGNAL);
+        if (ret > 0) {
+            sentBytes += ret;
+            lastProgress = std::chrono::steady_clock::now();
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    std::cout << "client blocked after: " << sentBytes / 1024 << " KB (bounded by socket buffers and relay pipe)" << std::endl;
+
+    // 上游开始读取后，客户端发送剩余数据
+    startRead = true;
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    SendAll(fd, chunk.data(), chunk.size());
+    sentBytes += chunk.size();
+    ::shutdown(fd, SHUT_WR);
+    ReadUntilEof(fd);
+    upstream.join();
+    ::close(fd);
+    ::close(listenFd);
+
+    std::cout << "upstream received: " << upstreamRecv << " / " << sentBytes
+        << " all delivered: " << (upstreamRecv == sentBytes ? "yes" : "no") << std::endl;
+
+    server->shutdown();
+}
+
+int main() {
+    // 转发时对端关闭可能触发SIGPIPE
+    ::signal(SIGPIPE, SIG_IGN);
+
+    Logger::SetLowestLevel(LogLevel::FATAL);
+    Logger::enableWriteFile(false);
+
+    FuncTestFst();
+    FuncTestSnd();
+    FuncTestTrd();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,661 @@
+#include <map>
+#include <set>
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <Utils/Logger.h>
+#include <Net/Acceptor.h>
+#include <Net/EventLoop.h>
+#include <Net/TcpServer.h>
+#include <Net/TcpClient.h>
+#include <Thread/EventLoopThread.h>
+using namespace Net;
+using namespace Utils;
+using namespace Thread;
+
+static const char* TEST_SERVER_IP = "127.0.0.1";
+
+/**
+ * @brief 阻塞方式连接服务端
+ * @return 连接套接字，失败返回-1
+ */
+static int ConnectServer(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, TEST_SERVER_IP, &addr.sin_addr);
+
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief 等待计数达到目标值
+ * @return 是否在超时前达到目标值
+ */
+static bool WaitCount(const std::atomic<uint64_t>& count, uint64_t target, int timeoutSec) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeoutSec);
+    while (count < target) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+void FuncTestFst() {
+    std::cout << "TCP SERVER TEST FIRST (CONNECT/DISCONNECT CHURN) -----------------------------" << std::endl;
+
+    const uint16_t port = 9101;
+    const uint64_t churnCount = 10000;
+
+    std::atomic<uint64_t> connCount(0);
+    std::atomic<uint64_t> disconnCount(0);
+
+    auto addr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port);
+    auto server = std::make_shared<TcpServer>(addr, nullptr, 2);
+    server->setConnectCallback([&connCount, &disconnCount](const Connection::Ptr& conn, bool isConn) {
+        isConn ? ++connCount : ++disconnCount;
+    });
+    server->setMessageCallback([](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        buf->moveReadStartPos(buf->readableBytes());
+    });
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 客户端反复建立并断开连接
+    auto start = std::chrono::steady_clock::now();
+    uint64_t failedCount = 0;
+    for (uint64_t idx = 0; idx < churnCount; ++idx) {
+        int fd = ConnectServer(port);
+        if (fd < 0) {
+            ++failedCount;
+            continue;
+        }
+        ::close(fd);
+    }
+
+    bool finished = WaitCount(disconnCount, churnCount - failedCount, 30);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "churn connections: " << churnCount << " failed: " << failedCount
+        << " server connected: " << connCount << " server disconnected: " << disconnCount
+        << " finished: " << (finished ? "yes" : "no") << std::endl;
+    std::cout << "elapsed: " << elapsed << " s, churn rate: " << static_cast<double>(disconnCount) / elapsed
+        << " connections/s" << std::endl;
+
+    server->shutdown();
+}
+
+void FuncTestSnd() {
+    std::cout << "TCP SERVER TEST SECOND (SHORT REQUEST CHURN) -----------------------------" << std::endl;
+
+    const uint16_t port = 9102;
+    const uint64_t churnCount = 10000;
+    const char request[] = "ping";
+
+    std::atomic<uint64_t> disconnCount(0);
+
+    auto addr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port);
+    auto server = std::make_shared<TcpServer>(addr, nullptr, 2);
+    server->setConnectCallback([&disconnCount](const Connection::Ptr& conn, bool isConn) {
+        if (!isConn) {
+            ++disconnCount;
+        }
+    });
+    server->setMessageCallback([](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        // 原样回显收到的请求
+        std::size_t size = 0;
+        auto data = buf->peek(size);
+        conn->send(data, size);
+        buf->moveReadStartPos(size);
+    });
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 客户端每次建立连接后发送一个请求，收到响应后断开连接
+    auto start = std::chrono::steady_clock::now();
+    uint64_t failedCount = 0;
+    for (uint64_t idx = 0; idx < churnCount; ++idx) {
+        int fd = ConnectServer(port);
+        if (fd < 0) {
+            ++failedCount;
+            continue;
+        }
+
+        char reply[sizeof(request)] = {};
+        if (::write(fd, request, sizeof(request)) != sizeof(request)
+            || ::recv(fd, reply, sizeof(reply), MSG_WAITALL) != sizeof(reply)
+            || 0 != ::memcmp(request, reply, sizeof(request))) {
+            ++failedCount;
+        }
+        ::close(fd);
+    }
+
+    bool finished = WaitCount(disconnCount, churnCount, 30);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "short requests: " << churnCount << " failed: " << failedCount
+        << " server disconnected: " << disconnCount << " finished: " << (finished ? "yes" : "no") << std::endl;
+    std::cout << "elapsed: " << elapsed << " s, request rate: " << static_cast<double>(churnCount - failedCount) / elapsed
+        << " connections/s" << std::endl;
+
+    server->shutdown();
+}
+
+/**
+ * @note  每个线程以非阻塞方式持续发起连接，不等待连接完成，最多保持windowSize个未关闭的连接；
+ *        关闭时发送RST，避免客户端端口进入TIME_WAIT
+ * @brief 发起连接风暴
+ */
+static void ConnectStorm(uint16_t port, const std::atomic_bool& stop, std::size_t windowSize) {
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, TEST_SERVER_IP, &addr.sin_addr);
+
+    linger lingerOpt = {1, 0};
+    std::deque<int> fds;
+    while (!stop) {
+        int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        ::setsockopt(fd, SOL_SOCKET, SO_LINGER, &lingerOpt, sizeof(lingerOpt));
+        ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        fds.push_back(fd);
+
+        if (fds.size() > windowSize) {
+            ::close(fds.front());
+            fds.pop_front();
+        }
+    }
+
+    for (int fd : fds) {
+        ::close(fd);
+    }
+}
+
+/**
+ * @brief 测试连接风暴下的接受速率
+ * @return 每秒接受连接数
+ */
+static double MeasureAcceptRate(uint16_t port, std::size_t batchSize, uint64_t acceptTarget) {
+    auto loopThread = std::make_shared<EventLoopThread>("TCP_SERVER_TEST_TRD");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    // 接受后直接关闭连接，只统计接受速率
+    std::atomic<uint64_t> acceptCount(0);
+    std::atomic<uint64_t> readyCount(0);
+    TcpAcceptor::Ptr acceptor;
+    auto addr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port);
+    loop.lock()->executeTask([&loop, &acceptor, &addr, &acceptCount, &readyCount, batchSize]() {
+        acceptor = std::make_shared<TcpAcceptor>(loop, addr, false);
+        acceptor->setAcceptBatchSize(batchSize);
+        acceptor->setNewConnCb([&acceptCount](Socket::Ptr& connSock, Timestamp recvTime) {
+            ++acceptCount;
+        });
+        acceptor->listen();
+        ++readyCount;
+    });
+    WaitCount(readyCount, 1, 3);
+
+    const std::size_t threadCount = 4;
+    std::atomic_bool stop(false);
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < threadCount; ++idx) {
+        threads.emplace_back(ConnectStorm, port, std::cref(stop), 256);
+    }
+
+    WaitCount(acceptCount, acceptTarget, 30);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t accepted = acceptCount;
+
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    loop.lock()->executeTask([&acceptor, &readyCount]() {
+        acceptor.reset();
+        --readyCount;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    return static_cast<double>(accepted) / elapsed;
+}
+
+void FuncTestTrd() {
+    std::cout << "TCP SERVER TEST THIRD (ACCEPT STORM) -----------------------------" << std::endl;
+
+    const uint64_t acceptTarget = 20000;
+    double singleRate = MeasureAcceptRate(9103, 1, acceptTarget);
+    double batchRate = MeasureAcceptRate(9104, ACCEPT_BATCH_SIZE, acceptTarget);
+    std::cout << "accepts/s  one per wakeup: " << singleRate << "  batched (" << ACCEPT_BATCH_SIZE << " per wakeup): "
+        << batchRate << std::endl;
+}
+
+/**
+ * @brief 测试不同接受连接方式下tcp服务的连接建立速率及各工作线程的连接分布
+ * @return 每秒建立连接数
+ */
+static double MeasureServerAcceptRate(uint16_t port, AcceptMode_t mode, bool cpuSteering, uint64_t connTarget,
+    std::map<std::thread::id, uint64_t>& distribution) {
+    std::mutex mutex;
+    std::atomic<uint64_t> connCount(0);
+    auto server = std::make_shared<TcpServer>(std::make_shared<IPv4Address>(TEST_SERVER_IP, port), nullptr, 2);
+    server->setAcceptMode(mode, cpuSteering);
+    server->setConnectCallback([&mutex, &connCount, &distribution](const Connection::Ptr& conn, bool isConn) {
+        if (isConn) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++distribution[std::this_thread::get_id()];
+            ++connCount;
+        }
+    });
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const std::size_t threadCount = 4;
+    std::atomic_bool stop(false);
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < threadCount; ++idx) {
+        threads.emplace_back(ConnectStorm, port, std::cref(stop), 256);
+    }
+
+    WaitCount(connCount, connTarget, 30);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t established = connCount;
+
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    server->shutdown();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<double>(established) / elapsed;
+}
+
+void FuncTestFth() {
+    std::cout << "TCP SERVER TEST FOURTH (PER WORKER REUSEPORT ACCEPT) -----------------------------" << std::endl;
+
+    // 客户端以RST关闭连接，服务端会记录大量读错误日志
+    Logger::SetLowestLevel(LogLevel::FATAL);
+
+    const uint64_t connTarget = 20000;
+    struct {
+        const char* m_name;
+        uint16_t m_port;
+        AcceptMode_t m_mode;
+        bool m_cpuSteering;
+    } cases[] = {
+        {"main loop accept", 9105, AcceptMode_t::AcceptMainLoop, false},
+        {"per worker accept (kernel hash)", 9106, AcceptMode_t::AcceptPerWorker, false},
+        {"per worker accept (cpu steering)", 9107, AcceptMode_t::AcceptPerWorker, true}
+    };
+
+    for (const auto& testCase : cases) {
+        std::map<std::thread::id, uint64_t> distribution;
+        double rate = MeasureServerAcceptRate(testCase.m_port, testCase.m_mode, testCase.m_cpuSteering, connTarget, distribution);
+
+        std::cout << testCase.m_name << ": " << rate << " connections/s, per worker:";
+        for (const auto& pair : distribution) {
+            std::cout << " " << pair.second;
+        }
+        std::cout << std::endl;
+    }
+}
+
+void FuncTestFif() {
+    std::cout << "TCP SERVER TEST FIFTH (RUNTIME ADD AND DRAIN WORK LOOPS) -----------------------------" << std::endl;
+
+    const uint16_t port = 9108;
+    const std::size_t connTarget = 40;
+    std::mutex mutex;
+    std::map<std::thread::id, uint64_t> distribution;
+    std::atomic<uint64_t> connCount(0);
+    std::atomic<uint64_t> disconnCount(0);
+
+    auto server = std::make_shared<TcpServer>(std::make_shared<IPv4Address>(TEST_SERVER_IP, port), nullptr, 1);
+    server->setConnectCallback([&mutex, &distribution, &connCount, &disconnCount](const Connection::Ptr& conn, bool isConn) {
+        if (isConn) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++distribution[std::this_thread::get_id()];
+            ++connCount;
+        }
+        else {
+            ++disconnCount;
+        }
+    });
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 扩容后新连接按轮询分配到新旧两个事件循环
+    bool added = server->addWorkLoops(1);
+    std::vector<int> fds;
+    for (std::size_t idx = 0; idx < connTarget; ++idx) {
+        int fd = ConnectServer(port);
+        if (fd >= 0) {
+            fds.push_back(fd);
+        }
+    }
+    WaitCount(connCount, fds.size(), 5);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::cout << "add result: " << added << "  loops: " << server->getWorkLoopCount() << "  per worker:";
+        for (const auto& pair : distribution) {
+            std::cout << " " << pair.second;
+        }
+        std::cout << std::endl;
+    }
+
+    // 移除时服务端关闭写方向，客户端读到EOF后关闭连接，无需等待超时
+    std::atomic_bool removeDone(false);
+    bool removed = false;
+    auto start = std::chrono::steady_clock::now();
+    std::thread remover([&server, &removeDone, &removed]() {
+        removed = server->removeWorkLoops(1, 3);
+        removeDone = true;
+    });
+
+    std::size_t eofCount = 0;
+    std::vector<bool> isClosed(fds.size(), false);
+    while (!removeDone) {
+        for (std::size_t idx = 0; idx < fds.size(); ++idx) {
+            char buf[16];
+            if (!isClosed[idx] && 0 == ::recv(fds[idx], buf, sizeof(buf), MSG_DONTWAIT)) {
+                ::close(fds[idx]);
+                isClosed[idx] = true;
+                ++eofCount;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    remover.join();
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "remove result: " << removed << "  loops: " << server->getWorkLoopCount() << "  drained clients: " << eofCount
+        << "  server disconnected: " << disconnCount << "  elapsed: " << elapsed << " ms" << std::endl;
+
+    // 剩余连接仍由保留的事件循环处理，新连接全部分配到保留的事件循环
+    uint64_t connected = connCount;
+    int fd = ConnectServer(port);
+    bool accepted = fd >= 0 && WaitCount(connCount, connected + 1, 3);
+    std::cout << "new connection after remove accepted: " << (accepted ? "yes" : "no") << std::endl;
+
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    for (std::size_t idx = 0; idx < fds.size(); ++idx) {
+        if (!isClosed[idx]) {
+            ::close(fds[idx]);
+        }
+    }
+    server->shutdown();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+/**
+ * @brief 回显客户端，逐条发送并校验回显，直到stop置位或连接断开
+ */
+static void EchoClient(uint16_t port, std::size_t msgSize, const std::atomic_bool& stop, std::atomic<uint64_t>& echoCount,
+    std::atomic<uint64_t>& errorCount) {
+    int fd = ConnectServer(port);
+    if (fd < 0) {
+        ++errorCount;
+        return;
+    }
+
+    std::vector<char> sendBuf(msgSize);
+    std::vector<char> recvBuf(msgSize);
+    for (uint64_t seq = 0; !stop; ++seq) {
+        for (std::size_t idx = 0; idx < msgSize; ++idx) {
+            sendBuf[idx] = static_cast<char>((seq + idx) & 0xff);
+        }
+
+        if (::send(fd, sendBuf.data(), msgSize, MSG_NOSIGNAL) != static_cast<ssize_t>(msgSize)) {
+            ++errorCount;
+            break;
+        }
+
+        std::size_t recvSize = 0;
+        while (recvSize < msgSize) {
+            ssize_t size = ::recv(fd, recvBuf.data() + recvSize, msgSize - recvSize, 0);
+            if (size <= 0) {
+                break;
+            }
+            recvSize += size;
+        }
+
+        if (recvSize != msgSize || 0 != ::memcmp(sendBuf.data(), recvBuf.data(), msgSize)) {
+            ++errorCount;
+            break;
+        }
+        ++echoCount;
+    }
+    ::close(fd);
+}
+
+void FuncTestSix() {
+    std::cout << "TCP SERVER TEST SIXTH (CONNECTION MIGRATION AND REBALANCE) -----------------------------" << std::endl;
+
+    const uint16_t port = 9109;
+    const std::size_t clientCount = 8;
+    std::mutex mutex;
+    std::map<std::thread::id, uint64_t> msgDistribution;
+
+    // 全部连接来自同一地址，一致性哈希将其分配到同一工作事件循环
+    auto server = std::make_shared<TcpServer>(std::make_shared<IPv4Address>(TEST_SERVER_IP, port), nullptr, 2);
+    server->setPlacementPolicy(Placement_t::PlacementConsistentHash);
+    server->setConnectCallback([](const Connection::Ptr& conn, bool isConn) {});
+    server->setMessageCallback([&mutex, &msgDistribution](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++msgDistribution[std::this_thread::get_id()];
+        }
+        conn->send(buf->readBegin(), buf->readableBytes());
+        buf->moveReadStartPos(buf->readableBytes());
+    });
+    server->run();
+    server->enableRebalance(0.2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::atomic_bool stop(false);
+    std::atomic<uint64_t> echoCount(0);
+    std::atomic<uint64_t> errorCount(0);
+    std::vector<std::thread> clients;
+    for (std::size_t idx = 0; idx < clientCount; ++idx) {
+        clients.emplace_back(EchoClient, port, 16 * 1024, std::cref(stop), std::ref(echoCount), std::ref(errorCount));
+    }
+
+    // 统计再均衡后一段时间内各工作事件循环处理的消息数
+    auto printDistribution = [&mutex, &msgDistribution](const std::string& phase) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::cout << phase << " messages per worker:";
+        for (const auto& pair : msgDistribution) {
+            std::cout << " " << pair.second;
+        }
+        std::cout << std::endl;
+        msgDistribution.clear();
+    };
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    printDistribution("before rebalance");
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        msgDistribution.clear();
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    printDistribution("after rebalance");
+    std::cout << "migrated connections: " << server->getMigratedCount() << "  echo: " << echoCount << "  errors: " << errorCount << std::endl;
+
+    // 扩容后移除事件循环并迁移其中的连接，客户端不感知
+    server->addWorkLoops(1);
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    uint64_t migratedBefore = server->getMigratedCount();
+    server->setMigrateOnDrain(true);
+    server->removeWorkLoops(2, 3);
+    uint64_t echoBefore = echoCount;
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    printDistribution("after remove with migration");
+    std::cout << "loops: " << server->getWorkLoopCount() << "  migrated by drain: " << server->getMigratedCount() - migratedBefore
+        << "  echo progressing: " << (echoCount > echoBefore ? "yes" : "no") << "  errors: " << errorCount << std::endl;
+
+    stop = true;
+    for (auto& client : clients) {
+        client.join();
+    }
+    server->shutdown();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+/**
+ * @brief 在共享线程池上创建回显服务端，记录处理消息的线程
+ */
+static TcpServer::Ptr CreateSharedEchoServer(const EventLoopThreadPool::Ptr& pool, uint16_t port, std::mutex& mutex,
+    std::set<std::thread::id>& threadIds) {
+    auto server = std::make_shared<TcpServer>(pool, std::make_shared<IPv4Address>(TEST_SERVER_IP, port));
+    server->setConnectCallback([](const Connection::Ptr& conn, bool isConn) {});
+    server->setMessageCallback([&mutex, &threadIds](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            threadIds.insert(std::this_thread::get_id());
+        }
+
+        std::size_t size = 0;
+        auto data = buf->peek(size);
+        conn->send(data, size);
+        buf->moveReadStartPos(size);
+    });
+    return server;
+}
+
+void FuncTestSev() {
+    std::cout << "TCP SERVER TEST SEVENTH (MULTIPLE SERVERS AND CLIENTS SHARING ONE POOL) -----------------------------" << std::endl;
+
+    const uint16_t fstPort = 9110;
+    const uint16_t sndPort = 9111;
+    const int connCount = 8;
+
+    std::mutex mutex;
+    std::set<std::thread::id> threadIds;
+    auto pool = std::make_shared<EventLoopThreadPool>(2);
+    auto fstServer = CreateSharedEchoServer(pool, fstPort, mutex, threadIds);
+    auto sndServer = CreateSharedEchoServer(pool, sndPort, mutex, threadIds);
+    sndServer->setAcceptMode(AcceptMode_t::AcceptPerWorker);
+    fstServer->run();
+    sndServer->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 两个服务各建立多个连接并回显
+    uint64_t echoCount = 0;
+    for (int idx = 0; idx < connCount; ++idx) {
+        int fd = ConnectServer(0 == idx % 2 ? fstPort : sndPort);
+        char buf[4] = {};
+        if (fd >= 0 && 4 == ::write(fd, "ping", 4) && 4 == ::read(fd, buf, sizeof(buf)) && 0 == memcmp(buf, "ping", 4)) {
+            ++echoCount;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    // 客户端从同一线程池中选择事件循环
+    std::atomic<uint64_t> clientEcho(0);
+    auto client = std::make_shared<TcpClient>(pool, std::make_shared<IPv4Address>(TEST_SERVER_IP, fstPort));
+    client->setConnectCallback([](const Connection::Ptr& conn, bool isConn) {
+        if (isConn) {
+            conn->send("ping", 4);
+        }
+    });
+    client->setMessageCallback([&mutex, &threadIds, &clientEcho](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            threadIds.insert(std::this_thread::get_id());
+        }
+        buf->moveReadStartPos(buf->readableBytes());
+        ++clientEcho;
+    });
+    client->connect();
+    WaitCount(clientEcho, 1, 3);
+
+    // 按工作事件循环独立监听的服务运行期间线程池不可扩缩容
+    bool heldAdd = pool->addWorkLoops(1);
+    sndServer->shutdown();
+
+    // 各工作事件循环中的监听器停止后才释放
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    bool releasedAdd = pool->addWorkLoops(1);
+
+    std::size_t threadCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        threadCount = threadIds.size();
+    }
+    std::cout << "server echo: " << echoCount << " / " << connCount << "  client echo: " << clientEcho
+        << "  handling threads: " << threadCount << " (pool work loops: 2)" << std::endl;
+    std::cout << "add loop while per worker listening: " << (heldAdd ? "yes" : "no")
+        << "  after shutdown: " << (releasedAdd ? "yes" : "no") << "  loops: " << pool->getWorkLoopCount() << std::endl;
+
+    // 移除工作事件循环时客户端连接计入活跃连接数，与服务端连接一同随排空迁移到保留的事件循环
+    fstServer->setMigrateOnDrain(true);
+    bool removed = pool->removeWorkLoops(pool->getWorkLoopCount() - 1, nullptr, 3);
+    auto conn = client->getConnection();
+    bool clientAlive = nullptr != conn && conn->send("ping", 4);
+    std::cout << "remove loops: " << (removed ? "yes" : "no") << "  loops: " << pool->getWorkLoopCount()
+        << "  client echo after remove: " << (clientAlive && WaitCount(clientEcho, 2, 3) ? "yes" : "no") << std::endl;
+
+    client->disconnect();
+
+    // 在工作事件循环中关闭服务，不等待其他事件循环
+    std::atomic<uint64_t> shutdownDone(0);
+    EventLoopWkPtr workLoop;
+    pool->getNextWorkEventLoop(workLoop);
+    workLoop.lock()->executeTask([fstServer, &shutdownDone]() {
+        fstServer->shutdown();
+        ++shutdownDone;
+    });
+    std::cout << "shutdown in work loop finished: " << (WaitCount(shutdownDone, 1, 3) ? "yes" : "no") << std::endl;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+int main() {
+    Logger::SetLowestLevel(LogLevel::ERROR);
+    Logger::enableWriteFile(false);
+
+    FuncTestFst();
+    FuncTestSnd();
+    FuncTestTrd();
+    FuncTestFth();
+    FuncTestFif();
+    FuncTestSix();
+    FuncTestSev();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <Utils/Logger.h>
+#include <Net/EventLoop.h>
+#include <Net/UdpServer.h>
+#include <Thread/EventLoopThread.h>
+using namespace Net;
+using namespace Utils;
+using namespace Thread;
+
+static const char* TEST_SERVER_IP = "127.0.0.1";
+
+/**
+ * @brief 创建连接到服务端的阻塞UDP套接字
+ * @return 套接字，失败返回-1
+ */
+static int CreateClient(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, TEST_SERVER_IP, &addr.sin_addr);
+
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+
+    // 接收超时，避免丢包时阻塞
+    timeval timeout = {1, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return fd;
+}
+
+/**
+ * @brief 等待计数稳定(一段时间内不再变化)
+ * @return 稳定后的计数
+ */
+template <typename Getter>
+static uint64_t WaitStable(Getter getter, uint64_t target, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    uint64_t last = getter();
+    while (last < target && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        uint64_t current = getter();
+        if (current == last) {
+            break;
+        }
+        last = current;
+    }
+    return last;
+}
+
+void FuncTestFst() {
+    std::cout << "UDP SERVER TEST FIRST (BATCH ECHO) -----------------------------" << std::endl;
+
+    const uint16_t port = 9401;
+    const int requestCount = 1000;
+
+    // 收到的一批报文原样批量回显给各自的对端
+    auto server = std::make_shared<UdpServer>(std::make_shared<IPv4Address>(TEST_SERVER_IP, port), nullptr, 1);
+    server->setMessageCallback([](const UdpSocket::Ptr& sock, const UdpSocket::DatagramBatch& batch, Timestamp recvTime) {
+        sock->sendBatch(batch);
+    });
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    int fd = CreateClient(port);
+    int echoCount = 0;
+    for (int idx = 0; idx < requestCount; ++idx) {
+        char request[32] = {};
+        int len = snprintf(request, sizeof(request), "datagram %d", idx);
+
+        char reply[32] = {};
+        if (::send(fd, request, len, 0) == len
+            && ::recv(fd, reply, sizeof(reply), 0) == len
+            && 0 == ::memcmp(request, reply, len)) {
+            ++echoCount;
+        }
+    }
+    ::close(fd);
+
+    std::cout << "echo requests: " << requestCount << " replied: " << echoCount
+        << " server received: " << server->getRecvCount() << std::endl;
+
+    server->shutdown();
+
+    // 重新启动后只统计新建的套接字，再次关闭后端口可被非复用套接字绑定
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    fd = CreateClient(port);
+    char reply[4] = {};
+    bool restartEcho = 4 == ::send(fd, "ping", 4, 0) && 4 == ::recv(fd, reply, sizeof(reply), 0);
+    ::close(fd);
+    uint64_t restartRecv = server->getRecvCount();
+    server->shutdown();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, TEST_SERVER_IP, &addr.sin_addr);
+    int bindFd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    bool released = 0 == ::bind(bindFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    ::close(bindFd);
+    std::cout << "restart echo: " << (restartEcho ? "yes" : "no") << " received after restart: " << restartRecv
+        << " port released after shutdown: " << (released ? "yes" : "no") << std::endl;
+}
+
+void FuncTestSnd() {
+    std::cout << "UDP SERVER TEST SECOND (RECVMMSG THROUGHPUT) -----------------------------" << std::endl;
+
+    const uint16_t port = 9402;
+    const uint64_t datagramCount = 1000000;
+    const std::size_t datagramSize = 64;
+    const std::size_t batchSize = 64;
+
+    std::atomic<uint64_t> batchCount(0);
+    auto server = std::make_shared<UdpServer>(std::make_shared<IPv4Address>(TEST_SERVER_IP, port), nullptr, 1);
+    server->setMessageCallback([&batchCount](const UdpSocket::Ptr& sock, const UdpSocket::DatagramBatch& batch, Timestamp recvTime) {
+        ++batchCount;
+    });
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 客户端通过sendmmsg批量发送
+    int fd = CreateClient(port);
+    int sndBuf = 4 * 1024 * 1024;
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndBuf, sizeof(sndBuf));
+
+    std::vector<char> payload(datagramSize, 'x');
+    std::vector<iovec> iovecs(batchSize, iovec{payload.data(), datagramSize});
+    std::vector<mmsghdr> msgs(batchSize);
+    for (std::size_t idx = 0; idx < batchSize; ++idx) {
+        ::memset(&msgs[idx], 0, sizeof(mmsghdr));
+        msgs[idx].msg_hdr.msg_iov = &iovecs[idx];
+        msgs[idx].msg_hdr.msg_iovlen = 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t sentCount = 0;
+    while (sentCount < datagramCount) {
+        int sent = ::sendmmsg(fd, msgs.data(), batchSize, 0);
+        if (sent > 0) {
+            sentCount += sent;
+        }
+
+        // 每批发送后让出CPU给服务端，避免单核环境下接收队列溢出
+        std::this_thread::yield();
+    }
+
+    uint64_t recvCount = WaitStable([&server]() { return server->getRecvCount(); }, datagramCount, 10000);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ::close(fd);
+
+    std::cout << "sent: " << sentCount << " received: " << recvCount << " lost: " << sentCount - recvCount
+        << " avg batch: " << (0 == batchCount ? 0 : static_cast<double>(recvCount) / batchCount) << std::endl;
+    std::cout << "elapsed: " << elapsed << " s, receive rate: " << static_cast<double>(recvCount) / elapsed
+        << " datagrams/s" << std::endl;
+
+    server->shutdown();
+}
+
+void FuncTestTrd() {
+    std::cout << "UDP SERVER TEST THIRD (GSO SEND AND GRO RECEIVE) -----------------------------" << std::endl;
+
+    const uint16_t port = 9403;
+    const uint16_t clientPort = 9404;
+    const uint16_t segmentSize = 1000;
+    const std::size_t dataSize = 64000;
+
+    std::atomic<uint64_t> recvBytes(0);
+    std::atomic<uint64_t> badSegments(0);
+    auto server = std::make_shared<UdpServer>(std::make_shared<IPv4Address>(TEST_SERVER_IP, port), nullptr, 1);
+    server->setGroEnabled(true);
+    server->setMessageCallback([&recvBytes, &badSegments, segmentSize](const UdpSocket::Ptr& sock, const UdpSocket::DatagramBatch& batch, Timestamp recvTime) {
+        for (const auto& datagram : batch) {
+            recvBytes += datagram.m_size;
+            if (segmentSize != datagram.m_size) {
+                ++badSegments;
+            }
+        }
+    });
+    server->run();
+
+    auto loopThread = std::make_shared<EventLoopThread>("UDP_SERVER_TEST_TRD");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 客户端启用GSO，一次发送由内核切分为多个报文
+    auto client = std::make_shared<UdpSocket>(loop, std::make_shared<IPv4Address>(TEST_SERVER_IP, clientPort));
+    client->setGsoEnabled(true);
+
+    std::atomic<uint64_t> sentCount(0);
+    std::vector<uint8_t> data(dataSize, 'g');
+    loop.lock()->executeTask([&client, &data, &sentCount, port, segmentSize]() {
+        client->open();
+
+        sockaddr_storage peerAddr = {};
+        IPv4Address(TEST_SERVER_IP, port).getSockAddr(peerAddr);
+        sentCount = client->sendSegments(peerAddr, data.data(), data.size(), segmentSize);
+    });
+
+    uint64_t recvCount = WaitStable([&server]() { return server->getRecvCount(); }, dataSize / segmentSize, 3000);
+    std::cout << "segments sent: " << sentCount << " received: " << recvCount
+        << " bytes: " << recvBytes << " bad segments: " << badSegments << std::endl;
+
+    loop.lock()->executeTask([&client]() {
+        client->close();
+    });
+    server->shutdown();
+}
+
+int main() {
+    Logger::SetLowestLevel(LogLevel::ERROR);
+    Logger::enableWriteFile(false);
+
+    FuncTestFst();
+    FuncTestSnd();
+    FuncTestTrd();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/socket.h>
+#include <Utils/Logger.h>
+#include <Net/Acceptor.h>
+#include <Net/EventLoop.h>
+#include <Net/TcpServer.h>
+#include <Net/TcpClient.h>
+#include <Thread/EventLoopThread.h>
+using namespace Net;
+using namespace Utils;
+using namespace Thread;
+
+static const char* TEST_SERVER_IP = "127.0.0.1";
+static const char* TEST_UNIX_PATH = "/tmp/reactor_test_unix.sock";
+static const char* TEST_UNIX_ABSTRACT = "@reactor_test_unix";
+static const char* TEST_SEQPACKET_PATH = "/tmp/reactor_test_seqpacket.sock";
+
+/**
+ * @brief 等待条件满足
+ * @return 是否在超时前满足条件
+ */
+template <typename Cond>
+static bool WaitFor(Cond cond, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!cond()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * @brief 创建回显服务端
+ */
+static TcpServer::Ptr CreateEchoServer(const Address::Ptr& addr) {
+    auto server = std::make_shared<TcpServer>(addr, nullptr, 1);
+    server->setConnectCallback([](const Connection::Ptr& conn, bool isConn) {});
+    server->setMessageCallback([](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        std::size_t size = 0;
+        auto data = buf->peek(size);
+        conn->send(data, size);
+        buf->moveReadStartPos(size);
+    });
+    return server;
+}
+
+/**
+ * @note  客户端收到回显后立即发起下一次请求
+ * @brief 测试回显往返速率
+ * @return 每秒往返次数
+ */
+static double MeasureRoundTrip(const EventLoopWkPtr& loop, const Address::Ptr& addr, uint64_t roundCount) {
+    static const char message[] = "0123456789abcdef0123456789abcdef";
+
+    std::atomic<uint64_t> doneCount(0);
+    auto client = std::make_shared<TcpClient>(loop, addr);
+    client->setConnectCallback([](const Connection::Ptr& conn, bool isConn) {
+        if (isConn) {
+            conn->send(message, sizeof(message));
+        }
+    });
+    client->setMessageCallback([&doneCount, roundCount](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        while (buf->readableBytes() >= sizeof(message)) {
+            buf->moveReadStartPos(sizeof(message));
+            if (++doneCount < roundCount) {
+                conn->send(message, sizeof(message));
+            }
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    client->connect();
+    WaitFor([&doneCount, roundCount]() { return doneCount >= roundCount; }, 30000);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    client->stop();
+    return static_cast<double>(doneCount) / elapsed;
+}
+
+void FuncTestFst() {
+    std::cout << "UNIX SOCKET TEST FIRST (STREAM ECHO VS TCP LOOPBACK) -----------------------------" << std::endl;
+
+    const uint64_t roundCount = 20000;
+    auto loopThread = std::make_shared<EventLoopThread>("UNIX_SOCKET_TEST_FST");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    auto unixAddr = std::make_shared<UnixAddress>(TEST_UNIX_PATH);
+    auto unixServer = CreateEchoServer(unixAddr);
+    unixServer->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::cout << "unix path exists while listening: " << (0 == ::access(TEST_UNIX_PATH, F_OK) ? "yes" : "no") << std::endl;
+    double unixRate = MeasureRoundTrip(loop, unixAddr, roundCount);
+
+    auto abstractAddr = std::make_shared<UnixAddress>(TEST_UNIX_ABSTRACT);
+    auto abstractServer = CreateEchoServer(abstractAddr);
+    abstractServer->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    double abstractRate = MeasureRoundTrip(loop, abstractAddr, roundCount);
+
+    auto tcpAddr = std::make_shared<IPv4Address>(TEST_SERVER_IP, 9501);
+    auto tcpServer = CreateEchoServer(tcpAddr);
+    tcpServer->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    double tcpRate = MeasureRoundTrip(loop, tcpAddr, roundCount);
+
+    std::cout << "round trips/s  unix path: " << unixRate << "  unix abstract: " << abstractRate
+        << "  tcp loopback: " << tcpRate << std::endl;
+
+    unixServer->shutdown();
+    abstractServer->shutdown();
+    tcpServer->shutdown();
+
+    // 监听器随服务端释放，同时删除套接字文件
+    unixServer.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::cout << "unix path removed after release: " << (0 != ::access(TEST_UNIX_PATH, F_OK) ? "yes" : "no") << std::endl;
+}
+
+void FuncTestSnd() {
+    std::cout << "UNIX SOCKET TEST SECOND (FILE DESCRIPTOR PASSING) -----------------------------" << std::endl;
+
+    // 服务端取出随消息到达的文件描述符，通过该描述符写入应答
+    static const char reply[] = "written through passed fd";
+    auto unixAddr = std::make_shared<UnixAddress>(TEST_UNIX_PATH);
+    auto server = std::make_shared<TcpServer>(unixAddr, nullptr, 1);
+    std::atomic<std::size_t> recvFdCount(0);
+    server->setConnectCallback([](const Connection::Ptr& conn, bool isConn) {});
+    server->setMessageCallback([&recvFdCount](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        buf->moveReadStartPos(buf->readableBytes());
+
+        std::vector<int> fds;
+        auto unixConn = std::dynamic_pointer_cast<UnixConnection>(conn);
+        if (nullptr == unixConn || 0 == unixConn->takeFds(fds)) {
+            return;
+        }
+
+        recvFdCount += fds.size();
+        for (int fd : fds) {
+            ssize_t ret = ::write(fd, reply, sizeof(reply));
+            (void)ret;
+            ::close(fd);
+        }
+    });
+    server->run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto loopThread = std::make_shared<EventLoopThread>("UNIX_SOCKET_TEST_SND");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    int pipeFds[2] = {-1, -1};
+    if (0 != ::pipe(pipeFds)) {
+        std::cout << "create pipe failed" << std::endl;
+        return;
+    }
+
+    // 连接建立后将管道写端发送给服务端，发送后本端即可关闭
+    std::atomic_bool sent(false);
+    auto client = std::make_shared<TcpClient>(loop, unixAddr);
+    client->setConnectCallback([&sent, &pipeFds](const Connection::Ptr& conn, bool isConn) {
+        auto unixConn = std::dynamic_pointer_cast<UnixConnection>(conn);
+        if (isConn && nullptr != unixConn) {
+            sent = unixConn->sendFds("fd", 2, std::vector<int>{pipeFds[1]});
+            ::close(pipeFds[1]);
+        }
+    });
+    client->connect();
+    WaitFor([&sent]() { return sent.load(); }, 3000);
+
+    char data[64] = {};
+    ssize_t readSize = ::read(pipeFds[0], data, sizeof(data));
+    ::close(pipeFds[0]);
+
+    std::cout << "fd sent: " << (sent ? "yes" : "no") << " fds received by server: " << recvFdCount << std::endl;
+    std::cout << "read from pipe: " << (readSize > 0 ? std::string(data) : std::string("(none)")) << std::endl;
+
+    client->stop();
+    server->shutdown();
+}
+
+void FuncTestTrd() {
+    std::cout << "UNIX SOCKET TEST THIRD (SEQPACKET RECORD BOUNDARIES) -----------------------------" << std::endl;
+
+    auto loopThread = std::make_shared<EventLoopThread>("UNIX_SOCKET_TEST_TRD");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    // 每次读回调对应一条完整记录，服务端逐条回显记录长度
+    auto unixAddr = std::make_shared<UnixAddress>(TEST_SEQPACKET_PATH);
+    std::vector<TcpConnection::Ptr> conns;
+    std::shared_ptr<UnixAcceptor> acceptor;
+    loop.lock()->executeTask([&loop, &unixAddr, &conns, &acceptor]() {
+        acceptor = std::make_shared<UnixAcceptor>(loop, unixAddr, Socket_t::SEQPACKET);
+        acceptor->setNewConnCb([&loop, &conns](Socket::Ptr& connSock, Timestamp recvTime) {
+            auto conn = TcpConnection::Create(loop, connSock);
+            conn->setConnectCallback([](const Connection::Ptr& conn, bool isConn) {});
+            conn->setMessageCallback([](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+                uint32_t recordSize = static_cast<uint32_t>(buf->readableBytes());
+                buf->moveReadStartPos(recordSize);
+                conn->send(&recordSize, sizeof(recordSize));
+            });
+            conn->open();
+            conns.push_back(conn);
+        });
+        acceptor->listen();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    int fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    sockaddr_un peerAddr = {};
+    peerAddr.sun_family = AF_UNIX;
+    ::strncpy(peerAddr.sun_path, TEST_SEQPACKET_PATH, sizeof(peerAddr.sun_path) - 1);
+    if (fd < 0 || 0 != ::connect(fd, reinterpret_cast<sockaddr*>(&peerAddr), sizeof(peerAddr))) {
+        std::cout << "connect seqpacket server failed" << std::endl;
+        return;
+    }
+
+    // 连续发送多条记录，服务端应按发送时的记录长度逐条应答
+    const std::vector<std::size_t> recordSizes = {1, 100, 4096, 60000};
+    for (auto size : recordSizes) {
+        std::vector<char> record(size, 'r');
+        ssize_t ret = ::send(fd, record.data(), record.size(), MSG_NOSIGNAL);
+        (void)ret;
+    }
+
+    bool matched = true;
+    for (auto size : recordSizes) {
+        uint32_t recordSize = 0;
+        if (::recv(fd, &recordSize, sizeof(recordSize), 0) != sizeof(recordSize) || recordSize != size) {
+            matched = false;
+        }
+        std::cout << "record sent: " << size << " received by server: " << recordSize << std::endl;
+    }
+    std::cout << "record boundaries preserved: " << (matched ? "yes" : "no") << std::endl;
+
+    ::close(fd);
+    loop.lock()->executeTask([&conns, &acceptor]() {
+        conns.clear();
+        acceptor.reset();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+int main() {
+    Logger::SetLowestLevel(LogLevel::FATAL);
+    Logger::enableWriteFile(false);
+
+    FuncTestFst();
+    FuncTestSnd();
+    FuncTestTrd();
+    return 0;
+}
\ No newline at end of file
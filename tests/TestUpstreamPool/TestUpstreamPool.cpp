@@ -0,0 +1,251 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <iostream>
+#include <Utils/Logger.h>
+#include <Net/EventLoop.h>
+#include <Net/TcpServer.h>
+#include <Net/UpstreamPool.h>
+#include <Thread/EventLoopThread.h>
+using namespace Net;
+using namespace Utils;
+using namespace Thread;
+
+static const char* TEST_SERVER_IP = "127.0.0.1";
+static const char TEST_REQUEST[] = "ping";
+static const std::size_t TEST_REQUEST_SIZE = sizeof(TEST_REQUEST);
+
+/**
+ * @brief 等待条件满足
+ * @return 是否在超时前满足条件
+ */
+template <typename Cond>
+static bool WaitFor(Cond cond, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!cond()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * @brief 创建回显服务端，并统计连接建立和断开次数
+ */
+static TcpServer::Ptr CreateEchoServer(uint16_t port, std::atomic<uint64_t>& connCount, std::atomic<uint64_t>& disconnCount) {
+    auto addr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port);
+    auto server = std::make_shared<TcpServer>(addr, nullptr, 1);
+    server->setConnectCallback([&connCount, &disconnCount](const Connection::Ptr& conn, bool isConn) {
+        isConn ? ++connCount : ++disconnCount;
+    });
+    server->setMessageCallback([](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        std::size_t size = 0;
+        auto data = buf->peek(size);
+        conn->send(data, size);
+        buf->moveReadStartPos(size);
+    });
+    return server;
+}
+
+/**
+ * @note  每收到一个完整响应回调一次，由回调归还连接
+ * @brief 设置连接池响应回调
+ */
+static void SetResponseCallback(const UpstreamPool::Ptr& pool, const std::function<void(const TcpConnection::Ptr&)>& onResponse) {
+    pool->setMessageCallback([onResponse](const Connection::Ptr& conn, const Buffer::Ptr& buf, Timestamp recvTime) {
+        auto tcpConn = std::dynamic_pointer_cast<TcpConnection>(conn);
+        while (buf->readableBytes() >= TEST_REQUEST_SIZE) {
+            buf->moveReadStartPos(TEST_REQUEST_SIZE);
+            onResponse(tcpConn);
+        }
+    });
+}
+
+void FuncTestFst() {
+    std::cout << "UPSTREAM POOL TEST FIRST (WARM CONNECTION REUSE) -----------------------------" << std::endl;
+
+    const uint16_t port = 9301;
+    const uint64_t requestCount = 20000;
+
+    std::atomic<uint64_t> connCount(0);
+    std::atomic<uint64_t> disconnCount(0);
+    auto server = CreateEchoServer(port, connCount, disconnCount);
+    server->run();
+
+    auto loopThread = std::make_shared<EventLoopThread>("UPSTREAM_POOL_TEST_FST");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    auto pool = std::make_shared<UpstreamPool>(std::vector<EventLoopWkPtr>{loop});
+    pool->start();
+
+    // 请求在连接池所属事件循环中串行发起，收到响应后发起下一个请求
+    auto upstreamAddr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port);
+    std::atomic<uint64_t> doneCount(0);
+    std::function<void()> sendRequest = [&pool, &loop, &upstreamAddr]() {
+        pool->acquire(loop.lock(), upstreamAddr, [](const TcpConnection::Ptr& conn) {
+            if (nullptr != conn) {
+                conn->send(TEST_REQUEST, TEST_REQUEST_SIZE);
+            }
+        });
+    };
+
+    UpstreamPool::WkPtr weakPool = pool;
+    SetResponseCallback(pool, [weakPool, &doneCount, &sendRequest, requestCount](const TcpConnection::Ptr& conn) {
+        weakPool.lock()->release(conn);
+        if (++doneCount < requestCount) {
+            sendRequest();
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    loop.lock()->executeTask(sendRequest);
+    bool finished = WaitFor([&doneCount, requestCount]() { return doneCount >= requestCount; }, 30000);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "pooled requests: " << doneCount << " finished: " << (finished ? "yes" : "no")
+        << " upstream connections: " << connCount << std::endl;
+    std::cout << "elapsed: " << elapsed << " s, request rate: " << static_cast<double>(doneCount) / elapsed
+        << " requests/s" << std::endl;
+
+    pool->stop();
+    WaitFor([&disconnCount, &connCount]() { return disconnCount >= connCount; }, 3000);
+    server->shutdown();
+}
+
+void FuncTestSnd() {
+    std::cout << "UPSTREAM POOL TEST SECOND (PIPELINE AND MAX TOTAL) -----------------------------" << std::endl;
+
+    const uint16_t port = 9302;
+    const uint64_t requestCount = 64;
+
+    std::atomic<uint64_t> connCount(0);
+    std::atomic<uint64_t> disconnCount(0);
+    auto server = CreateEchoServer(port, connCount, disconnCount);
+    server->run();
+
+    auto loopThread = std::make_shared<EventLoopThread>("UPSTREAM_POOL_TEST_SND");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    // 最多2个连接，每个连接最多4个进行中的请求
+    UpstreamPool::Options options;
+    options.m_maxTotal = 2;
+    options.m_maxPipeline = 4;
+    auto pool = std::make_shared<UpstreamPool>(std::vector<EventLoopWkPtr>{loop}, options);
+    pool->start();
+
+    std::atomic<uint64_t> doneCount(0);
+    std::atomic<uint64_t> maxInflight(0);
+    std::atomic<uint64_t> inflight(0);
+    UpstreamPool::WkPtr weakPool = pool;
+    SetResponseCallback(pool, [weakPool, &doneCount, &inflight](const TcpConnection::Ptr& conn) {
+        --inflight;
+        ++doneCount;
+        weakPool.lock()->release(conn);
+    });
+
+    // 同时发起全部请求，超出连接承载能力的请求排队等待
+    auto upstreamAddr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port);
+    loop.lock()->executeTask([&pool, &loop, &upstreamAddr, &inflight, &maxInflight, requestCount]() {
+        for (uint64_t idx = 0; idx < requestCount; ++idx) {
+            pool->acquire(loop.lock(), upstreamAddr, [&inflight, &maxInflight](const TcpConnection::Ptr& conn) {
+                if (nullptr != conn) {
+                    maxInflight = std::max<uint64_t>(maxInflight, ++inflight);
+                    conn->send(TEST_REQUEST, TEST_REQUEST_SIZE);
+                }
+            });
+        }
+    });
+
+    bool finished = WaitFor([&doneCount, requestCount]() { return doneCount >= requestCount; }, 5000);
+    std::cout << "pipelined requests: " << doneCount << " finished: " << (finished ? "yes" : "no")
+        << " upstream connections: " << connCount << " (max " << options.m_maxTotal << ")"
+        << " max inflight: " << maxInflight << " (max " << options.m_maxTotal * options.m_maxPipeline << ")" << std::endl;
+
+    pool->stop();
+    WaitFor([&disconnCount, &connCount]() { return disconnCount >= connCount; }, 3000);
+    server->shutdown();
+}
+
+void FuncTestTrd() {
+    std::cout << "UPSTREAM POOL TEST THIRD (IDLE AND HEALTH EVICTION) -----------------------------" << std::endl;
+
+    const uint16_t port = 9303;
+    const uint64_t requestCount = 4;
+
+    std::atomic<uint64_t> connCount(0);
+    std::atomic<uint64_t> disconnCount(0);
+    auto server = CreateEchoServer(port, connCount, disconnCount);
+    server->run();
+
+    auto loopThread = std::make_shared<EventLoopThread>("UPSTREAM_POOL_TEST_TRD");
+    loopThread->run();
+    EventLoopWkPtr loop;
+    loopThread->getEventLoop(loop);
+
+    // 最多保留1个空闲连接，空闲超过0.2秒后关闭
+    UpstreamPool::Options options;
+    options.m_maxIdle = 1;
+    options.m_idleTimeout = 0.2;
+    options.m_connectTimeout = 0.5;
+    auto pool = std::make_shared<UpstreamPool>(std::vector<EventLoopWkPtr>{loop}, options);
+    pool->start();
+
+    std::atomic<uint64_t> doneCount(0);
+    UpstreamPool::WkPtr weakPool = pool;
+    SetResponseCallback(pool, [weakPool, &doneCount](const TcpConnection::Ptr& conn) {
+        weakPool.lock()->release(conn);
+        ++doneCount;
+    });
+
+    // 同时发起请求，连接归还后超出空闲上限的连接立即关闭
+    auto upstreamAddr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port);
+    loop.lock()->executeTask([&pool, &loop, &upstreamAddr, requestCount]() {
+        for (uint64_t idx = 0; idx < requestCount; ++idx) {
+            pool->acquire(loop.lock(), upstreamAddr, [](const TcpConnection::Ptr& conn) {
+                if (nullptr != conn) {
+                    conn->send(TEST_REQUEST, TEST_REQUEST_SIZE);
+                }
+            });
+        }
+    });
+
+    WaitFor([&doneCount, requestCount]() { return doneCount >= requestCount; }, 3000);
+    WaitFor([&disconnCount, &connCount]() { return disconnCount + 1 >= connCount; }, 1000);
+    std::cout << "requests: " << doneCount << " upstream connections: " << connCount
+        << " closed after release: " << disconnCount << std::endl;
+
+    // 剩余空闲连接超时后关闭
+    bool evicted = WaitFor([&disconnCount, &connCount]() { return disconnCount >= connCount; }, 2000);
+    std::cout << "idle connection evicted: " << (evicted ? "yes" : "no") << std::endl;
+
+    // 上游不可用时，等待中的请求以空连接回调
+    std::atomic_bool failed(false);
+    auto deadAddr = std::make_shared<IPv4Address>(TEST_SERVER_IP, port + 100);
+    loop.lock()->executeTask([&pool, &loop, &deadAddr, &failed]() {
+        pool->acquire(loop.lock(), deadAddr, [&failed](const TcpConnection::Ptr& conn) {
+            failed = (nullptr == conn);
+        });
+    });
+    bool reported = WaitFor([&failed]() { return failed.load(); }, 2000);
+    std::cout << "dead upstream reported: " << (reported ? "yes" : "no") << std::endl;
+
+    pool->stop();
+    server->shutdown();
+}
+
+int main() {
+    Logger::SetLowestLevel(LogLevel::FATAL);
+    Logger::enableWriteFile(false);
+
+    FuncTestFst();
+    FuncTestSnd();
+    FuncTestTrd();
+    return 0;
+}
\ No newline at end of file